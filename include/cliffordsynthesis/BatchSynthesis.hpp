@@ -0,0 +1,35 @@
+//
+// This file is part of the MQT QMAP library released under the MIT license.
+// See README.md or go to https://github.com/cda-tum/qmap for more information.
+//
+
+#pragma once
+
+#include "cliffordsynthesis/Configuration.hpp"
+#include "cliffordsynthesis/Results.hpp"
+#include "cliffordsynthesis/Tableau.hpp"
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace cs {
+
+/**
+ * @brief synthesizes a circuit for every target (starting from the identity)
+ * with a shared configuration on up to `nThreads` threads.
+ *
+ * Targets that are equal up to a relabelling of the qubits are only
+ * synthesized once, the others reuse the relabelled circuit. Relabelling is
+ * skipped if the configuration restricts the qubit pairs, in which case only
+ * identical targets are shared. Reused results report no solver calls and the
+ * time it took to relabel the circuit as their runtime. The heuristic is not
+ * supported since it requires circuits.
+ * @returns the results in the order of the targets
+ */
+[[nodiscard]] std::vector<Results>
+synthesizeBatch(const std::vector<Tableau>& targets,
+                const Configuration& config = {},
+                std::size_t nThreads = std::thread::hardware_concurrency());
+
+} // namespace cs
@@ -0,0 +1,130 @@
+//
+// This file is part of the MQT QMAP library released under the MIT license.
+// See README.md or go to https://github.com/cda-tum/qmap for more information.
+//
+
+#pragma once
+
+#include "cliffordsynthesis/Tableau.hpp"
+#include "cliffordsynthesis/TargetMetric.hpp"
+#include "ir/QuantumComputation.hpp"
+#include "ir/operations/OpType.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cs {
+
+/**
+ * Table of optimal circuits for all tableaus on a few qubits that are
+ * reachable from the identity, i.e., all Clifford operations (with
+ * destabilizers) or all stabilizer states (without destabilizers).
+ *
+ * The table is computed by a search over the group using the gate set of the
+ * SAT encoding. It proceeds level by level in the target metric and breaks
+ * ties by the number of gates. Every entry only stores the last gate (or layer
+ * of gates for depth) of an optimal circuit, so a circuit is recovered by
+ * undoing these steps until the identity is reached.
+ *
+ * Tables are stored as little-endian files. The full Clifford group on three
+ * qubits has 92,897,280 elements, so its tables take 743 MB each and several
+ * minutes to generate, see mqt-qmap-clifford-db for measurements.
+ */
+class CliffordDatabase {
+public:
+  /// largest number of qubits whose tableaus fit the packed entries
+  static constexpr std::size_t MAX_QUBITS = 3U;
+  /// tables up to this size are generated in-process on first use
+  static constexpr std::size_t GENERATED_QUBITS = 2U;
+
+  CliffordDatabase() = default;
+
+  static CliffordDatabase generate(std::size_t nQubits, bool destabilizers,
+                                   TargetMetric metric);
+
+  void save(const std::string& filename) const;
+  static CliffordDatabase load(const std::string& filename);
+  /// file name of a table within a database directory
+  static std::string filename(std::size_t nQubits, bool destabilizers,
+                              TargetMetric metric);
+
+  /**
+   * @brief the shared table for the given parameters. Tables of up to
+   * GENERATED_QUBITS qubits are generated, larger ones are loaded from
+   * `directory` (if it contains the table).
+   * @returns nullptr if no table is available
+   */
+  static const CliffordDatabase* get(std::size_t nQubits, bool destabilizers,
+                                     TargetMetric metric,
+                                     const std::string& directory = "");
+
+  /// an optimal circuit that maps the identity to the target (if known)
+  [[nodiscard]] std::optional<qc::QuantumComputation>
+  lookup(const Tableau& target) const;
+
+  [[nodiscard]] std::size_t size() const { return entries.size(); }
+  [[nodiscard]] std::size_t getQubitCount() const { return nQubits; }
+  [[nodiscard]] bool hasDestabilizers() const { return destabilizers; }
+  [[nodiscard]] TargetMetric getMetric() const { return metric; }
+
+private:
+  /// gates applied in a single step, two-qubit gates are CX(first, second)
+  using Step = std::vector<std::pair<qc::OpType, std::pair<std::size_t,
+                                                           std::size_t>>>;
+
+  std::size_t nQubits = 0U;
+  bool destabilizers = false;
+  TargetMetric metric = TargetMetric::Gates;
+  // the bit of the first column in every row of a packed tableau
+  std::uint64_t rowMask = 0U;
+  // packed tableau in the lower bits and the last step in the upper bits,
+  // sorted by tableau
+  std::vector<std::uint64_t> entries;
+  std::vector<Step> steps;
+
+  static constexpr std::size_t STEP_SHIFT = 48U;
+  static constexpr std::uint64_t NO_STEP = 0xFFFFU;
+  static constexpr std::uint64_t TABLEAU_MASK =
+      (std::uint64_t{1} << STEP_SHIFT) - 1U;
+  // candidates of the search keep the number of gates below the tableau
+  static constexpr std::size_t GATE_BITS = 6U;
+  static constexpr std::uint64_t GATE_MASK =
+      (std::uint64_t{1} << GATE_BITS) - 1U;
+  static_assert((2U * MAX_QUBITS * ((2U * MAX_QUBITS) + 1U)) + GATE_BITS <=
+                STEP_SHIFT);
+
+  CliffordDatabase(std::size_t n, bool withDestabilizers,
+                   TargetMetric targetMetric);
+
+  static std::vector<Step> createSteps(std::size_t nQubits,
+                                       TargetMetric metric);
+  static std::uint64_t pack(const Tableau& tableau);
+  /// applies the gates of the step to all rows of the packed tableau at once
+  [[nodiscard]] std::uint64_t apply(std::uint64_t tableau, const Step& step,
+                                    bool inverse) const;
+  static std::uint64_t candidate(std::uint64_t tableau, std::uint64_t gates,
+                                 std::uint64_t step);
+  static std::uint64_t tableauOf(const std::uint64_t candidate) {
+    return (candidate & TABLEAU_MASK) >> GATE_BITS;
+  }
+  /// stably sorts the candidates by tableau and gate count and keeps the
+  /// first per tableau
+  static void sortUnique(std::vector<std::uint64_t>& candidates);
+  /// removes the (sorted) candidates whose tableau is in the (sorted) `known`
+  static void removeKnown(std::vector<std::uint64_t>& candidates,
+                          const std::vector<std::uint64_t>& known);
+  /// merges the (sorted) candidates into the entries
+  void settle(const std::vector<std::uint64_t>& candidates);
+  /// the sorted unique successors that are not settled yet
+  [[nodiscard]] std::vector<std::uint64_t>
+  expand(const std::vector<std::uint64_t>& from,
+         const std::vector<std::size_t>& stepIndices) const;
+  [[nodiscard]] std::optional<std::uint64_t>
+  findStep(std::uint64_t tableau) const;
+};
+
+} // namespace cs
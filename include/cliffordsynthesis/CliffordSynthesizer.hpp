@@ -7,15 +7,21 @@
 
 #include "cliffordsynthesis/Configuration.hpp"
 #include "cliffordsynthesis/Results.hpp"
+#include "cliffordsynthesis/SynthesisCache.hpp"
 #include "cliffordsynthesis/Tableau.hpp"
 #include "cliffordsynthesis/TargetMetric.hpp"
 #include "cliffordsynthesis/encoding/SATEncoder.hpp"
 #include "ir/QuantumComputation.hpp"
+#include "logicblocks/Statistics.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <cstddef>
 #include <limits>
 #include <memory>
+#include <optional>
 #include <plog/Log.h>
+#include <string>
 #include <utility>
 
 namespace cs {
@@ -67,6 +73,11 @@ protected:
   std::shared_ptr<qc::QuantumComputation> resultCircuit;
   Tableau resultTableau;
   std::size_t solverCalls{};
+  logicbase::Statistics solverStatistics{};
+  // whether every solver call so far was answered (e.g., none timed out)
+  bool conclusive = true;
+  // no solver call is started after this point (set for heuristic blocks)
+  std::optional<std::chrono::steady_clock::time_point> deadline{};
 
   static bool requiresMultiGateEncoding(const TargetMetric metric) {
     return metric == TargetMetric::Depth;
@@ -76,6 +87,17 @@ protected:
   std::pair<std::size_t, std::size_t> determineUpperBound(EncoderConfig config);
   void runMaxSAT(const EncoderConfig& config);
   Results callSolver(const EncoderConfig& config);
+  /// limits the solver to the time left until the deadline, returns false if
+  /// there is no time left
+  bool limitToDeadline(EncoderConfig& config) const;
+  void dumpIntermediateResult(const Results& res) const;
+  /// validates the pruning options and drops an initial circuit that does not
+  /// respect the coupling map
+  void checkQubitPairPruning();
+  bool loadFromDatabase();
+  bool loadFromCache(const CanonicalTableau& canonical, const std::string& key);
+  void storeInCache(const CanonicalTableau& canonical,
+                    const std::string& key) const;
 
   void minimizeGatesFixedDepth(EncoderConfig config);
 
@@ -91,12 +113,21 @@ protected:
                                            EncoderConfig config);
   void minimizeGatesFixedTwoQubitGateCount(EncoderConfig config);
 
+  /// the metric of a solution that the searched limit constrains
+  using SearchMetric = std::size_t (Results::*)() const;
+
   template <typename T>
   void runBinarySearch(T& value, T lowerBound, T upperBound,
-                       const EncoderConfig& config) {
+                       const EncoderConfig& config, SearchMetric metric) {
     PLOG_INFO << "Running binary search in range [" << lowerBound << ", "
               << upperBound << ")";
 
+    // A known solution, e.g., the initial circuit, already proves all limits
+    // from its value on to be satisfiable.
+    if (results.sat()) {
+      upperBound =
+          std::max(lowerBound, std::min<T>(upperBound, (results.*metric)()));
+    }
     while (lowerBound != upperBound) {
       value = (lowerBound + upperBound) / 2;
       PLOG_INFO << "Trying value " << value << " in range [" << lowerBound
@@ -104,7 +135,9 @@ protected:
       const auto r = callSolver(config);
       updateResults(configuration, r, results);
       if (r.sat()) {
-        upperBound = value;
+        // The solution may stay below the limit. All limits down to its value
+        // are then known to be satisfiable and need not be probed.
+        upperBound = std::max(lowerBound, std::min<T>(value, (r.*metric)()));
         PLOG_INFO << "Found solution. New upper bound is " << upperBound;
       } else {
         lowerBound = value + 1;
@@ -137,6 +170,17 @@ protected:
     PLOG_INFO << "No solution found in given interval.";
   }
 
+  /// binary search over a gate count limit that reuses a single solver
+  void runIncrementalBinarySearch(std::size_t lowerBound,
+                                  std::size_t upperBound,
+                                  const EncoderConfig& config,
+                                  bool includeSingleQubitGates = true);
+
+  /// optimizes all windows of `splitSize` layers, the first window ends after
+  /// `offset` layers (if non-zero)
+  std::shared_ptr<qc::QuantumComputation>
+  heuristicPass(const std::shared_ptr<qc::QuantumComputation>& circuit,
+                std::size_t offset, const Configuration& config);
   static std::shared_ptr<qc::QuantumComputation>
   synthesizeSubcircuit(const std::shared_ptr<qc::QuantumComputation>& qc,
                        std::size_t begin, std::size_t end,
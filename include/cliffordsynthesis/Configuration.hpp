@@ -6,21 +6,29 @@
 #pragma once
 
 #include "TargetMetric.hpp"
+#include "logicblocks/Encodings.hpp"
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <nlohmann/json.hpp>
 #include <ostream>
 #include <plog/Severity.h>
+#include <set>
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <utility>
 #include <variant>
 
 namespace cs {
 
+class SynthesisCache;
+
 using SolverParameter = std::variant<bool, std::uint32_t, double, std::string>;
 using SolverParameterMap = std::unordered_map<std::string, SolverParameter>;
+/// pairs of qubits that may interact (in either direction)
+using CouplingMap = std::set<std::pair<std::size_t, std::size_t>>;
 
 struct Configuration {
   Configuration() = default;
@@ -30,15 +38,34 @@ struct Configuration {
   std::size_t minimalTimesteps = 0U;
   bool useMaxSAT = false;
   bool linearSearch = false;
+  bool incrementalSearch = true;
   TargetMetric target = TargetMetric::Gates;
   bool useSymmetryBreaking = true;
+  encodings::CardinalityEncoding gateLimitEncoding =
+      encodings::CardinalityEncoding::PseudoBoolean;
   bool dumpIntermediateResults = false;
   std::string intermediateResultsPath = "./";
+  bool dumpInstances = false;
+  std::string instancesPath = "./";
   plog::Severity verbosity = plog::Severity::warning;
 
   /// Settings for the SAT solver
   SolverParameterMap solverParameters;
 
+  /// Settings for restricting the qubit pairs of two-qubit gates
+  /// (an empty coupling map allows all pairs, a window of 0 disables it)
+  CouplingMap couplingMap;
+  bool pruneByInteraction = false;
+  std::size_t twoQubitGateWindow = 0U;
+
+  /// Cache of previous syntheses that is consulted before calling the solver
+  std::shared_ptr<SynthesisCache> cache;
+
+  /// Settings for the table of optimal circuits on up to three qubits
+  bool useDatabase = true;
+  /// directory with tables generated by mqt-qmap-clifford-db (for 3 qubits)
+  std::string databasePath;
+
   /// Settings for depth-optimal synthesis
   bool minimizeGatesAfterDepthOptimization = false;
 
@@ -51,6 +78,14 @@ struct Configuration {
   bool heuristic = false;
   std::size_t splitSize = 5U;
   std::size_t nThreadsHeuristic = std::thread::hardware_concurrency();
+  /// time limit in milliseconds for the synthesis of each block, no further
+  /// solver call is started on a block after it (0 = none)
+  std::uint32_t heuristicTimeout = 0U;
+  /// maximum number of passes with alternating window offsets; further passes
+  /// only run while the depth improves (0 = no limit)
+  std::size_t heuristicPasses = 1U;
+  /// no further pass is started after this many seconds (0 = no limit)
+  double heuristicTimeBudget = 0.;
 
   [[nodiscard]] nlohmann::basic_json<> json() const {
     nlohmann::basic_json j;
@@ -58,8 +93,22 @@ struct Configuration {
     j["minimal_timesteps"] = minimalTimesteps;
     j["use_max_sat"] = useMaxSAT;
     j["linear_search"] = linearSearch;
+    j["incremental_search"] = incrementalSearch;
     j["target_metric"] = toString(target);
     j["use_symmetry_breaking"] = useSymmetryBreaking;
+    j["gate_limit_encoding"] = encodings::toString(gateLimitEncoding);
+    if (dumpInstances) {
+      j["instances_path"] = instancesPath;
+    }
+    if (!couplingMap.empty()) {
+      j["coupling_map"] = couplingMap;
+    }
+    j["prune_by_interaction"] = pruneByInteraction;
+    j["two_qubit_gate_window"] = twoQubitGateWindow;
+    j["use_database"] = useDatabase;
+    if (!databasePath.empty()) {
+      j["database_path"] = databasePath;
+    }
     j["minimize_gates_after_depth_optimization"] =
         minimizeGatesAfterDepthOptimization;
     j["try_higher_gate_limit_for_two_qubit_gate_optimization"] =
@@ -70,6 +119,9 @@ struct Configuration {
     j["heuristic"] = heuristic;
     j["split_size"] = splitSize;
     j["n_threads_heuristic"] = nThreadsHeuristic;
+    j["heuristic_timeout"] = heuristicTimeout;
+    j["heuristic_passes"] = heuristicPasses;
+    j["heuristic_time_budget"] = heuristicTimeBudget;
     if (!solverParameters.empty()) {
       nlohmann::basic_json solverParametersJson;
       for (const auto& entry : solverParameters) {
@@ -84,6 +136,12 @@ struct Configuration {
     return j;
   }
 
+  /// whether the encoding does not contain two-qubit gates on all pairs
+  [[nodiscard]] bool prunesQubitPairs() const {
+    return !couplingMap.empty() || pruneByInteraction ||
+           twoQubitGateWindow != 0U;
+  }
+
   friend std::ostream& operator<<(std::ostream& os,
                                   const Configuration& config) {
     os << config.json().dump(2);
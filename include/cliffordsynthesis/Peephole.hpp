@@ -0,0 +1,33 @@
+//
+// This file is part of the MQT QMAP library released under the MIT license.
+// See README.md or go to https://github.com/cda-tum/qmap for more information.
+//
+
+#pragma once
+
+#include "cliffordsynthesis/Tableau.hpp"
+#include "ir/QuantumComputation.hpp"
+#include "ir/operations/Operation.hpp"
+
+#include <cstddef>
+
+namespace cs {
+
+/// whether the tableau can simulate the operation
+[[nodiscard]] bool isSupportedCliffordGate(const qc::Operation& op);
+
+/**
+ * @brief removes all gates that leave the tableau of the circuit executed so
+ * far unchanged, starting from `initial`. For a tableau without
+ * destabilizers, these are the gates that stabilize the state prepared up to
+ * that point (e.g., a Z or CZ acting on |0>). Identity gates are always
+ * removed. The optimization stops at the first operation that the tableau
+ * cannot simulate, which is kept together with all subsequent operations.
+ * @returns the number of removed gates
+ */
+std::size_t removeRedundantGates(qc::QuantumComputation& qc, Tableau initial);
+
+/// removes the redundant gates of a circuit that is applied to |0...0>
+std::size_t removeRedundantGates(qc::QuantumComputation& qc);
+
+} // namespace cs
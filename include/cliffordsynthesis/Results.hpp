@@ -8,6 +8,7 @@
 #include "cliffordsynthesis/Tableau.hpp"
 #include "ir/QuantumComputation.hpp"
 #include "logicblocks/Logic.hpp"
+#include "logicblocks/Statistics.hpp"
 
 #include <cstddef>
 #include <limits>
@@ -36,6 +37,9 @@ public:
     return solverResult;
   }
   [[nodiscard]] std::size_t getSolverCalls() const { return solverCalls; }
+  [[nodiscard]] const logicbase::Statistics& getSolverStatistics() const {
+    return solverStatistics;
+  }
 
   [[nodiscard]] std::string getResultCircuit() const { return resultCircuit; }
   [[nodiscard]] std::string getResultTableau() const { return resultTableau; }
@@ -46,6 +50,9 @@ public:
   void setRuntime(const double t) { runtime = t; }
   void setSolverResult(const logicbase::Result r) { solverResult = r; }
   void setSolverCalls(const std::size_t c) { solverCalls = c; }
+  void setSolverStatistics(const logicbase::Statistics& s) {
+    solverStatistics = s;
+  }
 
   void setResultCircuit(const qc::QuantumComputation& qc);
   void setResultTableau(const Tableau& tableau);
@@ -68,6 +75,7 @@ protected:
   std::size_t depth = std::numeric_limits<std::size_t>::max();
   double runtime = 0.0;
   std::size_t solverCalls = 0U;
+  logicbase::Statistics solverStatistics;
 
   std::string resultTableau;
   std::string resultCircuit;
@@ -0,0 +1,126 @@
+//
+// This file is part of the MQT QMAP library released under the MIT license.
+// See README.md or go to https://github.com/cda-tum/qmap for more information.
+//
+
+#pragma once
+
+#include "Definitions.hpp"
+#include "cliffordsynthesis/Configuration.hpp"
+#include "cliffordsynthesis/Tableau.hpp"
+#include "ir/QuantumComputation.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace cs {
+
+/// relabels qubit q of every operation in the circuit to mapping[q]
+void relabelQubits(qc::QuantumComputation& qc,
+                   const std::vector<qc::Qubit>& mapping);
+
+/// tableaus on up to this many qubits are canonicalized over all relabellings
+constexpr std::size_t CANONICAL_QUBIT_LIMIT = 6U;
+
+/**
+ * Canonical form of a target tableau up to a relabelling of the qubits, i.e.,
+ * the lexicographically smallest representation over all qubit permutations.
+ * Larger tableaus are only used as they are.
+ */
+struct CanonicalTableau {
+  std::string tableau;
+  /// qubit q of the original tableau is qubit `permutation[q]` of the
+  /// canonical one
+  std::vector<qc::Qubit> permutation;
+
+  explicit CanonicalTableau(const Tableau& target);
+
+  /// relabels a circuit from the original to the canonical qubits
+  void toCanonical(qc::QuantumComputation& qc) const;
+  /// relabels a circuit from the canonical to the original qubits
+  void fromCanonical(qc::QuantumComputation& qc) const;
+};
+
+/// a synthesized circuit for the canonical form of its target
+struct CacheEntry {
+  std::string circuit;
+  std::size_t singleQubitGates = 0U;
+  std::size_t twoQubitGates = 0U;
+  std::size_t depth = 0U;
+
+  [[nodiscard]] nlohmann::basic_json<> json() const;
+  static CacheEntry fromJson(const nlohmann::basic_json<>& j);
+};
+
+/**
+ * Cache of optimal synthesis results. Entries are keyed by the canonical
+ * target tableau, the target metric and the options that change the optimum,
+ * so that equivalent blocks of larger circuits are only synthesized once.
+ * Caches may be shared by synthesizers running in parallel.
+ */
+class SynthesisCache {
+public:
+  virtual ~SynthesisCache() = default;
+
+  [[nodiscard]] static std::string key(const CanonicalTableau& target,
+                                       const Configuration& config,
+                                       bool initialDestabilizers);
+
+  std::optional<CacheEntry> lookup(const std::string& key);
+  virtual void store(const std::string& key, const CacheEntry& entry) = 0;
+
+  [[nodiscard]] std::size_t getHits() const { return hits; }
+  [[nodiscard]] std::size_t getMisses() const { return misses; }
+
+protected:
+  virtual std::optional<CacheEntry> find(const std::string& key) = 0;
+
+private:
+  std::atomic<std::size_t> hits{0U};
+  std::atomic<std::size_t> misses{0U};
+};
+
+/// in-memory cache that evicts the least recently used entries
+class LRUSynthesisCache : public SynthesisCache {
+public:
+  explicit LRUSynthesisCache(std::size_t cap = 1024U) : capacity(cap) {}
+
+  void store(const std::string& key, const CacheEntry& entry) override;
+  [[nodiscard]] std::size_t size() const;
+
+protected:
+  std::optional<CacheEntry> find(const std::string& key) override;
+
+private:
+  std::size_t capacity;
+  mutable std::mutex mutex;
+  // most recently used entries first
+  std::list<std::pair<std::string, CacheEntry>> entries;
+  std::unordered_map<std::string, decltype(entries)::iterator> index;
+};
+
+/// persistent cache with one JSON file per entry in a directory
+class DiskSynthesisCache : public SynthesisCache {
+public:
+  explicit DiskSynthesisCache(std::string dir);
+
+  void store(const std::string& key, const CacheEntry& entry) override;
+
+protected:
+  std::optional<CacheEntry> find(const std::string& key) override;
+
+private:
+  std::string directory;
+
+  [[nodiscard]] std::string filename(const std::string& key) const;
+};
+
+} // namespace cs
@@ -21,18 +21,68 @@
 #include <vector>
 
 namespace cs {
+/**
+ * Stabilizer tableau with one row per (de)stabilizer and 2n+1 columns (the X
+ * part, the Z part and the phase).
+ *
+ * The tableau is stored column-major and bit-packed, i.e., every column is a
+ * sequence of 64-bit words holding one bit per row. Hence, a gate on k qubits
+ * only touches 2k+1 columns and updates 64 rows per word operation. On CPUs
+ * with AVX2 (detected at runtime), columns of several words are updated four
+ * words at a time.
+ */
 class Tableau {
   using EntryType = std::uint8_t;
   using RowType = std::vector<EntryType>;
   using TableauType = std::vector<RowType>;
+  using WordType = std::uint64_t;
+  static constexpr std::size_t WORD_BITS = 64U;
+
   std::size_t nQubits{};
-  TableauType tableau;
+  std::size_t nRows{};
+  std::size_t nColumns{};
+  // number of words per column
+  std::size_t nWords{};
+  // bits of row i in column j are at bit i % 64 of data[j * nWords + i / 64]
+  // (unused bits of the last word of each column are always zero)
+  std::vector<WordType> data;
 
 private:
   void loadStabilizerDestabilizerString(const std::string& string);
   static RowType parseStabilizer(const std::string& stab);
+  // replaces the tableau by the given (rectangular) rows
+  void fromRows(const TableauType& rows);
+  void appendRows(const TableauType& rows);
+
+  [[nodiscard]] WordType* columnWords(const std::size_t j) {
+    return data.data() + (j * nWords);
+  }
+  [[nodiscard]] const WordType* columnWords(const std::size_t j) const {
+    return data.data() + (j * nWords);
+  }
 
 public:
+  /// lightweight view of a row that reads its entries from the tableau
+  class Row {
+    const Tableau* tableau;
+    std::size_t row;
+
+  public:
+    Row(const Tableau* t, const std::size_t r) : tableau(t), row(r) {}
+    [[nodiscard]] EntryType operator[](const std::size_t column) const {
+      return tableau->get(row, column) ? 1U : 0U;
+    }
+    [[nodiscard]] std::size_t size() const { return tableau->nColumns; }
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    operator RowType() const {
+      RowType r(size());
+      for (std::size_t j = 0U; j < r.size(); ++j) {
+        r[j] = (*this)[j];
+      }
+      return r;
+    }
+  };
+
   Tableau() = default;
   explicit Tableau(const qc::QuantumComputation& qc, std::size_t begin = 0,
                    std::size_t end = std::numeric_limits<std::size_t>::max(),
@@ -44,37 +94,49 @@ public:
   }
   explicit Tableau(const std::string& description) {
     fromString(description);
-    if (tableau.empty()) {
+    if (nRows == 0U) {
       throw std::runtime_error("Tableau is empty");
     }
-    nQubits = tableau.back().size() / 2U;
+    nQubits = nColumns / 2U;
   }
   explicit Tableau(const std::string& stabilizers,
                    const std::string& destabilizers) {
     fromString(stabilizers, destabilizers);
-    nQubits = tableau.size() / 2U;
+    nQubits = nRows / 2U;
   }
 
-  [[nodiscard]] RowType operator[](const std::size_t index) {
-    return tableau[index];
+  [[nodiscard]] Row operator[](const std::size_t index) const {
+    return {this, index};
   }
-  [[nodiscard]] RowType operator[](const std::size_t index) const {
-    return tableau[index];
+
+  [[nodiscard]] Row at(const std::size_t index) const {
+    if (index >= nRows) {
+      throw std::out_of_range("Tableau::at: row index out of range");
+    }
+    return {this, index};
   }
 
-  [[nodiscard]] RowType at(const std::size_t index) {
-    return tableau.at(index);
+  [[nodiscard]] bool get(const std::size_t row,
+                         const std::size_t column) const {
+    assert(row < nRows && column < nColumns);
+    const auto word = columnWords(column)[row / WORD_BITS];
+    return ((word >> (row % WORD_BITS)) & 1U) != 0U;
+  }
+  void set(const std::size_t row, const std::size_t column, const bool value) {
+    assert(row < nRows && column < nColumns);
+    auto& word = columnWords(column)[row / WORD_BITS];
+    const auto mask = WordType{1} << (row % WORD_BITS);
+    word = value ? (word | mask) : (word & ~mask);
   }
 
   [[nodiscard]] std::size_t getQubitCount() const { return nQubits; }
 
-  [[nodiscard]] std::size_t getTableauSize() const { return tableau.size(); }
+  [[nodiscard]] std::size_t getTableauSize() const { return nRows; }
 
-  [[nodiscard]] bool hasDestabilizers() const {
-    return tableau.size() == 2 * nQubits;
-  }
+  [[nodiscard]] bool hasDestabilizers() const { return nRows == 2 * nQubits; }
 
-  [[nodiscard]] auto& getTableau() const { return tableau; }
+  /// the tableau as a row-major matrix (one entry per byte)
+  [[nodiscard]] TableauType getTableau() const;
 
   void dump(const std::string& filename) const;
 
@@ -83,6 +145,26 @@ public:
   void import(const std::string& filename);
   void import(std::istream& is);
 
+  /**
+   * @brief compact binary serialization: a header with the dimensions
+   * followed by the bit-packed columns as little-endian 64-bit words.
+   */
+  void dumpBinary(const std::string& filename) const;
+  void dumpBinary(std::ostream& os) const;
+  void importBinary(const std::string& filename);
+  void importBinary(std::istream& is);
+
+  /**
+   * @brief replaces the tableau by the one of the OpenQASM (2 or 3) circuit
+   * read from the stream. Statements are parsed and applied one at a time,
+   * so the circuit is never held in memory. Only qubit declarations, barriers
+   * and the gates supported by applyGate without parameters are accepted, and
+   * all qubits have to be declared before the first gate.
+   */
+  void importQASM(const std::string& filename,
+                  bool includeDestabilizers = false);
+  void importQASM(std::istream& is, bool includeDestabilizers = false);
+
   template <std::size_t N>
   void populateTableauFrom(const std::bitset<N> bv, const std::size_t nQ,
                            const std::size_t column) {
@@ -90,19 +172,36 @@ public:
     assert(nQ <= getTableauSize());
     assert(nQ <= N);
     for (std::size_t i = 0U; i < nQ; ++i) {
-      if (bv[i]) {
-        tableau[i][column] = 1;
-      } else {
-        tableau[i][column] = 0;
-      }
+      set(i, column, bv[i]);
     }
   }
   void populateTableauFrom(const std::uint64_t bv, const std::size_t nQ,
                            const std::size_t column) {
-    populateTableauFrom(std::bitset<64>(bv), nQ, column);
+    assert(nQ <= getTableauSize());
+    assert(nQ <= WORD_BITS);
+    auto* const col = columnWords(column);
+    const auto mask =
+        nQ == WORD_BITS ? ~WordType{0} : (WordType{1} << nQ) - 1U;
+    col[0] = (col[0] & ~mask) | (bv & mask);
   }
 
   void applyGate(const qc::Operation* gate);
+  /// applies a gate or (recursively) the gates of a compound operation
+  void applyOperation(const qc::Operation& op);
+  /**
+   * @brief applies the operations of a range whose elements point to
+   * operations (e.g., a circuit or a generator of operations) in order.
+   */
+  template <class InputIt> void applyOperations(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      applyOperation(**first);
+    }
+  }
+  /**
+   * @brief applies the gate and reports whether it changed the tableau. Only
+   * the columns of the qubits the gate acts on and the phase are compared.
+   */
+  bool applyGateAndDetectChange(const qc::Operation* gate);
   void applyH(std::size_t target);
   void applyS(std::size_t target);
   void applySdag(std::size_t target);
@@ -120,7 +219,8 @@ public:
   void applyECR(std::size_t q1, std::size_t q2);
 
   [[gnu::pure]] friend bool operator==(const Tableau& lhs, const Tableau& rhs) {
-    return lhs.tableau == rhs.tableau;
+    return lhs.nRows == rhs.nRows && lhs.nColumns == rhs.nColumns &&
+           lhs.data == rhs.data;
   }
   [[gnu::pure]] friend bool operator!=(const Tableau& lhs, const Tableau& rhs) {
     return !(lhs == rhs);
@@ -153,15 +253,14 @@ public:
     assert(column <= 2 * nQubits);
     assert(nQubits <= N);
     std::bitset<N> bv;
-    for (std::size_t i = 0U; i < getTableauSize(); ++i) {
-      if (tableau[i][column] == 1U) {
-        bv[i] = 1;
-      }
+    for (std::size_t i = 0U; i < getTableauSize() && i < N; ++i) {
+      bv[i] = get(i, column);
     }
     return bv;
   }
   [[nodiscard]] std::uint64_t getBVFrom(const std::size_t column) const {
-    return getBVFrom<64>(column).to_ullong();
+    assert(column <= 2 * nQubits);
+    return nWords == 0U ? 0U : columnWords(column)[0];
   }
 };
 } // namespace cs
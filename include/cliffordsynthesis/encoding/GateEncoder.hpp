@@ -6,6 +6,7 @@
 #pragma once
 
 #include "cliffordsynthesis/Results.hpp"
+#include "cliffordsynthesis/encoding/QubitPairPruning.hpp"
 #include "cliffordsynthesis/encoding/TableauEncoder.hpp"
 #include "ir/QuantumComputation.hpp"
 #include "ir/operations/OpType.hpp"
@@ -37,6 +38,15 @@ public:
     logicbase::LogicMatrix3D gS;
     // variables for the two-qubit gates
     logicbase::LogicMatrix3D gC;
+    // the pairs that may carry a two-qubit gate in each timestep (all pairs
+    // if empty), the variables of all other pairs are constant false
+    std::vector<QubitPairMask> allowedPairs;
+
+    [[nodiscard]] bool isAllowed(const std::size_t pos, const std::size_t ctrl,
+                                 const std::size_t trgt) const {
+      return ctrl != trgt &&
+             (allowedPairs.empty() || allowedPairs[pos][ctrl][trgt]);
+    }
 
     void
     collectSingleQubitGateVariables(std::size_t pos, std::size_t qubit,
@@ -46,6 +56,12 @@ public:
                                       logicbase::LogicVector& variables) const;
   };
 
+  /// restricts the two-qubit gates to the given pairs per timestep (must be
+  /// called before the variables are created)
+  void restrictTwoQubitGates(std::vector<QubitPairMask> allowed) {
+    vars.allowedPairs = std::move(allowed);
+  }
+
   // variable creation
   void createSingleQubitGateVariables();
   void createTwoQubitGateVariables();
@@ -8,13 +8,16 @@
 #include "cliffordsynthesis/TargetMetric.hpp"
 #include "cliffordsynthesis/encoding/GateEncoder.hpp"
 #include "ir/operations/OpType.hpp"
+#include "logicblocks/Encodings.hpp"
 #include "logicblocks/LogicBlock.hpp"
 #include "logicblocks/LogicTerm.hpp"
 
 #include <cstddef>
 #include <memory>
+#include <optional>
 #include <plog/Log.h>
 #include <utility>
+#include <vector>
 
 namespace cs::encoding {
 
@@ -36,6 +39,25 @@ public:
         op(cost, logicbase::LogicTerm(static_cast<int>(maxGateCount))));
   }
 
+  /**
+   * @brief limits the gate count using a clausal cardinality encoding instead
+   * of an integer sum (which is used for CardinalityEncoding::PseudoBoolean)
+   */
+  void limitGateCount(std::size_t maxGateCount,
+                      encodings::CardinalityEncoding encoding,
+                      bool includeSingleQubitGates = true) const;
+
+  /**
+   * @brief creates a gate counter that can be bounded repeatedly (e.g., in
+   * different scopes of the logic block) without re-encoding the sum
+   * @param maxGateCount the largest bound that will be passed to
+   * boundGateCount()
+   */
+  void createGateCounter(std::size_t maxGateCount,
+                         encodings::CardinalityEncoding encoding,
+                         bool includeSingleQubitGates = true);
+  void boundGateCount(std::size_t maxGateCount) const;
+
   void optimizeMetric(TargetMetric targetMetric) const;
 
   void optimizeGateCount(bool includeSingleQubitGates = true) const;
@@ -54,6 +76,12 @@ protected:
   // the logic block
   std::shared_ptr<logicbase::LogicBlock> lb;
 
+  // the counter created by createGateCounter()
+  std::optional<encodings::Cardinality> gateCounter;
+
+  [[nodiscard]] std::vector<logicbase::LogicTerm>
+  collectGateVariables(bool includeSingleQubitGates = true) const;
+
   [[nodiscard]] logicbase::LogicTerm
   collectGateCount(bool includeSingleQubitGates = true) const;
 
@@ -77,8 +105,12 @@ protected:
     const auto& twoQubitGates = gvars->gC[pos];
     for (std::size_t ctrl = 0U; ctrl < N; ++ctrl) {
       for (std::size_t trgt = 0U; trgt < ctrl; ++trgt) {
-        terms = op(terms, twoQubitGates[ctrl][trgt]);
-        terms = op(terms, twoQubitGates[trgt][ctrl]);
+        if (gvars->isAllowed(pos, ctrl, trgt)) {
+          terms = op(terms, twoQubitGates[ctrl][trgt]);
+        }
+        if (gvars->isAllowed(pos, trgt, ctrl)) {
+          terms = op(terms, twoQubitGates[trgt][ctrl]);
+        }
       }
     }
   }
@@ -0,0 +1,49 @@
+//
+// This file is part of the MQT QMAP library released under the MIT license.
+// See README.md or go to https://github.com/cda-tum/qmap for more information.
+//
+
+#pragma once
+
+#include "cliffordsynthesis/Configuration.hpp"
+#include "cliffordsynthesis/Tableau.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace cs::encoding {
+
+/// whether a CNOT may act on (ctrl, trgt), indexed by [ctrl][trgt]
+using QubitPairMask = std::vector<std::vector<bool>>;
+
+/**
+ * @brief the component of every qubit in the graph that connects all qubits
+ * on which row i of the initial or row i of the target tableau acts
+ * non-trivially. Since a circuit maps every initial row to the corresponding
+ * target row, qubits of different components never need to interact.
+ */
+[[nodiscard]] std::vector<std::size_t>
+interactionComponents(const Tableau& initial, const Tableau& target);
+
+/**
+ * @brief the pairs that may carry a two-qubit gate in each timestep, i.e.,
+ * the pairs of the coupling map (all if empty) within the same interaction
+ * component (any if `components` is empty) and, if `window` is non-zero,
+ * within the qubits [t mod (N - window + 1), ... + window) at timestep t.
+ */
+[[nodiscard]] std::vector<QubitPairMask>
+createQubitPairMasks(std::size_t nQubits, std::size_t timesteps,
+                     const CouplingMap& couplingMap,
+                     const std::vector<std::size_t>& components,
+                     std::size_t window);
+
+/**
+ * @brief whether the pairs allowed in any of the masks connect all qubits of
+ * every interaction component. Otherwise, no number of timesteps suffices to
+ * reach the target.
+ */
+[[nodiscard]] bool
+connectsComponents(const std::vector<QubitPairMask>& masks,
+                   const std::vector<std::size_t>& components);
+
+} // namespace cs::encoding
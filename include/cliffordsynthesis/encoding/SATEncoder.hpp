@@ -12,12 +12,15 @@
 #include "cliffordsynthesis/encoding/GateEncoder.hpp"
 #include "cliffordsynthesis/encoding/ObjectiveEncoder.hpp"
 #include "cliffordsynthesis/encoding/TableauEncoder.hpp"
+#include "logicblocks/Encodings.hpp"
 #include "logicblocks/Logic.hpp"
 #include "logicblocks/LogicBlock.hpp"
+#include "logicblocks/Statistics.hpp"
 
 #include <cstddef>
 #include <memory>
 #include <optional>
+#include <string>
 
 namespace cs::encoding {
 
@@ -57,7 +60,27 @@ public:
     // an optional limit on the total number of two-qubit gates
     std::optional<std::size_t> twoQubitGateLimit = std::nullopt;
 
+    // how gate count limits are encoded
+    encodings::CardinalityEncoding gateLimitEncoding =
+        encodings::CardinalityEncoding::PseudoBoolean;
+
+    // two-qubit gates are only encoded for the pairs of this coupling map
+    // (for all pairs if empty)
+    CouplingMap couplingMap;
+
+    // two-qubit gates are only encoded for qubits that are connected by the
+    // rows of the initial or the target tableau
+    bool pruneByInteraction = false;
+
+    // two-qubit gates are only encoded within a window of this many qubits
+    // that moves by one qubit per timestep (0 = no window)
+    std::size_t twoQubitGateWindow = 0U;
+
     SolverParameterMap solverParameters;
+
+    // directory solver instances are written to before solving (together
+    // with a JSON file describing each instance), empty to disable
+    std::string instancesPath;
   };
 
   SATEncoder() = default;
@@ -68,12 +91,28 @@ public:
 
   virtual Results run();
 
+  /**
+   * Incremental interface: prepare() creates the formulation once and
+   * runWithGateLimit() solves it under a gate count limit that only holds for
+   * this call. Everything the solver learns is kept for subsequent limits.
+   */
+  void prepare(std::size_t maxGateLimit, bool includeSingleQubitGates = true);
+  Results runWithGateLimit(std::size_t limit);
+  /// statistics of the formulation (accumulated over all calls so far)
+  [[nodiscard]] logicbase::Statistics getStatistics() const {
+    return lb->getStatistics();
+  }
+  void cleanup() const;
+
 protected:
   void initializeSolver();
   void createFormulation();
   [[nodiscard]] logicbase::Result solve() const;
   void extractResultsFromModel(Results& res) const;
-  void cleanup() const;
+  void limitGateCount(std::size_t limit, bool includeSingleQubitGates) const;
+  /// writes the current instance if requested, `probeLimit` is the gate limit
+  /// of an incremental call to runWithGateLimit()
+  void dumpInstance(std::optional<std::size_t> probeLimit = std::nullopt) const;
 
   std::shared_ptr<logicbase::LogicBlock> lb;
   std::shared_ptr<TableauEncoder> tableauEncoder;
@@ -87,6 +126,9 @@ protected:
   std::size_t N{}; // NOLINT (readability-identifier-naming)
   // timestep limit T
   std::size_t T{}; // NOLINT (readability-identifier-naming)
+
+  // whether runWithGateLimit() limits all gates or only two-qubit gates
+  bool limitSingleQubitGates = true;
 };
 
 } // namespace cs::encoding
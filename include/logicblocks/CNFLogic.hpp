@@ -0,0 +1,148 @@
+#pragma once
+
+#include "Logic.hpp"
+#include "LogicBlock.hpp"
+#include "LogicTerm.hpp"
+#include "Model.hpp"
+#include "Preprocessor.hpp"
+#include "SATSolver.hpp"
+#include "Statistics.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace cnflogic {
+
+using namespace logicbase;
+
+/**
+ * LogicBlock that Tseitin-encodes formulas directly into CNF and solves them
+ * with a pluggable SAT solver.
+ *
+ * Supports Boolean terms and bit-vectors combined with bitwise operators,
+ * (in)equality and if-then-else. Bit-vectors are bit-blasted (least
+ * significant bit first). Arithmetic and integer/real terms are rejected.
+ *
+ * Definitions of subterms are always permanent. Only the top-level clauses
+ * asserted inside a scope are guarded by the scope's selector literal, which
+ * is assumed while the scope is open and permanently falsified by pop().
+ *
+ * With preprocessing enabled, the clauses that are pending when the instance
+ * is produced for the first time are simplified by a Preprocessor before
+ * they reach the solver. Later clauses and assumptions are mapped to the
+ * simplified formula and models are extended to the removed variables.
+ */
+class CNFLogicBlock : public LogicBlock {
+protected:
+  std::unique_ptr<SATSolver> solver;
+  /// literals of every encoded variable and subterm, indexed by term id
+  std::unordered_map<uint64_t, std::vector<Lit>> literals;
+  /// all clauses, each terminated by a 0 (as in DIMACS)
+  std::vector<Lit> cnf;
+  std::size_t numClauses = 0U;
+  std::size_t numSubmitted = 0U;
+  int32_t numVars = 0;
+  Lit trueLit = 0;
+  /// activation literal of each open scope
+  std::vector<Lit> selectors;
+  std::size_t convertedNodes = 0U;
+  std::size_t cacheHits = 0U;
+  bool preprocess = false;
+  std::unique_ptr<Preprocessor> preprocessor;
+  double preprocessTime = 0.;
+
+  void internalReset() override;
+  void emitClause(const LogicTerm& clause) override;
+  void internalPush() override;
+  void internalPop() override;
+
+  Lit newVar() { return ++numVars; }
+  void addClause(std::initializer_list<Lit> clause);
+  void addClause(const std::vector<Lit>& clause);
+
+  std::vector<Lit> encode(const LogicTerm& a);
+  std::vector<Lit> encodeComposite(const LogicTerm& a);
+  Lit encodeBool(const LogicTerm& a);
+  Lit getTrue();
+
+  Lit makeAnd(const std::vector<Lit>& lits);
+  Lit makeOr(const std::vector<Lit>& lits);
+  Lit makeXor(Lit a, Lit b);
+  Lit makeIte(Lit c, Lit t, Lit e);
+  Lit makeEqual(const std::vector<Lit>& a, const std::vector<Lit>& b);
+
+  /// adds a top-level clause, guarded by the selector of the current scope
+  void addAssertion(std::vector<Lit> clause);
+  void assertEncoded(const LogicTerm& a);
+
+  /// simplifies all pending clauses and hands the result to the solver
+  void runPreprocessor();
+  void submit(const std::vector<Lit>& clause);
+
+public:
+  explicit CNFLogicBlock(
+      std::unique_ptr<SATSolver> sol = std::make_unique<CDCLSolver>(),
+      bool convert = true, bool simplify = false)
+      : LogicBlock(convert), solver(std::move(sol)), preprocess(simplify) {}
+  // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+  ~CNFLogicBlock() override { delete model; }
+
+  void produceInstance() override;
+  Result solve() override;
+  Result solve(const std::vector<LogicTerm>& assumptions) override;
+  void interrupt() override { solver->interrupt(); }
+  [[nodiscard]] Statistics getStatistics() const override {
+    auto s = stats;
+    s.convertedNodes = convertedNodes;
+    s.cacheHits = cacheHits;
+    return s;
+  }
+
+  /// literals the term was encoded to, or an empty vector if it was not
+  [[nodiscard]] const std::vector<Lit>& getLiterals(const LogicTerm& a) const;
+
+  [[nodiscard]] int32_t getNumVars() const { return numVars; }
+  [[nodiscard]] std::size_t getNumClauses() const { return numClauses; }
+  /// the preprocessor, once the instance has been produced with preprocessing
+  [[nodiscard]] const Preprocessor* getPreprocessor() const {
+    return preprocessor.get();
+  }
+
+  void dumpDIMACS(std::ostream& os) const;
+  /**
+   * @brief writes the instance as weighted MaxSAT problem, where the given
+   * terms are soft constraints (weights are rounded to positive integers)
+   */
+  void dumpWCNF(std::ostream& os,
+                const std::vector<std::pair<LogicTerm, double>>& soft);
+
+  std::string dumpInternalSolver() override;
+  /// adds the clauses of a DIMACS file, its variables become fresh variables
+  void loadInstance(const std::string& filename) override;
+};
+
+class CNFModel : public Model {
+protected:
+  std::vector<bool> values;
+
+  [[nodiscard]] bool getLitValue(Lit lit) const;
+  [[nodiscard]] uint64_t getValue(const LogicTerm& a, LogicBlock* lb) const;
+
+public:
+  CNFModel(Result res, std::vector<bool> vals)
+      : Model(res), values(std::move(vals)) {}
+
+  int getIntValue(const LogicTerm& a, LogicBlock* lb) override;
+  bool getBoolValue(const LogicTerm& a, LogicBlock* lb) override;
+  double getRealValue(const LogicTerm& a, LogicBlock* lb) override;
+  uint64_t getBitvectorValue(const LogicTerm& a, LogicBlock* lb) override;
+};
+
+} // namespace cnflogic
@@ -6,6 +6,9 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -56,6 +59,119 @@ LogicTerm naiveAtLeastOne(const std::vector<LogicTerm>& clauseVars);
 LogicTerm atMostOneBiMander(const std::vector<LogicTerm>& vars,
                             LogicBlock* logic);
 
+enum class CardinalityEncoding : uint8_t {
+  // the sum is handed to the backend as (pseudo-Boolean) integer arithmetic
+  PseudoBoolean,
+  SequentialCounter,
+  Totalizer,
+  ModuloTotalizer
+};
+
+[[maybe_unused]] static inline std::string
+toString(const CardinalityEncoding encoding) {
+  switch (encoding) {
+  case CardinalityEncoding::PseudoBoolean:
+    return "pseudo_boolean";
+  case CardinalityEncoding::SequentialCounter:
+    return "sequential_counter";
+  case CardinalityEncoding::Totalizer:
+    return "totalizer";
+  case CardinalityEncoding::ModuloTotalizer:
+    return "modulo_totalizer";
+  }
+  return " ";
+}
+
+[[maybe_unused]] static CardinalityEncoding
+cardinalityEncodingFromString(const std::string& encoding) {
+  if (encoding == "pseudo_boolean") {
+    return CardinalityEncoding::PseudoBoolean;
+  }
+  if (encoding == "sequential_counter") {
+    return CardinalityEncoding::SequentialCounter;
+  }
+  if (encoding == "totalizer") {
+    return CardinalityEncoding::Totalizer;
+  }
+  if (encoding == "modulo_totalizer") {
+    return CardinalityEncoding::ModuloTotalizer;
+  }
+  throw std::invalid_argument("Invalid cardinality encoding: " + encoding);
+}
+
+/**
+ * Incremental cardinality constraint over a set of Boolean variables.
+ *
+ * The constructor builds a counter for the variables once. Its clauses
+ * (getDefinitions()) have to be asserted before any bound is used. atMost()
+ * and atLeast() then only return a unit (or a pair of clauses for the modulo
+ * totalizer) that fixes the bound. Hence, bounds can be tightened, assumed or
+ * asserted inside a push()/pop() scope without encoding the counter again.
+ *
+ * Only the clauses needed for the requested kind of bounds are generated.
+ * Bounds larger than `maxBound` cannot be expressed, which keeps the
+ * sequential counter and totalizer at O(n * maxBound) clauses.
+ */
+class Cardinality {
+public:
+  enum class Bounds : uint8_t { AtMost, AtLeast, Both };
+
+  Cardinality(
+      const std::vector<LogicTerm>& variables,
+      CardinalityEncoding cardinalityEncoding, LogicBlock* logicBlock,
+      Bounds requiredBounds = Bounds::AtMost,
+      std::size_t maximalBound = std::numeric_limits<std::size_t>::max());
+
+  [[nodiscard]] const LogicTerm& getDefinitions() const { return definitions; }
+  [[nodiscard]] CardinalityEncoding getEncoding() const { return encoding; }
+
+  /// at most k of the variables hold
+  [[nodiscard]] LogicTerm atMost(std::size_t k) const;
+  /// at least k of the variables hold
+  [[nodiscard]] LogicTerm atLeast(std::size_t k) const;
+
+protected:
+  struct ModuloCounter {
+    // lower[i] holds if (sum mod p) > i, upper[i] holds if (sum div p) > i
+    std::vector<LogicTerm> lower;
+    std::vector<LogicTerm> upper;
+  };
+
+  std::vector<LogicTerm> vars;
+  CardinalityEncoding encoding;
+  LogicBlock* logic;
+  Bounds bounds;
+  // number of unary outputs that are encoded
+  std::size_t width;
+  LogicTerm definitions = LogicTerm(true);
+  std::vector<LogicTerm> clauses;
+
+  // pseudo-Boolean sum
+  LogicTerm sum = LogicTerm(0);
+  // unary outputs, outputs[j] holds iff more than j variables hold
+  std::vector<LogicTerm> outputs;
+  // modulo totalizer over the variables and over their negations
+  std::size_t modulo = 0U;
+  ModuloCounter counter;
+  ModuloCounter negatedCounter;
+
+  void addClause(const std::vector<LogicTerm>& lits);
+  std::vector<LogicTerm> merge(const std::vector<LogicTerm>& a,
+                               const std::vector<LogicTerm>& b);
+  std::vector<LogicTerm> buildTotalizer(std::size_t begin, std::size_t end);
+  ModuloCounter mergeModulo(const ModuloCounter& a, const ModuloCounter& b);
+  ModuloCounter buildModulo(const std::vector<LogicTerm>& lits,
+                            std::size_t begin, std::size_t end);
+  [[nodiscard]] LogicTerm moduloAtMost(const ModuloCounter& c,
+                                       std::size_t k) const;
+};
+
+/// definitions and bound of an at-most-k constraint in a single term
+LogicTerm atMostK(const std::vector<LogicTerm>& vars, std::size_t k,
+                  CardinalityEncoding encoding, LogicBlock* logic);
+LogicTerm atLeastK(const std::vector<LogicTerm>& vars, std::size_t k,
+                   CardinalityEncoding encoding, LogicBlock* logic);
+
 std::vector<NestedVar> groupVars(const std::vector<LogicTerm>& vars,
                                  std::size_t maxSize);
 std::vector<NestedVar> groupVarsAux(const std::vector<NestedVar>& vars,
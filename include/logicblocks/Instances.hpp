@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Logic.hpp"
+#include "LogicBlock.hpp"
+#include "Statistics.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace logicutil {
+using namespace logicbase;
+
+/// formats of the instances that LogicBlock::dumpInternalSolver() produces
+enum class InstanceFormat : std::uint8_t { SMTLIB2, DIMACS, WCNF };
+
+/// detects the format of a dumped instance from its header
+[[nodiscard]] InstanceFormat getInstanceFormat(const std::string& instance);
+/// file extension of the format (including the dot)
+[[nodiscard]] std::string getExtension(InstanceFormat format);
+
+/**
+ * @brief writes the current instance of a block to
+ * `<directory>/<prefix>_<n><extension>`, where n is unique within the process
+ * @returns the path without extension (e.g., to store metadata next to the
+ * instance) or an empty string if the backend cannot dump its instance
+ */
+std::string dumpInstance(LogicBlock& lb, const std::string& directory,
+                         const std::string& prefix);
+
+struct ReplayResult {
+  Result result = Result::NDEF;
+  /// wall time for loading and solving the instance in seconds
+  double time = 0.;
+  Statistics statistics{};
+};
+
+/**
+ * @brief loads a dumped instance into an empty block and solves it, e.g., to
+ * compare backends and parameters without running the mapper or synthesizer
+ */
+ReplayResult replayInstance(LogicBlock& lb, const std::string& filename);
+
+} // namespace logicutil
@@ -265,6 +265,7 @@ inline CType getResultCType(OpType op) {
 }
 
 class LogicTerm;
+class TermStore;
 
 using LogicVector = std::vector<LogicTerm>;
 using LogicMatrix = std::vector<LogicVector>;
@@ -276,6 +277,7 @@ public:
   virtual ~Logic() = default;
   virtual uint64_t getNextId() = 0;
   virtual uint64_t getId() = 0;
+  virtual TermStore& getTermStore() = 0;
 };
 
 } // namespace logicbase
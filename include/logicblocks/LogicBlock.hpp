@@ -2,7 +2,10 @@
 
 #include "Logic.hpp"
 #include "LogicTerm.hpp"
+#include "Statistics.hpp"
 
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <set>
 #include <string>
@@ -14,30 +17,88 @@ class Model;
 
 class LogicBlock : public Logic {
 protected:
+  /// asserted clauses that have not been handed to the backend yet
   std::set<LogicTerm, TermDepthComparator> clauses;
+  /// all asserted clauses, only kept if `retainClauses` is set
+  std::vector<LogicTerm> retained;
+  /// number of retained clauses at each open push()
+  std::vector<std::size_t> scopes;
   Model* model{};
+  /// hand clauses to the backend as soon as they are asserted
   bool convertWhenAssert;
+  bool retainClauses = false;
   virtual void internalReset() = 0;
+  /// converts a single clause and adds it to the backend
+  virtual void emitClause(const LogicTerm& clause) = 0;
+  virtual void internalPush() = 0;
+  virtual void internalPop() = 0;
+  // ids and terms are scoped per block, so different blocks can be used
+  // concurrently (each from a single thread)
   uint64_t gid = 0U;
+  TermStore terms{this};
+  Statistics stats;
+
+  /// records a call to the backend's solver that started at `start`
+  void recordSolverCall(std::chrono::steady_clock::time_point start);
 
 public:
   explicit LogicBlock(bool convert = false) : convertWhenAssert(convert) {}
 
   uint64_t getNextId() override { return gid++; };
   uint64_t getId() override { return gid; };
+  TermStore& getTermStore() override { return terms; }
 
   Model* getModel() { return model; }
 
   virtual void assertFormula(const LogicTerm& a);
 
+  /**
+   * @brief keep all asserted clauses (e.g., for debugging dumps), even after
+   * they have been handed to the backend
+   */
+  void setRetainClauses(const bool retain) { retainClauses = retain; }
+  [[nodiscard]] const std::vector<LogicTerm>& getRetainedClauses() const {
+    return retained;
+  }
+
   LogicTerm makeVariable(const std::string& name, CType type = CType::BOOL,
                          uint16_t bvSize = 32U);
 
-  virtual void produceInstance() = 0;
+  /// hands all pending clauses to the backend
+  virtual void produceInstance();
   virtual Result solve() = 0;
+  /**
+   * @brief solves the instance under the assumption that all given Boolean
+   * terms hold. The assumptions are only active for this call, everything
+   * the backend learns is kept for subsequent calls.
+   */
+  virtual Result solve(const std::vector<LogicTerm>& assumptions) = 0;
+  /**
+   * @brief aborts a running call to solve() from another thread. The
+   * interrupted call returns Result::NDEF. Interrupts that arrive before
+   * solve() started may be lost.
+   */
+  virtual void interrupt() = 0;
   virtual void reset();
 
+  /// opens a new scope for assertions
+  void push();
+  /// removes all assertions made since the matching call to push()
+  void pop();
+  [[nodiscard]] std::size_t getNumScopes() const { return scopes.size(); }
+
   virtual std::string dumpInternalSolver() { return ""; }
+  /**
+   * @brief adds the constraints of an instance previously written by
+   * dumpInternalSolver() (or of a compatible file) to the backend
+   * @throws std::runtime_error if the backend cannot read the file
+   */
+  virtual void loadInstance(const std::string& filename);
+
+  /// statistics of the formulation since the last reset()
+  [[nodiscard]] virtual Statistics getStatistics() const { return stats; }
+  /// adds time the caller spent building the formulation to the statistics
+  void addEncodeTime(const double seconds) { stats.encodeTime += seconds; }
 };
 
 class LogicBlockOptimizer : public LogicBlock {
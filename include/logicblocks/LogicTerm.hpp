@@ -2,45 +2,61 @@
 
 #include "Logic.hpp"
 
+#include <atomic>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <initializer_list>
+#include <mutex>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 namespace logicbase {
+struct TermNode;
+class TermStore;
+
+/**
+ * Handle to a node of a term DAG.
+ *
+ * The nodes themselves are stored in the TermStore of the LogicBlock the term
+ * belongs to (or in a process-wide store for terms without a LogicBlock).
+ * Composite terms are hash-consed, i.e., structurally equal terms share a
+ * single node and have the same id. Constants have no node, their value is
+ * kept in the handle itself. Handles are only valid as long as the LogicBlock
+ * is not reset.
+ */
 class LogicTerm {
 private:
-  Logic* lb = nullptr;
-  uint64_t id = 0;
-  uint64_t depth = 0U;
-  std::string name;
-
+  TermStore* store = nullptr;
+  uint32_t index = 0U;
+  // cached from the node, since they are queried whenever terms are combined
   OpType opType = OpType::Variable;
-  bool value = false;
-  int iValue = 0;
-  double fValue = 0.;
-  uint64_t bvValue = 0U;
-  uint16_t bvSize = 0;
-  std::vector<LogicTerm> nodes;
   CType cType = CType::BOOL;
+  uint16_t bvSize = 0U;
+  // bits of the value of a constant (see cType), zero for all other terms
+  uint64_t constant = 0U;
 
+  // ids of terms without a LogicBlock, which may be created concurrently
   // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
-  static inline uint64_t gid = 1;
+  static inline std::atomic<uint64_t> gid = 1;
 
-public:
-  explicit LogicTerm(bool v) : opType(OpType::Constant), value(v) {}
+  LogicTerm(TermStore* s, uint32_t idx, OpType op, CType type, uint16_t bvs)
+      : store(s), index(idx), opType(op), cType(type), bvSize(bvs) {}
 
-  explicit LogicTerm(int32_t v)
-      : opType(OpType::Constant), iValue(v), cType(CType::INT) {}
+  [[nodiscard]] const TermNode& node() const;
+  /// whether both handles refer to the same node or are equal constants
+  [[nodiscard]] bool sameNode(const LogicTerm& other) const;
+  static TermStore& storeOf(Logic* logic);
 
-  explicit LogicTerm(double v)
-      : opType(OpType::Constant), fValue(v), cType(CType::REAL) {}
+  friend class TermStore;
 
-  LogicTerm(uint64_t v, uint16_t bvs)
-      : opType(OpType::Constant), bvValue(v), bvSize(bvs),
-        cType(CType::BITVECTOR) {}
+public:
+  explicit LogicTerm(bool v);
+  explicit LogicTerm(int32_t v);
+  explicit LogicTerm(double v);
+  LogicTerm(uint64_t v, uint16_t bvs);
 
   explicit LogicTerm(Logic* logic = nullptr);
   explicit LogicTerm(std::string n, Logic* logic = nullptr);
@@ -122,13 +138,13 @@ public:
 
   [[nodiscard]] bool isConst() const;
 
-  [[nodiscard]] uint64_t getID() const { return id; }
-  [[nodiscard]] const std::vector<LogicTerm>& getNodes() const { return nodes; }
+  [[nodiscard]] uint64_t getID() const;
+  [[nodiscard]] const std::vector<LogicTerm>& getNodes() const;
   [[nodiscard]] OpType getOpType() const { return opType; }
   [[nodiscard]] CType getCType() const { return cType; }
-  [[nodiscard]] const std::string& getName() const { return name; }
-  [[nodiscard]] Logic* getLogic() const { return lb; }
-  [[nodiscard]] uint64_t getDepth() const { return depth; }
+  [[nodiscard]] const std::string& getName() const;
+  [[nodiscard]] Logic* getLogic() const;
+  [[nodiscard]] uint64_t getDepth() const;
 
   [[nodiscard]] bool getBoolValue() const;
   [[nodiscard]] int getIntValue() const;
@@ -169,6 +185,7 @@ public:
   [[nodiscard]] static CType getTargetCType(CType targetType,
                                             const LogicTerm& b);
 
+  /// the operands of the nested applications of `op` at the root of `t`
   [[nodiscard]] static std::vector<LogicTerm>
   getFlatTerms(const LogicTerm& t, OpType op = OpType::AND);
 
@@ -177,9 +194,83 @@ public:
   [[nodiscard]] static uint16_t
   getMaxBVSize(const std::vector<LogicTerm>& terms);
 
-  static void reset() { gid = 0; }
+  static void reset() { gid.store(0); }
+};
+
+struct TermNode {
+  uint64_t id = 0;
+  uint64_t depth = 0U;
+  std::string name;
+
+  OpType opType = OpType::Variable;
+  uint16_t bvSize = 0;
+  std::vector<LogicTerm> nodes;
+  CType cType = CType::BOOL;
+};
+
+/**
+ * Arena of term nodes.
+ *
+ * Nodes are never modified or removed individually, so references to them
+ * stay valid until the store is cleared. Composite terms are interned via a
+ * hash table over the node indices.
+ */
+class TermStore {
+public:
+  explicit TermStore(Logic* logic = nullptr, bool synchronized = false);
+  TermStore(const TermStore&) = delete;
+  TermStore& operator=(const TermStore&) = delete;
+  ~TermStore() = default;
+
+  /// store for terms that do not belong to a LogicBlock
+  static TermStore& global();
+
+  /// adds a new node (assigning it a new id if it has none)
+  LogicTerm add(TermNode n);
+  /// returns the node structurally equal to `n`, adding it if there is none
+  LogicTerm intern(TermNode n);
+
+  [[nodiscard]] const TermNode& at(uint32_t idx) const;
+  [[nodiscard]] Logic* getLogic() const { return owner; }
+  [[nodiscard]] std::size_t size() const;
+
+  void clear();
+
+private:
+  struct NodeHash {
+    const TermStore* store;
+    std::size_t operator()(uint32_t idx) const;
+  };
+  struct NodeEqual {
+    const TermStore* store;
+    bool operator()(uint32_t lhs, uint32_t rhs) const;
+  };
+
+  Logic* owner;
+  bool synchronized;
+  mutable std::mutex mutex;
+  std::deque<TermNode> nodes;
+  std::unordered_set<uint32_t, NodeHash, NodeEqual> table;
+
+  LogicTerm push(TermNode n);
+  [[nodiscard]] std::unique_lock<std::mutex> lock() const;
 };
 
+inline const TermNode& LogicTerm::node() const {
+  // constants are the only terms without a store
+  static const TermNode CONSTANT{};
+  return store == nullptr ? CONSTANT : store->at(index);
+}
+inline uint64_t LogicTerm::getID() const { return node().id; }
+inline const std::vector<LogicTerm>& LogicTerm::getNodes() const {
+  return node().nodes;
+}
+inline const std::string& LogicTerm::getName() const { return node().name; }
+inline Logic* LogicTerm::getLogic() const {
+  return store == nullptr ? nullptr : store->getLogic();
+}
+inline uint64_t LogicTerm::getDepth() const { return node().depth; }
+
 struct TermHash {
   std::size_t operator()(const LogicTerm& t) const;
   bool operator()(const LogicTerm& t1, const LogicTerm& t2) const;
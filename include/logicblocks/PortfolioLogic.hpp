@@ -0,0 +1,157 @@
+#pragma once
+
+#include "Logic.hpp"
+#include "LogicBlock.hpp"
+#include "LogicTerm.hpp"
+#include "Model.hpp"
+#include "Statistics.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace portfoliologic {
+
+using namespace logicbase;
+
+/**
+ * LogicBlock that solves the same instance with several LogicBlocks (e.g.,
+ * with different seeds, tactics or backends) in parallel.
+ *
+ * Terms are created in the portfolio and asserted in every instance on the
+ * calling thread, only the calls to solve() run concurrently (one thread per
+ * instance). The first conclusive answer is returned and all other instances
+ * are interrupted. Afterwards, the model of the winning instance is used.
+ */
+class PortfolioLogicBlock : public LogicBlock {
+protected:
+  std::vector<std::unique_ptr<LogicBlock>> instances;
+  std::size_t winner = 0U;
+  std::atomic<bool> interrupted = false;
+
+  void internalReset() override;
+  void emitClause(const LogicTerm& clause) override;
+  void internalPush() override;
+  void internalPop() override;
+
+public:
+  explicit PortfolioLogicBlock(std::vector<std::unique_ptr<LogicBlock>> blocks,
+                               bool convert = true);
+  // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+  ~PortfolioLogicBlock() override { delete model; }
+
+  void produceInstance() override;
+  Result solve() override;
+  Result solve(const std::vector<LogicTerm>& assumptions) override;
+  void interrupt() override;
+  /**
+   * @brief statistics of the portfolio, including the conversion work of all
+   * instances and the solver statistics of the last winner
+   */
+  [[nodiscard]] Statistics getStatistics() const override;
+
+  /// dumps the internal state of the first instance
+  std::string dumpInternalSolver() override {
+    return instances.front()->dumpInternalSolver();
+  }
+  /// loads the instance into every member of the portfolio
+  void loadInstance(const std::string& filename) override {
+    produceInstance();
+    for (const auto& instance : instances) {
+      instance->loadInstance(filename);
+    }
+  }
+
+  [[nodiscard]] std::size_t getNumInstances() const {
+    return instances.size();
+  }
+  [[nodiscard]] LogicBlock* getInstance(const std::size_t i) const {
+    return instances.at(i).get();
+  }
+  /// index of the instance that answered the last call to solve()
+  [[nodiscard]] std::size_t getWinner() const { return winner; }
+};
+
+/**
+ * Portfolio of optimizers. Objectives are forwarded to every instance.
+ */
+class PortfolioLogicOptimizer : public LogicBlockOptimizer {
+protected:
+  std::vector<std::unique_ptr<LogicBlockOptimizer>> instances;
+  std::size_t winner = 0U;
+  std::atomic<bool> interrupted = false;
+  /// number of weighted terms that have been handed to the instances
+  std::size_t forwardedTerms = 0U;
+
+  void internalReset() override;
+  void emitClause(const LogicTerm& clause) override;
+  void internalPush() override;
+  void internalPop() override;
+  void forwardWeightedTerms();
+
+public:
+  explicit PortfolioLogicOptimizer(
+      std::vector<std::unique_ptr<LogicBlockOptimizer>> optimizers,
+      bool convert = true);
+  // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+  ~PortfolioLogicOptimizer() override { delete model; }
+
+  void produceInstance() override;
+  Result solve() override;
+  Result solve(const std::vector<LogicTerm>& assumptions) override;
+  void interrupt() override;
+  /**
+   * @brief statistics of the portfolio, including the conversion work of all
+   * instances and the solver statistics of the last winner
+   */
+  [[nodiscard]] Statistics getStatistics() const override;
+
+  bool makeMinimize() override;
+  bool makeMaximize() override;
+  bool maximize(const LogicTerm& term) override;
+  bool minimize(const LogicTerm& term) override;
+
+  /// dumps the internal state of the first instance
+  std::string dumpInternalSolver() override {
+    return instances.front()->dumpInternalSolver();
+  }
+  /// loads the instance into every member of the portfolio
+  void loadInstance(const std::string& filename) override {
+    produceInstance();
+    for (const auto& instance : instances) {
+      instance->loadInstance(filename);
+    }
+  }
+
+  [[nodiscard]] std::size_t getNumInstances() const {
+    return instances.size();
+  }
+  [[nodiscard]] LogicBlockOptimizer* getInstance(const std::size_t i) const {
+    return instances.at(i).get();
+  }
+  /// index of the instance that answered the last call to solve()
+  [[nodiscard]] std::size_t getWinner() const { return winner; }
+};
+
+/**
+ * Model of a portfolio, which queries the model of the winning instance.
+ */
+class PortfolioModel : public Model {
+protected:
+  Model* model;
+  LogicBlock* instance;
+
+public:
+  PortfolioModel(Result res, LogicBlock* winner)
+      : Model(res), model(winner->getModel()), instance(winner) {}
+
+  int getIntValue(const LogicTerm& a, LogicBlock* lb) override;
+  bool getBoolValue(const LogicTerm& a, LogicBlock* lb) override;
+  double getRealValue(const LogicTerm& a, LogicBlock* lb) override;
+  uint64_t getBitvectorValue(const LogicTerm& a, LogicBlock* lb) override;
+};
+
+} // namespace portfoliologic
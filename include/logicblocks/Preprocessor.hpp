@@ -0,0 +1,126 @@
+#pragma once
+
+#include "SATSolver.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cnflogic {
+
+/**
+ * Solver-independent simplification of a CNF before it is handed to a SAT
+ * solver.
+ *
+ * simplify() runs unit propagation, equivalent-literal substitution (based on
+ * the strongly connected components of the binary implication graph),
+ * subsumption and bounded variable elimination until the formula no longer
+ * changes. Frozen variables are never eliminated.
+ *
+ * The preprocessor remains responsible for the variables it removed.
+ * Literals that are used after simplify() (in new clauses or assumptions) have
+ * to be passed through rewrite(), which replaces substituted literals by their
+ * representatives and restores the clauses of eliminated variables that are
+ * used again. extendModel() assigns all removed variables given a model of the
+ * simplified formula.
+ */
+class Preprocessor {
+public:
+  void addClause(const std::vector<Lit>& clause);
+  /// prevents the elimination of variable v
+  void freeze(int32_t v);
+
+  /// @returns false if the formula was found to be unsatisfiable
+  bool simplify();
+  /**
+   * @brief moves the simplified formula out of the preprocessor. Fixed
+   * variables are included as unit clauses and an unsatisfiable formula is
+   * returned as a single empty clause.
+   */
+  std::vector<std::vector<Lit>> extractClauses();
+
+  /**
+   * @brief maps literals that are used after simplify() to the simplified
+   * formula
+   * @param lits the literals (e.g., of a new clause or assumptions)
+   * @param restored receives the clauses of eliminated variables that had to
+   * be restored (and have to be added to the solver as well)
+   * @returns the rewritten literals
+   */
+  std::vector<Lit> rewrite(const std::vector<Lit>& lits,
+                           std::vector<std::vector<Lit>>& restored);
+  /// assigns removed variables in a model (indexed by variable) of the solver
+  void extendModel(std::vector<bool>& values) const;
+
+  /// number of fixed, substituted, eliminated and restored variables and of
+  /// subsumed clauses
+  [[nodiscard]] std::map<std::string, double> getStatistics() const;
+
+  [[nodiscard]] std::size_t getNumClauses() const { return numActive; }
+  [[nodiscard]] bool isEliminated(const int32_t v) const {
+    return eliminated.find(v) != eliminated.end();
+  }
+  /// literal that replaces `lit` in the simplified formula
+  [[nodiscard]] Lit getRepresentative(Lit lit) const;
+
+private:
+  /// entry of the model reconstruction stack, `lit` is set to true if the
+  /// clause is not satisfied
+  struct Witness {
+    Lit lit;
+    std::vector<Lit> clause;
+  };
+  struct Elimination {
+    /// entries of the extension stack that belong to the variable
+    std::size_t first;
+    std::size_t last;
+    /// all clauses of the variable (for restoring it)
+    std::vector<std::vector<Lit>> clauses;
+  };
+
+  int32_t numVars = 0;
+  bool ok = true;
+  std::vector<std::vector<Lit>> clauses;
+  std::vector<bool> deleted;
+  std::size_t numActive = 0U;
+  /// clauses that contain a literal, may include stale entries
+  std::vector<std::vector<uint32_t>> occurrences;
+
+  std::vector<int8_t> fixed;
+  std::vector<Lit> units;
+  std::size_t propagated = 0U;
+  std::vector<Lit> representatives;
+  std::vector<bool> frozen;
+  std::unordered_map<int32_t, Elimination> eliminated;
+  std::vector<Witness> extension;
+
+  std::size_t numSubstituted = 0U;
+  std::size_t numSubsumed = 0U;
+  std::size_t numRestored = 0U;
+
+  static std::size_t index(Lit lit);
+  void ensureVars(int32_t v);
+  [[nodiscard]] int8_t value(Lit lit) const;
+  [[nodiscard]] bool contains(uint32_t cref, Lit lit) const;
+  /// sorts the clause and drops duplicates and false literals
+  /// @returns false if the clause is satisfied or a tautology
+  bool normalize(std::vector<Lit>& clause) const;
+
+  void assign(Lit lit);
+  void store(std::vector<Lit> clause);
+  void remove(uint32_t cref);
+  /// active clauses that contain the literal
+  std::vector<uint32_t> collect(Lit lit);
+
+  bool propagateUnits();
+  bool substituteEquivalences();
+  bool removeSubsumed();
+  bool eliminateVariables();
+  bool eliminate(int32_t v);
+  void substitute(const std::vector<std::vector<uint32_t>>& components);
+};
+
+} // namespace cnflogic
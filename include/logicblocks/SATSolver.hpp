@@ -0,0 +1,159 @@
+#pragma once
+
+#include "Logic.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace cnflogic {
+
+using namespace logicbase;
+
+/// literal in DIMACS notation, i.e., +v or -v for variable v > 0
+using Lit = int32_t;
+
+/**
+ * Interface of the SAT solvers that can be plugged into a CNFLogicBlock.
+ */
+class SATSolver {
+public:
+  virtual ~SATSolver() = default;
+
+  virtual void addClause(const std::vector<Lit>& clause) = 0;
+  /**
+   * @brief solves the instance under the given assumptions, i.e., unit
+   * literals that only hold for this call
+   */
+  virtual Result solve(const std::vector<Lit>& assumptions) = 0;
+  Result solve() { return solve({}); }
+  /// value of variable v in the model of the last satisfiable call to solve()
+  [[nodiscard]] virtual bool getValue(int32_t v) const = 0;
+  /**
+   * @brief aborts a running call to solve(), which then returns Result::NDEF.
+   * May be called from another thread.
+   */
+  virtual void interrupt() = 0;
+  virtual void reset() = 0;
+  /// statistics of the solver (e.g., the number of conflicts)
+  [[nodiscard]] virtual std::map<std::string, double> getStatistics() const = 0;
+};
+
+/**
+ * Embedded conflict-driven clause-learning solver.
+ *
+ * Implements two-watched-literal propagation, first-UIP clause learning,
+ * VSIDS branching with phase saving, Luby restarts and activity-based
+ * deletion of learnt clauses. Clauses can be added between calls to solve().
+ * Assumptions are decided first (as in MiniSat), so learnt clauses remain
+ * valid for later calls with different assumptions.
+ * A non-zero seed randomizes the initial phases and branching order.
+ */
+class CDCLSolver : public SATSolver {
+public:
+  explicit CDCLSolver(uint32_t randomSeed = 0U)
+      : seed(randomSeed), rng(randomSeed) {}
+
+  using SATSolver::solve;
+  void addClause(const std::vector<Lit>& clause) override;
+  Result solve(const std::vector<Lit>& assumptions) override;
+  [[nodiscard]] bool getValue(int32_t v) const override;
+  void interrupt() override { interrupted = true; }
+  /// calls to solve() return Result::NDEF after this many milliseconds (0 =
+  /// no limit)
+  void setTimeout(const uint32_t milliseconds) { timeout = milliseconds; }
+  void reset() override;
+  [[nodiscard]] std::map<std::string, double> getStatistics() const override;
+
+  [[nodiscard]] std::size_t getNumVars() const { return assigns.size(); }
+  [[nodiscard]] std::size_t getNumConflicts() const { return conflicts; }
+  [[nodiscard]] std::size_t getNumDecisions() const { return decisions; }
+
+private:
+  // internal literals are 2 * var + sign with 0-based variables
+  using ILit = uint32_t;
+  static constexpr uint32_t NO_REASON = UINT32_MAX;
+  static constexpr ILit NO_LIT = UINT32_MAX;
+  static constexpr int8_t UNASSIGNED = -1;
+
+  struct Clause {
+    // literals are stored contiguously in `arena`
+    std::size_t offset = 0U;
+    uint32_t size = 0U;
+    bool learnt = false;
+    bool deleted = false;
+    double activity = 0.;
+  };
+  struct Watcher {
+    uint32_t cref;
+    // some other literal of the clause, if it is true the clause is skipped
+    ILit blocker;
+  };
+
+  std::vector<ILit> arena;
+  std::size_t garbage = 0U;
+  std::vector<Clause> clauses;
+  std::vector<uint32_t> freeClauses;
+  std::vector<std::vector<Watcher>> watches;
+
+  std::vector<int8_t> assigns;
+  std::vector<uint32_t> levels;
+  std::vector<uint32_t> reasons;
+  std::vector<bool> polarity;
+  std::vector<bool> model;
+  std::vector<ILit> trail;
+  std::vector<std::size_t> trailLimits;
+  std::size_t propagated = 0U;
+  bool ok = true;
+
+  std::vector<double> activity;
+  double varIncrement = 1.;
+  double clauseIncrement = 1.;
+  std::vector<uint32_t> heap;
+  std::vector<int32_t> heapIndex;
+
+  std::vector<bool> seen;
+  std::size_t numLearnts = 0U;
+  std::size_t conflicts = 0U;
+  std::size_t decisions = 0U;
+
+  uint32_t seed = 0U;
+  std::mt19937 rng;
+  std::atomic<bool> interrupted = false;
+  uint32_t timeout = 0U;
+
+  static ILit toInternal(Lit lit);
+  static uint32_t var(const ILit l) { return l >> 1U; }
+  static ILit negate(const ILit l) { return l ^ 1U; }
+
+  void ensureVars(std::size_t n);
+  [[nodiscard]] int8_t value(ILit l) const;
+  [[nodiscard]] uint32_t decisionLevel() const {
+    return static_cast<uint32_t>(trailLimits.size());
+  }
+
+  ILit* literals(const Clause& c) { return &arena[c.offset]; }
+  uint32_t storeClause(const std::vector<ILit>& lits, bool learnt);
+  void enqueue(ILit l, uint32_t reason);
+  uint32_t propagate();
+  void analyze(uint32_t conflict, std::vector<ILit>& learnt,
+               uint32_t& backtrackLevel);
+  void cancelUntil(uint32_t level);
+  [[nodiscard]] bool isLocked(uint32_t cref) const;
+  void reduceLearnts();
+
+  void bumpVar(uint32_t v);
+  void bumpClause(Clause& c);
+  void heapUp(std::size_t pos);
+  void heapDown(std::size_t pos);
+  void heapInsert(uint32_t v);
+  uint32_t heapPop();
+
+  static double luby(double y, std::size_t x);
+};
+
+} // namespace cnflogic
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <string>
+
+namespace logicbase {
+
+/**
+ * Size of a formulation and the time spent on it in a LogicBlock.
+ *
+ * All wall times are in seconds. Statistics of several blocks (e.g., of
+ * consecutive solver calls) can be summed up with +=.
+ */
+struct Statistics {
+  std::size_t boolVariables = 0U;
+  std::size_t intVariables = 0U;
+  std::size_t realVariables = 0U;
+  std::size_t bitvectorVariables = 0U;
+  /// calls to assertFormula()
+  std::size_t assertedFormulas = 0U;
+  /// top-level conjuncts of the asserted formulas
+  std::size_t assertedClauses = 0U;
+  /// term nodes the backend converted and conversions served from its cache
+  std::size_t convertedNodes = 0U;
+  std::size_t cacheHits = 0U;
+  std::size_t solverCalls = 0U;
+  /// time spent building the formulation, as reported by the user of a block
+  double encodeTime = 0.;
+  /// time spent handing clauses to the backend
+  double convertTime = 0.;
+  double solveTime = 0.;
+  /// statistics the backend reported after the last call to solve()
+  std::map<std::string, double> solver;
+
+  [[nodiscard]] std::size_t getVariables() const {
+    return boolVariables + intVariables + realVariables + bitvectorVariables;
+  }
+
+  Statistics& operator+=(const Statistics& other) {
+    boolVariables += other.boolVariables;
+    intVariables += other.intVariables;
+    realVariables += other.realVariables;
+    bitvectorVariables += other.bitvectorVariables;
+    assertedFormulas += other.assertedFormulas;
+    assertedClauses += other.assertedClauses;
+    convertedNodes += other.convertedNodes;
+    cacheHits += other.cacheHits;
+    solverCalls += other.solverCalls;
+    encodeTime += other.encodeTime;
+    convertTime += other.convertTime;
+    solveTime += other.solveTime;
+    for (const auto& [key, value] : other.solver) {
+      solver[key] += value;
+    }
+    return *this;
+  }
+};
+
+/// serialization for nlohmann::json (without depending on it)
+template <class Json> void to_json(Json& j, const Statistics& stats) {
+  auto& variables = j["variables"];
+  variables["bool"] = stats.boolVariables;
+  variables["int"] = stats.intVariables;
+  variables["real"] = stats.realVariables;
+  variables["bitvector"] = stats.bitvectorVariables;
+  j["asserted_formulas"] = stats.assertedFormulas;
+  j["asserted_clauses"] = stats.assertedClauses;
+  j["converted_nodes"] = stats.convertedNodes;
+  j["cache_hits"] = stats.cacheHits;
+  j["solver_calls"] = stats.solverCalls;
+  j["encode_time"] = stats.encodeTime;
+  j["convert_time"] = stats.convertTime;
+  j["solve_time"] = stats.solveTime;
+  auto& solver = j["solver"];
+  solver = Json::object();
+  for (const auto& [key, value] : stats.solver) {
+    solver[key] = value;
+  }
+}
+
+} // namespace logicbase
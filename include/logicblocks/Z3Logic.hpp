@@ -3,9 +3,12 @@
 #include "Logic.hpp"
 #include "LogicBlock.hpp"
 #include "LogicTerm.hpp"
+#include "Statistics.hpp"
 
+#include <cstddef>
 #include <cstdint>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <ostream>
 #include <sstream>
@@ -27,6 +30,12 @@ protected:
                      TermHash, TermHash>
       cache;
   std::shared_ptr<z3::context> ctx;
+  std::size_t convertedNodes = 0U;
+  std::size_t cacheHits = 0U;
+
+  static std::map<std::string, double>
+  collectStatistics(const z3::stats& statistics);
+  [[nodiscard]] Statistics addConversionStatistics(Statistics stats) const;
 
 public:
   explicit Z3Base(std::shared_ptr<z3::context> context)
@@ -34,6 +43,7 @@ public:
   virtual ~Z3Base() = default;
 
   z3::expr convert(const LogicTerm& a, CType toType = CType::ERRORTYPE);
+  z3::expr_vector convertAll(const std::vector<LogicTerm>& terms);
   z3::context& getContext() { return *ctx; }
 
   static z3::expr getExprTerm(uint64_t id, CType type, Z3Base* z3base);
@@ -65,6 +75,9 @@ class Z3LogicBlock : public LogicBlock, public Z3Base {
 protected:
   std::shared_ptr<z3::solver> solver;
   void internalReset() override;
+  void emitClause(const LogicTerm& clause) override;
+  void internalPush() override { solver->push(); }
+  void internalPop() override { solver->pop(); }
 
 public:
   Z3LogicBlock(std::shared_ptr<z3::context> context,
@@ -75,9 +88,12 @@ public:
     variables.clear();
     cache.clear();
   }
-  void assertFormula(const LogicTerm& a) override;
-  void produceInstance() override;
   Result solve() override;
+  Result solve(const std::vector<LogicTerm>& assumptions) override;
+  void interrupt() override { ctx->interrupt(); }
+  [[nodiscard]] Statistics getStatistics() const override {
+    return addConversionStatistics(stats);
+  }
   std::string dumpInternalSolver() override {
     std::stringstream ss;
     ss << (*solver);
@@ -90,12 +106,16 @@ public:
     }
     return ss.str();
   }
+  void loadInstance(const std::string& filename) override;
 };
 
 class Z3LogicOptimizer : public LogicBlockOptimizer, public Z3Base {
 private:
   std::shared_ptr<z3::optimize> optimizer;
   void internalReset() override;
+  void emitClause(const LogicTerm& clause) override;
+  void internalPush() override { optimizer->push(); }
+  void internalPop() override { optimizer->pop(); }
 
 public:
   Z3LogicOptimizer(std::shared_ptr<z3::context> context,
@@ -106,9 +126,12 @@ public:
     variables.clear();
     cache.clear();
   }
-  void assertFormula(const LogicTerm& a) override;
-  void produceInstance() override;
   Result solve() override;
+  Result solve(const std::vector<LogicTerm>& assumptions) override;
+  void interrupt() override { ctx->interrupt(); }
+  [[nodiscard]] Statistics getStatistics() const override {
+    return addConversionStatistics(stats);
+  }
 
   bool makeMinimize() override;
   bool makeMaximize() override;
@@ -126,6 +149,7 @@ public:
     }
     return ss.str();
   }
+  void loadInstance(const std::string& filename) override;
 };
 
 } // namespace z3logic
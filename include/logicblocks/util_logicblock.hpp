@@ -1,10 +1,17 @@
 #pragma once
 
+#include "CNFLogic.hpp"
 #include "LogicBlock.hpp"
+#include "PortfolioLogic.hpp"
+#include "SATSolver.hpp"
 #include "Z3Logic.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
@@ -56,9 +63,67 @@ public:
   void addParam(const std::string& n, uint32_t value) {
     params.emplace_back(n, value);
   }
+  void addParam(const Param& param) { params.emplace_back(param); }
   [[nodiscard]] std::vector<Param> getParams() const { return params; }
 };
 
+/**
+ * Number of instances the Z3 factories below run in parallel as a portfolio
+ * (unsigned, defaults to 1, i.e., no portfolio). Instance i of a solver
+ * portfolio uses random_seed i, instances of an optimizer portfolio cycle
+ * through different MaxSAT engines. All other parameters are shared.
+ */
+constexpr auto PORTFOLIO_THREADS = "portfolio.threads";
+
+/// splits off the portfolio parameters from the solver parameters
+inline std::size_t extractPortfolioThreads(Params& params) {
+  std::size_t threads = 1U;
+  Params solverParams;
+  for (const auto& param : params.getParams()) {
+    if (param.name != PORTFOLIO_THREADS) {
+      solverParams.addParam(param);
+    } else if (param.type == ParamType::UINT) {
+      threads = std::max<std::size_t>(param.uivalue, 1U);
+    } else {
+      throw std::invalid_argument(std::string(PORTFOLIO_THREADS) +
+                                  " must be an unsigned integer");
+    }
+  }
+  params = solverParams;
+  return threads;
+}
+
+/**
+ * Backend of the logic blocks created by getLogicBlock() (string): "z3"
+ * (default) or "cnf". The cnf backend Tseitin-encodes the formulas, simplifies
+ * them with the Preprocessor and solves them with the embedded CDCLSolver. It
+ * only supports the "timeout" (in milliseconds), "random_seed" and portfolio
+ * parameters.
+ */
+constexpr auto BACKEND = "backend";
+
+enum class Backend : std::uint8_t { Z3, CNF };
+
+/// splits off the backend parameter from the solver parameters
+inline Backend extractBackend(Params& params) {
+  auto backend = Backend::Z3;
+  Params solverParams;
+  for (const auto& param : params.getParams()) {
+    if (param.name != BACKEND) {
+      solverParams.addParam(param);
+    } else if (param.type == ParamType::STR && param.strvalue == "z3") {
+      backend = Backend::Z3;
+    } else if (param.type == ParamType::STR && param.strvalue == "cnf") {
+      backend = Backend::CNF;
+    } else {
+      throw std::invalid_argument(std::string(BACKEND) +
+                                  " must be either \"z3\" or \"cnf\"");
+    }
+  }
+  params = solverParams;
+  return backend;
+}
+
 inline void setZ3Params(z3::params& p, const Params& params) {
   for (const auto& param : params.getParams()) {
     switch (param.type) {
@@ -80,28 +145,121 @@ inline void setZ3Params(z3::params& p, const Params& params) {
   }
 }
 
-inline std::unique_ptr<LogicBlock>
-getZ3LogicBlock(bool& success, bool convertWhenAssert,
-                const Params& params = Params()) {
+inline std::unique_ptr<z3logic::Z3LogicBlock>
+createZ3LogicBlock(bool convertWhenAssert, const Params& params) {
   auto c = std::make_shared<z3::context>();
   auto slv = std::make_shared<z3::solver>(*c);
   z3::params p(*c);
   setZ3Params(p, params);
   slv->set(p);
-  success = true;
   return std::make_unique<z3logic::Z3LogicBlock>(c, slv, convertWhenAssert);
 }
 
-inline std::unique_ptr<LogicBlockOptimizer>
-getZ3LogicOptimizer(bool& success, bool convertWhenAssert,
-                    const Params& params = Params()) {
+inline std::unique_ptr<z3logic::Z3LogicOptimizer>
+createZ3LogicOptimizer(bool convertWhenAssert, const Params& params) {
   auto c = std::make_shared<z3::context>();
   auto opt = std::make_shared<z3::optimize>(*c);
   z3::params p(*c);
   setZ3Params(p, params);
   opt->set(p);
-  success = true;
   return std::make_unique<z3logic::Z3LogicOptimizer>(c, opt, convertWhenAssert);
 }
 
+inline std::unique_ptr<LogicBlock>
+getZ3LogicBlock(bool& success, bool convertWhenAssert,
+                const Params& params = Params()) {
+  auto solverParams = params;
+  const auto threads = extractPortfolioThreads(solverParams);
+  success = true;
+  if (threads == 1U) {
+    return createZ3LogicBlock(convertWhenAssert, solverParams);
+  }
+  std::vector<std::unique_ptr<LogicBlock>> instances;
+  for (std::size_t i = 0U; i < threads; ++i) {
+    auto instanceParams = solverParams;
+    if (i != 0U) {
+      instanceParams.addParam("random_seed", static_cast<uint32_t>(i));
+    }
+    instances.emplace_back(createZ3LogicBlock(true, instanceParams));
+  }
+  return std::make_unique<portfoliologic::PortfolioLogicBlock>(
+      std::move(instances), convertWhenAssert);
+}
+
+inline std::unique_ptr<LogicBlockOptimizer>
+getZ3LogicOptimizer(bool& success, bool convertWhenAssert,
+                    const Params& params = Params()) {
+  // Z3's optimizer has no random seed, so the engines are varied instead
+  constexpr std::array<const char*, 3> maxSATEngines = {"maxres", "pd-maxres",
+                                                        "wmax"};
+  auto solverParams = params;
+  const auto threads = extractPortfolioThreads(solverParams);
+  success = true;
+  if (threads == 1U) {
+    return createZ3LogicOptimizer(convertWhenAssert, solverParams);
+  }
+  std::vector<std::unique_ptr<LogicBlockOptimizer>> instances;
+  for (std::size_t i = 0U; i < threads; ++i) {
+    auto instanceParams = solverParams;
+    if (i != 0U) {
+      instanceParams.addParam(
+          "maxsat_engine",
+          std::string(maxSATEngines[i % maxSATEngines.size()]));
+    }
+    instances.emplace_back(createZ3LogicOptimizer(true, instanceParams));
+  }
+  return std::make_unique<portfoliologic::PortfolioLogicOptimizer>(
+      std::move(instances), convertWhenAssert);
+}
+
+inline std::unique_ptr<LogicBlock>
+getCNFLogicBlock(bool& success, bool convertWhenAssert,
+                 std::unique_ptr<cnflogic::SATSolver> solver =
+                     std::make_unique<cnflogic::CDCLSolver>(),
+                 bool preprocess = false) {
+  success = true;
+  return std::make_unique<cnflogic::CNFLogicBlock>(
+      std::move(solver), convertWhenAssert, preprocess);
+}
+
+/// creates a logic block of the backend selected by the BACKEND parameter
+inline std::unique_ptr<LogicBlock>
+getLogicBlock(bool& success, bool convertWhenAssert,
+              const Params& params = Params()) {
+  auto solverParams = params;
+  if (extractBackend(solverParams) == Backend::Z3) {
+    return getZ3LogicBlock(success, convertWhenAssert, solverParams);
+  }
+
+  const auto threads = extractPortfolioThreads(solverParams);
+  uint32_t seed = 0U;
+  uint32_t timeout = 0U;
+  for (const auto& param : solverParams.getParams()) {
+    if (param.type == ParamType::UINT && param.name == "random_seed") {
+      seed = param.uivalue;
+    } else if (param.type == ParamType::UINT && param.name == "timeout") {
+      timeout = param.uivalue;
+    } else {
+      throw std::invalid_argument("Unsupported parameter " + param.name +
+                                  " for the cnf backend");
+    }
+  }
+  const auto createSolver = [timeout](const uint32_t instanceSeed) {
+    auto solver = std::make_unique<cnflogic::CDCLSolver>(instanceSeed);
+    solver->setTimeout(timeout);
+    return solver;
+  };
+  if (threads == 1U) {
+    return getCNFLogicBlock(success, convertWhenAssert, createSolver(seed),
+                            true);
+  }
+  std::vector<std::unique_ptr<LogicBlock>> instances;
+  for (std::size_t i = 0U; i < threads; ++i) {
+    instances.emplace_back(getCNFLogicBlock(
+        success, true, createSolver(seed + static_cast<uint32_t>(i)), true));
+  }
+  return std::make_unique<portfoliologic::PortfolioLogicBlock>(
+      std::move(instances), convertWhenAssert);
+}
+
 } // namespace logicutil
@@ -266,6 +266,34 @@ public:
     return distanceTable;
   }
 
+  /**
+   * @brief returns the distance table stored contiguously in row-major order,
+   * i.e. the distance from q1 to q2 is at index `q1 * nqubits + q2`
+   */
+  [[nodiscard]] const std::vector<double>&
+  getFlatDistanceTable(bool includeReversalCost = true) const {
+    if (includeReversalCost) {
+      return flatDistanceTableReversals;
+    }
+    return flatDistanceTable;
+  }
+
+  /**
+   * @brief returns the first qubits of all edges in the coupling map (in the
+   * order of the coupling map)
+   */
+  [[nodiscard]] const std::vector<std::uint32_t>& getEdgeSources() const {
+    return edgeSources;
+  }
+
+  /**
+   * @brief returns the second qubits of all edges in the coupling map (in the
+   * order of the coupling map)
+   */
+  [[nodiscard]] const std::vector<std::uint32_t>& getEdgeTargets() const {
+    return edgeTargets;
+  }
+
   [[nodiscard]] const Properties& getProperties() const { return properties; }
 
   [[nodiscard]] Properties& getProperties() { return properties; }
@@ -396,6 +424,24 @@ public:
     return swapFidelityCosts.at(q1).at(q2);
   }
 
+  /**
+   * @brief returns the fidelity costs of executing a 2Q-gate on each edge of
+   * the coupling map, in the order of `getEdgeSources()`/`getEdgeTargets()`
+   *
+   * @param reverse if true, the costs of the gate in the reverse direction of
+   * the edges are returned
+   */
+  [[nodiscard]] const std::vector<double>&
+  getEdgeFidelityCosts(bool reverse = false) const {
+    if (!fidelityAvailable) {
+      throw QMAPException("No fidelity data available.");
+    }
+    if (reverse) {
+      return edgeReverseFidelityCosts;
+    }
+    return edgeFidelityCosts;
+  }
+
   /** true if the coupling map contains no unidirectional edges */
   [[nodiscard]] bool bidirectional() const { return isBidirectional; }
 
@@ -415,6 +461,10 @@ public:
     couplingMap.clear();
     distanceTable.clear();
     distanceTableReversals.clear();
+    flatDistanceTable.clear();
+    flatDistanceTableReversals.clear();
+    edgeSources.clear();
+    edgeTargets.clear();
     isBidirectional = true;
     isUnidirectional = true;
     properties.clear();
@@ -425,6 +475,8 @@ public:
     twoQubitFidelityCosts.clear();
     swapFidelityCosts.clear();
     fidelityDistanceTables.clear();
+    edgeFidelityCosts.clear();
+    edgeReverseFidelityCosts.clear();
   }
 
   [[nodiscard]] double distance(std::uint16_t control, std::uint16_t target,
@@ -515,6 +567,12 @@ protected:
 
   Matrix distanceTable;
   Matrix distanceTableReversals;
+  // flat copies of the distance tables and the coupling map for the
+  // vectorized heuristic kernels
+  std::vector<double> flatDistanceTable;
+  std::vector<double> flatDistanceTableReversals;
+  std::vector<std::uint32_t> edgeSources;
+  std::vector<std::uint32_t> edgeTargets;
   std::vector<std::pair<std::int16_t, std::int16_t>> teleportationQubits;
   Properties properties;
   bool fidelityAvailable = false;
@@ -524,6 +582,8 @@ protected:
   Matrix twoQubitFidelityCosts;
   Matrix swapFidelityCosts;
   std::vector<Matrix> fidelityDistanceTables;
+  std::vector<double> edgeFidelityCosts;
+  std::vector<double> edgeReverseFidelityCosts;
 
   void createDistanceTable();
   void createFidelityTable();
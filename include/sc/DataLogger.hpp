@@ -9,7 +9,7 @@
 #include "Definitions.hpp"
 #include "MappingResults.hpp"
 #include "ir/QuantumComputation.hpp"
-#include "ir/operations/CompoundOperation.hpp"
+#include "ir/operations/Operation.hpp"
 #include "utils.hpp"
 
 #include <cstddef>
@@ -60,11 +60,9 @@ public:
                      const std::vector<std::int16_t>& qubits, bool validMapping,
                      const std::vector<Exchange>& swaps, std::size_t depth);
   void logFinalizeLayer(
-      std::size_t layer, const qc::CompoundOperation& ops,
+      std::size_t layer, const std::vector<const qc::Operation*>& ops,
       const std::vector<std::uint16_t>& singleQubitMultiplicity,
-      const std::map<std::pair<std::uint16_t, std::uint16_t>,
-                     std::pair<std::uint16_t, std::uint16_t>>&
-          twoQubitMultiplicity,
+      const TwoQubitMultiplicity& twoQubitMultiplicity,
       const std::vector<std::int16_t>& initialLayout, std::size_t finalNodeId,
       double finalCostFixed, double finalCostHeur, double finalLookaheadPenalty,
       const std::vector<std::int16_t>& finalLayout,
@@ -10,6 +10,7 @@
 #include "MappingResults.hpp"
 #include "configuration/Configuration.hpp"
 #include "ir//QuantumComputation.hpp"
+#include "ir/operations/OpType.hpp"
 #include "ir/operations/Operation.hpp"
 #include "utils.hpp"
 
@@ -17,7 +18,6 @@
 #include <cstddef>
 #include <cstdint>
 #include <iostream>
-#include <map>
 #include <nlohmann/json.hpp>
 #include <optional>
 #include <set>
@@ -25,28 +25,6 @@
 #include <utility>
 #include <vector>
 
-/**
- * number of two-qubit gates acting on pairs of logical qubits in some layer
- * where the keys correspond to logical qubit pairs ({q1, q2}, with q1<=q2)
- * and the values to the number of gates acting on a pair in each direction
- * (the first number with control=q1, target=q2 and the second the reverse).
- *
- * e.g., with multiplicity {{0,1},{2,3}} there are 2 gates with logical
- * qubit 0 as control and qubit 1 as target, and 3 gates with 1 as control
- * and 0 as target.
- */
-using TwoQubitMultiplicity =
-    std::map<Edge, std::pair<std::uint16_t, std::uint16_t>>;
-
-/**
- * number of single-qubit gates acting on each logical qubit in some
- * layer.
- *
- * e.g. with multiplicity {1,0,2} there is 1 1Q-gate acting on q0, no 1Q-gates
- * acting on q1, and 2 1Q-gates acting on q2
- */
-using SingleQubitMultiplicity = std::vector<std::uint16_t>;
-
 constexpr std::int16_t DEFAULT_POSITION = -1;
 
 class Mapper {
@@ -93,6 +71,63 @@ protected:
    */
   std::vector<std::vector<Gate>> layers;
 
+  /**
+   * @brief Index of the circuit layer stored in `layers.front()`
+   *
+   * Always 0, except when layers are created and routed in a sliding window
+   * (see `HeuristicMapper::mapStreaming`), in which case all layers before
+   * this index have already been routed and discarded.
+   */
+  std::size_t layerOffset = 0;
+
+  /**
+   * @brief Classes of gate actions on a single qubit, which commute with each
+   * other as long as they belong to the same class
+   */
+  enum class CommutationClass : std::uint8_t {
+    /** diagonal in the Z basis (e.g. Z, S, T, RZ, P, or a CNOT control) */
+    ZDiagonal,
+    /** diagonal in the X basis (e.g. X, SX, RX, or a CNOT target) */
+    XDiagonal,
+    /** commutes with nothing in general */
+    None
+  };
+
+  /**
+   * @brief State carried from one gate to the next while splitting a circuit
+   * into layers
+   */
+  struct LayeringState {
+    /** the (absolute) index of the last layer each qubit is used in */
+    std::vector<std::optional<std::size_t>> lastLayer;
+    /** qubits acted on in the last layer (for Layering::QubitTriangle) */
+    std::set<std::uint16_t> qubitsInLayer;
+    /** true if the next gate starts a new layer (for Layering::OddGates) */
+    bool even = true;
+    /**
+     * commutation class of the current run of mutually commuting gates on
+     * each qubit (for Layering::CommutationFront)
+     */
+    std::vector<CommutationClass> runClass;
+    /**
+     * the last layer each qubit is used in before its current run of
+     * commuting gates (for Layering::CommutationFront)
+     */
+    std::vector<std::optional<std::size_t>> runStart;
+
+    explicit LayeringState(const std::size_t nqubits)
+        : lastLayer(nqubits, std::nullopt),
+          runClass(nqubits, CommutationClass::None),
+          runStart(nqubits, std::nullopt) {}
+  };
+
+  /**
+   * @brief Returns the commutation class of a gate of type `type` on its
+   * control (if `control` is true) or target qubit
+   */
+  [[nodiscard]] static CommutationClass commutationClass(qc::OpType type,
+                                                         bool control);
+
   /**
    * @brief The number of 1Q-gates acting on each logical qubit in each layer
    */
@@ -108,19 +143,19 @@ protected:
    * @brief For each layer the set of all logical qubits, which are acted on by
    * a gate in the layer
    */
-  std::vector<std::set<std::uint16_t>> activeQubits;
+  std::vector<QubitSet> activeQubits;
 
   /**
    * @brief For each layer the set of all logical qubits, which are acted on by
    * a 1Q-gate in the layer
    */
-  std::vector<std::set<std::uint16_t>> activeQubits1QGates;
+  std::vector<QubitSet> activeQubits1QGates;
 
   /**
    * @brief For each layer the set of all logical qubits, which are acted on by
    * a 2Q-gate in the layer
    */
-  std::vector<std::set<std::uint16_t>> activeQubits2QGates;
+  std::vector<QubitSet> activeQubits2QGates;
 
   /**
    * @brief containing the logical qubit currently mapped to each physical
@@ -162,9 +197,38 @@ protected:
    * distinct qubits
    * Layering::Disjoint2qBlocks -> each layer contains 2Q-Blocks only acting on
    * a disjoint set of qubits
+   * Layering::CommutationFront -> each gate is put in the first layer allowed
+   * by its dependencies, where consecutive gates of the same commutation class
+   * on a qubit do not depend on each other, and each layer contains 2Q-gates
+   * only acting on disjoint qubit pairs (the heuristic mapper additionally
+   * executes all gates becoming executable after routing a layer directly)
    */
   virtual void createLayers();
 
+  /**
+   * @brief Adds a single gate of the circuit to `layers` according to the
+   * method set in `config.layering` (see `createLayers`)
+   *
+   * Gates are never added to layers before `layerOffset`, i.e. to layers that
+   * have already been routed.
+   *
+   * @param gate the gate to be added
+   * @param state the layering state after the previous gate of the circuit
+   */
+  void addToLayers(qc::Operation* gate, LayeringState& state);
+
+  /**
+   * @brief (Re)computes the gate multiplicities and active qubits of all
+   * layers currently stored in `layers`
+   */
+  void computeLayerMultiplicities();
+
+  /**
+   * @brief (Re)computes the gate multiplicities and active qubits of the
+   * layer at the given index after its gates have changed
+   */
+  void computeLayerMultiplicities(std::size_t layer);
+
   /**
    * @brief Returns true if the layer at the given index can be split into two
    * without resulting in an empty layer (assuming the original layer only has
@@ -216,6 +280,20 @@ protected:
       const std::optional<std::uint16_t>& control, std::uint16_t target,
       qc::Operation* gate);
 
+  /**
+   * Gates are put in the first layer after all gates on the same qubits they
+   * do not commute with, and which contains no 2Q-gate acting on a different
+   * pair of qubits sharing one of the gate's qubits.
+   *
+   * @param state the layering state after the previous gate
+   * @param control the (potential) control qubit of the gate
+   * @param target the target qubit of the gate
+   * @param gate the gate to be added to the layer
+   */
+  void processCommutationLayer(LayeringState& state,
+                               const std::optional<std::uint16_t>& control,
+                               std::uint16_t target, qc::Operation* gate);
+
   /**
    * @brief Get the index of the next layer after the given index containing a
    * gate acting on more than one qubit
@@ -342,6 +420,7 @@ public:
     architecture->reset();
     qc.reset();
     layers.clear();
+    layerOffset = 0;
     qubits.clear();
     locations.clear();
 
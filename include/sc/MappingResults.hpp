@@ -5,6 +5,7 @@
 
 #include "configuration/Configuration.hpp"
 #include "configuration/Method.hpp"
+#include "logicblocks/Statistics.hpp"
 
 #include <cstddef>
 #include <cstdint>
@@ -100,6 +101,8 @@ struct MappingResults {
   std::string mappedCircuit;
 
   std::string wcnf;
+  // formulation size and solver effort of the exact mapper (all solver calls)
+  logicbase::Statistics solverStatistics{};
 
   HeuristicBenchmarkInfo heuristicBenchmark{};
   std::vector<LayerHeuristicBenchmarkInfo> layerHeuristicBenchmark;
@@ -154,6 +157,7 @@ struct MappingResults {
       if (config.includeWCNF && !wcnf.empty()) {
         stats["WCNF"] = wcnf;
       }
+      stats["solver_statistics"] = solverStatistics;
     } else if (config.method == Method::Heuristic) {
       stats["teleportations"] = output.teleportations;
       stats["benchmark"] = heuristicBenchmark.json();
@@ -98,9 +98,17 @@ struct Configuration {
   // use qubit subsets in exact mapper
   bool useSubsets = true;
 
+  // number of solver instances the exact mapper runs in parallel (with
+  // different MaxSAT engines); the first one to finish is used
+  std::size_t portfolioThreads = 1;
+
   // include WCNF file in results of exact mapper
   bool includeWCNF = false;
 
+  // directory the exact mapper writes its solver instances to (together with
+  // a JSON file describing each instance), empty to disable
+  std::string instanceDumpPath;
+
   // limit the number of considered swaps
   bool enableSwapLimits = true;
   SwapReduction swapReduction = SwapReduction::CouplingLimit;
@@ -113,6 +121,10 @@ struct Configuration {
     return !dataLoggingPath.empty();
   }
 
+  [[nodiscard]] bool instanceDumpEnabled() const {
+    return !instanceDumpPath.empty();
+  }
+
   void setTimeout(const std::size_t sec) { timeout = sec; }
   [[nodiscard]] bool swapLimitsEnabled() const {
     return (swapReduction != SwapReduction::None) && enableSwapLimits;
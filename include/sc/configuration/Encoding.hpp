@@ -11,7 +11,14 @@
 #include <stdexcept>
 #include <string>
 
-enum class Encoding : std::uint8_t { Naive, Commander, Bimander };
+enum class Encoding : std::uint8_t {
+  Naive,
+  Commander,
+  Bimander,
+  SequentialCounter,
+  Totalizer,
+  ModuloTotalizer
+};
 
 [[maybe_unused]] static inline std::string toString(const Encoding encoding) {
   switch (encoding) {
@@ -21,6 +28,12 @@ enum class Encoding : std::uint8_t { Naive, Commander, Bimander };
     return "commander";
   case Encoding::Bimander:
     return "bimander";
+  case Encoding::SequentialCounter:
+    return "sequential_counter";
+  case Encoding::Totalizer:
+    return "totalizer";
+  case Encoding::ModuloTotalizer:
+    return "modulo_totalizer";
   }
   return " ";
 }
@@ -36,6 +49,15 @@ encodingFromString(const std::string& encoding) {
   if (encoding == "bimander" || encoding == "2") {
     return Encoding::Bimander;
   }
+  if (encoding == "sequential_counter" || encoding == "3") {
+    return Encoding::SequentialCounter;
+  }
+  if (encoding == "totalizer" || encoding == "4") {
+    return Encoding::Totalizer;
+  }
+  if (encoding == "modulo_totalizer" || encoding == "5") {
+    return Encoding::ModuloTotalizer;
+  }
   throw std::invalid_argument("Invalid encoding value: " + encoding);
 }
 
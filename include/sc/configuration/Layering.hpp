@@ -14,7 +14,8 @@ enum class Layering : std::uint8_t {
   DisjointQubits,
   OddGates,
   QubitTriangle,
-  Disjoint2qBlocks
+  Disjoint2qBlocks,
+  CommutationFront
 };
 
 [[maybe_unused]] static inline std::string toString(const Layering strategy) {
@@ -29,6 +30,8 @@ enum class Layering : std::uint8_t {
     return "qubit_triangle";
   case Layering::Disjoint2qBlocks:
     return "disjoint_2q_blocks";
+  case Layering::CommutationFront:
+    return "commutation_front";
   }
   return " ";
 }
@@ -50,5 +53,8 @@ layeringFromString(const std::string& layering) {
   if (layering == "disjoint_2q_blocks" || layering == "4") {
     return Layering::Disjoint2qBlocks;
   }
+  if (layering == "commutation_front" || layering == "5") {
+    return Layering::CommutationFront;
+  }
   throw std::invalid_argument("Invalid layering value: " + layering);
 }
@@ -0,0 +1,91 @@
+//
+// This file is part of the MQT QMAP library released under the MIT license.
+// See README.md or go to https://github.com/cda-tum/qmap for more information.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Gather-and-reduce kernels used by the heuristic mapper to evaluate the
+ * (lookahead) heuristics of search nodes on flat distance tables.
+ *
+ * Each kernel has a scalar implementation and an AVX2 implementation, which is
+ * selected at runtime if supported by the CPU. Both implementations use the
+ * same lane-wise association order (and no multiplications that could be
+ * contracted differently), so their results are bitwise identical.
+ *
+ * All indices have to be smaller than 2^31 (the AVX2 gathers use signed 32-bit
+ * offsets).
+ */
+namespace kernels {
+
+enum class Backend : std::uint8_t {
+  /** portable implementation */
+  Scalar,
+  /** x86-64 AVX2 implementation (using hardware gathers) */
+  AVX2
+};
+
+/// number of partial results accumulated independently in each kernel
+constexpr std::size_t LANES = 4;
+
+/**
+ * @brief returns true if the given backend can be used on this machine
+ */
+[[nodiscard]] bool isAvailable(Backend backend);
+
+/**
+ * @brief returns the fastest backend available on this machine (determined
+ * once on first use)
+ */
+[[nodiscard]] Backend bestAvailable();
+
+/**
+ * @brief computes the maximum of max(table[from[i]], table[to[i]]) over all
+ * `i < count`, or 0 if `count == 0`
+ *
+ * @param table flat table (e.g. a distance table stored row-major)
+ * @param from first index into `table` for each entry
+ * @param to second index into `table` for each entry
+ * @param count number of entries
+ * @param backend implementation to use
+ */
+[[nodiscard]] double gatherPairMax(const double* table,
+                                   const std::uint32_t* from,
+                                   const std::uint32_t* to, std::size_t count,
+                                   Backend backend = bestAvailable());
+
+/**
+ * @brief computes the sum of max(table[from[i]], table[to[i]]) over all
+ * `i < count`
+ *
+ * @param table flat table (e.g. a distance table stored row-major)
+ * @param from first index into `table` for each entry
+ * @param to second index into `table` for each entry
+ * @param count number of entries
+ * @param backend implementation to use
+ */
+[[nodiscard]] double gatherPairSum(const double* table,
+                                   const std::uint32_t* from,
+                                   const std::uint32_t* to, std::size_t count,
+                                   Backend backend = bestAvailable());
+
+/**
+ * @brief computes the minimum of `costs[i] + row1[col1[i]] + row2[col2[i]]`
+ * over all `i < count`, or the maximum double if `count == 0`
+ *
+ * Used to find the cheapest physical edge for a pair of logical qubits, where
+ * `costs` are the costs of executing the pair's gates on each edge and
+ * `row1`/`row2` are the distance table rows of the qubits' current locations.
+ */
+[[nodiscard]] double gatherEdgeCostMin(const double* costs, const double* row1,
+                                       const std::uint32_t* col1,
+                                       const double* row2,
+                                       const std::uint32_t* col2,
+                                       std::size_t count,
+                                       Backend backend = bestAvailable());
+
+} // namespace kernels
@@ -25,6 +25,12 @@ public:
 
   static constexpr double EFFECTIVE_BRANCH_RATE_TOLERANCE = 1e-10;
 
+  /**
+   * maximum number of nodes of a search aborted to split a layer, which are
+   * carried over as starting points to the search on the split layer
+   */
+  static constexpr std::size_t MAX_SPLIT_SEEDS = 32;
+
   /**
    * @brief map the circuit passed at initialization to the architecture
    *
@@ -33,6 +39,31 @@ public:
    */
   void map(const Configuration& configuration) override;
 
+  /**
+   * @brief map the circuit passed at initialization to the architecture,
+   * writing the mapped circuit to `os` (as OpenQASM 3) while routing
+   *
+   * Layers are created lazily from the gates of the circuit and routed in a
+   * sliding window holding the current layer and the `nrLookaheads` following
+   * ones. The mapped circuit is written layer by layer and never stored as a
+   * whole, so memory stays bounded by the window instead of growing with the
+   * length of the circuit. Compared to `map`
+   * - gates are never moved into layers that have already been routed,
+   * - qubits only acted on by single-qubit gates are placed on the first free
+   * physical qubit as soon as they are encountered,
+   * - post-mapping optimizations are only applied within each layer,
+   * - the initial layout and output permutation are written as comments at
+   * the end of the output, and
+   * - iterative bidirectional routing and data logging are not supported.
+   *
+   * The results are available via `getResults()` afterwards, but the mapped
+   * circuit cannot be dumped again.
+   *
+   * @param configuration the settings for this mapping run
+   * @param os stream to which the mapped circuit is written
+   */
+  void mapStreaming(const Configuration& configuration, std::ostream& os);
+
   /**
    * @brief struct representing one node in the A* search containing info about
    * swaps, mappings and costs
@@ -144,6 +175,19 @@ protected:
   bool principallyAdmissibleHeur = true;
   bool tightHeur = true;
   bool fidelityAwareHeur = false;
+  /** true while mapping via `mapStreaming` */
+  bool streaming = false;
+  /**
+   * most promising nodes of the last search aborted to split its layer, used
+   * as additional starting points by the next call to `aStarMap`
+   */
+  std::vector<Node> splitSeeds;
+
+  // scratch buffers for the vectorized heuristic kernels, reused across nodes
+  std::vector<std::uint32_t> kernelFrom;
+  std::vector<std::uint32_t> kernelTo;
+  std::vector<double> kernelEdgeCosts;
+  std::vector<double> kernelZeroRow;
 
   /**
    * @brief check the `results.config` for any invalid settings
@@ -189,6 +233,54 @@ protected:
    */
   void routeCircuit();
 
+  /**
+   * @brief Routes a single layer, i.e. searches for the swaps to execute all
+   * of its gates and appends the swaps and the (mapped) gates to `qcMapped`
+   *
+   * @param layer index of the layer in `layers`
+   * @param gateidx index of the next gate appended to `qcMapped`
+   * @param gatesToAdjust indices of gates in `qcMapped` acting on yet unmapped
+   * qubits, which need to be adjusted once the final layout is known
+   * @return false if the layer was empty (i.e. all of its gates have already
+   * been executed early) and nothing was routed
+   */
+  bool routeLayer(std::size_t layer, std::size_t& gateidx,
+                  std::vector<std::size_t>& gatesToAdjust);
+
+  /**
+   * @brief Appends a gate of the input circuit to `qcMapped` using the current
+   * qubit locations (reversing the direction of 2Q-gates if necessary)
+   *
+   * @param gate the gate to append
+   * @param gateidx index of the next gate appended to `qcMapped`
+   * @param gatesToAdjust indices of gates in `qcMapped` acting on yet unmapped
+   * qubits, which need to be adjusted once the final layout is known
+   */
+  void appendMappedGate(const Gate& gate, std::size_t& gateidx,
+                        std::vector<std::size_t>& gatesToAdjust);
+
+  /**
+   * @brief After routing `layer`, executes all gates of the next
+   * `nrLookaheads` layers that are executable in the current layout and
+   * commute with all gates before them still remaining in the layers, and
+   * removes them from their layers (for Layering::CommutationFront)
+   *
+   * @param layer index of the layer in `layers` that has just been routed
+   * @param gateidx index of the next gate appended to `qcMapped`
+   * @param gatesToAdjust indices of gates in `qcMapped` acting on yet unmapped
+   * qubits, which need to be adjusted once the final layout is known
+   */
+  void absorbExecutableGates(std::size_t layer, std::size_t& gateidx,
+                             std::vector<std::size_t>& gatesToAdjust);
+
+  /**
+   * @brief averages the search statistics collected in
+   * `results.heuristicBenchmark` over all routed layers (only in debug mode)
+   *
+   * @param nLayers number of routed layers
+   */
+  void finalizeHeuristicBenchmark(std::size_t nLayers);
+
   /**
    * @brief Performs pseudo-routing on the input circuit, i.e. rearranges the
    * qubit layout layer by layer to meet topology constraints without actually
@@ -214,13 +306,20 @@ protected:
    */
   virtual Node aStarMap(std::size_t layer, bool reverse);
 
+  /**
+   * @brief returns the operations of the given layer (e.g. for data logging)
+   * without copying them
+   */
+  [[nodiscard]] std::vector<const qc::Operation*>
+  getLayerOperations(std::size_t layer) const;
+
   /**
    * @brief Get all qubits that are acted on by a relevant gate in the given
    * layer
    *
    * @param layer the layer for which to get the considered qubits
    */
-  const std::set<std::uint16_t>& getConsideredQubits(std::size_t layer) const {
+  const QubitSet& getConsideredQubits(std::size_t layer) const {
     if (fidelityAwareHeur) {
       return activeQubits.at(layer);
     }
@@ -379,6 +478,27 @@ protected:
    */
   double heuristicFidelityBestLocation(std::size_t layer, Node& node);
 
+  /**
+   * @brief returns true if the distance-based heuristics can be evaluated by
+   * the kernels in `HeuristicKernels.hpp` on the flat distance tables of the
+   * architecture (i.e. no teleportation is used and all table indices fit
+   * into the kernels' 32-bit offsets)
+   */
+  [[nodiscard]] bool distanceKernelsApplicable() const;
+
+  /**
+   * @brief appends the flat distance table indices for a not validly mapped
+   * pair of qubits to `kernelFrom`/`kernelTo`, such that the maximum of both
+   * entries is the swap distance of the pair
+   *
+   * @param physQ1 physical qubit of the first logical qubit of the pair
+   * @param physQ2 physical qubit of the second logical qubit of the pair
+   * @param forwardMult number of gates from the first to the second qubit
+   * @param reverseMult number of gates from the second to the first qubit
+   */
+  void addKernelPair(std::uint16_t physQ1, std::uint16_t physQ2,
+                     std::uint16_t forwardMult, std::uint16_t reverseMult);
+
   /**
    * @brief calculates an estimation of the heuristic cost for the following
    * layers (depreciated by a constant factor growing with each layer) and
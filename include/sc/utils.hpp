@@ -11,6 +11,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <iterator>
 #include <limits>
 #include <optional>
 #include <set>
@@ -24,6 +25,164 @@ using Edge = std::pair<std::uint16_t, std::uint16_t>;
 using CouplingMap = std::set<Edge>;
 using QubitSubset = std::set<std::uint16_t>;
 
+/**
+ * number of two-qubit gates acting on a pair of logical qubits {q1, q2}, with
+ * q1<=q2, in some layer. `forward` counts the gates with control=q1 and
+ * target=q2, `backward` the gates in the reverse direction.
+ */
+struct TwoQubitGateCount {
+  std::uint16_t q1 = 0;
+  std::uint16_t q2 = 0;
+  std::uint16_t forward = 0;
+  std::uint16_t backward = 0;
+
+  [[nodiscard]] Edge edge() const { return {q1, q2}; }
+};
+
+/**
+ * number of two-qubit gates acting on pairs of logical qubits in some layer,
+ * stored contiguously and sorted by the logical qubit pairs {q1, q2}.
+ *
+ * e.g., with multiplicity {{0,1,2,3}} there are 2 gates with logical
+ * qubit 0 as control and qubit 1 as target, and 3 gates with 1 as control
+ * and 0 as target.
+ */
+using TwoQubitMultiplicity = std::vector<TwoQubitGateCount>;
+
+/**
+ * number of single-qubit gates acting on each logical qubit in some
+ * layer.
+ *
+ * e.g. with multiplicity {1,0,2} there is 1 1Q-gate acting on q0, no 1Q-gates
+ * acting on q1, and 2 1Q-gates acting on q2
+ */
+using SingleQubitMultiplicity = std::vector<std::uint16_t>;
+
+/**
+ * @brief Adds `forward` gates with control=q1, target=q2 and `backward` gates
+ * in the reverse direction to the given multiplicity, keeping it sorted
+ *
+ * @param multiplicity the multiplicity of the layer
+ * @param q1 the smaller logical qubit of the pair
+ * @param q2 the larger logical qubit of the pair
+ */
+void addTwoQubitGateCount(TwoQubitMultiplicity& multiplicity, std::uint16_t q1,
+                          std::uint16_t q2, std::uint16_t forward,
+                          std::uint16_t backward);
+
+/**
+ * @brief Set of qubits stored as a packed bitset.
+ *
+ * Used instead of a node-based `std::set` for the qubits acted on in a layer,
+ * which are queried in the innermost loops of the heuristic mapper.
+ * Iterating yields the contained qubits in increasing order.
+ */
+class QubitSet {
+  using Word = std::uint64_t;
+  static constexpr std::size_t WORD_BITS = 64U;
+
+  std::vector<Word> words;
+  std::size_t count = 0U;
+
+  [[nodiscard]] std::size_t capacity() const {
+    return words.size() * WORD_BITS;
+  }
+
+  /// index of the first contained qubit >= `from` or `capacity()` if none
+  [[nodiscard]] std::size_t nextFrom(std::size_t from) const {
+    auto w = from / WORD_BITS;
+    if (w >= words.size()) {
+      return capacity();
+    }
+    auto word = words[w] & (~Word{0U} << (from % WORD_BITS));
+    while (word == 0U) {
+      if (++w == words.size()) {
+        return capacity();
+      }
+      word = words[w];
+    }
+    return (w * WORD_BITS) + countTrailingZeros(word);
+  }
+
+  static std::size_t countTrailingZeros(Word word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<std::size_t>(__builtin_ctzll(word));
+#else
+    std::size_t n = 0U;
+    while ((word & 1U) == 0U) {
+      word >>= 1U;
+      ++n;
+    }
+    return n;
+#endif
+  }
+
+public:
+  class const_iterator {
+    const QubitSet* set = nullptr;
+    std::size_t pos = 0U;
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::uint16_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const std::uint16_t*;
+    using reference = std::uint16_t;
+
+    const_iterator() = default;
+    const_iterator(const QubitSet* s, const std::size_t p) : set(s), pos(p) {}
+
+    reference operator*() const { return static_cast<std::uint16_t>(pos); }
+    const_iterator& operator++() {
+      pos = set->nextFrom(pos + 1);
+      return *this;
+    }
+    const_iterator operator++(int) {
+      auto tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+    bool operator==(const const_iterator& other) const {
+      return pos == other.pos;
+    }
+    bool operator!=(const const_iterator& other) const {
+      return pos != other.pos;
+    }
+  };
+
+  QubitSet() = default;
+  explicit QubitSet(const std::size_t nqubits)
+      : words((nqubits + WORD_BITS - 1) / WORD_BITS, 0U) {}
+
+  [[nodiscard]] bool contains(const std::uint16_t q) const {
+    const auto w = q / WORD_BITS;
+    return w < words.size() && ((words[w] >> (q % WORD_BITS)) & 1U) != 0U;
+  }
+
+  void insert(const std::uint16_t q) {
+    const auto w = q / WORD_BITS;
+    if (w >= words.size()) {
+      words.resize(w + 1, 0U);
+    }
+    const auto mask = Word{1U} << (q % WORD_BITS);
+    if ((words[w] & mask) == 0U) {
+      words[w] |= mask;
+      ++count;
+    }
+  }
+
+  void clear() {
+    std::fill(words.begin(), words.end(), 0U);
+    count = 0U;
+  }
+
+  [[nodiscard]] std::size_t size() const { return count; }
+  [[nodiscard]] bool empty() const { return count == 0U; }
+
+  [[nodiscard]] const_iterator begin() const { return {this, nextFrom(0U)}; }
+  [[nodiscard]] const_iterator end() const { return {this, capacity()}; }
+};
+
 struct Exchange {
   Exchange(const std::uint16_t f, const std::uint16_t s, const qc::OpType type)
       : first(f), second(s),
@@ -0,0 +1,147 @@
+//
+// This file is part of the MQT QMAP library released under the MIT license.
+// See README.md or go to https://github.com/cda-tum/qmap for more information.
+//
+
+#include "cliffordsynthesis/BatchSynthesis.hpp"
+
+#include "cliffordsynthesis/CliffordSynthesizer.hpp"
+#include "cliffordsynthesis/Configuration.hpp"
+#include "cliffordsynthesis/Results.hpp"
+#include "cliffordsynthesis/SynthesisCache.hpp"
+#include "cliffordsynthesis/Tableau.hpp"
+#include "logicblocks/Statistics.hpp"
+#include "qasm3/Importer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <plog/Appenders/ConsoleAppender.h>
+#include <plog/Formatters/TxtFormatter.h>
+#include <plog/Init.h>
+#include <plog/Log.h>
+#include <plog/Logger.h>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace cs {
+
+std::vector<Results> synthesizeBatch(const std::vector<Tableau>& targets,
+                                     const Configuration& config,
+                                     const std::size_t nThreads) {
+  if (config.heuristic) {
+    throw std::invalid_argument(
+        "The heuristic requires circuits and is not supported in batches.");
+  }
+  if (targets.empty()) {
+    return {};
+  }
+
+  // initialize logging before the synthesizers do so concurrently
+  if (plog::get() == nullptr) {
+    static plog::ConsoleAppender<plog::TxtFormatter> consoleAppender;
+    plog::init(plog::none, &consoleAppender);
+  }
+  plog::get()->setMaxSeverity(config.verbosity);
+
+  // A coupling map or a window is not invariant under relabelling the qubits,
+  // so then only identical targets share a result.
+  const bool relabel = !config.prunesQubitPairs();
+  std::vector<std::optional<CanonicalTableau>> canonicals(targets.size());
+  std::unordered_map<std::string, std::size_t> representatives{};
+  std::vector<std::size_t> representative(targets.size());
+  std::vector<std::size_t> unique{};
+  for (std::size_t i = 0U; i < targets.size(); ++i) {
+    std::string key{};
+    if (relabel) {
+      key = canonicals[i].emplace(targets[i]).tableau;
+    } else {
+      key = targets[i].toString();
+    }
+    const auto [it, inserted] = representatives.emplace(key, i);
+    representative[i] = it->second;
+    if (inserted) {
+      unique.emplace_back(i);
+    }
+  }
+
+  // Targets on more qubits tend to take longer, so they are started first to
+  // avoid a single large target running on its own at the end.
+  std::stable_sort(unique.begin(), unique.end(),
+                   [&targets](const std::size_t a, const std::size_t b) {
+                     return targets[a].getQubitCount() >
+                            targets[b].getQubitCount();
+                   });
+
+  // Workers pull the next target from a shared counter. The results are
+  // stored per target, so they do not depend on the scheduling.
+  std::vector<Results> results(targets.size());
+  std::vector<std::exception_ptr> errors(targets.size());
+  std::atomic<std::size_t> next{0U};
+  const auto worker = [&targets, &unique, &results, &errors, &next,
+                       &config]() {
+    for (auto i = next++; i < unique.size(); i = next++) {
+      const auto item = unique[i];
+      try {
+        auto synthesizer = CliffordSynthesizer(targets[item]);
+        synthesizer.synthesize(config);
+        results[item] = synthesizer.getResults();
+      } catch (...) {
+        errors[item] = std::current_exception();
+      }
+    }
+  };
+
+  const auto threadCount =
+      std::min(std::max<std::size_t>(nThreads, 1U), unique.size());
+  PLOG_INFO << "Synthesizing " << unique.size() << " distinct of "
+            << targets.size() << " targets with " << threadCount
+            << " thread(s)";
+  std::vector<std::thread> threads;
+  threads.reserve(threadCount - 1U);
+  for (std::size_t i = 1U; i < threadCount; ++i) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (const auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  // the remaining targets reuse the (relabelled) result of their
+  // representative
+  for (std::size_t i = 0U; i < targets.size(); ++i) {
+    const auto rep = representative[i];
+    if (rep == i) {
+      continue;
+    }
+    const auto start = std::chrono::high_resolution_clock::now();
+    results[i] = results[rep];
+    results[i].setSolverCalls(0U);
+    results[i].setSolverStatistics({});
+    if (relabel && results[rep].sat() &&
+        !results[rep].getResultCircuit().empty()) {
+      auto circuit = qasm3::Importer::imports(results[rep].getResultCircuit());
+      canonicals[rep]->toCanonical(circuit);
+      canonicals[i]->fromCanonical(circuit);
+      results[i].setResultCircuit(circuit);
+      results[i].setResultTableau(targets[i]);
+    }
+    const std::chrono::duration<double> diff =
+        std::chrono::high_resolution_clock::now() - start;
+    results[i].setRuntime(diff.count());
+  }
+  return results;
+}
+
+} // namespace cs
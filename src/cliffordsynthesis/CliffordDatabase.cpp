@@ -0,0 +1,567 @@
+//
+// This file is part of the MQT QMAP library released under the MIT license.
+// See README.md or go to https://github.com/cda-tum/qmap for more information.
+//
+
+#include "cliffordsynthesis/CliffordDatabase.hpp"
+
+#include "Definitions.hpp"
+#include "cliffordsynthesis/Tableau.hpp"
+#include "cliffordsynthesis/TargetMetric.hpp"
+#include "ir/QuantumComputation.hpp"
+#include "ir/operations/Control.hpp"
+#include "ir/operations/OpType.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace cs {
+
+namespace {
+// the single-qubit gates of the SAT encoding (without the identity)
+constexpr std::array<qc::OpType, 6> SINGLE_QUBIT_GATES = {
+    qc::OpType::X, qc::OpType::Y, qc::OpType::Z,
+    qc::OpType::H, qc::OpType::S, qc::OpType::Sdg};
+
+constexpr std::array<char, 8> MAGIC = {'Q', 'M', 'A', 'P', 'C', 'D', 'B', '1'};
+
+// bound on the successors that are generated at once (128 MB)
+constexpr std::size_t MAX_CANDIDATES = 1U << 24U;
+// smaller sets of candidates are sorted by comparison
+constexpr std::size_t RADIX_SORT_THRESHOLD = 1U << 16U;
+constexpr std::size_t RADIX_BITS = 11U;
+constexpr std::uint64_t RADIX = std::uint64_t{1} << RADIX_BITS;
+
+constexpr std::size_t WORD_BYTES = sizeof(std::uint64_t);
+// words are written in chunks to bound the size of the byte buffer
+constexpr std::size_t WORDS_PER_CHUNK = 1U << 16U;
+
+void writeWords(std::ostream& os, const std::uint64_t* words,
+                const std::size_t count) {
+  std::vector<char> bytes(std::min(count, WORDS_PER_CHUNK) * WORD_BYTES);
+  for (std::size_t begin = 0U; begin < count; begin += WORDS_PER_CHUNK) {
+    const auto end = std::min(begin + WORDS_PER_CHUNK, count);
+    for (std::size_t w = begin; w < end; ++w) {
+      for (std::size_t b = 0U; b < WORD_BYTES; ++b) {
+        bytes[((w - begin) * WORD_BYTES) + b] =
+            static_cast<char>((words[w] >> (8U * b)) & 0xFFU);
+      }
+    }
+    os.write(bytes.data(),
+             static_cast<std::streamsize>((end - begin) * WORD_BYTES));
+  }
+}
+
+bool readWords(std::istream& is, std::uint64_t* words,
+               const std::size_t count) {
+  std::vector<char> bytes(std::min(count, WORDS_PER_CHUNK) * WORD_BYTES);
+  for (std::size_t begin = 0U; begin < count; begin += WORDS_PER_CHUNK) {
+    const auto end = std::min(begin + WORDS_PER_CHUNK, count);
+    if (!is.read(bytes.data(),
+                 static_cast<std::streamsize>((end - begin) * WORD_BYTES))) {
+      return false;
+    }
+    for (std::size_t w = begin; w < end; ++w) {
+      words[w] = 0U;
+      for (std::size_t b = 0U; b < WORD_BYTES; ++b) {
+        words[w] |= static_cast<std::uint64_t>(static_cast<unsigned char>(
+                        bytes[((w - begin) * WORD_BYTES) + b]))
+                    << (8U * b);
+      }
+    }
+  }
+  return true;
+}
+} // namespace
+
+CliffordDatabase::CliffordDatabase(const std::size_t n,
+                                   const bool withDestabilizers,
+                                   const TargetMetric targetMetric)
+    : nQubits(n), destabilizers(withDestabilizers), metric(targetMetric),
+      steps(createSteps(n, targetMetric)) {
+  const auto rows = destabilizers ? 2U * nQubits : nQubits;
+  const auto columns = (2U * nQubits) + 1U;
+  for (std::size_t i = 0U; i < rows; ++i) {
+    rowMask |= std::uint64_t{1} << (i * columns);
+  }
+}
+
+std::uint64_t CliffordDatabase::pack(const Tableau& tableau) {
+  const auto columns = (2U * tableau.getQubitCount()) + 1U;
+  std::uint64_t packed = 0U;
+  for (std::size_t i = 0U; i < tableau.getTableauSize(); ++i) {
+    for (std::size_t j = 0U; j < columns; ++j) {
+      if (tableau.get(i, j)) {
+        packed |= std::uint64_t{1} << ((i * columns) + j);
+      }
+    }
+  }
+  return packed;
+}
+
+std::vector<CliffordDatabase::Step>
+CliffordDatabase::createSteps(const std::size_t nQubits,
+                              const TargetMetric metric) {
+  std::vector<Step> steps;
+  if (metric != TargetMetric::Depth) {
+    for (std::size_t q = 0U; q < nQubits; ++q) {
+      for (const auto gate : SINGLE_QUBIT_GATES) {
+        steps.push_back({{gate, {q, q}}});
+      }
+    }
+    for (std::size_t c = 0U; c < nQubits; ++c) {
+      for (std::size_t t = 0U; t < nQubits; ++t) {
+        if (c != t) {
+          steps.push_back({{qc::OpType::X, {c, t}}});
+        }
+      }
+    }
+    return steps;
+  }
+
+  // for depth, every step is a non-empty layer of gates on disjoint qubits
+  std::vector<bool> used(nQubits, false);
+  Step layer;
+  const std::function<void(std::size_t)> enumerate = [&](const std::size_t q) {
+    if (q == nQubits) {
+      if (!layer.empty()) {
+        steps.push_back(layer);
+      }
+      return;
+    }
+    if (used[q]) {
+      enumerate(q + 1U);
+      return;
+    }
+    enumerate(q + 1U);
+    used[q] = true;
+    for (const auto gate : SINGLE_QUBIT_GATES) {
+      layer.push_back({gate, {q, q}});
+      enumerate(q + 1U);
+      layer.pop_back();
+    }
+    for (std::size_t p = q + 1U; p < nQubits; ++p) {
+      if (used[p]) {
+        continue;
+      }
+      used[p] = true;
+      for (const auto& cx : {std::pair{q, p}, std::pair{p, q}}) {
+        layer.push_back({qc::OpType::X, cx});
+        enumerate(q + 1U);
+        layer.pop_back();
+      }
+      used[p] = false;
+    }
+    used[q] = false;
+  };
+  enumerate(0U);
+  return steps;
+}
+
+// same update rules as the corresponding Tableau::apply* methods, with the
+// columns of all rows extracted into the bits of rowMask
+std::uint64_t CliffordDatabase::apply(std::uint64_t tableau, const Step& step,
+                                      const bool inverse) const {
+  const auto column = [this, &tableau](const std::size_t j) {
+    return (tableau >> j) & rowMask;
+  };
+  const auto r = 2U * nQubits;
+  for (const auto& [gate, qubits] : step) {
+    const auto [first, second] = qubits;
+    const auto x = column(first);
+    const auto z = column(nQubits + first);
+    if (first != second) {
+      const auto xt = column(second);
+      const auto zt = column(nQubits + second);
+      tableau ^= ((x & zt & ~(xt ^ z)) << r) | (zt << (nQubits + first)) |
+                 (x << second);
+      continue;
+    }
+    std::uint64_t sign = 0U;
+    std::uint64_t flipX = 0U;
+    std::uint64_t flipZ = 0U;
+    switch (gate) {
+    case qc::OpType::X:
+      sign = z;
+      break;
+    case qc::OpType::Y:
+      sign = x ^ z;
+      break;
+    case qc::OpType::Z:
+      sign = x;
+      break;
+    case qc::OpType::H:
+      sign = x & z;
+      flipX = x ^ z;
+      flipZ = x ^ z;
+      break;
+    case qc::OpType::S:
+    case qc::OpType::Sdg:
+      sign = ((gate == qc::OpType::S) != inverse) ? x & z : x & ~z;
+      flipZ = x;
+      break;
+    default:
+      throw std::invalid_argument("Unsupported gate in Clifford database");
+    }
+    tableau ^= (sign << r) | (flipX << first) | (flipZ << (nQubits + first));
+  }
+  return tableau;
+}
+
+std::uint64_t CliffordDatabase::candidate(const std::uint64_t tableau,
+                                          const std::uint64_t gates,
+                                          const std::uint64_t step) {
+  if (gates > GATE_MASK) {
+    throw std::runtime_error("Too many gates for a Clifford database entry");
+  }
+  return (tableau << GATE_BITS) | gates | (step << STEP_SHIFT);
+}
+
+void CliffordDatabase::sortUnique(std::vector<std::uint64_t>& candidates) {
+  if (candidates.size() < RADIX_SORT_THRESHOLD) {
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [](const std::uint64_t a, const std::uint64_t b) {
+                       return (a & TABLEAU_MASK) < (b & TABLEAU_MASK);
+                     });
+  } else {
+    // LSD radix sort, which is several times faster than comparison sorting
+    // for the millions of candidates of three-qubit tables. Digits that are
+    // equal for all candidates are skipped.
+    const auto digit = [](const std::uint64_t entry, const std::size_t shift) {
+      return static_cast<std::size_t>(((entry & TABLEAU_MASK) >> shift) &
+                                      (RADIX - 1U));
+    };
+    std::vector<std::uint64_t> buffer(candidates.size());
+    std::vector<std::size_t> offsets(RADIX + 1U);
+    for (std::size_t shift = 0U; shift < STEP_SHIFT; shift += RADIX_BITS) {
+      std::fill(offsets.begin(), offsets.end(), 0U);
+      for (const auto entry : candidates) {
+        ++offsets[digit(entry, shift) + 1U];
+      }
+      if (std::find(offsets.begin(), offsets.end(), candidates.size()) !=
+          offsets.end()) {
+        continue;
+      }
+      std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+      for (const auto entry : candidates) {
+        buffer[offsets[digit(entry, shift)]++] = entry;
+      }
+      candidates.swap(buffer);
+    }
+  }
+  // the fewest gates come first for every tableau
+  const auto sameTableau = [](const std::uint64_t a, const std::uint64_t b) {
+    return tableauOf(a) == tableauOf(b);
+  };
+  candidates.erase(
+      std::unique(candidates.begin(), candidates.end(), sameTableau),
+      candidates.end());
+}
+
+void CliffordDatabase::removeKnown(std::vector<std::uint64_t>& candidates,
+                                   const std::vector<std::uint64_t>& known) {
+  const auto less = [](const std::uint64_t entry, const std::uint64_t value) {
+    return (entry & TABLEAU_MASK) < value;
+  };
+  std::size_t kept = 0U;
+  std::size_t pos = 0U;
+  for (const auto candidate : candidates) {
+    const auto tableau = tableauOf(candidate);
+    // galloping search, since there are often far fewer candidates than known
+    // tableaus
+    std::size_t bound = 1U;
+    while (pos + bound < known.size() && less(known[pos + bound], tableau)) {
+      pos += bound;
+      bound *= 2U;
+    }
+    const auto last = known.begin() + static_cast<std::ptrdiff_t>(std::min(
+                                          pos + bound + 1U, known.size()));
+    pos = static_cast<std::size_t>(
+        std::lower_bound(known.begin() + static_cast<std::ptrdiff_t>(pos),
+                         last, tableau, less) -
+        known.begin());
+    if (pos == known.size() || (known[pos] & TABLEAU_MASK) != tableau) {
+      candidates[kept++] = candidate;
+    }
+  }
+  candidates.resize(kept);
+}
+
+void CliffordDatabase::settle(const std::vector<std::uint64_t>& candidates) {
+  const auto settled = static_cast<std::ptrdiff_t>(entries.size());
+  for (const auto c : candidates) {
+    entries.emplace_back(tableauOf(c) | (c & ~TABLEAU_MASK));
+  }
+  std::inplace_merge(entries.begin(), entries.begin() + settled, entries.end(),
+                     [](const std::uint64_t a, const std::uint64_t b) {
+                       return (a & TABLEAU_MASK) < (b & TABLEAU_MASK);
+                     });
+}
+
+std::vector<std::uint64_t>
+CliffordDatabase::expand(const std::vector<std::uint64_t>& from,
+                         const std::vector<std::size_t>& stepIndices) const {
+  // Successors are generated in chunks that are deduplicated and filtered
+  // right away. The result is only compacted once it has doubled in size.
+  std::vector<std::uint64_t> result;
+  std::vector<std::uint64_t> chunk;
+  std::size_t compacted = 0U;
+  if (stepIndices.empty()) {
+    return result;
+  }
+  const auto chunkSize =
+      std::max<std::size_t>(1U, MAX_CANDIDATES / stepIndices.size());
+  for (std::size_t begin = 0U; begin < from.size(); begin += chunkSize) {
+    const auto end = std::min(begin + chunkSize, from.size());
+    for (std::size_t i = begin; i < end; ++i) {
+      const auto tableau = tableauOf(from[i]);
+      const auto gates = from[i] & GATE_MASK;
+      for (const auto s : stepIndices) {
+        chunk.emplace_back(candidate(apply(tableau, steps[s], false),
+                                     gates + steps[s].size(), s));
+      }
+    }
+    sortUnique(chunk);
+    removeKnown(chunk, entries);
+    result.insert(result.end(), chunk.begin(), chunk.end());
+    chunk.clear();
+    if (result.size() > 2U * compacted) {
+      sortUnique(result);
+      compacted = result.size();
+    }
+  }
+  sortUnique(result);
+  return result;
+}
+
+CliffordDatabase CliffordDatabase::generate(const std::size_t nQubits,
+                                            const bool destabilizers,
+                                            const TargetMetric metric) {
+  if (nQubits == 0U || nQubits > MAX_QUBITS) {
+    throw std::invalid_argument(
+        "Clifford databases support between 1 and " +
+        std::to_string(MAX_QUBITS) + " qubits");
+  }
+  CliffordDatabase db(nQubits, destabilizers, metric);
+
+  // Every step increases the target metric by one, except for single-qubit
+  // gates when counting two-qubit gates. The former lead to the next level,
+  // the latter stay within it.
+  std::vector<std::size_t> levelSteps;
+  std::vector<std::size_t> innerSteps;
+  for (std::size_t s = 0U; s < db.steps.size(); ++s) {
+    const auto& [gate, qubits] = db.steps[s].front();
+    if (metric == TargetMetric::TwoQubitGates &&
+        qubits.first == qubits.second) {
+      innerSteps.emplace_back(s);
+    } else {
+      levelSteps.emplace_back(s);
+    }
+  }
+
+  // Search level by level over the target metric with the sorted entries as
+  // the only visited set. An optimal circuit for a tableau of level l
+  // consists of an optimal circuit for a tableau of level l - 1 followed by a
+  // level step and inner steps, so the fewest gates of a level follow from
+  // the previous level alone. Within a level, the tableaus are settled in the
+  // order of their gate count. Ties are broken by the order in which the
+  // candidates are generated, so the table is deterministic.
+  std::vector<std::uint64_t> seeds{
+      candidate(pack(Tableau(nQubits, destabilizers)), 0U, NO_STEP)};
+  while (!seeds.empty()) {
+    removeKnown(seeds, db.entries);
+    if (innerSteps.empty()) {
+      db.settle(seeds);
+      seeds = db.expand(seeds, levelSteps);
+      continue;
+    }
+    std::stable_sort(seeds.begin(), seeds.end(),
+                     [](const std::uint64_t a, const std::uint64_t b) {
+                       return (a & GATE_MASK) < (b & GATE_MASK);
+                     });
+    std::vector<std::uint64_t> level;
+    std::vector<std::uint64_t> current;
+    auto next = seeds.begin();
+    for (auto gates = seeds.empty() ? 0U : seeds.front() & GATE_MASK;
+         next != seeds.end() || !current.empty(); ++gates) {
+      // the seeds with this many gates join the successors within the level
+      for (; next != seeds.end() && (*next & GATE_MASK) == gates; ++next) {
+        current.emplace_back(*next);
+      }
+      sortUnique(current);
+      removeKnown(current, db.entries);
+      db.settle(current);
+      level.insert(level.end(), current.begin(), current.end());
+      current = db.expand(current, innerSteps);
+    }
+    seeds = db.expand(level, levelSteps);
+  }
+  return db;
+}
+
+void CliffordDatabase::save(const std::string& filename) const {
+  std::ofstream os(filename, std::ios::binary);
+  if (!os.good()) {
+    throw std::runtime_error("Could not write Clifford database to " +
+                             filename);
+  }
+  const std::array<char, 4> header = {static_cast<char>(nQubits),
+                                      static_cast<char>(destabilizers),
+                                      static_cast<char>(metric), 0};
+  const auto count = static_cast<std::uint64_t>(entries.size());
+  os.write(MAGIC.data(), MAGIC.size());
+  os.write(header.data(), header.size());
+  writeWords(os, &count, 1U);
+  writeWords(os, entries.data(), entries.size());
+}
+
+CliffordDatabase CliffordDatabase::load(const std::string& filename) {
+  std::ifstream is(filename, std::ios::binary);
+  std::array<char, MAGIC.size()> magic{};
+  std::array<char, 4> header{};
+  std::uint64_t count = 0U;
+  is.read(magic.data(), magic.size());
+  is.read(header.data(), header.size());
+  if (!readWords(is, &count, 1U) || magic != MAGIC || header[0] <= 0 ||
+      static_cast<std::size_t>(header[0]) > MAX_QUBITS || header[2] < 0 ||
+      header[2] > static_cast<char>(TargetMetric::Depth)) {
+    throw std::runtime_error(filename + " is not a Clifford database");
+  }
+  CliffordDatabase db(static_cast<std::size_t>(header[0]), header[1] != 0,
+                      static_cast<TargetMetric>(header[2]));
+  db.entries.resize(count);
+  if (!readWords(is, db.entries.data(), count)) {
+    throw std::runtime_error("Clifford database " + filename +
+                             " is truncated");
+  }
+  return db;
+}
+
+std::string CliffordDatabase::filename(const std::size_t nQubits,
+                                       const bool destabilizers,
+                                       const TargetMetric metric) {
+  return "clifford_" + std::to_string(nQubits) + "_" +
+         (destabilizers ? "full" : "stabilizers") + "_" + toString(metric) +
+         ".db";
+}
+
+const CliffordDatabase* CliffordDatabase::get(const std::size_t nQubits,
+                                              const bool destabilizers,
+                                              const TargetMetric metric,
+                                              const std::string& directory) {
+  if (nQubits == 0U || nQubits > MAX_QUBITS ||
+      (nQubits > GENERATED_QUBITS && directory.empty())) {
+    return nullptr;
+  }
+  static std::mutex mutex;
+  static std::map<std::tuple<std::size_t, bool, TargetMetric, std::string>,
+                  std::unique_ptr<CliffordDatabase>>
+      databases;
+  // generated tables do not depend on the directory
+  const auto key = std::tuple{nQubits, destabilizers, metric,
+                              nQubits > GENERATED_QUBITS ? directory : ""};
+  const std::lock_guard lock(mutex);
+  if (const auto it = databases.find(key); it != databases.end()) {
+    return it->second.get();
+  }
+  auto& db = databases[key];
+  if (nQubits <= GENERATED_QUBITS) {
+    db = std::make_unique<CliffordDatabase>(
+        generate(nQubits, destabilizers, metric));
+  } else if (const auto file = std::filesystem::path(directory) /
+                               filename(nQubits, destabilizers, metric);
+             std::filesystem::exists(file)) {
+    db = std::make_unique<CliffordDatabase>(load(file.string()));
+  }
+  return db.get();
+}
+
+std::optional<std::uint64_t>
+CliffordDatabase::findStep(const std::uint64_t tableau) const {
+  const auto mask = (std::uint64_t{1} << STEP_SHIFT) - 1U;
+  const auto it = std::lower_bound(
+      entries.begin(), entries.end(), tableau,
+      [mask](const std::uint64_t entry, const std::uint64_t value) {
+        return (entry & mask) < value;
+      });
+  if (it == entries.end() || (*it & mask) != tableau) {
+    return std::nullopt;
+  }
+  return *it >> STEP_SHIFT;
+}
+
+std::optional<qc::QuantumComputation>
+CliffordDatabase::lookup(const Tableau& target) const {
+  const auto rows = destabilizers ? 2U * nQubits : nQubits;
+  if (target.getQubitCount() != nQubits || target.getTableauSize() != rows) {
+    return std::nullopt;
+  }
+  // undo the last step until the identity is reached
+  auto tableau = pack(target);
+  std::vector<std::size_t> path;
+  while (true) {
+    const auto step = findStep(tableau);
+    if (!step) {
+      return std::nullopt;
+    }
+    if (*step == NO_STEP) {
+      break;
+    }
+    // every step strictly reduces the cost, longer paths mean a corrupt table
+    if (path.size() == entries.size() || *step >= steps.size()) {
+      return std::nullopt;
+    }
+    path.emplace_back(*step);
+    tableau = apply(tableau, steps[*step], true);
+  }
+
+  qc::QuantumComputation qc(nQubits);
+  for (auto it = path.rbegin(); it != path.rend(); ++it) {
+    for (const auto& [gate, qubits] : steps[*it]) {
+      const auto first = static_cast<qc::Qubit>(qubits.first);
+      const auto second = static_cast<qc::Qubit>(qubits.second);
+      if (first != second) {
+        qc.cx(qc::Control{first}, second);
+        continue;
+      }
+      switch (gate) {
+      case qc::OpType::X:
+        qc.x(first);
+        break;
+      case qc::OpType::Y:
+        qc.y(first);
+        break;
+      case qc::OpType::Z:
+        qc.z(first);
+        break;
+      case qc::OpType::H:
+        qc.h(first);
+        break;
+      case qc::OpType::S:
+        qc.s(first);
+        break;
+      default:
+        qc.sdg(first);
+        break;
+      }
+    }
+  }
+  return qc;
+}
+
+} // namespace cs
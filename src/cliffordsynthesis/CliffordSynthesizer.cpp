@@ -5,9 +5,13 @@
 
 #include "cliffordsynthesis/CliffordSynthesizer.hpp"
 
+#include "cliffordsynthesis/CliffordDatabase.hpp"
 #include "cliffordsynthesis/Configuration.hpp"
+#include "cliffordsynthesis/Peephole.hpp"
+#include "cliffordsynthesis/SynthesisCache.hpp"
 #include "cliffordsynthesis/Tableau.hpp"
 #include "cliffordsynthesis/TargetMetric.hpp"
+#include "cliffordsynthesis/encoding/QubitPairPruning.hpp"
 #include "cliffordsynthesis/encoding/SATEncoder.hpp"
 #include "ir/QuantumComputation.hpp"
 #include "ir/operations/CompoundOperation.hpp"
@@ -15,28 +19,36 @@
 #include "qasm3/Importer.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <exception>
 #include <fstream>
-#include <future>
 #include <memory>
+#include <numeric>
+#include <optional>
 #include <plog/Appenders/ConsoleAppender.h>
 #include <plog/Formatters/TxtFormatter.h>
 #include <plog/Init.h>
 #include <plog/Log.h>
 #include <plog/Logger.h>
 #include <plog/Severity.h>
+#include <set>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <utility>
+#include <variant>
 #include <vector>
 
 namespace cs {
 
 void CliffordSynthesizer::synthesize(const Configuration& config) {
   configuration = config;
+  conclusive = true;
 
   // initialize logging
   if (plog::get() == nullptr) {
@@ -58,9 +70,17 @@ void CliffordSynthesizer::synthesize(const Configuration& config) {
   encoderConfig.targetMetric = configuration.target;
   encoderConfig.useMaxSAT = configuration.useMaxSAT;
   encoderConfig.useSymmetryBreaking = configuration.useSymmetryBreaking;
+  encoderConfig.gateLimitEncoding = configuration.gateLimitEncoding;
   encoderConfig.solverParameters = configuration.solverParameters;
+  if (configuration.dumpInstances) {
+    encoderConfig.instancesPath = configuration.instancesPath;
+  }
+  encoderConfig.couplingMap = configuration.couplingMap;
+  encoderConfig.pruneByInteraction = configuration.pruneByInteraction;
+  encoderConfig.twoQubitGateWindow = configuration.twoQubitGateWindow;
   encoderConfig.useMultiGateEncoding =
       requiresMultiGateEncoding(encoderConfig.targetMetric);
+  checkQubitPairPruning();
 
   if (configuration.heuristic) {
     if (initialCircuit->empty() && !targetTableau.isIdentityTableau()) {
@@ -70,6 +90,34 @@ void CliffordSynthesizer::synthesize(const Configuration& config) {
     return;
   }
 
+  // The database and the cache are keyed by the target alone, so they only
+  // apply to syntheses that start from the identity. Neither knows about
+  // restricted qubit pairs.
+  const bool fromIdentity =
+      initialTableau == Tableau(initialTableau.getQubitCount(),
+                                initialTableau.hasDestabilizers());
+  if (fromIdentity && configuration.useDatabase &&
+      configuration.couplingMap.empty() && loadFromDatabase()) {
+    const std::chrono::duration<double> diff =
+        std::chrono::high_resolution_clock::now() - start;
+    results.setRuntime(diff.count());
+    return;
+  }
+  std::optional<CanonicalTableau> canonical{};
+  std::string cacheKey{};
+  if (fromIdentity && configuration.cache != nullptr &&
+      !configuration.prunesQubitPairs()) {
+    canonical.emplace(targetTableau);
+    cacheKey = SynthesisCache::key(*canonical, configuration,
+                                   initialTableau.hasDestabilizers());
+    if (loadFromCache(*canonical, cacheKey)) {
+      const std::chrono::duration<double> diff =
+          std::chrono::high_resolution_clock::now() - start;
+      results.setRuntime(diff.count());
+      return;
+    }
+  }
+
   // First, determine an initial guess for the number of timesteps. This can
   // either be specified as a configuration parameter or starts at 1.
   determineInitialTimestepLimit(encoderConfig);
@@ -117,11 +165,127 @@ void CliffordSynthesizer::synthesize(const Configuration& config) {
   }
 
   results.setSolverCalls(solverCalls);
+  results.setSolverStatistics(solverStatistics);
 
   const auto end = std::chrono::high_resolution_clock::now();
   const std::chrono::duration<double> diff = end - start;
   PLOG_INFO << "Synthesis took " << diff.count() << " seconds";
   results.setRuntime(diff.count());
+
+  // results of inconclusive searches might not be optimal
+  if (canonical && conclusive && results.sat()) {
+    storeInCache(*canonical, cacheKey);
+  }
+}
+
+void CliffordSynthesizer::checkQubitPairPruning() {
+  if (configuration.twoQubitGateWindow == 1U) {
+    throw std::invalid_argument(
+        "A window of a single qubit does not permit any two-qubit gate.");
+  }
+  if (!configuration.prunesQubitPairs()) {
+    return;
+  }
+
+  const auto n = initialTableau.getQubitCount();
+  for (const auto& [q1, q2] : configuration.couplingMap) {
+    if (q1 >= n || q2 >= n) {
+      throw std::invalid_argument(
+          "The coupling map contains a qubit that is not part of the tableau.");
+    }
+  }
+  // qubits that interact have to be connected by the pairs that remain over
+  // one cycle of the window (after which the masks repeat), otherwise the
+  // search for an upper bound would never terminate
+  const auto components =
+      encoding::interactionComponents(initialTableau, targetTableau);
+  const auto window = configuration.twoQubitGateWindow;
+  const auto cycle = window == 0U || window >= n ? 1U : n - window + 1U;
+  const auto masks = encoding::createQubitPairMasks(
+      n, cycle, configuration.couplingMap,
+      configuration.pruneByInteraction ? components
+                                       : std::vector<std::size_t>{},
+      window);
+  if (!encoding::connectsComponents(masks, components)) {
+    throw std::invalid_argument("The target cannot be reached with the given "
+                                "coupling map and two-qubit gate window.");
+  }
+
+  if (configuration.couplingMap.empty() || !results.sat() ||
+      initialCircuit == nullptr) {
+    return;
+  }
+  const auto coupled = [this](const std::size_t q1, const std::size_t q2) {
+    return configuration.couplingMap.count({q1, q2}) != 0U ||
+           configuration.couplingMap.count({q2, q1}) != 0U;
+  };
+  for (const auto& op : *initialCircuit) {
+    const auto qubits = op->getUsedQubits();
+    if (qubits.size() < 2U) {
+      continue;
+    }
+    if (qubits.size() > 2U || !coupled(*qubits.begin(), *qubits.rbegin())) {
+      PLOG_INFO << "The initial circuit does not respect the coupling map and "
+                   "is not used as an upper bound.";
+      results = Results();
+      return;
+    }
+  }
+}
+
+bool CliffordSynthesizer::loadFromDatabase() {
+  if (initialTableau.hasDestabilizers() != targetTableau.hasDestabilizers()) {
+    return false;
+  }
+  const auto* const db = CliffordDatabase::get(
+      targetTableau.getQubitCount(), targetTableau.hasDestabilizers(),
+      configuration.target, configuration.databasePath);
+  if (db == nullptr) {
+    return false;
+  }
+  auto circuit = db->lookup(targetTableau);
+  if (!circuit) {
+    return false;
+  }
+  results = Results(*circuit, targetTableau);
+  PLOG_INFO << "Using optimal circuit from the database with depth "
+            << results.getDepth() << " and " << results.getGates()
+            << " gate(s)";
+  return true;
+}
+
+bool CliffordSynthesizer::loadFromCache(const CanonicalTableau& canonical,
+                                        const std::string& key) {
+  const auto entry = configuration.cache->lookup(key);
+  if (!entry) {
+    return false;
+  }
+  PLOG_INFO << "Using cached result with depth " << entry->depth << " and "
+            << entry->singleQubitGates + entry->twoQubitGates << " gate(s)";
+  auto circuit = qasm3::Importer::imports(entry->circuit);
+  canonical.fromCanonical(circuit);
+  results.setResultCircuit(circuit);
+  results.setResultTableau(targetTableau);
+  results.setSingleQubitGates(entry->singleQubitGates);
+  results.setTwoQubitGates(entry->twoQubitGates);
+  results.setDepth(entry->depth);
+  results.setSolverResult(logicbase::Result::SAT);
+  results.setSolverCalls(0U);
+  return true;
+}
+
+void CliffordSynthesizer::storeInCache(const CanonicalTableau& canonical,
+                                       const std::string& key) const {
+  auto circuit = qasm3::Importer::imports(results.getResultCircuit());
+  canonical.toCanonical(circuit);
+  std::stringstream ss;
+  circuit.dumpOpenQASM(ss);
+  CacheEntry entry;
+  entry.circuit = ss.str();
+  entry.singleQubitGates = results.getSingleQubitGates();
+  entry.twoQubitGates = results.getTwoQubitGates();
+  entry.depth = results.getDepth();
+  configuration.cache->store(key, entry);
 }
 
 void CliffordSynthesizer::initResultCircuitFromResults() {
@@ -229,7 +393,8 @@ void CliffordSynthesizer::gateOptimalSynthesis(EncoderConfig config,
     // The binary search approach calls the SAT solver repeatedly with varying
     // timestep (=gate) limits T until a solution with T gates is found, but no
     // solution with T-1 gates could be determined.
-    runBinarySearch(config.timestepLimit, lower, upper, config);
+    runBinarySearch(config.timestepLimit, lower, upper, config,
+                    &Results::getGates);
   }
 }
 
@@ -256,7 +421,8 @@ void CliffordSynthesizer::depthOptimalSynthesis(
     // The binary search approach calls the SAT solver repeatedly with varying
     // timestep (=depth) limits T until a solution with depth T is found, but no
     // solution with depth T-1 could be determined.
-    runBinarySearch(config.timestepLimit, lower, upper, config);
+    runBinarySearch(config.timestepLimit, lower, upper, config,
+                    &Results::getDepth);
   }
 
   if (configuration.minimizeGatesAfterDepthOptimization) {
@@ -292,10 +458,13 @@ void CliffordSynthesizer::minimizeGatesFixedDepth(EncoderConfig config) {
 
   if (config.useMaxSAT) {
     runMaxSAT(config);
+  } else if (configuration.incrementalSearch) {
+    config.gateLimit.reset();
+    runIncrementalBinarySearch(results.getDepth(), results.getGates(), config);
   } else {
     config.gateLimit = results.getGates();
     runBinarySearch(*config.gateLimit, results.getDepth(), results.getGates(),
-                    config);
+                    config, &Results::getGates);
   }
   PLOG_INFO << "Found a depth " << results.getDepth() << " circuit with "
             << results.getGates() << " gate(s).";
@@ -325,8 +494,14 @@ void CliffordSynthesizer::twoQubitGateOptimalSynthesis(
     // The binary search approach calls the SAT solver repeatedly with varying
     // two-qubit gate count limits G until a solution with G two-qubit gates is
     // found, but no solution with G-1 two-qubit gates could be determined.
-    config.twoQubitGateLimit = upper;
-    runBinarySearch(*config.twoQubitGateLimit, lower, upper, config);
+    if (configuration.incrementalSearch) {
+      config.twoQubitGateLimit.reset();
+      runIncrementalBinarySearch(lower, upper, config, false);
+    } else {
+      config.twoQubitGateLimit = upper;
+      runBinarySearch(*config.twoQubitGateLimit, lower, upper, config,
+                      &Results::getTwoQubitGates);
+    }
   }
 
   // To find a solution with even fewer two-qubit gates but more gates overall,
@@ -398,7 +573,7 @@ void CliffordSynthesizer::minimizeGatesFixedTwoQubitGateCount(
     runMaxSAT(config);
   } else {
     runBinarySearch(config.timestepLimit, results.getTwoQubitGates(),
-                    results.getGates(), config);
+                    results.getGates(), config, &Results::getGates);
   }
   PLOG_INFO << "Found a circuit with " << results.getTwoQubitGates()
             << " two-qubit gate(s) and " << results.getGates()
@@ -417,10 +592,90 @@ void CliffordSynthesizer::runMaxSAT(const EncoderConfig& config) {
   updateResults(configuration, r, results);
 }
 
+void CliffordSynthesizer::runIncrementalBinarySearch(
+    std::size_t lowerBound, std::size_t upperBound, const EncoderConfig& config,
+    const bool includeSingleQubitGates) {
+  PLOG_INFO << "Running incremental binary search in range [" << lowerBound
+            << ", " << upperBound << ")";
+
+  // The formulation is only created once. Each probe adds its gate limit in a
+  // separate solver scope, so learned clauses carry over to the next probe.
+  auto limited = config;
+  if (!limitToDeadline(limited)) {
+    conclusive = false;
+    return;
+  }
+  auto encoder = encoding::SATEncoder(limited);
+  encoder.prepare(upperBound, includeSingleQubitGates);
+  while (lowerBound != upperBound) {
+    if (deadline && std::chrono::steady_clock::now() >= *deadline) {
+      PLOG_INFO << "Deadline reached. Keeping the best solution so far.";
+      conclusive = false;
+      break;
+    }
+    const auto value = (lowerBound + upperBound) / 2;
+    PLOG_INFO << "Trying value " << value << " in range [" << lowerBound
+              << ", " << upperBound << ")";
+    ++solverCalls;
+    const auto r = encoder.runWithGateLimit(value);
+    conclusive = conclusive && (r.sat() || r.unsat());
+    dumpIntermediateResult(r);
+    updateResults(configuration, r, results);
+    if (r.sat()) {
+      const auto achieved = includeSingleQubitGates ? r.getGates()
+                                                    : r.getTwoQubitGates();
+      upperBound = std::max(lowerBound, std::min(value, achieved));
+      PLOG_INFO << "Found solution. New upper bound is " << upperBound;
+    } else {
+      lowerBound = value + 1;
+      PLOG_INFO << "No solution found. New lower bound is " << lowerBound;
+    }
+  }
+  solverStatistics += encoder.getStatistics();
+  encoder.cleanup();
+  if (lowerBound == upperBound) {
+    PLOG_INFO << "Found optimum: " << lowerBound;
+  }
+}
+
 Results CliffordSynthesizer::callSolver(const EncoderConfig& config) {
+  auto limited = config;
+  if (!limitToDeadline(limited)) {
+    // an undecided result keeps the best circuit found so far
+    conclusive = false;
+    return {};
+  }
   ++solverCalls;
-  auto encoder = encoding::SATEncoder(config);
+  auto encoder = encoding::SATEncoder(limited);
   const auto res = encoder.run();
+  conclusive = conclusive && (res.sat() || res.unsat());
+  solverStatistics += res.getSolverStatistics();
+  dumpIntermediateResult(res);
+  return res;
+}
+
+bool CliffordSynthesizer::limitToDeadline(EncoderConfig& config) const {
+  if (!deadline) {
+    return true;
+  }
+  const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                             *deadline - std::chrono::steady_clock::now())
+                             .count();
+  if (remaining <= 0) {
+    PLOG_INFO << "Deadline reached. Skipping further solver calls.";
+    return false;
+  }
+  auto timeout = static_cast<std::uint32_t>(remaining);
+  if (const auto it = config.solverParameters.find("timeout");
+      it != config.solverParameters.end() &&
+      std::holds_alternative<std::uint32_t>(it->second)) {
+    timeout = std::min(timeout, std::get<std::uint32_t>(it->second));
+  }
+  config.solverParameters["timeout"] = timeout;
+  return true;
+}
+
+void CliffordSynthesizer::dumpIntermediateResult(const Results& res) const {
   if (configuration.dumpIntermediateResults && res.sat()) {
     const auto filename = configuration.intermediateResultsPath +
                           "intermediate_" + std::to_string(solverCalls) +
@@ -430,7 +685,6 @@ Results CliffordSynthesizer::callSolver(const EncoderConfig& config) {
     file << res.getResultCircuit();
     file.close();
   }
-  return res;
 }
 
 void CliffordSynthesizer::updateResults(const Configuration& config,
@@ -513,51 +767,200 @@ void CliffordSynthesizer::depthHeuristicSynthesis() {
   if (initialCircuit->getDepth() == 0) {
     return;
   }
+  const auto start = std::chrono::steady_clock::now();
   auto optimalConfig = configuration;
   optimalConfig.heuristic = false;
   optimalConfig.target = TargetMetric::Depth;
   optimalConfig.initialTimestepLimit = configuration.splitSize;
 
-  initialCircuit->reorderOperations();
-  qc::QuantumComputation optCircuit{initialCircuit->getNqubits()};
-  const std::vector<std::size_t>& layers = getLayers(*initialCircuit);
+  // The first pass uses windows aligned to the start of the circuit. Further
+  // passes alternate with windows shifted by half the window size, so that
+  // gates next to a previous window boundary can be optimized together.
+  auto current = heuristicPass(initialCircuit, 0U, optimalConfig);
+  const auto shift = configuration.splitSize / 2U;
+  for (std::size_t pass = 1U;
+       shift != 0U && (configuration.heuristicPasses == 0U ||
+                       pass < configuration.heuristicPasses);
+       ++pass) {
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    if (configuration.heuristicTimeBudget > 0. &&
+        elapsed.count() >= configuration.heuristicTimeBudget) {
+      PLOG_INFO << "Time budget exhausted after " << pass << " pass(es)";
+      break;
+    }
+    if (current->getDepth() == 0U) {
+      break;
+    }
+    auto refined =
+        heuristicPass(current, pass % 2U == 1U ? shift : 0U, optimalConfig);
+    PLOG_INFO << "Depth after pass " << pass << ": " << current->getDepth()
+              << " -> " << refined->getDepth();
+    if (refined->getDepth() >= current->getDepth()) {
+      break;
+    }
+    current = std::move(refined);
+  }
 
-  std::vector<std::future<std::shared_ptr<qc::QuantumComputation>>> subCircuits;
-  for (std::size_t i = 0; i < layers.size() - 1; i += configuration.splitSize) {
-    std::size_t const startIdx = layers[i];
-    std::size_t endIdx = 0;
+  results.setDepth(current->getDepth());
+  results.setResultCircuit(*current);
+}
 
-    if (i + configuration.splitSize >= layers.size()) {
-      endIdx = layers.back();
-    } else {
-      endIdx = layers[i + configuration.splitSize];
+std::shared_ptr<qc::QuantumComputation>
+CliffordSynthesizer::heuristicPass(
+    const std::shared_ptr<qc::QuantumComputation>& circuit,
+    const std::size_t offset, const Configuration& config) {
+  circuit->reorderOperations();
+  const std::vector<std::size_t>& layers = getLayers(*circuit);
+
+  // window boundaries in terms of layers, the first window may be shorter
+  std::vector<std::size_t> boundaries{0U};
+  for (auto i = std::min(offset, layers.size() - 1U); i < layers.size() - 1U;
+       i += configuration.splitSize) {
+    if (i != 0U) {
+      boundaries.emplace_back(i);
+    }
+  }
+  boundaries.emplace_back(layers.size() - 1U);
+
+  std::vector<std::pair<std::size_t, std::size_t>> blocks;
+  for (std::size_t i = 0U; i + 1U < boundaries.size(); ++i) {
+    blocks.emplace_back(layers[boundaries[i]], layers[boundaries[i + 1U]]);
+  }
+
+  // Blocks with more gates tend to take longer, so they are started first to
+  // avoid a single large block running on its own at the end.
+  std::vector<std::size_t> order(blocks.size());
+  std::iota(order.begin(), order.end(), 0U);
+  std::stable_sort(order.begin(), order.end(),
+                   [&blocks](const std::size_t a, const std::size_t b) {
+                     return blocks[a].second - blocks[a].first >
+                            blocks[b].second - blocks[b].first;
+                   });
+
+  // Workers pull the next block from a shared counter. The results are stored
+  // per block, so the assembled circuit does not depend on the scheduling.
+  std::vector<std::shared_ptr<qc::QuantumComputation>> subCircuits(
+      blocks.size());
+  std::vector<std::exception_ptr> errors(blocks.size());
+  std::atomic<std::size_t> next{0U};
+  const auto worker = [&circuit, &blocks, &order, &subCircuits, &errors,
+                       &next, &config]() {
+    for (auto i = next++; i < order.size(); i = next++) {
+      const auto block = order[i];
+      try {
+        subCircuits[block] = synthesizeSubcircuit(
+            circuit, blocks[block].first, blocks[block].second, config);
+      } catch (...) {
+        errors[block] = std::current_exception();
+      }
+    }
+  };
+
+  const auto nThreads = std::min(
+      std::max<std::size_t>(configuration.nThreadsHeuristic, 1U),
+      blocks.size());
+  PLOG_INFO << "Synthesizing " << blocks.size() << " blocks with " << nThreads
+            << " thread(s)";
+  std::vector<std::thread> threads;
+  threads.reserve(nThreads - 1U);
+  for (std::size_t i = 1U; i < nThreads; ++i) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (const auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
     }
-
-    // launch threads
-    subCircuits.emplace_back(
-        std::async(std::launch::async | std::launch::deferred,
-                   [this, startIdx, endIdx, &optimalConfig]() {
-                     return cs::CliffordSynthesizer::synthesizeSubcircuit(
-                         initialCircuit, startIdx, endIdx, optimalConfig);
-                   }));
   }
 
+  auto optCircuit =
+      std::make_shared<qc::QuantumComputation>(circuit->getNqubits());
   for (auto& subCircuit : subCircuits) {
-    const auto& circ = subCircuit.get();
-    for (auto& it : *circ) {
-      optCircuit.emplace_back(std::move(it));
+    for (auto& it : *subCircuit) {
+      optCircuit->emplace_back(std::move(it));
     }
   }
-  results.setDepth(optCircuit.getDepth());
-
-  results.setResultCircuit(optCircuit);
+  return optCircuit;
 }
+
 std::shared_ptr<qc::QuantumComputation>
 CliffordSynthesizer::synthesizeSubcircuit(
     const std::shared_ptr<qc::QuantumComputation>& qc, std::size_t begin,
     std::size_t end, const Configuration& config) {
-  const Tableau subTargetTableau{*qc, begin, end, true};
-  CliffordSynthesizer synth(subTargetTableau);
+  // The time limit applies to the whole search for the block, not to each of
+  // its solver calls.
+  std::optional<std::chrono::steady_clock::time_point> deadline{};
+  if (config.heuristicTimeout != 0U) {
+    deadline = std::chrono::steady_clock::now() +
+               std::chrono::milliseconds(config.heuristicTimeout);
+  }
+
+  // Starting from the block's own gates bounds the search by the block's depth
+  // and keeps them as the result if every solver call runs into the timeout.
+  qc::QuantumComputation block{qc->getNqubits()};
+  std::size_t currentG = 0;
+  const auto addGate = [&block, &currentG, begin, end](const auto& gate) {
+    if (currentG >= begin && currentG < end) {
+      block.emplace_back(gate->clone());
+    }
+    ++currentG;
+  };
+  for (const auto& gate : *qc) {
+    if (const auto* const compOp =
+            dynamic_cast<const qc::CompoundOperation* const>(gate.get());
+        compOp != nullptr) {
+      for (const auto& subGate : *compOp) {
+        addGate(subGate);
+      }
+    } else {
+      addGate(gate);
+    }
+    if (currentG >= end) {
+      break;
+    }
+  }
+
+  // A block that only acts on a few qubits is synthesized on these qubits
+  // alone, so that it can be looked up in the database. Restricted qubit
+  // pairs refer to the qubits of the whole circuit and prevent this.
+  std::set<qc::Qubit> active{};
+  for (const auto& gate : block) {
+    const auto used = gate->getUsedQubits();
+    active.insert(used.begin(), used.end());
+  }
+  if (config.useDatabase && !config.prunesQubitPairs() &&
+      active.size() < block.getNqubits() &&
+      CliffordDatabase::get(active.size(), true, config.target,
+                            config.databasePath) != nullptr) {
+    std::vector<qc::Qubit> toActive(block.getNqubits());
+    std::vector<qc::Qubit> fromActive(active.begin(), active.end());
+    for (std::size_t q = 0U; q < fromActive.size(); ++q) {
+      toActive[fromActive[q]] = static_cast<qc::Qubit>(q);
+    }
+    qc::QuantumComputation restricted{active.size()};
+    for (auto& gate : block) {
+      restricted.emplace_back(std::move(gate));
+    }
+    relabelQubits(restricted, toActive);
+
+    CliffordSynthesizer synth(Tableau(active.size(), true), restricted);
+    synth.deadline = deadline;
+    synth.synthesize(config);
+    synth.initResultCircuitFromResults();
+    relabelQubits(*synth.resultCircuit, fromActive);
+    auto result = std::make_shared<qc::QuantumComputation>(qc->getNqubits());
+    for (auto& gate : *synth.resultCircuit) {
+      result->emplace_back(std::move(gate));
+    }
+    return result;
+  }
+
+  CliffordSynthesizer synth(Tableau(qc->getNqubits(), true), block);
+  synth.deadline = deadline;
   synth.synthesize(config);
 
   synth.initResultCircuitFromResults();
@@ -565,20 +968,9 @@ CliffordSynthesizer::synthesizeSubcircuit(
 }
 
 void CliffordSynthesizer::removeRedundantGates() {
-  Tableau prev = initialTableau;
-  Tableau curr = initialTableau;
   initResultCircuitFromResults();
-  qc::QuantumComputation reducedResult(resultCircuit->getNqubits());
-
-  for (auto& gate : *resultCircuit) {
-    curr.applyGate(gate.get());
-    if (prev != curr) {
-      prev.applyGate(gate.get());
-      reducedResult.emplace_back(std::move(gate));
-    }
-  }
-
-  results.setResultCircuit(reducedResult);
-  results.setSingleQubitGates(reducedResult.getNsingleQubitOps());
+  cs::removeRedundantGates(*resultCircuit, initialTableau);
+  results.setResultCircuit(*resultCircuit);
+  results.setSingleQubitGates(resultCircuit->getNsingleQubitOps());
 }
 } // namespace cs
@@ -0,0 +1,84 @@
+//
+// This file is part of the MQT QMAP library released under the MIT license.
+// See README.md or go to https://github.com/cda-tum/qmap for more information.
+//
+
+#include "cliffordsynthesis/Peephole.hpp"
+
+#include "cliffordsynthesis/Tableau.hpp"
+#include "ir/QuantumComputation.hpp"
+#include "ir/operations/OpType.hpp"
+#include "ir/operations/Operation.hpp"
+
+#include <cstddef>
+#include <utility>
+
+namespace cs {
+
+bool isSupportedCliffordGate(const qc::Operation& op) {
+  if (!op.isStandardOperation() || op.getNcontrols() > 1U) {
+    return false;
+  }
+  if (op.isControlled()) {
+    switch (op.getType()) {
+    case qc::OpType::X:
+    case qc::OpType::Y:
+    case qc::OpType::Z:
+      return true;
+    default:
+      return false;
+    }
+  }
+  switch (op.getType()) {
+  case qc::OpType::H:
+  case qc::OpType::S:
+  case qc::OpType::Sdg:
+  case qc::OpType::SX:
+  case qc::OpType::SXdg:
+  case qc::OpType::X:
+  case qc::OpType::Y:
+  case qc::OpType::Z:
+  case qc::OpType::SWAP:
+  case qc::OpType::iSWAP:
+  case qc::OpType::DCX:
+  case qc::OpType::ECR:
+    return true;
+  default:
+    return false;
+  }
+}
+
+std::size_t removeRedundantGates(qc::QuantumComputation& qc,
+                                 Tableau initial) {
+  // kept operations are compacted to the front and the rest erased at once
+  auto kept = qc.begin();
+  auto it = qc.begin();
+  for (; it != qc.end(); ++it) {
+    const auto& op = **it;
+    if (op.getType() == qc::OpType::Barrier) {
+      *kept++ = std::move(*it);
+      continue;
+    }
+    if (op.getType() == qc::OpType::I && !op.isControlled()) {
+      continue;
+    }
+    if (!isSupportedCliffordGate(op)) {
+      break;
+    }
+    if (initial.applyGateAndDetectChange(&op)) {
+      *kept++ = std::move(*it);
+    }
+  }
+  for (; it != qc.end(); ++it) {
+    *kept++ = std::move(*it);
+  }
+  const auto removed = static_cast<std::size_t>(qc.end() - kept);
+  qc.erase(kept, qc.end());
+  return removed;
+}
+
+std::size_t removeRedundantGates(qc::QuantumComputation& qc) {
+  return removeRedundantGates(qc, Tableau(qc.getNqubits()));
+}
+
+} // namespace cs
@@ -9,6 +9,7 @@
 #include "circuit_optimizer/CircuitOptimizer.hpp"
 #include "cliffordsynthesis/Tableau.hpp"
 #include "ir/QuantumComputation.hpp"
+#include "logicblocks/Statistics.hpp"
 
 #include <nlohmann/json.hpp>
 #include <ostream>
@@ -49,6 +50,7 @@ nlohmann::basic_json<> Results::json() const {
   resultJSON["depth"] = depth;
   resultJSON["runtime"] = runtime;
   resultJSON["solver_calls"] = solverCalls;
+  resultJSON["solver_statistics"] = solverStatistics;
 
   return resultJSON;
 }
@@ -0,0 +1,238 @@
+//
+// This file is part of the MQT QMAP library released under the MIT license.
+// See README.md or go to https://github.com/cda-tum/qmap for more information.
+//
+
+#include "cliffordsynthesis/SynthesisCache.hpp"
+
+#include "Definitions.hpp"
+#include "cliffordsynthesis/Configuration.hpp"
+#include "cliffordsynthesis/Tableau.hpp"
+#include "cliffordsynthesis/TargetMetric.hpp"
+#include "ir/QuantumComputation.hpp"
+#include "ir/operations/Control.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <numeric>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cs {
+
+namespace {
+// the tableau of the circuit with qubit q relabelled to permutation[q]
+Tableau permuteQubits(const Tableau& tableau,
+                      const std::vector<qc::Qubit>& permutation) {
+  const auto n = tableau.getQubitCount();
+  Tableau permuted(n, tableau.hasDestabilizers());
+  for (std::size_t row = 0U; row < tableau.getTableauSize(); ++row) {
+    const auto newRow = ((row / n) * n) + permutation[row % n];
+    for (std::size_t q = 0U; q < n; ++q) {
+      permuted.set(newRow, permutation[q], tableau.get(row, q));
+      permuted.set(newRow, n + permutation[q], tableau.get(row, n + q));
+    }
+    permuted.set(newRow, 2U * n, tableau.get(row, 2U * n));
+  }
+  return permuted;
+}
+
+// FNV-1a, so that file names do not change between builds and platforms
+std::uint64_t stableHash(const std::string& str) {
+  std::uint64_t hash = 14695981039346656037ULL;
+  for (const auto c : str) {
+    hash ^= static_cast<std::uint8_t>(c);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+// temporary files must not clash between concurrent writers
+std::atomic<std::size_t> tempCounter{0U};
+} // namespace
+
+void relabelQubits(qc::QuantumComputation& qc,
+                   const std::vector<qc::Qubit>& mapping) {
+  for (auto& op : qc) {
+    auto targets = op->getTargets();
+    for (auto& target : targets) {
+      target = mapping[target];
+    }
+    op->setTargets(targets);
+    if (op->isControlled()) {
+      qc::Controls controls{};
+      for (const auto& control : op->getControls()) {
+        controls.emplace(mapping[control.qubit], control.type);
+      }
+      op->setControls(controls);
+    }
+  }
+}
+
+CanonicalTableau::CanonicalTableau(const Tableau& target)
+    : tableau(target.toString()), permutation(target.getQubitCount()) {
+  const auto n = target.getQubitCount();
+  std::iota(permutation.begin(), permutation.end(), 0U);
+  // partial stabilizer tableaus have no row per qubit
+  if (n > CANONICAL_QUBIT_LIMIT ||
+      (target.getTableauSize() != n && !target.hasDestabilizers())) {
+    return;
+  }
+  auto candidate = permutation;
+  while (std::next_permutation(candidate.begin(), candidate.end())) {
+    auto str = permuteQubits(target, candidate).toString();
+    if (str < tableau) {
+      tableau = std::move(str);
+      permutation = candidate;
+    }
+  }
+}
+
+void CanonicalTableau::toCanonical(qc::QuantumComputation& qc) const {
+  relabelQubits(qc, permutation);
+}
+
+void CanonicalTableau::fromCanonical(qc::QuantumComputation& qc) const {
+  std::vector<qc::Qubit> inverse(permutation.size());
+  for (std::size_t q = 0U; q < permutation.size(); ++q) {
+    inverse[permutation[q]] = static_cast<qc::Qubit>(q);
+  }
+  relabelQubits(qc, inverse);
+}
+
+nlohmann::basic_json<> CacheEntry::json() const {
+  nlohmann::basic_json<> j;
+  j["circuit"] = circuit;
+  j["single_qubit_gates"] = singleQubitGates;
+  j["two_qubit_gates"] = twoQubitGates;
+  j["depth"] = depth;
+  return j;
+}
+
+CacheEntry CacheEntry::fromJson(const nlohmann::basic_json<>& j) {
+  CacheEntry entry;
+  entry.circuit = j.at("circuit").get<std::string>();
+  entry.singleQubitGates = j.at("single_qubit_gates").get<std::size_t>();
+  entry.twoQubitGates = j.at("two_qubit_gates").get<std::size_t>();
+  entry.depth = j.at("depth").get<std::size_t>();
+  return entry;
+}
+
+std::string SynthesisCache::key(const CanonicalTableau& target,
+                                const Configuration& config,
+                                const bool initialDestabilizers) {
+  std::ostringstream ss;
+  ss << toString(config.target) << ';' << config.minimalTimesteps << ';'
+     << initialDestabilizers << ';'
+     << config.minimizeGatesAfterDepthOptimization << ';'
+     << config.tryHigherGateLimitForTwoQubitGateOptimization << ';'
+     << config.gateLimitFactor << ';'
+     << config.minimizeGatesAfterTwoQubitGateOptimization;
+  // Two-qubit gate counts are only optimal for the timestep limit of the
+  // search, which is determined starting from the initial limit.
+  if (config.target == TargetMetric::TwoQubitGates) {
+    ss << ';' << config.initialTimestepLimit;
+  }
+  ss << '\n' << target.tableau;
+  return ss.str();
+}
+
+std::optional<CacheEntry> SynthesisCache::lookup(const std::string& key) {
+  auto entry = find(key);
+  if (entry) {
+    ++hits;
+  } else {
+    ++misses;
+  }
+  return entry;
+}
+
+void LRUSynthesisCache::store(const std::string& key,
+                              const CacheEntry& entry) {
+  const std::lock_guard lock(mutex);
+  if (const auto it = index.find(key); it != index.end()) {
+    it->second->second = entry;
+    entries.splice(entries.begin(), entries, it->second);
+    return;
+  }
+  if (capacity == 0U) {
+    return;
+  }
+  if (entries.size() >= capacity) {
+    index.erase(entries.back().first);
+    entries.pop_back();
+  }
+  entries.emplace_front(key, entry);
+  index.emplace(key, entries.begin());
+}
+
+std::size_t LRUSynthesisCache::size() const {
+  const std::lock_guard lock(mutex);
+  return entries.size();
+}
+
+std::optional<CacheEntry> LRUSynthesisCache::find(const std::string& key) {
+  const std::lock_guard lock(mutex);
+  const auto it = index.find(key);
+  if (it == index.end()) {
+    return std::nullopt;
+  }
+  entries.splice(entries.begin(), entries, it->second);
+  return it->second->second;
+}
+
+DiskSynthesisCache::DiskSynthesisCache(std::string dir)
+    : directory(std::move(dir)) {
+  std::filesystem::create_directories(directory);
+}
+
+std::string DiskSynthesisCache::filename(const std::string& key) const {
+  std::ostringstream ss;
+  ss << std::hex << std::setw(16) << std::setfill('0') << stableHash(key);
+  return (std::filesystem::path(directory) / (ss.str() + ".json")).string();
+}
+
+void DiskSynthesisCache::store(const std::string& key,
+                               const CacheEntry& entry) {
+  nlohmann::basic_json<> j;
+  j["key"] = key;
+  j["entry"] = entry.json();
+  const auto file = filename(key);
+  // readers only ever see complete files
+  const auto temp = file + ".tmp" + std::to_string(tempCounter++);
+  {
+    std::ofstream os(temp);
+    if (!os.good()) {
+      throw std::runtime_error("Could not write cache entry to " + temp);
+    }
+    os << j.dump();
+  }
+  std::filesystem::rename(temp, file);
+}
+
+std::optional<CacheEntry> DiskSynthesisCache::find(const std::string& key) {
+  std::ifstream is(filename(key));
+  if (!is.good()) {
+    return std::nullopt;
+  }
+  const auto j = nlohmann::basic_json<>::parse(is, nullptr, false);
+  // hash collisions are resolved by comparing the full key
+  if (j.is_discarded() || !j.contains("key") || j["key"] != key ||
+      !j.contains("entry")) {
+    return std::nullopt;
+  }
+  return CacheEntry::fromJson(j["entry"]);
+}
+
+} // namespace cs
@@ -11,11 +11,16 @@
 #include "ir/operations/Operation.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cctype>
+#include <charconv>
 #include <cstddef>
+#include <cstdint>
 #include <fstream>
+#include <initializer_list>
 #include <istream>
+#include <limits>
 #include <optional>
 #include <ostream>
 #include <plog/Log.h>
@@ -24,9 +29,20 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <system_error>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+// the AVX2 variants of the column updates are compiled via function
+// attributes (as the heuristic mapper's kernels), so that the library itself
+// does not have to be built with `-mavx2` and still runs on older CPUs
+#if (defined(__x86_64__) || defined(_M_X64)) &&                               \
+    (defined(__GNUC__) || defined(__clang__))
+#define QMAP_TABLEAU_AVX2 1
+#include <immintrin.h>
+#endif
+
 namespace cs {
 void Tableau::dump(const std::string& filename) const {
   auto of = std::ofstream(filename);
@@ -82,27 +98,188 @@ void parseLine(const std::string& line, char separator,
 }
 
 void Tableau::import(std::istream& is) {
-  tableau.clear();
+  // rows are bit-packed while reading and transposed into columns at the end
+  std::vector<WordType> rows{};
+  std::size_t rowWords = 0U;
+  nRows = 0U;
+  nColumns = 0U;
 
   std::string line;
-  std::vector<std::string> data{};
+  std::vector<std::string> entries{};
   char delimiter = '|';
 
   while (std::getline(is, line)) {
     if (line.find('|', 0) == std::string::npos) {
       delimiter = ';';
     }
-    tableau.emplace_back();
-    parseLine(line, delimiter, {'\"'}, {'\\', '\r', '\n', '\t'}, data);
-    for (const auto& datum : data) {
-      if (datum.empty()) {
-        continue;
+    parseLine(line, delimiter, {'\"'}, {'\\', '\r', '\n', '\t'}, entries);
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                 [](const auto& e) { return e.empty(); }),
+                  entries.end());
+    if (entries.empty()) {
+      continue;
+    }
+    if (nRows == 0U) {
+      nColumns = entries.size();
+      rowWords = (nColumns + WORD_BITS - 1U) / WORD_BITS;
+    } else if (entries.size() != nColumns) {
+      const auto* const msg = "Tableau::import: Tableau is not rectangular";
+      PLOG_FATAL << msg;
+      throw std::runtime_error(msg);
+    }
+    rows.resize(rows.size() + rowWords, 0U);
+    auto* const row = rows.data() + (nRows * rowWords);
+    for (std::size_t j = 0U; j < nColumns; ++j) {
+      if (std::stoul(entries[j]) != 0U) {
+        row[j / WORD_BITS] |= WordType{1} << (j % WORD_BITS);
+      }
+    }
+    ++nRows;
+  }
+
+  nWords = (nRows + WORD_BITS - 1U) / WORD_BITS;
+  data.assign(nColumns * nWords, 0U);
+  for (std::size_t i = 0U; i < nRows; ++i) {
+    const auto* const row = rows.data() + (i * rowWords);
+    for (std::size_t j = 0U; j < nColumns; ++j) {
+      if (((row[j / WORD_BITS] >> (j % WORD_BITS)) & 1U) != 0U) {
+        set(i, j, true);
+      }
+    }
+  }
+  nQubits = nColumns / 2U;
+}
+
+namespace {
+constexpr std::array<char, 8U> BINARY_MAGIC = {'Q', 'M', 'A', 'P',
+                                               'T', 'A', 'B', '1'};
+constexpr std::size_t WORD_BYTES = 8U;
+
+[[noreturn]] void binaryError(const std::string& msg) {
+  PLOG_FATAL << msg;
+  throw std::runtime_error(msg);
+}
+
+void writeWords(std::ostream& os, const std::uint64_t* words,
+                const std::size_t count) {
+  std::vector<char> bytes(count * WORD_BYTES);
+  for (std::size_t w = 0U; w < count; ++w) {
+    for (std::size_t b = 0U; b < WORD_BYTES; ++b) {
+      bytes[(w * WORD_BYTES) + b] =
+          static_cast<char>((words[w] >> (8U * b)) & 0xFFU);
+    }
+  }
+  os.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+void readWords(std::istream& is, std::uint64_t* words,
+               const std::size_t count) {
+  std::vector<char> bytes(count * WORD_BYTES);
+  if (!is.read(bytes.data(), static_cast<std::streamsize>(bytes.size()))) {
+    binaryError("Tableau::importBinary: Unexpected end of input");
+  }
+  for (std::size_t w = 0U; w < count; ++w) {
+    words[w] = 0U;
+    for (std::size_t b = 0U; b < WORD_BYTES; ++b) {
+      words[w] |= static_cast<std::uint64_t>(
+                      static_cast<unsigned char>(bytes[(w * WORD_BYTES) + b]))
+                  << (8U * b);
+    }
+  }
+}
+} // namespace
+
+void Tableau::dumpBinary(const std::string& filename) const {
+  auto of = std::ofstream(filename, std::ios::binary);
+  if (!of.good()) {
+    const auto msg = "Error opening file " + filename;
+    PLOG_FATAL << msg;
+    throw std::runtime_error(msg);
+  }
+  dumpBinary(of);
+}
+
+void Tableau::dumpBinary(std::ostream& os) const {
+  os.write(BINARY_MAGIC.data(), BINARY_MAGIC.size());
+  const std::array<std::uint64_t, 3U> header = {nQubits, nRows, nColumns};
+  writeWords(os, header.data(), header.size());
+  // one column at a time to bound the size of the byte buffer
+  for (std::size_t j = 0U; j < nColumns; ++j) {
+    writeWords(os, columnWords(j), nWords);
+  }
+}
+
+void Tableau::importBinary(const std::string& filename) {
+  auto is = std::ifstream(filename, std::ios::binary);
+  if (!is.good()) {
+    const auto msg = "Error opening file " + filename;
+    PLOG_FATAL << msg;
+    throw std::runtime_error(msg);
+  }
+  importBinary(is);
+}
+
+void Tableau::importBinary(std::istream& is) {
+  std::array<char, BINARY_MAGIC.size()> magic{};
+  if (!is.read(magic.data(), magic.size()) || magic != BINARY_MAGIC) {
+    binaryError("Tableau::importBinary: Not a binary tableau");
+  }
+  std::array<std::uint64_t, 3U> header{};
+  readWords(is, header.data(), header.size());
+  const auto [nq, rows, columns] = header;
+  if (columns != (2U * nq) + 1U || rows > 2U * nq) {
+    binaryError("Tableau::importBinary: Inconsistent tableau dimensions");
+  }
+  nQubits = nq;
+  nRows = rows;
+  nColumns = columns;
+  nWords = (nRows + WORD_BITS - 1U) / WORD_BITS;
+  data.assign(nColumns * nWords, 0U);
+  const auto unused = nRows % WORD_BITS == 0U
+                          ? WordType{0}
+                          : ~((WordType{1} << (nRows % WORD_BITS)) - 1U);
+  for (std::size_t j = 0U; j < nColumns; ++j) {
+    readWords(is, columnWords(j), nWords);
+    if (nWords != 0U && (columnWords(j)[nWords - 1U] & unused) != 0U) {
+      binaryError("Tableau::importBinary: Bits beyond the last row are set");
+    }
+  }
+}
+
+void Tableau::fromRows(const TableauType& rows) {
+  nRows = rows.size();
+  nColumns = rows.empty() ? 0U : rows.front().size();
+  nWords = (nRows + WORD_BITS - 1U) / WORD_BITS;
+  data.assign(nColumns * nWords, 0U);
+  for (std::size_t i = 0U; i < nRows; ++i) {
+    if (rows[i].size() != nColumns) {
+      const auto* const msg = "Tableau::fromRows: Tableau is not rectangular";
+      PLOG_FATAL << msg;
+      throw std::runtime_error(msg);
+    }
+    for (std::size_t j = 0U; j < nColumns; ++j) {
+      if (rows[i][j] != 0U) {
+        set(i, j, true);
       }
-      tableau.back().emplace_back(static_cast<EntryType>(std::stoul(datum)));
     }
   }
 }
 
+void Tableau::appendRows(const TableauType& rows) {
+  auto all = getTableau();
+  all.insert(all.end(), rows.begin(), rows.end());
+  fromRows(all);
+}
+
+Tableau::TableauType Tableau::getTableau() const {
+  TableauType rows;
+  rows.reserve(nRows);
+  for (std::size_t i = 0U; i < nRows; ++i) {
+    rows.emplace_back((*this)[i]);
+  }
+  return rows;
+}
+
 void Tableau::applyGate(const qc::Operation* const gate) {
   if (gate->getNcontrols() > 1U) {
     const auto* const msg =
@@ -192,53 +369,63 @@ void Tableau::applyGate(const qc::Operation* const gate) {
   }
 }
 
+bool Tableau::applyGateAndDetectChange(const qc::Operation* const gate) {
+  // a gate can only modify the X and Z columns of its qubits and the phase
+  std::vector<std::size_t> columns{2U * nQubits};
+  for (const auto target : gate->getTargets()) {
+    columns.emplace_back(target);
+    columns.emplace_back(target + nQubits);
+  }
+  for (const auto& control : gate->getControls()) {
+    columns.emplace_back(control.qubit);
+    columns.emplace_back(control.qubit + nQubits);
+  }
+  std::vector<WordType> before;
+  before.reserve(columns.size() * nWords);
+  for (const auto column : columns) {
+    const auto* const words = columnWords(column);
+    before.insert(before.end(), words, words + nWords);
+  }
+
+  applyGate(gate);
+
+  auto it = before.cbegin();
+  for (const auto column : columns) {
+    if (!std::equal(it, it + static_cast<std::ptrdiff_t>(nWords),
+                    columnWords(column))) {
+      return true;
+    }
+    it += static_cast<std::ptrdiff_t>(nWords);
+  }
+  return false;
+}
+
 void Tableau::createDiagonalTableau(const std::size_t nQ,
                                     const bool includeDestabilizers) {
   nQubits = nQ;
-  tableau.clear();
-  if (includeDestabilizers) {
-    tableau.resize(2U * nQubits);
-  } else {
-    tableau.resize(nQubits);
-  }
-  for (std::size_t i = 0U; i < getTableauSize(); ++i) {
-    tableau[i].resize((2U * nQubits) + 1U);
-    if (includeDestabilizers) {
-      for (std::size_t j = 0; j < (2U * nQubits); ++j) {
-        tableau[i][j] = 0;
-        if (i == j) {
-          tableau[i][j] = 1;
-        }
-      }
-    } else {
-      for (std::size_t j = nQubits; j < (2U * nQubits); ++j) {
-        tableau[i][j] = 0;
-        if (i == (j - nQubits)) {
-          tableau[i][j] = 1;
-        }
-      }
-    }
+  nRows = includeDestabilizers ? 2U * nQubits : nQubits;
+  nColumns = (2U * nQubits) + 1U;
+  nWords = (nRows + WORD_BITS - 1U) / WORD_BITS;
+  data.assign(nColumns * nWords, 0U);
+  for (std::size_t i = 0U; i < nRows; ++i) {
+    set(i, includeDestabilizers ? i : i + nQubits, true);
   }
 }
 
 std::string Tableau::toString() const {
-  std::stringstream ss;
-  for (const auto& row : tableau) {
-    if (row.size() != tableau.back().size()) {
-      const auto* const msg = "Tableau::toString: Tableau is not rectangular";
-      PLOG_FATAL << msg;
-      throw std::runtime_error(msg);
+  std::string str;
+  str.reserve(nRows * ((2U * nColumns) + 1U));
+  for (std::size_t i = 0U; i < nRows; ++i) {
+    for (std::size_t j = 0U; j < nColumns; ++j) {
+      str += get(i, j) ? "1;" : "0;";
     }
-    for (const auto& s : row) {
-      ss << std::to_string(s) << ';';
-    }
-    ss << "\n";
+    str += '\n';
   }
-  return ss.str();
+  return str;
 }
 
 void Tableau::fromString(const std::string& str) {
-  std::stringstream ss(str);
+  std::istringstream ss(str);
   std::string line;
   std::getline(ss, line);
   if (line.empty()) {
@@ -250,35 +437,273 @@ void Tableau::fromString(const std::string& str) {
     loadStabilizerDestabilizerString(str);
   } else {
     // assume string is a semicolon separated binary matrix
-    ss = std::stringstream(str);
+    ss.clear();
+    ss.seekg(0);
     import(ss);
   }
 }
 
+namespace {
+
+// Each update works on the words of the affected columns. The AVX2 variants
+// process four words at a time and leave the remaining words to the scalar
+// variants. Columns of fewer words (i.e., tableaus on less than 128 qubits
+// with destabilizers) are updated by the scalar variants, which are inlined.
+using Word = std::uint64_t;
+
+void scalarH(Word* x, Word* z, Word* r, const std::size_t n) {
+  for (std::size_t w = 0U; w < n; ++w) {
+    r[w] ^= x[w] & z[w];
+    std::swap(x[w], z[w]);
+  }
+}
+
+void scalarS(const Word* x, Word* z, Word* r, const std::size_t n) {
+  for (std::size_t w = 0U; w < n; ++w) {
+    r[w] ^= x[w] & z[w];
+    z[w] ^= x[w];
+  }
+}
+
+void scalarSdag(const Word* x, Word* z, Word* r, const std::size_t n) {
+  for (std::size_t w = 0U; w < n; ++w) {
+    r[w] ^= x[w] & ~z[w];
+    z[w] ^= x[w];
+  }
+}
+
+void scalarXor(const Word* a, Word* r, const std::size_t n) {
+  for (std::size_t w = 0U; w < n; ++w) {
+    r[w] ^= a[w];
+  }
+}
+
+void scalarXor2(const Word* a, const Word* b, Word* r, const std::size_t n) {
+  for (std::size_t w = 0U; w < n; ++w) {
+    r[w] ^= a[w] ^ b[w];
+  }
+}
+
+void scalarCX(const Word* xa, Word* za, Word* xb, const Word* zb, Word* r,
+              const std::size_t n) {
+  for (std::size_t w = 0U; w < n; ++w) {
+    r[w] ^= xa[w] & zb[w] & ~(xb[w] ^ za[w]);
+    za[w] ^= zb[w];
+    xb[w] ^= xa[w];
+  }
+}
+
+void scalarCZ(const Word* xa, Word* za, const Word* xb, Word* zb, Word* r,
+              const std::size_t n) {
+  for (std::size_t w = 0U; w < n; ++w) {
+    r[w] ^= xa[w] & xb[w] & (za[w] ^ zb[w]);
+    za[w] ^= xb[w];
+    zb[w] ^= xa[w];
+  }
+}
+
+#ifdef QMAP_TABLEAU_AVX2
+// NOLINTBEGIN(portability-simd-intrinsics)
+constexpr std::size_t LANES = 4U;
+
+__attribute__((target("avx2"))) __m256i load(const Word* p) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+
+__attribute__((target("avx2"))) void store(Word* p, const __m256i v) {
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+}
+
+__attribute__((target("avx2"))) void avx2H(Word* x, Word* z, Word* r,
+                                           const std::size_t n) {
+  std::size_t w = 0U;
+  for (; w + LANES <= n; w += LANES) {
+    const auto vx = load(x + w);
+    const auto vz = load(z + w);
+    store(r + w, _mm256_xor_si256(load(r + w), _mm256_and_si256(vx, vz)));
+    store(x + w, vz);
+    store(z + w, vx);
+  }
+  scalarH(x + w, z + w, r + w, n - w);
+}
+
+__attribute__((target("avx2"))) void avx2S(const Word* x, Word* z, Word* r,
+                                           const std::size_t n) {
+  std::size_t w = 0U;
+  for (; w + LANES <= n; w += LANES) {
+    const auto vx = load(x + w);
+    const auto vz = load(z + w);
+    store(r + w, _mm256_xor_si256(load(r + w), _mm256_and_si256(vx, vz)));
+    store(z + w, _mm256_xor_si256(vz, vx));
+  }
+  scalarS(x + w, z + w, r + w, n - w);
+}
+
+__attribute__((target("avx2"))) void avx2Sdag(const Word* x, Word* z, Word* r,
+                                              const std::size_t n) {
+  std::size_t w = 0U;
+  for (; w + LANES <= n; w += LANES) {
+    const auto vx = load(x + w);
+    const auto vz = load(z + w);
+    store(r + w, _mm256_xor_si256(load(r + w), _mm256_andnot_si256(vz, vx)));
+    store(z + w, _mm256_xor_si256(vz, vx));
+  }
+  scalarSdag(x + w, z + w, r + w, n - w);
+}
+
+__attribute__((target("avx2"))) void avx2Xor(const Word* a, Word* r,
+                                             const std::size_t n) {
+  std::size_t w = 0U;
+  for (; w + LANES <= n; w += LANES) {
+    store(r + w, _mm256_xor_si256(load(r + w), load(a + w)));
+  }
+  scalarXor(a + w, r + w, n - w);
+}
+
+__attribute__((target("avx2"))) void
+avx2Xor2(const Word* a, const Word* b, Word* r, const std::size_t n) {
+  std::size_t w = 0U;
+  for (; w + LANES <= n; w += LANES) {
+    const auto ab = _mm256_xor_si256(load(a + w), load(b + w));
+    store(r + w, _mm256_xor_si256(load(r + w), ab));
+  }
+  scalarXor2(a + w, b + w, r + w, n - w);
+}
+
+__attribute__((target("avx2"))) void avx2CX(const Word* xa, Word* za,
+                                            Word* xb, const Word* zb, Word* r,
+                                            const std::size_t n) {
+  std::size_t w = 0U;
+  for (; w + LANES <= n; w += LANES) {
+    const auto vxa = load(xa + w);
+    const auto vza = load(za + w);
+    const auto vxb = load(xb + w);
+    const auto vzb = load(zb + w);
+    const auto flip = _mm256_andnot_si256(_mm256_xor_si256(vxb, vza),
+                                          _mm256_and_si256(vxa, vzb));
+    store(r + w, _mm256_xor_si256(load(r + w), flip));
+    store(za + w, _mm256_xor_si256(vza, vzb));
+    store(xb + w, _mm256_xor_si256(vxb, vxa));
+  }
+  scalarCX(xa + w, za + w, xb + w, zb + w, r + w, n - w);
+}
+
+__attribute__((target("avx2"))) void avx2CZ(const Word* xa, Word* za,
+                                            const Word* xb, Word* zb, Word* r,
+                                            const std::size_t n) {
+  std::size_t w = 0U;
+  for (; w + LANES <= n; w += LANES) {
+    const auto vxa = load(xa + w);
+    const auto vza = load(za + w);
+    const auto vxb = load(xb + w);
+    const auto vzb = load(zb + w);
+    const auto flip = _mm256_and_si256(_mm256_and_si256(vxa, vxb),
+                                       _mm256_xor_si256(vza, vzb));
+    store(r + w, _mm256_xor_si256(load(r + w), flip));
+    store(za + w, _mm256_xor_si256(vza, vxb));
+    store(zb + w, _mm256_xor_si256(vzb, vxa));
+  }
+  scalarCZ(xa + w, za + w, xb + w, zb + w, r + w, n - w);
+}
+// NOLINTEND(portability-simd-intrinsics)
+
+bool hasAVX2() {
+  static const bool SUPPORTED = __builtin_cpu_supports("avx2") != 0;
+  return SUPPORTED;
+}
+#endif
+
+void updateH(Word* x, Word* z, Word* r, const std::size_t n) {
+#ifdef QMAP_TABLEAU_AVX2
+  if (n >= LANES && hasAVX2()) {
+    avx2H(x, z, r, n);
+    return;
+  }
+#endif
+  scalarH(x, z, r, n);
+}
+
+void updateS(const Word* x, Word* z, Word* r, const std::size_t n) {
+#ifdef QMAP_TABLEAU_AVX2
+  if (n >= LANES && hasAVX2()) {
+    avx2S(x, z, r, n);
+    return;
+  }
+#endif
+  scalarS(x, z, r, n);
+}
+
+void updateSdag(const Word* x, Word* z, Word* r, const std::size_t n) {
+#ifdef QMAP_TABLEAU_AVX2
+  if (n >= LANES && hasAVX2()) {
+    avx2Sdag(x, z, r, n);
+    return;
+  }
+#endif
+  scalarSdag(x, z, r, n);
+}
+
+void updateXor(const Word* a, Word* r, const std::size_t n) {
+#ifdef QMAP_TABLEAU_AVX2
+  if (n >= LANES && hasAVX2()) {
+    avx2Xor(a, r, n);
+    return;
+  }
+#endif
+  scalarXor(a, r, n);
+}
+
+void updateXor2(const Word* a, const Word* b, Word* r, const std::size_t n) {
+#ifdef QMAP_TABLEAU_AVX2
+  if (n >= LANES && hasAVX2()) {
+    avx2Xor2(a, b, r, n);
+    return;
+  }
+#endif
+  scalarXor2(a, b, r, n);
+}
+
+void updateCX(const Word* xa, Word* za, Word* xb, const Word* zb, Word* r,
+              const std::size_t n) {
+#ifdef QMAP_TABLEAU_AVX2
+  if (n >= LANES && hasAVX2()) {
+    avx2CX(xa, za, xb, zb, r, n);
+    return;
+  }
+#endif
+  scalarCX(xa, za, xb, zb, r, n);
+}
+
+void updateCZ(const Word* xa, Word* za, const Word* xb, Word* zb, Word* r,
+              const std::size_t n) {
+#ifdef QMAP_TABLEAU_AVX2
+  if (n >= LANES && hasAVX2()) {
+    avx2CZ(xa, za, xb, zb, r, n);
+    return;
+  }
+#endif
+  scalarCZ(xa, za, xb, zb, r, n);
+}
+
+} // namespace
+
 void Tableau::applyH(const std::size_t target) {
   assert(target < nQubits);
-  for (std::size_t i = 0U; i < getTableauSize(); ++i) {
-    tableau[i][2U * nQubits] ^= static_cast<EntryType>(
-        tableau[i][target] & tableau[i][target + nQubits]);
-    std::swap(tableau[i][target], tableau[i][target + nQubits]);
-  }
+  updateH(columnWords(target), columnWords(target + nQubits),
+          columnWords(2U * nQubits), nWords);
 }
 
 void Tableau::applyS(const std::size_t target) {
   assert(target < nQubits);
-  for (std::size_t i = 0U; i < getTableauSize(); ++i) {
-    tableau[i][2U * nQubits] ^= static_cast<EntryType>(
-        tableau[i][target] & tableau[i][target + nQubits]);
-    tableau[i][target + nQubits] ^= tableau[i][target];
-  }
+  updateS(columnWords(target), columnWords(target + nQubits),
+          columnWords(2U * nQubits), nWords);
 }
 
 // Sdag = S * S * S
 void Tableau::applySdag(const std::size_t target) {
   assert(target < nQubits);
-  applyS(target);
-  applyS(target);
-  applyS(target);
+  updateSdag(columnWords(target), columnWords(target + nQubits),
+             columnWords(2U * nQubits), nWords);
 }
 
 // Sx = Sdag * H * Sdag
@@ -300,38 +725,29 @@ void Tableau::applySxdag(const std::size_t target) {
 // X = H * Z * H
 void Tableau::applyX(const std::size_t target) {
   assert(target < nQubits);
-  applyH(target);
-  applyZ(target);
-  applyH(target);
+  updateXor(columnWords(target + nQubits), columnWords(2U * nQubits), nWords);
 }
 
 // Y = X * Z
 void Tableau::applyY(const std::size_t target) {
   assert(target < nQubits);
-  applyX(target);
-  applyZ(target);
+  updateXor2(columnWords(target), columnWords(target + nQubits),
+             columnWords(2U * nQubits), nWords);
 }
 
 // Z = S * S
 void Tableau::applyZ(const std::size_t target) {
   assert(target < nQubits);
-  applyS(target);
-  applyS(target);
+  updateXor(columnWords(target), columnWords(2U * nQubits), nWords);
 }
 
 void Tableau::applyCX(const std::size_t control, const std::size_t target) {
   assert(control < nQubits);
   assert(target < nQubits);
   assert(control != target);
-  for (auto i = 0U; i < getTableauSize(); ++i) {
-    const auto xa = tableau[i][control];
-    const auto za = tableau[i][control + nQubits];
-    const auto xb = tableau[i][target];
-    const auto zb = tableau[i][target + nQubits];
-    tableau[i][2 * nQubits] ^= (xa & zb) & ((xb ^ za) ^ 1);
-    tableau[i][control + nQubits] = za ^ zb;
-    tableau[i][target] = xb ^ xa;
-  }
+  updateCX(columnWords(control), columnWords(control + nQubits),
+           columnWords(target), columnWords(target + nQubits),
+           columnWords(2U * nQubits), nWords);
 }
 
 void Tableau::applyCY(const std::size_t control, const std::size_t target) {
@@ -343,22 +759,25 @@ void Tableau::applyCY(const std::size_t control, const std::size_t target) {
   applyS(target);
 }
 
+// CZ = H(target) * CX * H(target)
 void Tableau::applyCZ(const std::size_t control, const std::size_t target) {
   assert(control < nQubits);
   assert(target < nQubits);
   assert(control != target);
-  applyH(target);
-  applyCX(control, target);
-  applyH(target);
+  updateCZ(columnWords(control), columnWords(control + nQubits),
+           columnWords(target), columnWords(target + nQubits),
+           columnWords(2U * nQubits), nWords);
 }
 
+// SWAP = CX * CX * CX only permutes the columns
 void Tableau::applySwap(const std::size_t q1, const std::size_t q2) {
   assert(q1 < nQubits);
   assert(q2 < nQubits);
   assert(q1 != q2);
-  applyCX(q1, q2);
-  applyCX(q2, q1);
-  applyCX(q1, q2);
+  for (const auto offset : {std::size_t{0U}, nQubits}) {
+    auto* const a = columnWords(q1 + offset);
+    std::swap_ranges(a, a + nWords, columnWords(q2 + offset));
+  }
 }
 
 void Tableau::applyISwap(const std::size_t q1, const std::size_t q2) {
@@ -417,6 +836,280 @@ Tableau::Tableau(const qc::QuantumComputation& qc, const std::size_t begin,
     }
   }
 }
+
+void Tableau::applyOperation(const qc::Operation& op) {
+  if (const auto* const compOp =
+          dynamic_cast<const qc::CompoundOperation*>(&op);
+      compOp != nullptr) {
+    for (const auto& gate : *compOp) {
+      applyOperation(*gate);
+    }
+    return;
+  }
+  applyGate(&op);
+}
+
+namespace {
+[[noreturn]] void qasmError(const std::string& msg) {
+  const auto error = "Tableau::importQASM: " + msg;
+  PLOG_FATAL << error;
+  throw std::runtime_error(error);
+}
+
+/// a register size or index of the statement
+std::size_t parseNumber(const std::string& token,
+                        const std::string& statement) {
+  std::size_t value = 0U;
+  const auto* const end = token.data() + token.size();
+  const auto [ptr, ec] = std::from_chars(token.data(), end, value);
+  if (ec != std::errc{} || ptr != end) {
+    qasmError("Malformed number \"" + token + "\" in \"" + statement + "\"");
+  }
+  return value;
+}
+
+bool isSpace(const char c) {
+  return std::isspace(static_cast<unsigned char>(c)) != 0;
+}
+
+/// reads the statements of an OpenQASM program one at a time (without
+/// comments and the terminating semicolon)
+bool nextStatement(std::istream& is, std::string& statement) {
+  statement.clear();
+  char c{};
+  while (is.get(c)) {
+    if (c == '/' && is.peek() == '/') {
+      is.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+      if (!statement.empty()) {
+        statement += ' ';
+      }
+      continue;
+    }
+    if (c == '/' && is.peek() == '*') {
+      is.get();
+      char prev{};
+      while (is.get(c) && !(prev == '*' && c == '/')) {
+        prev = c;
+      }
+      if (!statement.empty()) {
+        statement += ' ';
+      }
+      continue;
+    }
+    if (c == ';') {
+      while (!statement.empty() && isSpace(statement.back())) {
+        statement.pop_back();
+      }
+      return true;
+    }
+    if (!statement.empty() || !isSpace(c)) {
+      statement += c;
+    }
+  }
+  if (!statement.empty()) {
+    qasmError("Missing \";\" after \"" + statement + "\"");
+  }
+  return false;
+}
+
+/// identifiers, numbers (including versions) and strings are single tokens,
+/// everything else is split into single characters
+void tokenize(const std::string& statement, std::vector<std::string>& tokens) {
+  tokens.clear();
+  std::size_t i = 0U;
+  const auto isWord = [](const char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) != 0 || c == '_' ||
+           c == '.';
+  };
+  while (i < statement.size()) {
+    const char c = statement[i];
+    if (isSpace(c)) {
+      ++i;
+      continue;
+    }
+    std::size_t end = i + 1U;
+    if (isWord(c)) {
+      while (end < statement.size() && isWord(statement[end])) {
+        ++end;
+      }
+    } else if (c == '"') {
+      end = statement.find('"', i + 1U);
+      if (end == std::string::npos) {
+        qasmError("Unterminated string in \"" + statement + "\"");
+      }
+      ++end;
+    }
+    tokens.emplace_back(statement.substr(i, end - i));
+    i = end;
+  }
+}
+
+using SingleQubitGate = void (Tableau::*)(std::size_t);
+using TwoQubitGate = void (Tableau::*)(std::size_t, std::size_t);
+
+const std::unordered_map<std::string, SingleQubitGate> SINGLE_QUBIT_GATES = {
+    {"x", &Tableau::applyX},
+    {"y", &Tableau::applyY},
+    {"z", &Tableau::applyZ},
+    {"h", &Tableau::applyH},
+    {"s", &Tableau::applyS},
+    {"sdg", &Tableau::applySdag},
+    {"sx", &Tableau::applySx},
+    {"sxdg", &Tableau::applySxdag},
+    {"id", nullptr},
+    {"i", nullptr},
+};
+
+const std::unordered_map<std::string, TwoQubitGate> TWO_QUBIT_GATES = {
+    {"cx", &Tableau::applyCX},
+    {"CX", &Tableau::applyCX},
+    {"cy", &Tableau::applyCY},
+    {"cz", &Tableau::applyCZ},
+    {"swap", &Tableau::applySwap},
+    {"iswap", &Tableau::applyISwap},
+    {"dcx", &Tableau::applyDCX},
+    {"ecr", &Tableau::applyECR},
+};
+
+/// a single qubit or a whole register that a gate is broadcast over
+struct Operand {
+  std::size_t first;
+  std::size_t size;
+  bool isRegister;
+};
+} // namespace
+
+void Tableau::importQASM(const std::string& filename,
+                         const bool includeDestabilizers) {
+  auto is = std::ifstream(filename);
+  if (!is.good()) {
+    const auto msg = "Error opening file " + filename;
+    PLOG_FATAL << msg;
+    throw std::runtime_error(msg);
+  }
+  importQASM(is, includeDestabilizers);
+}
+
+void Tableau::importQASM(std::istream& is, const bool includeDestabilizers) {
+  // first qubit and size of every quantum register
+  std::unordered_map<std::string, std::pair<std::size_t, std::size_t>>
+      registers{};
+  std::size_t declaredQubits = 0U;
+  bool started = false;
+  const auto start = [&]() {
+    if (!started) {
+      createDiagonalTableau(declaredQubits, includeDestabilizers);
+      started = true;
+    }
+  };
+  const auto declare = [&](const std::string& name, const std::size_t size) {
+    if (started) {
+      qasmError("Register " + name + " is declared after the first gate");
+    }
+    if (!registers.emplace(name, std::make_pair(declaredQubits, size))
+             .second) {
+      qasmError("Register " + name + " is declared twice");
+    }
+    declaredQubits += size;
+  };
+
+  std::string statement;
+  std::vector<std::string> tokens;
+  std::vector<Operand> operands;
+  while (nextStatement(is, statement)) {
+    tokenize(statement, tokens);
+    if (tokens.empty()) {
+      continue;
+    }
+    const auto& keyword = tokens.front();
+    if (keyword == "OPENQASM" || keyword == "include" || keyword == "creg" ||
+        keyword == "bit" || keyword == "barrier") {
+      continue;
+    }
+    if (keyword == "qreg" && tokens.size() == 5U && tokens[2] == "[" &&
+        tokens[4] == "]") {
+      declare(tokens[1], parseNumber(tokens[3], statement));
+      continue;
+    }
+    if (keyword == "qubit") {
+      if (tokens.size() == 2U) {
+        declare(tokens[1], 1U);
+        continue;
+      }
+      if (tokens.size() == 5U && tokens[1] == "[" && tokens[3] == "]") {
+        declare(tokens[4], parseNumber(tokens[2], statement));
+        continue;
+      }
+    }
+
+    // gate application of the form name q[i], r, ...
+    const auto single = SINGLE_QUBIT_GATES.find(keyword);
+    const auto two = TWO_QUBIT_GATES.find(keyword);
+    const auto arity = single != SINGLE_QUBIT_GATES.end() ? 1U
+                       : two != TWO_QUBIT_GATES.end()     ? 2U
+                                                          : 0U;
+    if (arity == 0U) {
+      qasmError("Unsupported statement \"" + statement + "\"");
+    }
+    operands.clear();
+    for (std::size_t i = 1U; i < tokens.size(); ++i) {
+      if (i > 1U && tokens[i++] != ",") {
+        qasmError("Malformed operands in \"" + statement + "\"");
+      }
+      const auto reg = i < tokens.size() ? registers.find(tokens[i])
+                                         : registers.end();
+      if (reg == registers.end()) {
+        qasmError("Unknown register in \"" + statement + "\"");
+      }
+      const auto [first, size] = reg->second;
+      if (i + 1U < tokens.size() && tokens[i + 1U] == "[") {
+        if (i + 3U >= tokens.size() || tokens[i + 3U] != "]") {
+          qasmError("Malformed operands in \"" + statement + "\"");
+        }
+        const auto index = parseNumber(tokens[i + 2U], statement);
+        if (index >= size) {
+          qasmError("Index out of range in \"" + statement + "\"");
+        }
+        operands.push_back({first + index, 1U, false});
+        i += 3U;
+      } else {
+        operands.push_back({first, size, true});
+      }
+    }
+    if (operands.size() != arity) {
+      qasmError("Wrong number of operands in \"" + statement + "\"");
+    }
+
+    // registers are broadcast element-wise, single qubits are repeated
+    std::optional<std::size_t> repetitions{};
+    for (const auto& operand : operands) {
+      if (operand.isRegister) {
+        if (repetitions && operand.size != *repetitions) {
+          qasmError("Registers of different sizes in \"" + statement + "\"");
+        }
+        repetitions = operand.size;
+      }
+    }
+    start();
+    for (std::size_t k = 0U; k < repetitions.value_or(1U); ++k) {
+      const auto qubit = [&](const Operand& operand) {
+        return operand.first + (operand.isRegister ? k : 0U);
+      };
+      if (arity == 1U) {
+        if (single->second != nullptr) {
+          (this->*(single->second))(qubit(operands[0]));
+        }
+      } else {
+        if (qubit(operands[0]) == qubit(operands[1])) {
+          qasmError("Gate acts twice on a qubit in \"" + statement + "\"");
+        }
+        (this->*(two->second))(qubit(operands[0]), qubit(operands[1]));
+      }
+    }
+  }
+  start();
+}
+
 void Tableau::fromString(const std::string& stabilizers,
                          const std::string& destabilizers) {
   loadStabilizerDestabilizerString(destabilizers);
@@ -490,6 +1183,7 @@ void Tableau::loadStabilizerDestabilizerString(const std::string& string) {
     }
   }
 
+  TableauType rows;
   std::optional<std::size_t> stabLength;
   const auto& checkStabLength = [&](const RowType& row) {
     if (!stabLength.has_value()) {
@@ -507,18 +1201,24 @@ void Tableau::loadStabilizerDestabilizerString(const std::string& string) {
     stab = stabilizers.substr(0, pos);
     const auto& row = parseStabilizer(stab);
     checkStabLength(row);
-    tableau.push_back(row);
+    rows.push_back(row);
     stabilizers = stabilizers.substr(pos + 1);
   }
   const auto& row =
       parseStabilizer(stabilizers); // parse stabilizer past last comma
   checkStabLength(row);
-  tableau.push_back(row);
+  rows.push_back(row);
+  appendRows(rows);
 }
 bool Tableau::isIdentityTableau() const {
-  for (std::size_t i = 0U; i < getTableauSize(); ++i) {
-    for (std::size_t j = 0U; j < tableau[i].size(); ++j) {
-      if ((j == i && tableau[i][j] == 0U) || (j != i && tableau[i][j] == 1U)) {
+  for (std::size_t j = 0U; j < nColumns; ++j) {
+    const auto* const col = columnWords(j);
+    for (std::size_t w = 0U; w < nWords; ++w) {
+      WordType expected = 0U;
+      if (j < nRows && j / WORD_BITS == w) {
+        expected = WordType{1} << (j % WORD_BITS);
+      }
+      if (col[w] != expected) {
         return false;
       }
     }
@@ -54,6 +54,10 @@ void GateEncoder::createTwoQubitGateVariables() {
       auto& control = timeStep.emplace_back();
       control.reserve(N);
       for (std::size_t trgt = 0U; trgt < N; ++trgt) {
+        if (ctrl != trgt && !vars.isAllowed(t, ctrl, trgt)) {
+          control.emplace_back(LogicTerm(false));
+          continue;
+        }
         const std::string gName = "g_" + std::to_string(t) + "_cx_" +
                                   std::to_string(ctrl) + "_" +
                                   std::to_string(trgt);
@@ -79,7 +83,7 @@ void GateEncoder::Variables::collectTwoQubitGateVariables(
   const auto& twoQubitGates = gC[pos];
   const auto n = twoQubitGates.size();
   for (std::size_t q = 0; q < n; ++q) {
-    if (q == qubit) {
+    if (target ? !isAllowed(pos, q, qubit) : !isAllowed(pos, qubit, q)) {
       continue;
     }
     if (target) {
@@ -215,7 +219,7 @@ void GateEncoder::extractTwoQubitGatesFromModel(const std::size_t pos,
   const auto& twoQubitGates = vars.gC[pos];
   for (std::size_t ctrl = 0U; ctrl < N; ++ctrl) {
     for (std::size_t trgt = 0U; trgt < N; ++trgt) {
-      if (ctrl == trgt) {
+      if (!vars.isAllowed(pos, ctrl, trgt)) {
         continue;
       }
       const auto control =
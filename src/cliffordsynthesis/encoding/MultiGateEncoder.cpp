@@ -80,7 +80,7 @@ void encoding::MultiGateEncoder::assertTwoQubitGateConstraints(
   const auto& twoQubitGates = vars.gC[pos];
   for (std::size_t ctrl = 0U; ctrl < N; ++ctrl) {
     for (std::size_t trgt = 0U; trgt < N; ++trgt) {
-      if (ctrl == trgt) {
+      if (!vars.isAllowed(pos, ctrl, trgt)) {
         continue;
       }
       const auto changes = createTwoQubitGateConstraint(pos, ctrl, trgt);
@@ -145,10 +145,18 @@ void MultiGateEncoder::assertTwoQubitGateOrderConstraints(
   const auto& gCNext = vars.gC[pos + 1];
 
   // two identical CNOTs may not be applied in a row because they would cancel.
-  lb->assertFormula(
-      LogicTerm::implies(vars.gC[pos][ctrl][trgt], !gCNext[ctrl][trgt]));
-  lb->assertFormula(
-      LogicTerm::implies(vars.gC[pos][trgt][ctrl], !gCNext[trgt][ctrl]));
+  if (vars.isAllowed(pos, ctrl, trgt) && vars.isAllowed(pos + 1, ctrl, trgt)) {
+    lb->assertFormula(
+        LogicTerm::implies(vars.gC[pos][ctrl][trgt], !gCNext[ctrl][trgt]));
+  }
+  if (vars.isAllowed(pos, trgt, ctrl) && vars.isAllowed(pos + 1, trgt, ctrl)) {
+    lb->assertFormula(
+        LogicTerm::implies(vars.gC[pos][trgt][ctrl], !gCNext[trgt][ctrl]));
+  }
+  if (!vars.isAllowed(pos + 1, ctrl, trgt) &&
+      !vars.isAllowed(pos + 1, trgt, ctrl)) {
+    return;
+  }
 
   // no gate on both qubits => no CNOT on them in the next time step.
   // hadamards on both qubits => no CNOT on them in the next time step (CNOT can
@@ -8,12 +8,14 @@
 #include "cliffordsynthesis/TargetMetric.hpp"
 #include "cliffordsynthesis/encoding/GateEncoder.hpp"
 #include "ir/operations/OpType.hpp"
+#include "logicblocks/Encodings.hpp"
 #include "logicblocks/LogicTerm.hpp"
 
 #include <cstddef>
 #include <functional>
 #include <plog/Log.h>
 #include <stdexcept>
+#include <vector>
 
 namespace cs::encoding {
 
@@ -31,6 +33,60 @@ ObjectiveEncoder::collectGateCount(const bool includeSingleQubitGates) const {
   return cost;
 }
 
+std::vector<LogicTerm> ObjectiveEncoder::collectGateVariables(
+    const bool includeSingleQubitGates) const {
+  std::vector<LogicTerm> variables{};
+  const auto collect = [&variables](const LogicTerm& terms,
+                                    const LogicTerm& var) {
+    variables.emplace_back(var);
+    return terms;
+  };
+  auto unused = LogicTerm(0);
+  for (std::size_t t = 0U; t < T; ++t) {
+    if (includeSingleQubitGates) {
+      collectSingleQubitGateTerms(t, unused, collect);
+    }
+    collectTwoQubitGateTerms(t, unused, collect);
+  }
+  return variables;
+}
+
+void ObjectiveEncoder::limitGateCount(
+    const std::size_t maxGateCount,
+    const encodings::CardinalityEncoding encoding,
+    const bool includeSingleQubitGates) const {
+  PLOG_DEBUG << "Limiting gate count to at most " << maxGateCount
+             << (includeSingleQubitGates ? "" : " two-qubit") << " gate(s) ("
+             << encodings::toString(encoding) << ")";
+
+  const auto variables = collectGateVariables(includeSingleQubitGates);
+  lb->assertFormula(
+      encodings::atMostK(variables, maxGateCount, encoding, lb.get()));
+}
+
+void ObjectiveEncoder::createGateCounter(
+    const std::size_t maxGateCount,
+    const encodings::CardinalityEncoding encoding,
+    const bool includeSingleQubitGates) {
+  PLOG_DEBUG << "Creating " << encodings::toString(encoding)
+             << (includeSingleQubitGates ? "" : " two-qubit")
+             << " gate counter up to " << maxGateCount << " gate(s)";
+
+  gateCounter.emplace(collectGateVariables(includeSingleQubitGates), encoding,
+                      lb.get(), encodings::Cardinality::Bounds::AtMost,
+                      maxGateCount);
+  lb->assertFormula(gateCounter->getDefinitions());
+}
+
+void ObjectiveEncoder::boundGateCount(const std::size_t maxGateCount) const {
+  if (!gateCounter.has_value()) {
+    throw std::runtime_error("No gate counter has been created.");
+  }
+  PLOG_DEBUG << "Bounding gate counter to at most " << maxGateCount
+             << " gate(s)";
+  lb->assertFormula(gateCounter->atMost(maxGateCount));
+}
+
 void ObjectiveEncoder::optimizeGateCount(
     const bool includeSingleQubitGates) const {
   PLOG_DEBUG << "Optimizing " << (includeSingleQubitGates ? "" : "two-qubit ")
@@ -0,0 +1,128 @@
+//
+// This file is part of the MQT QMAP library released under the MIT license.
+// See README.md or go to https://github.com/cda-tum/qmap for more information.
+//
+
+#include "cliffordsynthesis/encoding/QubitPairPruning.hpp"
+
+#include "cliffordsynthesis/Configuration.hpp"
+#include "cliffordsynthesis/Tableau.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <numeric>
+#include <optional>
+#include <vector>
+
+namespace cs::encoding {
+
+std::vector<std::size_t> interactionComponents(const Tableau& initial,
+                                               const Tableau& target) {
+  const auto nQubits = target.getQubitCount();
+  std::vector<std::size_t> parent(nQubits);
+  std::iota(parent.begin(), parent.end(), 0U);
+  const auto find = [&parent](std::size_t q) {
+    while (parent[q] != q) {
+      parent[q] = parent[parent[q]];
+      q = parent[q];
+    }
+    return q;
+  };
+
+  // like the encoding, only the rows both tableaus have are related
+  const auto rows =
+      std::min(initial.getTableauSize(), target.getTableauSize());
+  for (std::size_t row = 0U; row < rows; ++row) {
+    std::optional<std::size_t> first{};
+    for (const auto* const tableau : {&initial, &target}) {
+      for (std::size_t q = 0U; q < nQubits; ++q) {
+        if (!tableau->get(row, q) && !tableau->get(row, nQubits + q)) {
+          continue;
+        }
+        if (first) {
+          parent[find(q)] = find(*first);
+        } else {
+          first = q;
+        }
+      }
+    }
+  }
+
+  std::vector<std::size_t> components(nQubits);
+  for (std::size_t q = 0U; q < nQubits; ++q) {
+    components[q] = find(q);
+  }
+  return components;
+}
+
+std::vector<QubitPairMask>
+createQubitPairMasks(const std::size_t nQubits, const std::size_t timesteps,
+                     const CouplingMap& couplingMap,
+                     const std::vector<std::size_t>& components,
+                     const std::size_t window) {
+  QubitPairMask allowed(nQubits, std::vector<bool>(nQubits, false));
+  for (std::size_t ctrl = 0U; ctrl < nQubits; ++ctrl) {
+    for (std::size_t trgt = 0U; trgt < nQubits; ++trgt) {
+      if (ctrl == trgt) {
+        continue;
+      }
+      const bool coupled = couplingMap.empty() ||
+                           couplingMap.count({ctrl, trgt}) != 0U ||
+                           couplingMap.count({trgt, ctrl}) != 0U;
+      const bool interacting =
+          components.empty() || components[ctrl] == components[trgt];
+      allowed[ctrl][trgt] = coupled && interacting;
+    }
+  }
+
+  if (window == 0U || window >= nQubits) {
+    return std::vector<QubitPairMask>(timesteps, allowed);
+  }
+  std::vector<QubitPairMask> masks{};
+  masks.reserve(timesteps);
+  const auto positions = nQubits - window + 1U;
+  for (std::size_t t = 0U; t < timesteps; ++t) {
+    auto& mask = masks.emplace_back(allowed);
+    const auto begin = t % positions;
+    for (std::size_t ctrl = 0U; ctrl < nQubits; ++ctrl) {
+      for (std::size_t trgt = 0U; trgt < nQubits; ++trgt) {
+        const bool inside = ctrl >= begin && ctrl < begin + window &&
+                            trgt >= begin && trgt < begin + window;
+        mask[ctrl][trgt] = mask[ctrl][trgt] && inside;
+      }
+    }
+  }
+  return masks;
+}
+
+bool connectsComponents(const std::vector<QubitPairMask>& masks,
+                        const std::vector<std::size_t>& components) {
+  const auto nQubits = components.size();
+  std::vector<std::size_t> parent(nQubits);
+  std::iota(parent.begin(), parent.end(), 0U);
+  const auto find = [&parent](std::size_t q) {
+    while (parent[q] != q) {
+      parent[q] = parent[parent[q]];
+      q = parent[q];
+    }
+    return q;
+  };
+  for (const auto& mask : masks) {
+    for (std::size_t ctrl = 0U; ctrl < nQubits; ++ctrl) {
+      for (std::size_t trgt = 0U; trgt < nQubits; ++trgt) {
+        if (mask[ctrl][trgt]) {
+          parent[find(ctrl)] = find(trgt);
+        }
+      }
+    }
+  }
+  for (std::size_t q = 0U; q < nQubits; ++q) {
+    if (find(q) != find(components[q])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace cs::encoding
@@ -7,21 +7,29 @@
 
 #include "Logic.hpp"
 #include "cliffordsynthesis/Results.hpp"
+#include "cliffordsynthesis/TargetMetric.hpp"
 #include "cliffordsynthesis/encoding/MultiGateEncoder.hpp"
 #include "cliffordsynthesis/encoding/ObjectiveEncoder.hpp"
+#include "cliffordsynthesis/encoding/QubitPairPruning.hpp"
 #include "cliffordsynthesis/encoding/SingleGateEncoder.hpp"
 #include "cliffordsynthesis/encoding/TableauEncoder.hpp"
+#include "logicblocks/Encodings.hpp"
+#include "logicblocks/Instances.hpp"
 #include "logicblocks/util_logicblock.hpp"
 
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <fstream>
 #include <functional>
 #include <memory>
+#include <nlohmann/json.hpp>
+#include <optional>
 #include <plog/Log.h>
 #include <stdexcept>
 #include <string>
 #include <variant>
+#include <vector>
 
 namespace cs::encoding {
 
@@ -47,10 +55,24 @@ void SATEncoder::initializeSolver() {
     }
   }
 
+  // The backend parameter selects the logic block of the SAT calls, MaxSAT
+  // always uses Z3's optimizer.
   if (config.useMaxSAT) {
+    if (logicutil::extractBackend(params) != logicutil::Backend::Z3) {
+      const auto* const msg = "MaxSAT is only supported by the z3 backend.";
+      PLOG_FATAL << msg;
+      throw std::invalid_argument(msg);
+    }
     lb = logicutil::getZ3LogicOptimizer(success, true, params);
   } else {
-    lb = logicutil::getZ3LogicBlock(success, true, params);
+    auto solverParams = params;
+    if (logicutil::extractBackend(solverParams) == logicutil::Backend::CNF &&
+        config.gateLimitEncoding ==
+            encodings::CardinalityEncoding::PseudoBoolean) {
+      // the cnf backend has no integer arithmetic to sum up the gates
+      config.gateLimitEncoding = encodings::CardinalityEncoding::Totalizer;
+    }
+    lb = logicutil::getLogicBlock(success, true, params);
   }
   if (!success) {
     const auto* const msg = "Could not initialize solver engine.";
@@ -81,6 +103,17 @@ void SATEncoder::createFormulation() {
     gateEncoder = std::make_shared<SingleGateEncoder>(
         N, s, T, tableauEncoder->getVariables(), lb);
   }
+  if (!config.couplingMap.empty() || config.pruneByInteraction ||
+      config.twoQubitGateWindow != 0U) {
+    std::vector<std::size_t> components{};
+    if (config.pruneByInteraction) {
+      components =
+          interactionComponents(*config.initialTableau, *config.targetTableau);
+    }
+    gateEncoder->restrictTwoQubitGates(
+        createQubitPairMasks(N, T, config.couplingMap, components,
+                             config.twoQubitGateWindow));
+  }
   gateEncoder->createSingleQubitGateVariables();
   gateEncoder->createTwoQubitGateVariables();
   gateEncoder->encodeGates();
@@ -93,12 +126,11 @@ void SATEncoder::createFormulation() {
       std::make_shared<ObjectiveEncoder>(N, T, gateEncoder->getVariables(), lb);
 
   if (config.gateLimit.has_value()) {
-    objectiveEncoder->limitGateCount(*config.gateLimit, std::less_equal{});
+    limitGateCount(*config.gateLimit, true);
   }
 
   if (config.twoQubitGateLimit.has_value()) {
-    objectiveEncoder->limitGateCount(*config.twoQubitGateLimit,
-                                     std::less_equal{}, false);
+    limitGateCount(*config.twoQubitGateLimit, false);
   }
 
   if (config.useMaxSAT) {
@@ -106,6 +138,7 @@ void SATEncoder::createFormulation() {
   }
 
   const auto end = std::chrono::high_resolution_clock::now();
+  lb->addEncodeTime(std::chrono::duration<double>(end - start).count());
   const auto duration =
       std::chrono::duration_cast<std::chrono::milliseconds>(end - start)
           .count();
@@ -136,10 +169,48 @@ void SATEncoder::cleanup() const {
     lb->reset();
   }
 }
+void SATEncoder::dumpInstance(
+    const std::optional<std::size_t> probeLimit) const {
+  if (config.instancesPath.empty()) {
+    return;
+  }
+  const auto base =
+      logicutil::dumpInstance(*lb, config.instancesPath, "clifford");
+  if (base.empty()) {
+    return;
+  }
+  nlohmann::basic_json<> meta{};
+  meta["source"] = "clifford_synthesis";
+  meta["qubits"] = N;
+  meta["timesteps"] = T;
+  meta["target_metric"] = toString(config.targetMetric);
+  meta["use_max_sat"] = config.useMaxSAT;
+  meta["multi_gate_encoding"] = config.useMultiGateEncoding;
+  meta["symmetry_breaking"] = config.useSymmetryBreaking;
+  if (config.gateLimit.has_value()) {
+    meta["gate_limit"] = *config.gateLimit;
+  }
+  if (config.twoQubitGateLimit.has_value()) {
+    meta["two_qubit_gate_limit"] = *config.twoQubitGateLimit;
+  }
+  meta["gate_limit_encoding"] = encodings::toString(config.gateLimitEncoding);
+  if (!config.couplingMap.empty()) {
+    meta["coupling_map"] = config.couplingMap;
+  }
+  meta["prune_by_interaction"] = config.pruneByInteraction;
+  meta["two_qubit_gate_window"] = config.twoQubitGateWindow;
+  if (probeLimit.has_value()) {
+    meta["probe_limit"] = *probeLimit;
+    meta["probe_includes_single_qubit_gates"] = limitSingleQubitGates;
+  }
+  std::ofstream(base + ".json") << meta.dump(2);
+}
+
 Results SATEncoder::run() {
   const auto start = std::chrono::high_resolution_clock::now();
 
   createFormulation();
+  dumpInstance();
   const auto solverResult = solve();
 
   const auto end = std::chrono::high_resolution_clock::now();
@@ -152,10 +223,67 @@ Results SATEncoder::run() {
   if (solverResult == Result::SAT) {
     extractResultsFromModel(res);
   }
+  res.setSolverStatistics(lb->getStatistics());
 
   cleanup();
 
   return res;
 }
 
+void SATEncoder::limitGateCount(const std::size_t limit,
+                                const bool includeSingleQubitGates) const {
+  if (config.gateLimitEncoding ==
+      encodings::CardinalityEncoding::PseudoBoolean) {
+    objectiveEncoder->limitGateCount(limit, std::less_equal{},
+                                     includeSingleQubitGates);
+  } else {
+    objectiveEncoder->limitGateCount(limit, config.gateLimitEncoding,
+                                     includeSingleQubitGates);
+  }
+}
+
+void SATEncoder::prepare(const std::size_t maxGateLimit,
+                         const bool includeSingleQubitGates) {
+  createFormulation();
+  limitSingleQubitGates = includeSingleQubitGates;
+  if (config.gateLimitEncoding !=
+      encodings::CardinalityEncoding::PseudoBoolean) {
+    // the counter is shared by all gate limits and, hence, must be created
+    // outside of any scope
+    objectiveEncoder->createGateCounter(maxGateLimit, config.gateLimitEncoding,
+                                        includeSingleQubitGates);
+  }
+}
+
+Results SATEncoder::runWithGateLimit(const std::size_t limit) {
+  const auto start = std::chrono::high_resolution_clock::now();
+
+  lb->push();
+  if (config.gateLimitEncoding ==
+      encodings::CardinalityEncoding::PseudoBoolean) {
+    objectiveEncoder->limitGateCount(limit, std::less_equal{},
+                                     limitSingleQubitGates);
+  } else {
+    objectiveEncoder->boundGateCount(limit);
+  }
+  dumpInstance(limit);
+  const auto solverResult = solve();
+
+  const auto end = std::chrono::high_resolution_clock::now();
+  const auto runtime = std::chrono::duration<double>(end - start);
+
+  Results res{};
+  res.setRuntime(runtime.count());
+  res.setSolverResult(solverResult);
+
+  if (solverResult == Result::SAT) {
+    extractResultsFromModel(res);
+  }
+  res.setSolverStatistics(lb->getStatistics());
+
+  lb->pop();
+
+  return res;
+}
+
 } // namespace cs::encoding
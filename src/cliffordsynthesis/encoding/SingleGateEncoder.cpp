@@ -68,7 +68,7 @@ void SingleGateEncoder::assertTwoQubitGateConstraints(const std::size_t pos) {
   const auto& twoQubitGates = vars.gC[pos];
   for (std::size_t ctrl = 0U; ctrl < N; ++ctrl) {
     for (std::size_t trgt = 0U; trgt < N; ++trgt) {
-      if (ctrl == trgt) {
+      if (!vars.isAllowed(pos, ctrl, trgt)) {
         continue;
       }
       const auto changes = createTwoQubitGateConstraint(pos, ctrl, trgt);
@@ -117,11 +117,12 @@ LogicTerm SingleGateEncoder::createNoGateOnQubit(const std::size_t pos,
   }
   const auto& twoQubitGates = vars.gC[pos];
   for (std::size_t i = 0; i < N; ++i) {
-    if (i == q) {
-      continue;
+    if (vars.isAllowed(pos, i, q)) {
+      noGate = noGate && !twoQubitGates[i][q];
+    }
+    if (vars.isAllowed(pos, q, i)) {
+      noGate = noGate && !twoQubitGates[q][i];
     }
-    noGate = noGate && !twoQubitGates[i][q];
-    noGate = noGate && !twoQubitGates[q][i];
   }
 
   return noGate;
@@ -185,6 +186,9 @@ void SingleGateEncoder::assertTwoQubitGateOrderConstraints(
   const auto& gSNext = vars.gS[pos + 1];
   for (const auto& [control, target] :
        {std::pair{ctrl, trgt}, std::pair{trgt, ctrl}}) {
+    if (!vars.isAllowed(pos, control, target)) {
+      continue;
+    }
     const auto& current = vars.gC[pos][control][target];
 
     // two identical CNOTs may not be applied in a row because they would
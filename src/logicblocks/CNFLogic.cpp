@@ -0,0 +1,564 @@
+#include "CNFLogic.hpp"
+
+#include "Logic.hpp"
+#include "LogicBlock.hpp"
+#include "LogicTerm.hpp"
+#include "Preprocessor.hpp"
+#include "SATSolver.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <initializer_list>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cnflogic {
+
+namespace {
+std::vector<Lit> extend(std::vector<Lit> bits, const std::size_t width,
+                        const Lit falseLit) {
+  bits.resize(std::max(bits.size(), width), falseLit);
+  return bits;
+}
+} // namespace
+
+void CNFLogicBlock::addClause(const std::initializer_list<Lit> clause) {
+  cnf.insert(cnf.end(), clause.begin(), clause.end());
+  cnf.emplace_back(0);
+  ++numClauses;
+}
+
+void CNFLogicBlock::addClause(const std::vector<Lit>& clause) {
+  cnf.insert(cnf.end(), clause.begin(), clause.end());
+  cnf.emplace_back(0);
+  ++numClauses;
+}
+
+Lit CNFLogicBlock::getTrue() {
+  if (trueLit == 0) {
+    trueLit = newVar();
+    addClause({trueLit});
+  }
+  return trueLit;
+}
+
+Lit CNFLogicBlock::makeAnd(const std::vector<Lit>& lits) {
+  const auto t = getTrue();
+  std::vector<Lit> operands;
+  operands.reserve(lits.size());
+  for (const auto l : lits) {
+    if (l == -t) {
+      return -t;
+    }
+    if (l != t) {
+      operands.emplace_back(l);
+    }
+  }
+  if (operands.empty()) {
+    return t;
+  }
+  if (operands.size() == 1U) {
+    return operands.front();
+  }
+  const auto x = newVar();
+  std::vector<Lit> back{x};
+  back.reserve(operands.size() + 1U);
+  for (const auto l : operands) {
+    addClause({-x, l});
+    back.emplace_back(-l);
+  }
+  addClause(back);
+  return x;
+}
+
+Lit CNFLogicBlock::makeOr(const std::vector<Lit>& lits) {
+  std::vector<Lit> negated;
+  negated.reserve(lits.size());
+  for (const auto l : lits) {
+    negated.emplace_back(-l);
+  }
+  return -makeAnd(negated);
+}
+
+Lit CNFLogicBlock::makeXor(const Lit a, const Lit b) {
+  const auto t = getTrue();
+  if (a == t || a == -t) {
+    return a == t ? -b : b;
+  }
+  if (b == t || b == -t) {
+    return b == t ? -a : a;
+  }
+  if (a == b) {
+    return -t;
+  }
+  if (a == -b) {
+    return t;
+  }
+  const auto x = newVar();
+  addClause({-x, a, b});
+  addClause({-x, -a, -b});
+  addClause({x, -a, b});
+  addClause({x, a, -b});
+  return x;
+}
+
+Lit CNFLogicBlock::makeIte(const Lit c, const Lit t, const Lit e) {
+  const auto tr = getTrue();
+  if (c == tr || t == e) {
+    return t;
+  }
+  if (c == -tr) {
+    return e;
+  }
+  const auto x = newVar();
+  addClause({-c, -t, x});
+  addClause({-c, t, -x});
+  addClause({c, -e, x});
+  addClause({c, e, -x});
+  return x;
+}
+
+Lit CNFLogicBlock::makeEqual(const std::vector<Lit>& a,
+                             const std::vector<Lit>& b) {
+  const auto width = std::max(a.size(), b.size());
+  const auto lhs = extend(a, width, -getTrue());
+  const auto rhs = extend(b, width, -getTrue());
+  std::vector<Lit> bits;
+  bits.reserve(width);
+  for (std::size_t i = 0U; i < width; ++i) {
+    bits.emplace_back(-makeXor(lhs[i], rhs[i]));
+  }
+  return makeAnd(bits);
+}
+
+Lit CNFLogicBlock::encodeBool(const LogicTerm& a) {
+  const auto bits = encode(a);
+  if (bits.size() == 1U) {
+    return bits.front();
+  }
+  // non-zero bit-vectors are true
+  return makeOr(bits);
+}
+
+std::vector<Lit> CNFLogicBlock::encode(const LogicTerm& a) {
+  switch (a.getOpType()) {
+  case OpType::Constant: {
+    const auto t = getTrue();
+    if (a.getCType() == CType::BOOL) {
+      return {a.getBoolValue() ? t : -t};
+    }
+    if (a.getCType() == CType::BITVECTOR) {
+      const auto value = a.getBitVectorValue();
+      std::vector<Lit> bits;
+      for (uint16_t i = 0U; i < a.getBitVectorSize(); ++i) {
+        bits.emplace_back(((value >> i) & 1U) != 0U ? t : -t);
+      }
+      return bits;
+    }
+    throw std::runtime_error("Unsupported constant type for CNF encoding");
+  }
+  case OpType::NEG: {
+    auto bits = encode(a.getNodes().front());
+    for (auto& l : bits) {
+      l = -l;
+    }
+    return bits;
+  }
+  default:
+    break;
+  }
+
+  if (const auto it = literals.find(a.getID()); it != literals.end()) {
+    ++cacheHits;
+    return it->second;
+  }
+  ++convertedNodes;
+  std::vector<Lit> bits;
+  if (a.getOpType() == OpType::Variable) {
+    if (a.getCType() == CType::BOOL) {
+      bits.emplace_back(newVar());
+    } else if (a.getCType() == CType::BITVECTOR) {
+      for (uint16_t i = 0U; i < a.getBitVectorSize(); ++i) {
+        bits.emplace_back(newVar());
+      }
+    } else {
+      throw std::runtime_error("Unsupported variable type for CNF encoding");
+    }
+  } else {
+    bits = encodeComposite(a);
+  }
+  return literals.emplace(a.getID(), std::move(bits)).first->second;
+}
+
+std::vector<Lit> CNFLogicBlock::encodeComposite(const LogicTerm& a) {
+  const auto& nodes = a.getNodes();
+  const auto isBool = [](const LogicTerm& t) {
+    return t.getCType() == CType::BOOL;
+  };
+  switch (a.getOpType()) {
+  case OpType::AND:
+  case OpType::OR: {
+    const auto terms = LogicTerm::getFlatTerms(a, a.getOpType());
+    std::vector<Lit> lits;
+    lits.reserve(terms.size());
+    for (const auto& n : terms) {
+      lits.emplace_back(encodeBool(n));
+    }
+    return {a.getOpType() == OpType::AND ? makeAnd(lits) : makeOr(lits)};
+  }
+  case OpType::IMPL:
+    return {makeOr({-encodeBool(nodes[0]), encodeBool(nodes[1])})};
+  case OpType::ITE: {
+    const auto c = encodeBool(nodes[0]);
+    const auto t = encode(nodes[1]);
+    const auto e = encode(nodes[2]);
+    const auto width = std::max(t.size(), e.size());
+    const auto tBits = extend(t, width, -getTrue());
+    const auto eBits = extend(e, width, -getTrue());
+    std::vector<Lit> bits;
+    bits.reserve(width);
+    for (std::size_t i = 0U; i < width; ++i) {
+      bits.emplace_back(makeIte(c, tBits[i], eBits[i]));
+    }
+    return bits;
+  }
+  case OpType::BitAnd:
+  case OpType::BitOr:
+  case OpType::BitXor: {
+    auto acc = encode(nodes[0]);
+    for (std::size_t k = 1U; k < nodes.size(); ++k) {
+      const auto other = encode(nodes[k]);
+      const auto width = std::max(acc.size(), other.size());
+      acc = extend(acc, width, -getTrue());
+      const auto rhs = extend(other, width, -getTrue());
+      for (std::size_t i = 0U; i < width; ++i) {
+        if (a.getOpType() == OpType::BitAnd) {
+          acc[i] = makeAnd({acc[i], rhs[i]});
+        } else if (a.getOpType() == OpType::BitOr) {
+          acc[i] = makeOr({acc[i], rhs[i]});
+        } else {
+          acc[i] = makeXor(acc[i], rhs[i]);
+        }
+      }
+    }
+    return acc;
+  }
+  case OpType::EQ:
+  case OpType::XOR:
+  case OpType::BitEq: {
+    const bool negated = a.getOpType() == OpType::XOR;
+    if (std::all_of(nodes.begin(), nodes.end(), isBool)) {
+      // chained (in)equivalences of Boolean terms
+      auto acc = encodeBool(nodes[0]);
+      for (std::size_t k = 1U; k < nodes.size(); ++k) {
+        const auto x = makeXor(acc, encodeBool(nodes[k]));
+        acc = negated ? x : -x;
+      }
+      return {acc};
+    }
+    const auto eq = makeEqual(encode(nodes[0]), encode(nodes[1]));
+    return {negated ? -eq : eq};
+  }
+  default:
+    throw std::runtime_error("Unsupported operation for CNF encoding: " +
+                             toString(a.getOpType()));
+  }
+}
+
+void CNFLogicBlock::addAssertion(std::vector<Lit> clause) {
+  if (!selectors.empty()) {
+    clause.emplace_back(-selectors.back());
+  }
+  addClause(clause);
+}
+
+void CNFLogicBlock::assertEncoded(const LogicTerm& a) {
+  switch (a.getOpType()) {
+  case OpType::AND:
+    for (const auto& n : LogicTerm::getFlatTerms(a, OpType::AND)) {
+      assertEncoded(n);
+    }
+    return;
+  case OpType::OR: {
+    // top-level disjunctions become clauses without auxiliary variables
+    const auto terms = LogicTerm::getFlatTerms(a, OpType::OR);
+    std::vector<Lit> clause;
+    clause.reserve(terms.size() + 1U);
+    for (const auto& n : terms) {
+      clause.emplace_back(encodeBool(n));
+    }
+    addAssertion(std::move(clause));
+    return;
+  }
+  case OpType::IMPL:
+    addAssertion({-encodeBool(a.getNodes()[0]), encodeBool(a.getNodes()[1])});
+    return;
+  default:
+    addAssertion({encodeBool(a)});
+  }
+}
+
+void CNFLogicBlock::emitClause(const LogicTerm& clause) {
+  assertEncoded(clause);
+}
+
+void CNFLogicBlock::produceInstance() {
+  LogicBlock::produceInstance();
+  if (preprocess && !preprocessor) {
+    runPreprocessor();
+    return;
+  }
+
+  std::vector<Lit> clause;
+  for (; numSubmitted < cnf.size(); ++numSubmitted) {
+    if (cnf[numSubmitted] == 0) {
+      submit(clause);
+      clause.clear();
+    } else {
+      clause.emplace_back(cnf[numSubmitted]);
+    }
+  }
+}
+
+void CNFLogicBlock::runPreprocessor() {
+  const auto start = std::chrono::steady_clock::now();
+  preprocessor = std::make_unique<Preprocessor>();
+  std::vector<Lit> clause;
+  for (; numSubmitted < cnf.size(); ++numSubmitted) {
+    if (cnf[numSubmitted] == 0) {
+      preprocessor->addClause(clause);
+      clause.clear();
+    } else {
+      clause.emplace_back(cnf[numSubmitted]);
+    }
+  }
+  // selectors are assumed in every call to solve()
+  for (const auto selector : selectors) {
+    preprocessor->freeze(selector);
+  }
+  preprocessor->simplify();
+  for (const auto& c : preprocessor->extractClauses()) {
+    solver->addClause(c);
+  }
+  preprocessTime = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+}
+
+void CNFLogicBlock::submit(const std::vector<Lit>& clause) {
+  if (!preprocessor) {
+    solver->addClause(clause);
+    return;
+  }
+  std::vector<std::vector<Lit>> restored;
+  const auto rewritten = preprocessor->rewrite(clause, restored);
+  for (const auto& c : restored) {
+    solver->addClause(c);
+  }
+  solver->addClause(rewritten);
+}
+
+void CNFLogicBlock::internalPush() { selectors.emplace_back(newVar()); }
+
+void CNFLogicBlock::internalPop() {
+  addClause({-selectors.back()});
+  selectors.pop_back();
+}
+
+Result CNFLogicBlock::solve() { return solve(std::vector<LogicTerm>{}); }
+
+Result CNFLogicBlock::solve(const std::vector<LogicTerm>& assumptions) {
+  std::vector<Lit> assumed(selectors);
+  assumed.reserve(selectors.size() + assumptions.size());
+  for (const auto& a : assumptions) {
+    assumed.emplace_back(encodeBool(a));
+  }
+  produceInstance();
+  if (preprocessor) {
+    std::vector<std::vector<Lit>> restored;
+    assumed = preprocessor->rewrite(assumed, restored);
+    for (const auto& c : restored) {
+      solver->addClause(c);
+    }
+  }
+  const auto start = std::chrono::steady_clock::now();
+  const auto res = solver->solve(assumed);
+  recordSolverCall(start);
+  stats.solver = solver->getStatistics();
+  if (preprocessor) {
+    for (const auto& [key, value] : preprocessor->getStatistics()) {
+      stats.solver["preprocess_" + key] = value;
+    }
+    stats.solver["preprocess_time"] = preprocessTime;
+  }
+  if (res == Result::SAT) {
+    std::vector<bool> values(static_cast<std::size_t>(numVars) + 1U);
+    for (int32_t v = 1; v <= numVars; ++v) {
+      values[static_cast<std::size_t>(v)] = solver->getValue(v);
+    }
+    if (preprocessor) {
+      preprocessor->extendModel(values);
+    }
+    delete model;
+    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+    model = new CNFModel(res, std::move(values));
+  }
+  return res;
+}
+
+void CNFLogicBlock::internalReset() {
+  solver->reset();
+  literals.clear();
+  cnf.clear();
+  numClauses = 0U;
+  numSubmitted = 0U;
+  numVars = 0;
+  trueLit = 0;
+  selectors.clear();
+  convertedNodes = 0U;
+  cacheHits = 0U;
+  preprocessor.reset();
+  preprocessTime = 0.;
+}
+
+const std::vector<Lit>& CNFLogicBlock::getLiterals(const LogicTerm& a) const {
+  static const std::vector<Lit> NONE{};
+  if (const auto it = literals.find(a.getID()); it != literals.end()) {
+    return it->second;
+  }
+  return NONE;
+}
+
+void CNFLogicBlock::dumpDIMACS(std::ostream& os) const {
+  os << "p cnf " << numVars << " " << numClauses << "\n";
+  for (const auto l : cnf) {
+    os << l << (l == 0 ? "\n" : " ");
+  }
+}
+
+void CNFLogicBlock::dumpWCNF(
+    std::ostream& os, const std::vector<std::pair<LogicTerm, double>>& soft) {
+  produceInstance();
+  std::vector<std::pair<Lit, uint64_t>> softLits;
+  uint64_t top = 1U;
+  for (const auto& [term, weight] : soft) {
+    const auto w = static_cast<uint64_t>(std::max(1LL, std::llround(weight)));
+    softLits.emplace_back(encodeBool(term), w);
+    top += w;
+  }
+  os << "p wcnf " << numVars << " " << numClauses + softLits.size() << " "
+     << top << "\n";
+  bool start = true;
+  for (const auto l : cnf) {
+    if (start) {
+      os << top << " ";
+    }
+    os << l << (l == 0 ? "\n" : " ");
+    start = l == 0;
+  }
+  for (const auto& [lit, weight] : softLits) {
+    os << weight << " " << lit << " 0\n";
+  }
+}
+
+std::string CNFLogicBlock::dumpInternalSolver() {
+  produceInstance();
+  std::stringstream ss;
+  dumpDIMACS(ss);
+  return ss.str();
+}
+
+void CNFLogicBlock::loadInstance(const std::string& filename) {
+  std::ifstream is(filename);
+  if (!is.good()) {
+    throw std::runtime_error("Could not open " + filename);
+  }
+  const auto offset = numVars;
+  std::vector<Lit> clause;
+  std::string token;
+  while (is >> token) {
+    if (token == "c") {
+      std::getline(is, token);
+      continue;
+    }
+    if (token == "p") {
+      std::string format;
+      is >> format;
+      if (format != "cnf") {
+        throw std::invalid_argument("Only DIMACS instances can be loaded into "
+                                    "a CNF logic block, " +
+                                    filename + " is " + format);
+      }
+      std::getline(is, token);
+      continue;
+    }
+    if (token.find_first_not_of("-0123456789") != std::string::npos) {
+      throw std::invalid_argument(filename + " is not a DIMACS instance");
+    }
+    const auto lit = static_cast<Lit>(std::stol(token));
+    if (lit == 0) {
+      addAssertion(clause);
+      ++stats.assertedClauses;
+      clause.clear();
+      continue;
+    }
+    const auto v = std::abs(lit) + offset;
+    numVars = std::max(numVars, v);
+    clause.emplace_back(lit > 0 ? v : -v);
+  }
+  if (!clause.empty()) {
+    throw std::invalid_argument("Unterminated clause in " + filename);
+  }
+}
+
+bool CNFModel::getLitValue(const Lit lit) const {
+  const auto v = static_cast<std::size_t>(std::abs(lit));
+  const bool value = v < values.size() && values[v];
+  return lit > 0 ? value : !value;
+}
+
+uint64_t CNFModel::getValue(const LogicTerm& a, LogicBlock* lb) const {
+  if (a.isConst()) {
+    return a.getBitVectorValue();
+  }
+  const auto* const block = dynamic_cast<CNFLogicBlock*>(lb);
+  if (block == nullptr) {
+    throw std::runtime_error("Model does not belong to a CNF logic block");
+  }
+  uint64_t value = 0U;
+  const auto& bits = block->getLiterals(a);
+  for (std::size_t i = 0U; i < bits.size() && i < 64U; ++i) {
+    if (getLitValue(bits[i])) {
+      value |= uint64_t{1} << i;
+    }
+  }
+  return value;
+}
+
+bool CNFModel::getBoolValue(const LogicTerm& a, LogicBlock* lb) {
+  return getValue(a, lb) != 0U;
+}
+
+uint64_t CNFModel::getBitvectorValue(const LogicTerm& a, LogicBlock* lb) {
+  return getValue(a, lb);
+}
+
+int CNFModel::getIntValue(const LogicTerm& /*a*/, LogicBlock* /*lb*/) {
+  throw std::runtime_error("Integer terms are not supported by CNF models");
+}
+
+double CNFModel::getRealValue(const LogicTerm& /*a*/, LogicBlock* /*lb*/) {
+  throw std::runtime_error("Real terms are not supported by CNF models");
+}
+
+} // namespace cnflogic
@@ -9,6 +9,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <iterator>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -106,6 +107,300 @@ LogicTerm atMostOneCmdr(const std::vector<NestedVar>& subords,
   return ret && naiveAtMostOne(clauseVars);
 }
 
+namespace {
+LogicTerm conjunction(const std::vector<LogicTerm>& terms, LogicBlock* logic) {
+  if (terms.empty()) {
+    return LogicTerm(true);
+  }
+  if (terms.size() == 1U) {
+    return terms.front();
+  }
+  return {OpType::AND, terms, CType::BOOL, logic};
+}
+} // namespace
+
+Cardinality::Cardinality(const std::vector<LogicTerm>& variables,
+                         const CardinalityEncoding cardinalityEncoding,
+                         LogicBlock* logicBlock, const Bounds requiredBounds,
+                         const std::size_t maximalBound)
+    : vars(variables), encoding(cardinalityEncoding), logic(logicBlock),
+      bounds(requiredBounds),
+      width(maximalBound < variables.size() ? maximalBound + 1U
+                                            : variables.size()) {
+  switch (encoding) {
+  case CardinalityEncoding::PseudoBoolean: {
+    std::vector<LogicTerm> summands;
+    summands.reserve(vars.size());
+    for (const auto& v : vars) {
+      summands.emplace_back(LogicTerm::ite(v, LogicTerm(1), LogicTerm(0)));
+    }
+    if (summands.size() == 1U) {
+      sum = summands.front();
+    } else if (summands.size() > 1U) {
+      sum = LogicTerm(OpType::ADD, summands, CType::INT, logic);
+    }
+    break;
+  }
+  case CardinalityEncoding::SequentialCounter:
+    // a totalizer degenerated to a chain, which yields Sinz' registers
+    for (const auto& v : vars) {
+      outputs = outputs.empty() ? std::vector<LogicTerm>{v}
+                                : merge(outputs, {v});
+    }
+    break;
+  case CardinalityEncoding::Totalizer:
+    outputs = buildTotalizer(0U, vars.size());
+    break;
+  case CardinalityEncoding::ModuloTotalizer: {
+    modulo = std::max<std::size_t>(
+        2U, static_cast<std::size_t>(
+                std::ceil(std::sqrt(static_cast<double>(width)))));
+    if (vars.empty()) {
+      break;
+    }
+    if (bounds != Bounds::AtLeast) {
+      counter = buildModulo(vars, 0U, vars.size());
+    }
+    if (bounds != Bounds::AtMost) {
+      // at least k variables hold iff at most n - k negations hold
+      std::vector<LogicTerm> negated;
+      negated.reserve(vars.size());
+      for (const auto& v : vars) {
+        negated.emplace_back(!v);
+      }
+      negatedCounter = buildModulo(negated, 0U, negated.size());
+    }
+    break;
+  }
+  }
+  definitions = conjunction(clauses, logic);
+  clauses.clear();
+}
+
+void Cardinality::addClause(const std::vector<LogicTerm>& lits) {
+  if (lits.size() == 1U) {
+    clauses.emplace_back(lits.front());
+  } else {
+    clauses.emplace_back(OpType::OR, lits, CType::BOOL, logic);
+  }
+}
+
+std::vector<LogicTerm> Cardinality::merge(const std::vector<LogicTerm>& a,
+                                          const std::vector<LogicTerm>& b) {
+  const auto n = std::min(a.size() + b.size(), width);
+  std::vector<LogicTerm> r;
+  r.reserve(n);
+  for (std::size_t i = 0U; i < n; ++i) {
+    r.emplace_back(logic->makeVariable("card_o"));
+  }
+  std::vector<LogicTerm> lits;
+  for (std::size_t i = 0U; i <= a.size() && i <= n; ++i) {
+    for (std::size_t j = 0U; j <= b.size() && i + j <= n; ++j) {
+      // a_i && b_j -> r_{i+j} (with a_0 and b_0 being true)
+      if (bounds != Bounds::AtLeast && i + j > 0U) {
+        lits.clear();
+        if (i > 0U) {
+          lits.emplace_back(!a[i - 1U]);
+        }
+        if (j > 0U) {
+          lits.emplace_back(!b[j - 1U]);
+        }
+        lits.emplace_back(r[i + j - 1U]);
+        addClause(lits);
+      }
+      // !a_{i+1} && !b_{j+1} -> !r_{i+j+1} (with a_{|a|+1} and b_{|b|+1}
+      // being false, which only holds if the children are not truncated)
+      if (bounds != Bounds::AtMost && i + j < n) {
+        lits.clear();
+        if (i < a.size()) {
+          lits.emplace_back(a[i]);
+        }
+        if (j < b.size()) {
+          lits.emplace_back(b[j]);
+        }
+        lits.emplace_back(!r[i + j]);
+        addClause(lits);
+      }
+    }
+  }
+  return r;
+}
+
+std::vector<LogicTerm> Cardinality::buildTotalizer(const std::size_t begin,
+                                                   const std::size_t end) {
+  if (end - begin <= 1U) {
+    return {vars.begin() + static_cast<std::ptrdiff_t>(begin),
+            vars.begin() + static_cast<std::ptrdiff_t>(end)};
+  }
+  const auto mid = begin + ((end - begin) / 2U);
+  return merge(buildTotalizer(begin, mid), buildTotalizer(mid, end));
+}
+
+Cardinality::ModuloCounter
+Cardinality::mergeModulo(const ModuloCounter& a, const ModuloCounter& b) {
+  const auto la = a.lower.size();
+  const auto lb = b.lower.size();
+  const bool carry = la + lb >= modulo;
+
+  ModuloCounter r;
+  for (std::size_t i = 0U; i < std::min(modulo - 1U, la + lb); ++i) {
+    r.lower.emplace_back(logic->makeVariable("card_l"));
+  }
+  const auto c = carry ? logic->makeVariable("card_c") : LogicTerm(false);
+  const auto nu = a.upper.size() + b.upper.size() + (carry ? 1U : 0U);
+  for (std::size_t i = 0U; i < nu; ++i) {
+    r.upper.emplace_back(logic->makeVariable("card_u"));
+  }
+
+  std::vector<LogicTerm> lits;
+  for (std::size_t i = 0U; i <= la; ++i) {
+    for (std::size_t j = 0U; j <= lb; ++j) {
+      if (i + j == 0U) {
+        continue;
+      }
+      std::vector<LogicTerm> premise;
+      if (i > 0U) {
+        premise.emplace_back(!a.lower[i - 1U]);
+      }
+      if (j > 0U) {
+        premise.emplace_back(!b.lower[j - 1U]);
+      }
+      lits = premise;
+      if (i + j < modulo) {
+        // the remainders add up to i + j or they overflow
+        lits.emplace_back(r.lower[i + j - 1U]);
+        if (carry) {
+          lits.emplace_back(c);
+        }
+        addClause(lits);
+        continue;
+      }
+      lits.emplace_back(c);
+      addClause(lits);
+      if (i + j > modulo) {
+        premise.emplace_back(r.lower[i + j - modulo - 1U]);
+        addClause(premise);
+      }
+    }
+  }
+  for (std::size_t i = 0U; i <= a.upper.size(); ++i) {
+    for (std::size_t j = 0U; j <= b.upper.size(); ++j) {
+      lits.clear();
+      if (i > 0U) {
+        lits.emplace_back(!a.upper[i - 1U]);
+      }
+      if (j > 0U) {
+        lits.emplace_back(!b.upper[j - 1U]);
+      }
+      if (i + j > 0U) {
+        lits.emplace_back(r.upper[i + j - 1U]);
+        addClause(lits);
+        lits.pop_back();
+      }
+      if (carry) {
+        lits.emplace_back(!c);
+        lits.emplace_back(r.upper[i + j]);
+        addClause(lits);
+      }
+    }
+  }
+  return r;
+}
+
+Cardinality::ModuloCounter
+Cardinality::buildModulo(const std::vector<LogicTerm>& lits,
+                         const std::size_t begin, const std::size_t end) {
+  if (end - begin == 1U) {
+    return {{lits[begin]}, {}};
+  }
+  const auto mid = begin + ((end - begin) / 2U);
+  return mergeModulo(buildModulo(lits, begin, mid),
+                     buildModulo(lits, mid, end));
+}
+
+LogicTerm Cardinality::moduloAtMost(const ModuloCounter& c,
+                                    const std::size_t k) const {
+  // sum <= q * p + r iff (sum div p) < q or ((sum div p) == q and
+  // (sum mod p) <= r)
+  const auto q = k / modulo;
+  const auto r = k % modulo;
+  std::vector<LogicTerm> parts;
+  if (q < c.upper.size()) {
+    parts.emplace_back(!c.upper[q]);
+  }
+  if (r < c.lower.size() && q <= c.upper.size()) {
+    if (q == 0U) {
+      parts.emplace_back(!c.lower[r]);
+    } else {
+      parts.emplace_back(!c.upper[q - 1U] || !c.lower[r]);
+    }
+  }
+  return conjunction(parts, logic);
+}
+
+LogicTerm Cardinality::atMost(const std::size_t k) const {
+  if (k >= vars.size()) {
+    return LogicTerm(true);
+  }
+  switch (encoding) {
+  case CardinalityEncoding::PseudoBoolean:
+    return sum <= LogicTerm(static_cast<int32_t>(k));
+  case CardinalityEncoding::ModuloTotalizer:
+    if (bounds == Bounds::AtLeast) {
+      throw std::invalid_argument("Counter does not encode upper bounds");
+    }
+    return moduloAtMost(counter, k);
+  default:
+    if (bounds == Bounds::AtLeast) {
+      throw std::invalid_argument("Counter does not encode upper bounds");
+    }
+    if (k >= outputs.size()) {
+      throw std::invalid_argument("Bound exceeds the maximal bound");
+    }
+    return !outputs[k];
+  }
+}
+
+LogicTerm Cardinality::atLeast(const std::size_t k) const {
+  if (k == 0U) {
+    return LogicTerm(true);
+  }
+  if (k > vars.size()) {
+    return LogicTerm(false);
+  }
+  switch (encoding) {
+  case CardinalityEncoding::PseudoBoolean:
+    return sum >= LogicTerm(static_cast<int32_t>(k));
+  case CardinalityEncoding::ModuloTotalizer:
+    if (bounds == Bounds::AtMost) {
+      throw std::invalid_argument("Counter does not encode lower bounds");
+    }
+    return moduloAtMost(negatedCounter, vars.size() - k);
+  default:
+    if (bounds == Bounds::AtMost) {
+      throw std::invalid_argument("Counter does not encode lower bounds");
+    }
+    if (k > outputs.size()) {
+      throw std::invalid_argument("Bound exceeds the maximal bound");
+    }
+    return outputs[k - 1U];
+  }
+}
+
+LogicTerm atMostK(const std::vector<LogicTerm>& vars, const std::size_t k,
+                  const CardinalityEncoding encoding, LogicBlock* logic) {
+  const Cardinality card(vars, encoding, logic, Cardinality::Bounds::AtMost,
+                         k);
+  return card.getDefinitions() && card.atMost(k);
+}
+
+LogicTerm atLeastK(const std::vector<LogicTerm>& vars, const std::size_t k,
+                   const CardinalityEncoding encoding, LogicBlock* logic) {
+  const Cardinality card(vars, encoding, logic, Cardinality::Bounds::AtLeast,
+                         k);
+  return card.getDefinitions() && card.atLeast(k);
+}
+
 std::vector<NestedVar> groupVars(const std::vector<LogicTerm>& vars,
                                  std::size_t maxSize) {
   std::vector<NestedVar> vVars;
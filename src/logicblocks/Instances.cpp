@@ -0,0 +1,83 @@
+#include "Instances.hpp"
+
+#include "Logic.hpp"
+#include "LogicBlock.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace logicutil {
+
+namespace {
+// file names must be unique across concurrent mapping and synthesis runs
+std::atomic<std::size_t> instanceCounter{0U};
+} // namespace
+
+InstanceFormat getInstanceFormat(const std::string& instance) {
+  std::istringstream is(instance);
+  std::string line;
+  while (std::getline(is, line)) {
+    if (line.empty() || line.front() == 'c') {
+      continue;
+    }
+    if (line.rfind("p wcnf", 0) == 0) {
+      return InstanceFormat::WCNF;
+    }
+    if (line.rfind("p cnf", 0) == 0) {
+      return InstanceFormat::DIMACS;
+    }
+    break;
+  }
+  return InstanceFormat::SMTLIB2;
+}
+
+std::string getExtension(const InstanceFormat format) {
+  switch (format) {
+  case InstanceFormat::DIMACS:
+    return ".cnf";
+  case InstanceFormat::WCNF:
+    return ".wcnf";
+  default:
+    return ".smt2";
+  }
+}
+
+std::string dumpInstance(LogicBlock& lb, const std::string& directory,
+                         const std::string& prefix) {
+  lb.produceInstance();
+  const auto instance = lb.dumpInternalSolver();
+  if (instance.empty()) {
+    return "";
+  }
+  const std::filesystem::path dir(directory);
+  std::filesystem::create_directories(dir);
+  const auto base =
+      (dir / (prefix + "_" + std::to_string(instanceCounter++))).string();
+  const auto filename = base + getExtension(getInstanceFormat(instance));
+  std::ofstream file(filename);
+  if (!file.good()) {
+    throw std::runtime_error("Could not write instance to " + filename);
+  }
+  file << instance;
+  return base;
+}
+
+ReplayResult replayInstance(LogicBlock& lb, const std::string& filename) {
+  const auto start = std::chrono::steady_clock::now();
+  lb.loadInstance(filename);
+  ReplayResult res;
+  res.result = lb.solve();
+  res.time = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                           start)
+                 .count();
+  res.statistics = lb.getStatistics();
+  return res;
+}
+
+} // namespace logicutil
@@ -4,6 +4,8 @@
 #include "LogicTerm.hpp"
 #include "Z3Model.hpp" // IWYU pragma: keep
 
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <stdexcept>
 #include <string>
@@ -11,20 +13,94 @@
 namespace logicbase {
 
 void LogicBlock::assertFormula(const LogicTerm& a) {
-  if (a.getOpType() == OpType::AND) {
-    for (const auto& clause : a.getNodes()) {
+  const auto start = std::chrono::steady_clock::now();
+  const auto assertClause = [this](const LogicTerm& clause) {
+    ++stats.assertedClauses;
+    if (retainClauses) {
+      retained.emplace_back(clause);
+    }
+    if (convertWhenAssert) {
+      emitClause(clause);
+    } else {
       clauses.insert(clause);
     }
+  };
+  ++stats.assertedFormulas;
+  if (a.getOpType() == OpType::AND) {
+    for (const auto& clause : LogicTerm::getFlatTerms(a, OpType::AND)) {
+      assertClause(clause);
+    }
   } else {
-    clauses.insert(a);
+    assertClause(a);
+  }
+  if (convertWhenAssert) {
+    stats.convertTime += std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
   }
 }
 
+void LogicBlock::produceInstance() {
+  if (clauses.empty()) {
+    return;
+  }
+  const auto start = std::chrono::steady_clock::now();
+  for (const auto& clause : clauses) {
+    emitClause(clause);
+  }
+  clauses.clear();
+  stats.convertTime +=
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+          .count();
+}
+
+void LogicBlock::recordSolverCall(
+    const std::chrono::steady_clock::time_point start) {
+  ++stats.solverCalls;
+  stats.solveTime +=
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+          .count();
+}
+
+void LogicBlock::push() {
+  // pending clauses belong to the enclosing scope
+  produceInstance();
+  scopes.emplace_back(retained.size());
+  internalPush();
+}
+
+void LogicBlock::pop() {
+  if (scopes.empty()) {
+    throw std::runtime_error("pop() without matching push()");
+  }
+  clauses.clear();
+  retained.erase(retained.begin() + static_cast<std::ptrdiff_t>(scopes.back()),
+                 retained.end());
+  scopes.pop_back();
+  internalPop();
+}
+
 LogicTerm LogicBlock::makeVariable(const std::string& name, CType type,
                                    uint16_t bvSize) {
   if (type == CType::BITVECTOR && bvSize == 0) {
     throw std::invalid_argument("bv_size must be > 0");
   }
+  switch (type) {
+  case CType::BOOL:
+    ++stats.boolVariables;
+    break;
+  case CType::INT:
+    ++stats.intVariables;
+    break;
+  case CType::REAL:
+    ++stats.realVariables;
+    break;
+  case CType::BITVECTOR:
+    ++stats.bitvectorVariables;
+    break;
+  default:
+    break;
+  }
   return {name, type, this, bvSize};
 }
 
@@ -32,15 +108,28 @@ void LogicBlock::reset() {
   delete model;
   model = nullptr;
   clauses.clear();
+  retained.clear();
+  scopes.clear();
+  stats = {};
   internalReset();
+  terms.clear();
   gid = 0U;
 }
 
+void LogicBlock::loadInstance(const std::string& filename) {
+  throw std::runtime_error("Loading " + filename +
+                           " is not supported by this backend");
+}
+
 void LogicBlockOptimizer::reset() {
   model = nullptr;
   clauses.clear();
+  retained.clear();
+  scopes.clear();
+  stats = {};
   weightedTerms.clear();
   internalReset();
+  terms.clear();
   gid = 0U;
 }
 
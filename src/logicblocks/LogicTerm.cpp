@@ -3,13 +3,15 @@
 #include "Logic.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <initializer_list>
+#include <functional>
 #include <limits>
 #include <ostream>
-#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -17,92 +19,59 @@
 
 namespace logicbase {
 
-uint64_t LogicTerm::getMaxChildrenDepth() const {
-  uint64_t max = 0;
-  for (const LogicTerm& t : getNodes()) {
-    const uint64_t d = t.getMaxChildrenDepth();
-    if (d > max) {
-      max = d;
-    }
-  }
-  return max + 1;
-}
+uint64_t LogicTerm::getMaxChildrenDepth() const { return getDepth() + 1; }
 
 std::string LogicTerm::getStrRep(OpType op) {
-  std::stringstream os;
   switch (op) {
   case OpType::Constant:
-    os << "CONST";
-    break;
+    return "CONST";
   case OpType::Variable:
-    os << "VAR";
-    break;
+    return "VAR";
   case OpType::AND:
-    os << "<AND ";
-    break;
+    return "<AND ";
   case OpType::OR:
-    os << "<OR ";
-    break;
+    return "<OR ";
   case OpType::BitAnd:
-    os << "<BV_AND ";
-    break;
+    return "<BV_AND ";
   case OpType::BitOr:
-    os << "<BV_OR ";
-    break;
+    return "<BV_OR ";
   case OpType::ITE:
-    os << "<ITE ";
-    break;
+    return "<ITE ";
   case OpType::NEG:
-    os << "<NEG ";
-    break;
+    return "<NEG ";
   case OpType::EQ:
-    os << "<EQ ";
-    break;
+    return "<EQ ";
   case OpType::XOR:
-    os << "<XOR ";
-    break;
+    return "<XOR ";
   case OpType::BitEq:
-    os << "<BV_EQ ";
-    break;
+    return "<BV_EQ ";
   case OpType::BitXor:
-    os << "<BV_XOR ";
-    break;
+    return "<BV_XOR ";
   case OpType::IMPL:
-    os << "<IMPL ";
-    break;
+    return "<IMPL ";
   case OpType::ADD:
-    os << "<ADD ";
-    break;
+    return "<ADD ";
   case OpType::SUB:
-    os << "<SUB ";
-    break;
+    return "<SUB ";
   case OpType::MUL:
-    os << "<MUL ";
-    break;
+    return "<MUL ";
   case OpType::DIV:
-    os << "<DIV ";
-    break;
+    return "<DIV ";
   case OpType::GT:
-    os << "<GT ";
-    break;
+    return "<GT ";
   case OpType::LT:
-    os << "<LT ";
-    break;
+    return "<LT ";
   case OpType::GTE:
-    os << "<GTE ";
-    break;
+    return "<GTE ";
   case OpType::LTE:
-    os << "<LTE ";
-    break;
+    return "<LTE ";
   default:
-    os << "<ERROR TYPE";
-    break;
+    return "<ERROR TYPE";
   }
-  return os.str();
 }
 
-LogicTerm::LogicTerm(const OpType op, const LogicTerm& a, const LogicTerm& b)
-    : lb(getValidLogicPtr(a, b)) {
+LogicTerm::LogicTerm(const OpType op, const LogicTerm& a, const LogicTerm& b) {
+  auto* const lb = getValidLogicPtr(a, b);
   if (a.isConst() || b.isConst()) {
     *this = combineConst(a, b, op, lb);
     return;
@@ -129,48 +98,116 @@ LogicTerm::LogicTerm(OpType op, const LogicTerm& a, const LogicTerm& b,
 
 uint64_t LogicTerm::getNextId(Logic* logic) {
   if (logic == nullptr) {
-    return gid++;
+    return gid.fetch_add(1, std::memory_order_relaxed);
   }
   return logic->getNextId();
 }
 
+TermStore& LogicTerm::storeOf(Logic* logic) {
+  if (logic == nullptr) {
+    return TermStore::global();
+  }
+  return logic->getTermStore();
+}
+
+namespace {
+// constants keep their value as raw bits in the handle
+uint64_t intBits(const int32_t v) { return static_cast<uint32_t>(v); }
+int32_t intValue(const uint64_t bits) {
+  return static_cast<int32_t>(static_cast<uint32_t>(bits));
+}
+uint64_t realBits(const double v) {
+  static_assert(sizeof(double) == sizeof(uint64_t));
+  uint64_t bits = 0U;
+  std::memcpy(&bits, &v, sizeof(bits));
+  return bits;
+}
+double realValue(const uint64_t bits) {
+  double v = 0.;
+  std::memcpy(&v, &bits, sizeof(v));
+  return v;
+}
+
+TermNode variableNode(const uint64_t id, std::string name, const CType type,
+                      const uint16_t bvs = 0) {
+  TermNode n{};
+  n.id = id;
+  n.name = std::move(name);
+  n.cType = type;
+  n.bvSize = bvs;
+  return n;
+}
+} // namespace
+
+LogicTerm::LogicTerm(const bool v)
+    : opType(OpType::Constant), cType(CType::BOOL), constant(v ? 1U : 0U) {}
+
+LogicTerm::LogicTerm(const int32_t v)
+    : opType(OpType::Constant), cType(CType::INT), constant(intBits(v)) {}
+
+LogicTerm::LogicTerm(const double v)
+    : opType(OpType::Constant), cType(CType::REAL), constant(realBits(v)) {}
+
+LogicTerm::LogicTerm(const uint64_t v, const uint16_t bvs)
+    : opType(OpType::Constant), cType(CType::BITVECTOR), bvSize(bvs),
+      constant(v) {}
+
 LogicTerm::LogicTerm(OpType op, const std::initializer_list<LogicTerm>& n,
                      CType type, Logic* logic)
-    : lb(logic), id(getNextId(logic)), depth(getMax(n)), name(getStrRep(op)),
-      opType(op), bvSize(getMaxBVSize(n)), nodes(n), cType(type) {}
+    : LogicTerm(op, std::vector<LogicTerm>(n), type, logic) {}
 
 LogicTerm::LogicTerm(OpType op, const std::vector<LogicTerm>& n, CType type,
-                     Logic* logic)
-    : lb(logic), id(getNextId(logic)), depth(getMax(n)), name(getStrRep(op)),
-      opType(op), bvSize(getMaxBVSize(n)), nodes(n), cType(type) {}
+                     Logic* logic) {
+  TermNode node{};
+  node.depth = getMax(n);
+  node.name = getStrRep(op);
+  node.opType = op;
+  node.bvSize = getMaxBVSize(n);
+  node.nodes = n;
+  node.cType = type;
+  *this = storeOf(logic).intern(std::move(node));
+}
 
-LogicTerm::LogicTerm(Logic* logic)
-    : lb(logic), id(getNextId(lb)), name(std::to_string(id)) {}
+LogicTerm::LogicTerm(Logic* logic) {
+  const auto id = getNextId(logic);
+  *this = storeOf(logic).add(
+      variableNode(id, std::to_string(id), CType::BOOL));
+}
 
-LogicTerm::LogicTerm(std::string n, Logic* logic)
-    : lb(logic), id(getNextId(lb)), name(std::move(n)) {}
+LogicTerm::LogicTerm(std::string n, Logic* logic) {
+  *this = storeOf(logic).add(
+      variableNode(getNextId(logic), std::move(n), CType::BOOL));
+}
 
-LogicTerm::LogicTerm(OpType op, std::string n, CType type,
-                     Logic* logic) // potentially , uint16_t bvs = 0
-    : lb(logic), id(getNextId(lb)), name(std::move(n)), opType(op),
-      cType(type) {}
+LogicTerm::LogicTerm(OpType op, std::string n, CType type, Logic* logic) {
+  auto node = variableNode(getNextId(logic), std::move(n), type);
+  node.opType = op;
+  *this = storeOf(logic).add(std::move(node));
+}
 
-LogicTerm::LogicTerm(std::string n, const uint64_t identifier, Logic* logic)
-    : lb(logic), id(identifier), name(std::move(n)) {}
+LogicTerm::LogicTerm(std::string n, const uint64_t identifier, Logic* logic) {
+  *this = storeOf(logic).add(
+      variableNode(identifier, std::move(n), CType::BOOL));
+}
 
-LogicTerm::LogicTerm(CType type, Logic* logic)
-    : lb(logic), id(getNextId(lb)), name(std::to_string(id)), cType(type) {}
+LogicTerm::LogicTerm(CType type, Logic* logic) {
+  const auto id = getNextId(logic);
+  *this = storeOf(logic).add(variableNode(id, std::to_string(id), type));
+}
 
-LogicTerm::LogicTerm(std::string n, CType type, Logic* logic, uint16_t bvs)
-    : lb(logic), id(getNextId(lb)), name(std::move(n)), bvSize(bvs),
-      cType(type) {}
+LogicTerm::LogicTerm(std::string n, CType type, Logic* logic, uint16_t bvs) {
+  *this = storeOf(logic).add(
+      variableNode(getNextId(logic), std::move(n), type, bvs));
+}
 
 LogicTerm::LogicTerm(std::string n, const uint64_t identifier, CType type,
-                     Logic* logic)
-    : lb(logic), id(identifier), name(std::move(n)), cType(type) {}
+                     Logic* logic) {
+  *this = storeOf(logic).add(variableNode(identifier, std::move(n), type));
+}
 
 LogicTerm LogicTerm::noneTerm() {
-  return {OpType::None, "None", CType::BOOL, nullptr};
+  static const LogicTerm NONE{OpType::None, "None", CType::BOOL, nullptr};
+  return NONE;
 }
 
 LogicTerm LogicTerm::eq(const LogicTerm& a, const LogicTerm& b) {
@@ -311,13 +348,13 @@ bool LogicTerm::isConst() const { return getOpType() == OpType::Constant; }
 bool LogicTerm::getBoolValue() const {
   switch (cType) {
   case CType::BOOL:
-    return value;
+    return constant != 0U;
   case CType::INT:
-    return iValue != 0;
+    return intValue(constant) != 0;
   case CType::REAL:
-    return fValue != 0;
+    return realValue(constant) != 0;
   case CType::BITVECTOR:
-    return bvValue != 0;
+    return constant != 0;
   default:
     return false;
   }
@@ -326,13 +363,13 @@ bool LogicTerm::getBoolValue() const {
 int LogicTerm::getIntValue() const {
   switch (cType) {
   case CType::BOOL:
-    return value ? 1 : 0;
+    return constant != 0U ? 1 : 0;
   case CType::INT:
-    return iValue;
+    return intValue(constant);
   case CType::REAL:
-    return static_cast<int32_t>(std::floor(fValue));
+    return static_cast<int32_t>(std::floor(realValue(constant)));
   case CType::BITVECTOR:
-    return static_cast<int>(bvValue);
+    return static_cast<int>(constant);
   default:
     return std::numeric_limits<int>::max();
   }
@@ -341,13 +378,13 @@ int LogicTerm::getIntValue() const {
 double LogicTerm::getFloatValue() const {
   switch (cType) {
   case CType::BOOL:
-    return value ? 1.0 : 0.0;
+    return constant != 0U ? 1.0 : 0.0;
   case CType::INT:
-    return iValue;
+    return intValue(constant);
   case CType::REAL:
-    return fValue;
+    return realValue(constant);
   case CType::BITVECTOR:
-    return static_cast<double>(bvValue);
+    return static_cast<double>(constant);
   default:
     return std::numeric_limits<double>::max();
   }
@@ -356,13 +393,13 @@ double LogicTerm::getFloatValue() const {
 uint64_t LogicTerm::getBitVectorValue() const {
   switch (cType) {
   case CType::BOOL:
-    return value ? 1.0 : 0.0;
+    return constant != 0U ? 1.0 : 0.0;
   case CType::INT:
-    return static_cast<uint64_t>(iValue);
+    return static_cast<uint64_t>(intValue(constant));
   case CType::REAL:
-    return static_cast<uint64_t>(fValue);
+    return static_cast<uint64_t>(realValue(constant));
   case CType::BITVECTOR:
-    return bvValue & (static_cast<uint64_t>(std::pow(2, bvSize)) - 1U);
+    return constant & (static_cast<uint64_t>(std::pow(2, bvSize)) - 1U);
   default:
     return std::numeric_limits<uint64_t>::max();
   }
@@ -383,7 +420,17 @@ uint16_t LogicTerm::getBitVectorSize() const {
   }
 }
 
+bool LogicTerm::sameNode(const LogicTerm& other) const {
+  return store == other.store && index == other.index &&
+         (store != nullptr || (cType == other.cType &&
+                               bvSize == other.bvSize &&
+                               constant == other.constant));
+}
+
 bool LogicTerm::deepEquals(const LogicTerm& other) const {
+  if (sameNode(other)) {
+    return true;
+  }
   if (getOpType() == OpType::Variable && getID() == other.getID()) {
     return true;
   }
@@ -448,15 +495,15 @@ Logic* LogicTerm::getValidLogicPtr(const LogicTerm& a, const LogicTerm& b,
 
 LogicTerm LogicTerm::combineTerms(const LogicTerm& a, const LogicTerm& b,
                                   OpType op, Logic* logic) {
-  if ((a.getOpType() == op || b.getOpType() == op) && isAssociative(op)) {
-    std::vector<LogicTerm> terms{};
-    terms.reserve(a.getNodes().size() + b.getNodes().size());
-
-    auto res = getFlatTerms(a, op);
-    terms.insert(terms.end(), res.begin(), res.end());
-    res = getFlatTerms(b, op);
-    terms.insert(terms.end(), res.begin(), res.end());
-
+  // Conjunctions, disjunctions, sums and products are only flattened when
+  // the term is converted (see getFlatTerms). Flattening them here would
+  // intern a new n-ary node per step of an accumulation like `x = x && y`,
+  // which the store keeps alive until it is cleared.
+  if ((op == OpType::EQ || op == OpType::XOR) &&
+      (a.getOpType() == op || b.getOpType() == op)) {
+    auto terms = getFlatTerms(a, op);
+    const auto rest = getFlatTerms(b, op);
+    terms.insert(terms.end(), rest.begin(), rest.end());
     return {op, terms, getTargetCType(a, b, op), logic};
   }
   return {op, a, b, getTargetCType(a, b, op), logic};
@@ -638,18 +685,18 @@ CType LogicTerm::getTargetCType(CType targetType, const LogicTerm& b) {
 }
 
 std::vector<LogicTerm> LogicTerm::getFlatTerms(const LogicTerm& t, OpType op) {
+  // iterative, since accumulated terms form chains as deep as they are long
   std::vector<LogicTerm> terms;
-  if (t.getOpType() != op) {
-    terms.push_back(t);
-  } else {
-    for (const LogicTerm& it : t.getNodes()) {
-      if (it.getOpType() != op) {
-        terms.push_back(it);
-      } else {
-        auto res = getFlatTerms(it, op);
-        terms.insert(terms.end(), res.begin(), res.end());
-      }
+  std::vector<LogicTerm> pending{t};
+  while (!pending.empty()) {
+    const auto term = pending.back();
+    pending.pop_back();
+    if (term.getOpType() != op) {
+      terms.push_back(term);
+      continue;
     }
+    const auto& nodes = term.getNodes();
+    pending.insert(pending.end(), nodes.rbegin(), nodes.rend());
   }
   return terms;
 }
@@ -716,4 +763,97 @@ bool TermDepthComparator::operator()(const LogicTerm& t1,
     return t1.getDepth() > t2.getDepth();
   }
 }
+
+TermStore::TermStore(Logic* logic, const bool sync)
+    : owner(logic), synchronized(sync), table(0U, NodeHash{this},
+                                              NodeEqual{this}) {}
+
+TermStore& TermStore::global() {
+  static TermStore store(nullptr, true);
+  return store;
+}
+
+std::unique_lock<std::mutex> TermStore::lock() const {
+  if (synchronized) {
+    return std::unique_lock<std::mutex>(mutex);
+  }
+  return {};
+}
+
+LogicTerm TermStore::push(TermNode n) {
+  if (nodes.size() >= std::numeric_limits<uint32_t>::max()) {
+    throw std::runtime_error("Term store exhausted");
+  }
+  const auto idx = static_cast<uint32_t>(nodes.size());
+  const auto op = n.opType;
+  const auto type = n.cType;
+  const auto bvs = n.bvSize;
+  nodes.emplace_back(std::move(n));
+  return {this, idx, op, type, bvs};
+}
+
+LogicTerm TermStore::add(TermNode n) {
+  const auto guard = lock();
+  return push(std::move(n));
+}
+
+LogicTerm TermStore::intern(TermNode n) {
+  const auto guard = lock();
+  const auto term = push(std::move(n));
+  const auto [it, inserted] = table.insert(term.index);
+  if (!inserted) {
+    nodes.pop_back();
+    return {this, *it, term.opType, term.cType, term.bvSize};
+  }
+  // ids are only handed out to new nodes
+  nodes.back().id = LogicTerm::getNextId(owner);
+  return term;
+}
+
+const TermNode& TermStore::at(const uint32_t idx) const {
+  const auto guard = lock();
+  return nodes[idx];
+}
+
+std::size_t TermStore::size() const {
+  const auto guard = lock();
+  return nodes.size();
+}
+
+void TermStore::clear() {
+  const auto guard = lock();
+  table.clear();
+  nodes.clear();
+}
+
+std::size_t TermStore::NodeHash::operator()(const uint32_t idx) const {
+  const auto& n = store->nodes[idx];
+  std::size_t h = (static_cast<std::size_t>(n.opType) << 8U) |
+                  static_cast<std::size_t>(n.cType);
+  const auto combine = [&h](const std::size_t v) {
+    h ^= v + 0x9e3779b9U + (h << 6U) + (h >> 2U);
+  };
+  for (const auto& child : n.nodes) {
+    combine(std::hash<const TermStore*>{}(child.store));
+    combine(child.index);
+    combine(std::hash<uint64_t>{}(child.constant));
+  }
+  return h;
+}
+
+bool TermStore::NodeEqual::operator()(const uint32_t lhs,
+                                      const uint32_t rhs) const {
+  const auto& a = store->nodes[lhs];
+  const auto& b = store->nodes[rhs];
+  if (a.opType != b.opType || a.cType != b.cType || a.bvSize != b.bvSize ||
+      a.nodes.size() != b.nodes.size() || a.name != b.name) {
+    return false;
+  }
+  for (std::size_t i = 0U; i < a.nodes.size(); ++i) {
+    if (!a.nodes[i].sameNode(b.nodes[i])) {
+      return false;
+    }
+  }
+  return true;
+}
 } // namespace logicbase
@@ -0,0 +1,332 @@
+#include "PortfolioLogic.hpp"
+
+#include "Logic.hpp"
+#include "LogicBlock.hpp"
+#include "LogicTerm.hpp"
+#include "Statistics.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace portfoliologic {
+
+namespace {
+// interrupts that arrive before an instance started solving may be lost, so
+// they are repeated in this interval until every instance has returned
+constexpr auto INTERRUPT_INTERVAL = std::chrono::milliseconds(10);
+
+struct Race {
+  std::mutex mutex;
+  std::condition_variable finishedSignal;
+  std::size_t finished = 0U;
+  std::vector<bool> done;
+  std::optional<std::size_t> winner;
+  Result result = Result::NDEF;
+  std::exception_ptr error;
+};
+
+/**
+ * @brief solves all instances concurrently until the first one returns a
+ * conclusive result (or `interrupted` is set) and interrupts the others
+ * @returns the result and the index of the instance that produced it
+ */
+template <class Block>
+std::pair<Result, std::size_t>
+race(const std::vector<std::unique_ptr<Block>>& instances,
+     const std::vector<LogicTerm>& assumptions,
+     const std::atomic<bool>& interrupted) {
+  Race state;
+  const auto n = instances.size();
+  state.done.resize(n, false);
+  std::vector<std::thread> threads;
+  threads.reserve(n);
+  for (std::size_t i = 0U; i < n; ++i) {
+    threads.emplace_back([&state, &instances, &assumptions, i]() {
+      auto res = Result::NDEF;
+      std::exception_ptr error;
+      try {
+        res = instances[i]->solve(assumptions);
+      } catch (...) {
+        error = std::current_exception();
+      }
+      const std::lock_guard lock(state.mutex);
+      ++state.finished;
+      state.done[i] = true;
+      if (res != Result::NDEF && !state.winner.has_value()) {
+        state.winner = i;
+        state.result = res;
+      }
+      if (error && !state.error) {
+        state.error = error;
+      }
+      state.finishedSignal.notify_all();
+    });
+  }
+
+  {
+    std::unique_lock lock(state.mutex);
+    while (!state.finishedSignal.wait_for(lock, INTERRUPT_INTERVAL, [&]() {
+      return state.winner.has_value() || state.finished == n ||
+             interrupted.load();
+    })) {
+    }
+    // instances that already returned are left alone, since some backends
+    // (e.g., Z3's optimizer) keep the interrupt until their next call
+    while (state.finished < n) {
+      for (std::size_t i = 0U; i < n; ++i) {
+        if (!state.done[i]) {
+          instances[i]->interrupt();
+        }
+      }
+      state.finishedSignal.wait_for(lock, INTERRUPT_INTERVAL,
+                                    [&]() { return state.finished == n; });
+    }
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  if (!state.winner.has_value()) {
+    if (state.error) {
+      std::rethrow_exception(state.error);
+    }
+    return {Result::NDEF, 0U};
+  }
+  return {state.result, *state.winner};
+}
+
+/// adds the conversion work of all instances and the solver statistics of the
+/// winning one to the statistics of the portfolio
+template <class Block>
+Statistics
+combineStatistics(Statistics stats,
+                  const std::vector<std::unique_ptr<Block>>& instances,
+                  const std::size_t winner) {
+  for (const auto& instance : instances) {
+    const auto instanceStats = instance->getStatistics();
+    stats.convertedNodes += instanceStats.convertedNodes;
+    stats.cacheHits += instanceStats.cacheHits;
+  }
+  stats.solver = instances[winner]->getStatistics().solver;
+  return stats;
+}
+} // namespace
+
+PortfolioLogicBlock::PortfolioLogicBlock(
+    std::vector<std::unique_ptr<LogicBlock>> blocks, const bool convert)
+    : LogicBlock(convert), instances(std::move(blocks)) {
+  if (instances.empty()) {
+    throw std::invalid_argument("A portfolio requires at least one instance");
+  }
+}
+
+void PortfolioLogicBlock::emitClause(const LogicTerm& clause) {
+  for (const auto& instance : instances) {
+    instance->assertFormula(clause);
+  }
+}
+
+void PortfolioLogicBlock::produceInstance() {
+  LogicBlock::produceInstance();
+  for (const auto& instance : instances) {
+    instance->produceInstance();
+  }
+}
+
+void PortfolioLogicBlock::internalPush() {
+  for (const auto& instance : instances) {
+    instance->push();
+  }
+}
+
+void PortfolioLogicBlock::internalPop() {
+  for (const auto& instance : instances) {
+    instance->pop();
+  }
+}
+
+Result PortfolioLogicBlock::solve() {
+  return solve(std::vector<LogicTerm>{});
+}
+
+Result PortfolioLogicBlock::solve(const std::vector<LogicTerm>& assumptions) {
+  produceInstance();
+  interrupted = false;
+  const auto start = std::chrono::steady_clock::now();
+  const auto [res, index] = race(instances, assumptions, interrupted);
+  recordSolverCall(start);
+  if (res == Result::SAT) {
+    winner = index;
+    delete model;
+    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+    model = new PortfolioModel(res, instances[index].get());
+  } else if (res == Result::UNSAT) {
+    winner = index;
+  }
+  return res;
+}
+
+void PortfolioLogicBlock::interrupt() {
+  // the running race forwards the interrupt to the unfinished instances
+  interrupted = true;
+}
+
+Statistics PortfolioLogicBlock::getStatistics() const {
+  return combineStatistics(stats, instances, winner);
+}
+
+void PortfolioLogicBlock::internalReset() {
+  for (const auto& instance : instances) {
+    instance->reset();
+  }
+  winner = 0U;
+}
+
+PortfolioLogicOptimizer::PortfolioLogicOptimizer(
+    std::vector<std::unique_ptr<LogicBlockOptimizer>> optimizers,
+    const bool convert)
+    : LogicBlockOptimizer(convert), instances(std::move(optimizers)) {
+  if (instances.empty()) {
+    throw std::invalid_argument("A portfolio requires at least one instance");
+  }
+}
+
+void PortfolioLogicOptimizer::emitClause(const LogicTerm& clause) {
+  for (const auto& instance : instances) {
+    instance->assertFormula(clause);
+  }
+}
+
+void PortfolioLogicOptimizer::produceInstance() {
+  LogicBlock::produceInstance();
+  for (const auto& instance : instances) {
+    instance->produceInstance();
+  }
+}
+
+void PortfolioLogicOptimizer::internalPush() {
+  for (const auto& instance : instances) {
+    instance->push();
+  }
+}
+
+void PortfolioLogicOptimizer::internalPop() {
+  for (const auto& instance : instances) {
+    instance->pop();
+  }
+}
+
+void PortfolioLogicOptimizer::forwardWeightedTerms() {
+  for (; forwardedTerms < weightedTerms.size(); ++forwardedTerms) {
+    const auto& [term, weight] = weightedTerms[forwardedTerms];
+    for (const auto& instance : instances) {
+      instance->weightedTerm(term, weight);
+    }
+  }
+}
+
+bool PortfolioLogicOptimizer::makeMinimize() {
+  forwardWeightedTerms();
+  bool res = false;
+  for (const auto& instance : instances) {
+    res = instance->makeMinimize();
+  }
+  return res;
+}
+
+bool PortfolioLogicOptimizer::makeMaximize() {
+  forwardWeightedTerms();
+  bool res = false;
+  for (const auto& instance : instances) {
+    res = instance->makeMaximize();
+  }
+  return res;
+}
+
+bool PortfolioLogicOptimizer::maximize(const LogicTerm& term) {
+  bool res = false;
+  for (const auto& instance : instances) {
+    res = instance->maximize(term);
+  }
+  return res;
+}
+
+bool PortfolioLogicOptimizer::minimize(const LogicTerm& term) {
+  bool res = false;
+  for (const auto& instance : instances) {
+    res = instance->minimize(term);
+  }
+  return res;
+}
+
+Result PortfolioLogicOptimizer::solve() {
+  return solve(std::vector<LogicTerm>{});
+}
+
+Result
+PortfolioLogicOptimizer::solve(const std::vector<LogicTerm>& assumptions) {
+  produceInstance();
+  interrupted = false;
+  const auto start = std::chrono::steady_clock::now();
+  const auto [res, index] = race(instances, assumptions, interrupted);
+  recordSolverCall(start);
+  if (res == Result::SAT) {
+    winner = index;
+    delete model;
+    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+    model = new PortfolioModel(res, instances[index].get());
+  } else if (res == Result::UNSAT) {
+    winner = index;
+  }
+  return res;
+}
+
+void PortfolioLogicOptimizer::interrupt() {
+  // the running race forwards the interrupt to the unfinished instances
+  interrupted = true;
+}
+
+Statistics PortfolioLogicOptimizer::getStatistics() const {
+  return combineStatistics(stats, instances, winner);
+}
+
+void PortfolioLogicOptimizer::internalReset() {
+  for (const auto& instance : instances) {
+    instance->reset();
+  }
+  winner = 0U;
+  forwardedTerms = 0U;
+}
+
+int PortfolioModel::getIntValue(const LogicTerm& a,
+                                [[maybe_unused]] LogicBlock* lb) {
+  return model->getIntValue(a, instance);
+}
+
+bool PortfolioModel::getBoolValue(const LogicTerm& a,
+                                  [[maybe_unused]] LogicBlock* lb) {
+  return model->getBoolValue(a, instance);
+}
+
+double PortfolioModel::getRealValue(const LogicTerm& a,
+                                    [[maybe_unused]] LogicBlock* lb) {
+  return model->getRealValue(a, instance);
+}
+
+uint64_t PortfolioModel::getBitvectorValue(const LogicTerm& a,
+                                           [[maybe_unused]] LogicBlock* lb) {
+  return model->getBitvectorValue(a, instance);
+}
+
+} // namespace portfoliologic
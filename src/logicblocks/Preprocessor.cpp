@@ -0,0 +1,565 @@
+#include "Preprocessor.hpp"
+
+#include "SATSolver.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cnflogic {
+
+namespace {
+constexpr std::size_t MAX_ROUNDS = 4U;
+// variables with more occurrences (of both polarities) are not eliminated
+constexpr std::size_t MAX_OCCURRENCES = 16U;
+constexpr std::size_t MAX_RESOLVENT_SIZE = 20U;
+
+Lit toLit(const uint32_t node) {
+  const auto v = static_cast<Lit>(node >> 1U) + 1;
+  return (node & 1U) != 0U ? -v : v;
+}
+} // namespace
+
+std::size_t Preprocessor::index(const Lit lit) {
+  const auto v = static_cast<std::size_t>(std::abs(lit)) - 1U;
+  return (v << 1U) | (lit < 0 ? 1U : 0U);
+}
+
+void Preprocessor::ensureVars(const int32_t v) {
+  if (v <= numVars) {
+    return;
+  }
+  numVars = v;
+  const auto n = static_cast<std::size_t>(v) + 1U;
+  fixed.resize(n, 0);
+  representatives.resize(n, 0);
+  frozen.resize(n, false);
+  occurrences.resize(2U * static_cast<std::size_t>(v));
+}
+
+int8_t Preprocessor::value(const Lit lit) const {
+  const auto v = std::abs(lit);
+  if (v > numVars) {
+    return 0;
+  }
+  const auto val = fixed[static_cast<std::size_t>(v)];
+  return lit > 0 ? val : static_cast<int8_t>(-val);
+}
+
+bool Preprocessor::contains(const uint32_t cref, const Lit lit) const {
+  const auto& clause = clauses[cref];
+  return std::binary_search(
+      clause.begin(), clause.end(), lit,
+      [](const Lit a, const Lit b) { return index(a) < index(b); });
+}
+
+bool Preprocessor::normalize(std::vector<Lit>& clause) const {
+  std::sort(clause.begin(), clause.end(),
+            [](const Lit a, const Lit b) { return index(a) < index(b); });
+  clause.erase(std::unique(clause.begin(), clause.end()), clause.end());
+  std::size_t j = 0U;
+  for (std::size_t i = 0U; i < clause.size(); ++i) {
+    const auto val = value(clause[i]);
+    if (val == 1 || (i + 1 < clause.size() && clause[i + 1] == -clause[i])) {
+      return false;
+    }
+    if (val == 0) {
+      clause[j++] = clause[i];
+    }
+  }
+  clause.resize(j);
+  return true;
+}
+
+void Preprocessor::addClause(const std::vector<Lit>& clause) {
+  for (const auto lit : clause) {
+    if (lit == 0) {
+      throw std::invalid_argument("0 is not a valid literal");
+    }
+    ensureVars(std::abs(lit));
+  }
+  std::vector<Lit> lits(clause);
+  if (ok && normalize(lits)) {
+    store(std::move(lits));
+  }
+}
+
+void Preprocessor::freeze(const int32_t v) {
+  ensureVars(v);
+  frozen[static_cast<std::size_t>(v)] = true;
+}
+
+void Preprocessor::assign(const Lit lit) {
+  const auto val = value(lit);
+  if (val == -1) {
+    ok = false;
+  } else if (val == 0) {
+    fixed[static_cast<std::size_t>(std::abs(lit))] = lit > 0 ? 1 : -1;
+    units.emplace_back(lit);
+  }
+}
+
+void Preprocessor::store(std::vector<Lit> clause) {
+  if (clause.empty()) {
+    ok = false;
+    return;
+  }
+  if (clause.size() == 1U) {
+    assign(clause.front());
+    return;
+  }
+  const auto cref = static_cast<uint32_t>(clauses.size());
+  for (const auto lit : clause) {
+    occurrences[index(lit)].emplace_back(cref);
+  }
+  clauses.emplace_back(std::move(clause));
+  deleted.emplace_back(false);
+  ++numActive;
+}
+
+void Preprocessor::remove(const uint32_t cref) {
+  deleted[cref] = true;
+  clauses[cref] = {};
+  --numActive;
+}
+
+std::vector<uint32_t> Preprocessor::collect(const Lit lit) {
+  auto& occs = occurrences[index(lit)];
+  std::sort(occs.begin(), occs.end());
+  occs.erase(std::unique(occs.begin(), occs.end()), occs.end());
+  occs.erase(std::remove_if(occs.begin(), occs.end(),
+                            [&](const uint32_t cref) {
+                              return deleted[cref] || !contains(cref, lit);
+                            }),
+             occs.end());
+  return occs;
+}
+
+bool Preprocessor::propagateUnits() {
+  bool changed = false;
+  while (ok && propagated < units.size()) {
+    const auto lit = units[propagated++];
+    changed = true;
+    for (const auto cref : collect(lit)) {
+      remove(cref);
+    }
+    for (const auto cref : collect(-lit)) {
+      auto& clause = clauses[cref];
+      clause.erase(std::remove(clause.begin(), clause.end(), -lit),
+                   clause.end());
+      if (clause.size() <= 1U) {
+        const auto remaining = clause;
+        remove(cref);
+        store(remaining);
+      }
+    }
+    occurrences[index(lit)].clear();
+    occurrences[index(-lit)].clear();
+  }
+  return changed;
+}
+
+bool Preprocessor::substituteEquivalences() {
+  // edges of the binary implication graph, nodes are literal indices
+  const auto n = 2U * static_cast<std::size_t>(numVars);
+  std::vector<std::vector<uint32_t>> graph(n);
+  bool hasEdges = false;
+  for (std::size_t cref = 0U; cref < clauses.size(); ++cref) {
+    const auto& clause = clauses[cref];
+    if (!deleted[cref] && clause.size() == 2U) {
+      graph[index(-clause[0])].emplace_back(index(clause[1]));
+      graph[index(-clause[1])].emplace_back(index(clause[0]));
+      hasEdges = true;
+    }
+  }
+  if (!hasEdges) {
+    return false;
+  }
+
+  // Tarjan's algorithm (iterative, since the graph may be deep)
+  constexpr auto UNVISITED = UINT32_MAX;
+  std::vector<uint32_t> order(n, UNVISITED);
+  std::vector<uint32_t> lowlink(n, 0U);
+  std::vector<uint32_t> component(n, UNVISITED);
+  std::vector<uint32_t> stack;
+  std::vector<std::pair<uint32_t, std::size_t>> calls;
+  std::vector<std::vector<uint32_t>> components;
+  uint32_t counter = 0U;
+  uint32_t numComponents = 0U;
+  const auto visit = [&](const uint32_t node) {
+    order[node] = lowlink[node] = counter++;
+    stack.emplace_back(node);
+    calls.emplace_back(node, 0U);
+  };
+  for (uint32_t root = 0U; root < n; ++root) {
+    if (order[root] != UNVISITED || graph[root].empty()) {
+      continue;
+    }
+    visit(root);
+    while (!calls.empty()) {
+      const auto node = calls.back().first;
+      if (calls.back().second < graph[node].size()) {
+        const auto next = graph[node][calls.back().second++];
+        if (order[next] == UNVISITED) {
+          visit(next);
+        } else if (component[next] == UNVISITED) {
+          lowlink[node] = std::min(lowlink[node], order[next]);
+        }
+        continue;
+      }
+      calls.pop_back();
+      if (!calls.empty()) {
+        auto& parent = lowlink[calls.back().first];
+        parent = std::min(parent, lowlink[node]);
+      }
+      if (lowlink[node] != order[node]) {
+        continue;
+      }
+      std::vector<uint32_t> members;
+      uint32_t member = 0U;
+      do {
+        member = stack.back();
+        stack.pop_back();
+        component[member] = numComponents;
+        members.emplace_back(member);
+      } while (member != node);
+      ++numComponents;
+      if (members.size() > 1U) {
+        components.emplace_back(std::move(members));
+      }
+    }
+  }
+
+  for (const auto& members : components) {
+    for (const auto member : members) {
+      if (component[member] == component[member ^ 1U]) {
+        // a literal is equivalent to its negation
+        ok = false;
+        return true;
+      }
+    }
+  }
+  const auto before = numSubstituted;
+  substitute(components);
+  return numSubstituted != before;
+}
+
+void Preprocessor::substitute(
+    const std::vector<std::vector<uint32_t>>& components) {
+  for (const auto& members : components) {
+    // a frozen representative keeps the variable in the formula, otherwise
+    // the smallest variable is chosen. Both choices are the same for the
+    // component of the negated literals.
+    const auto best = *std::min_element(
+        members.begin(), members.end(),
+        [&](const uint32_t a, const uint32_t b) {
+          const bool fa = frozen[(a >> 1U) + 1U];
+          const bool fb = frozen[(b >> 1U) + 1U];
+          return fa != fb ? fa : (a >> 1U) < (b >> 1U);
+        });
+    const auto rep = toLit(best);
+    for (const auto member : members) {
+      const auto lit = toLit(member);
+      const auto v = static_cast<std::size_t>(std::abs(lit));
+      if (std::abs(lit) == std::abs(rep) || representatives[v] != 0) {
+        continue;
+      }
+      const auto target = lit > 0 ? rep : -rep;
+      representatives[v] = target;
+      const auto x = static_cast<Lit>(v);
+      extension.push_back({x, {x, -target}});
+      extension.push_back({-x, {-x, target}});
+      ++numSubstituted;
+    }
+  }
+
+  for (uint32_t cref = 0U; cref < clauses.size(); ++cref) {
+    auto& clause = clauses[cref];
+    if (deleted[cref] ||
+        std::none_of(clause.begin(), clause.end(), [&](const Lit lit) {
+          return representatives[static_cast<std::size_t>(std::abs(lit))] !=
+                 0;
+        })) {
+      continue;
+    }
+    auto lits = clause;
+    for (auto& lit : lits) {
+      lit = getRepresentative(lit);
+    }
+    if (!normalize(lits)) {
+      remove(cref);
+      continue;
+    }
+    if (lits.size() <= 1U) {
+      remove(cref);
+      store(std::move(lits));
+      continue;
+    }
+    for (const auto lit : lits) {
+      occurrences[index(lit)].emplace_back(cref);
+    }
+    clause = std::move(lits);
+  }
+}
+
+bool Preprocessor::removeSubsumed() {
+  std::vector<uint32_t> candidates;
+  for (uint32_t cref = 0U; cref < clauses.size(); ++cref) {
+    if (!deleted[cref]) {
+      candidates.emplace_back(cref);
+    }
+  }
+  std::stable_sort(candidates.begin(), candidates.end(),
+                   [&](const uint32_t a, const uint32_t b) {
+                     return clauses[a].size() < clauses[b].size();
+                   });
+  const auto before = numSubsumed;
+  const auto less = [](const Lit a, const Lit b) {
+    return index(a) < index(b);
+  };
+  for (const auto cref : candidates) {
+    if (deleted[cref]) {
+      continue;
+    }
+    const auto& clause = clauses[cref];
+    // every clause that is subsumed contains the least frequent literal
+    const auto pivot = *std::min_element(
+        clause.begin(), clause.end(), [&](const Lit a, const Lit b) {
+          return occurrences[index(a)].size() < occurrences[index(b)].size();
+        });
+    for (const auto other : collect(pivot)) {
+      const auto& candidate = clauses[other];
+      if (other == cref || candidate.size() < clause.size()) {
+        continue;
+      }
+      if (std::includes(candidate.begin(), candidate.end(), clause.begin(),
+                        clause.end(), less)) {
+        remove(other);
+        ++numSubsumed;
+      }
+    }
+  }
+  return numSubsumed != before;
+}
+
+bool Preprocessor::eliminateVariables() {
+  std::vector<std::pair<std::size_t, int32_t>> candidates;
+  for (int32_t v = 1; v <= numVars; ++v) {
+    const auto i = static_cast<std::size_t>(v);
+    if (frozen[i] || fixed[i] != 0 || representatives[i] != 0 ||
+        isEliminated(v)) {
+      continue;
+    }
+    const auto pos = collect(v).size();
+    const auto neg = collect(-v).size();
+    if (pos + neg > 0U) {
+      candidates.emplace_back(pos * neg, v);
+    }
+  }
+  // cheap eliminations first
+  std::sort(candidates.begin(), candidates.end());
+
+  bool changed = false;
+  for (const auto& [cost, v] : candidates) {
+    if (!ok) {
+      break;
+    }
+    if (eliminate(v)) {
+      changed = true;
+      propagateUnits();
+    }
+  }
+  return changed;
+}
+
+bool Preprocessor::eliminate(const int32_t v) {
+  if (fixed[static_cast<std::size_t>(v)] != 0) {
+    return false;
+  }
+  const auto pos = collect(v);
+  const auto neg = collect(-v);
+  if (pos.empty() && neg.empty()) {
+    return false;
+  }
+  if (!pos.empty() && !neg.empty() &&
+      pos.size() + neg.size() > MAX_OCCURRENCES) {
+    return false;
+  }
+
+  // only eliminate if the resolvents do not increase the number of clauses
+  std::vector<std::vector<Lit>> resolvents;
+  for (const auto p : pos) {
+    for (const auto q : neg) {
+      std::vector<Lit> resolvent;
+      for (const auto lit : clauses[p]) {
+        if (lit != v) {
+          resolvent.emplace_back(lit);
+        }
+      }
+      for (const auto lit : clauses[q]) {
+        if (lit != -v) {
+          resolvent.emplace_back(lit);
+        }
+      }
+      if (!normalize(resolvent)) {
+        continue;
+      }
+      if (resolvent.size() > MAX_RESOLVENT_SIZE ||
+          resolvents.size() == pos.size() + neg.size()) {
+        return false;
+      }
+      resolvents.emplace_back(std::move(resolvent));
+    }
+  }
+
+  // as in MiniSat, the clauses of one polarity are kept for reconstructing
+  // the model, together with a default value for the variable
+  Elimination elimination{extension.size(), 0U, {}};
+  const bool keepPositive = pos.size() <= neg.size();
+  const auto witness = keepPositive ? v : -v;
+  for (const auto cref : keepPositive ? pos : neg) {
+    extension.push_back({witness, clauses[cref]});
+  }
+  extension.push_back({-witness, {-witness}});
+  elimination.last = extension.size();
+
+  for (const auto& side : {pos, neg}) {
+    for (const auto cref : side) {
+      elimination.clauses.emplace_back(std::move(clauses[cref]));
+      remove(cref);
+    }
+  }
+  eliminated.emplace(v, std::move(elimination));
+  for (auto& resolvent : resolvents) {
+    store(std::move(resolvent));
+  }
+  return true;
+}
+
+bool Preprocessor::simplify() {
+  for (std::size_t round = 0U; round < MAX_ROUNDS && ok; ++round) {
+    bool changed = propagateUnits();
+    if (ok && substituteEquivalences()) {
+      changed = true;
+      propagateUnits();
+    }
+    if (ok && removeSubsumed()) {
+      changed = true;
+    }
+    if (ok && eliminateVariables()) {
+      changed = true;
+    }
+    if (!changed) {
+      break;
+    }
+  }
+  return ok;
+}
+
+std::vector<std::vector<Lit>> Preprocessor::extractClauses() {
+  std::vector<std::vector<Lit>> result;
+  if (!ok) {
+    result.emplace_back();
+  } else {
+    result.reserve(units.size() + numActive);
+    for (const auto unit : units) {
+      result.push_back({unit});
+    }
+    for (std::size_t cref = 0U; cref < clauses.size(); ++cref) {
+      if (!deleted[cref]) {
+        result.emplace_back(std::move(clauses[cref]));
+      }
+    }
+  }
+  clauses.clear();
+  deleted.clear();
+  occurrences.clear();
+  occurrences.resize(2U * static_cast<std::size_t>(numVars));
+  numActive = 0U;
+  return result;
+}
+
+Lit Preprocessor::getRepresentative(Lit lit) const {
+  auto v = std::abs(lit);
+  while (v <= numVars && representatives[static_cast<std::size_t>(v)] != 0) {
+    const auto rep = representatives[static_cast<std::size_t>(v)];
+    lit = lit > 0 ? rep : -rep;
+    v = std::abs(lit);
+  }
+  return lit;
+}
+
+std::vector<Lit>
+Preprocessor::rewrite(const std::vector<Lit>& lits,
+                      std::vector<std::vector<Lit>>& restored) {
+  std::vector<Lit> result;
+  result.reserve(lits.size());
+  std::vector<int32_t> pending;
+  for (const auto lit : lits) {
+    result.emplace_back(getRepresentative(lit));
+    if (isEliminated(std::abs(result.back()))) {
+      pending.emplace_back(std::abs(result.back()));
+    }
+  }
+
+  // the restored clauses may mention further eliminated variables
+  while (!pending.empty()) {
+    const auto v = pending.back();
+    pending.pop_back();
+    const auto it = eliminated.find(v);
+    if (it == eliminated.end()) {
+      continue;
+    }
+    auto elimination = std::move(it->second);
+    eliminated.erase(it);
+    ++numRestored;
+    // the variable is part of the solver's formula again
+    for (auto i = elimination.first; i < elimination.last; ++i) {
+      extension[i] = {0, {}};
+    }
+    for (auto& clause : elimination.clauses) {
+      for (auto& lit : clause) {
+        lit = getRepresentative(lit);
+        if (isEliminated(std::abs(lit))) {
+          pending.emplace_back(std::abs(lit));
+        }
+      }
+      restored.emplace_back(std::move(clause));
+    }
+  }
+  return result;
+}
+
+void Preprocessor::extendModel(std::vector<bool>& values) const {
+  if (values.size() <= static_cast<std::size_t>(numVars)) {
+    values.resize(static_cast<std::size_t>(numVars) + 1U, false);
+  }
+  for (auto it = extension.rbegin(); it != extension.rend(); ++it) {
+    if (it->lit == 0) {
+      continue;
+    }
+    const bool satisfied =
+        std::any_of(it->clause.begin(), it->clause.end(), [&](const Lit lit) {
+          return values[static_cast<std::size_t>(std::abs(lit))] == (lit > 0);
+        });
+    if (!satisfied) {
+      values[static_cast<std::size_t>(std::abs(it->lit))] = it->lit > 0;
+    }
+  }
+}
+
+std::map<std::string, double> Preprocessor::getStatistics() const {
+  return {{"fixed", static_cast<double>(units.size())},
+          {"substituted", static_cast<double>(numSubstituted)},
+          {"subsumed", static_cast<double>(numSubsumed)},
+          {"eliminated", static_cast<double>(eliminated.size())},
+          {"restored", static_cast<double>(numRestored)}};
+}
+
+} // namespace cnflogic
@@ -0,0 +1,550 @@
+#include "SATSolver.hpp"
+
+#include "Logic.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cnflogic {
+
+namespace {
+constexpr double VAR_DECAY = 0.95;
+constexpr double CLAUSE_DECAY = 0.999;
+constexpr double RESTART_BASE = 100.;
+constexpr double RESTART_FACTOR = 2.;
+constexpr double LEARNT_GROWTH = 1.05;
+constexpr std::size_t MIN_LEARNTS = 1000U;
+} // namespace
+
+CDCLSolver::ILit CDCLSolver::toInternal(const Lit lit) {
+  if (lit == 0) {
+    throw std::invalid_argument("0 is not a valid literal");
+  }
+  const auto v = static_cast<uint32_t>(std::abs(lit)) - 1U;
+  return (v << 1U) | (lit < 0 ? 1U : 0U);
+}
+
+void CDCLSolver::ensureVars(const std::size_t n) {
+  const auto old = assigns.size();
+  if (n <= old) {
+    return;
+  }
+  assigns.resize(n, UNASSIGNED);
+  levels.resize(n, 0U);
+  reasons.resize(n, NO_REASON);
+  polarity.resize(n, true);
+  activity.resize(n, 0.);
+  heapIndex.resize(n, -1);
+  seen.resize(n, false);
+  watches.resize(2 * n);
+  for (auto v = old; v < n; ++v) {
+    if (seed != 0U) {
+      // small enough to be overridden by the first bump
+      polarity[v] = (rng() & 1U) != 0U;
+      activity[v] = 1e-5 * std::uniform_real_distribution<>(0., 1.)(rng);
+    }
+    heapInsert(static_cast<uint32_t>(v));
+  }
+}
+
+int8_t CDCLSolver::value(const ILit l) const {
+  const auto a = assigns[var(l)];
+  if (a == UNASSIGNED) {
+    return UNASSIGNED;
+  }
+  return static_cast<int8_t>(a ^ static_cast<int8_t>(l & 1U));
+}
+
+void CDCLSolver::addClause(const std::vector<Lit>& clause) {
+  if (!ok) {
+    return;
+  }
+  std::vector<ILit> lits;
+  lits.reserve(clause.size());
+  for (const auto lit : clause) {
+    lits.emplace_back(toInternal(lit));
+    ensureVars(var(lits.back()) + 1U);
+  }
+  std::sort(lits.begin(), lits.end());
+  lits.erase(std::unique(lits.begin(), lits.end()), lits.end());
+
+  // drop literals that are false at the top level and skip satisfied clauses
+  std::size_t j = 0U;
+  for (std::size_t i = 0U; i < lits.size(); ++i) {
+    const auto val = value(lits[i]);
+    if (val == 1 || (i + 1 < lits.size() && lits[i + 1] == negate(lits[i]))) {
+      return;
+    }
+    if (val == UNASSIGNED) {
+      lits[j++] = lits[i];
+    }
+  }
+  lits.resize(j);
+
+  if (lits.empty()) {
+    ok = false;
+  } else if (lits.size() == 1U) {
+    enqueue(lits.front(), NO_REASON);
+    ok = propagate() == NO_REASON;
+  } else {
+    storeClause(lits, false);
+  }
+}
+
+uint32_t CDCLSolver::storeClause(const std::vector<ILit>& lits,
+                                 const bool learnt) {
+  uint32_t cref = 0U;
+  if (freeClauses.empty()) {
+    cref = static_cast<uint32_t>(clauses.size());
+    clauses.emplace_back();
+  } else {
+    cref = freeClauses.back();
+    freeClauses.pop_back();
+  }
+  auto& c = clauses[cref];
+  c.offset = arena.size();
+  c.size = static_cast<uint32_t>(lits.size());
+  c.activity = 0.;
+  c.learnt = learnt;
+  c.deleted = false;
+  arena.insert(arena.end(), lits.begin(), lits.end());
+  watches[lits[0]].push_back({cref, lits[1]});
+  watches[lits[1]].push_back({cref, lits[0]});
+  if (learnt) {
+    ++numLearnts;
+  }
+  return cref;
+}
+
+void CDCLSolver::enqueue(const ILit l, const uint32_t reason) {
+  const auto v = var(l);
+  assigns[v] = static_cast<int8_t>((l & 1U) == 0U ? 1 : 0);
+  levels[v] = decisionLevel();
+  reasons[v] = reason;
+  trail.emplace_back(l);
+}
+
+uint32_t CDCLSolver::propagate() {
+  while (propagated < trail.size()) {
+    const auto falseLit = negate(trail[propagated++]);
+    auto& ws = watches[falseLit];
+    std::size_t i = 0U;
+    std::size_t j = 0U;
+    while (i < ws.size()) {
+      const auto w = ws[i++];
+      if (value(w.blocker) == 1) {
+        ws[j++] = w;
+        continue;
+      }
+      const auto& c = clauses[w.cref];
+      auto* lits = literals(c);
+      // make sure the false literal is the second watch
+      if (lits[0] == falseLit) {
+        std::swap(lits[0], lits[1]);
+      }
+      if (lits[0] != w.blocker && value(lits[0]) == 1) {
+        ws[j++] = {w.cref, lits[0]};
+        continue;
+      }
+      // look for a new literal to watch
+      bool moved = false;
+      for (std::size_t k = 2U; k < c.size; ++k) {
+        if (value(lits[k]) != 0) {
+          std::swap(lits[1], lits[k]);
+          watches[lits[1]].push_back({w.cref, lits[0]});
+          moved = true;
+          break;
+        }
+      }
+      if (moved) {
+        continue;
+      }
+      ws[j++] = {w.cref, lits[0]};
+      if (value(lits[0]) == 0) {
+        // conflict, keep the remaining watches
+        while (i < ws.size()) {
+          ws[j++] = ws[i++];
+        }
+        ws.resize(j);
+        propagated = trail.size();
+        return w.cref;
+      }
+      enqueue(lits[0], w.cref);
+    }
+    ws.resize(j);
+  }
+  return NO_REASON;
+}
+
+void CDCLSolver::analyze(uint32_t conflict, std::vector<ILit>& learnt,
+                         uint32_t& backtrackLevel) {
+  learnt.clear();
+  learnt.emplace_back(0U); // placeholder for the asserting literal
+  std::size_t pathCount = 0U;
+  auto index = trail.size();
+  ILit p = 0U;
+  bool first = true;
+
+  do {
+    auto& c = clauses[conflict];
+    if (c.learnt) {
+      bumpClause(c);
+    }
+    const auto* lits = literals(c);
+    for (std::size_t k = first ? 0U : 1U; k < c.size; ++k) {
+      const auto q = lits[k];
+      const auto v = var(q);
+      if (!seen[v] && levels[v] > 0U) {
+        bumpVar(v);
+        seen[v] = true;
+        if (levels[v] >= decisionLevel()) {
+          ++pathCount;
+        } else {
+          learnt.emplace_back(q);
+        }
+      }
+    }
+    // select the next literal on the trail to resolve on
+    do {
+      --index;
+    } while (!seen[var(trail[index])]);
+    p = trail[index];
+    conflict = reasons[var(p)];
+    seen[var(p)] = false;
+    --pathCount;
+    first = false;
+  } while (pathCount > 0U);
+  learnt[0] = negate(p);
+
+  // the literal with the highest level becomes the second watch
+  backtrackLevel = 0U;
+  if (learnt.size() > 1U) {
+    std::size_t maxIndex = 1U;
+    for (std::size_t k = 2U; k < learnt.size(); ++k) {
+      if (levels[var(learnt[k])] > levels[var(learnt[maxIndex])]) {
+        maxIndex = k;
+      }
+    }
+    std::swap(learnt[1], learnt[maxIndex]);
+    backtrackLevel = levels[var(learnt[1])];
+  }
+  for (const auto l : learnt) {
+    seen[var(l)] = false;
+  }
+}
+
+void CDCLSolver::cancelUntil(const uint32_t level) {
+  if (decisionLevel() <= level) {
+    return;
+  }
+  for (auto i = trail.size(); i > trailLimits[level]; --i) {
+    const auto l = trail[i - 1];
+    const auto v = var(l);
+    assigns[v] = UNASSIGNED;
+    reasons[v] = NO_REASON;
+    polarity[v] = (l & 1U) != 0U;
+    if (heapIndex[v] < 0) {
+      heapInsert(v);
+    }
+  }
+  trail.resize(trailLimits[level]);
+  trailLimits.resize(level);
+  propagated = trail.size();
+}
+
+bool CDCLSolver::isLocked(const uint32_t cref) const {
+  const auto l = arena[clauses[cref].offset];
+  return reasons[var(l)] == cref && value(l) == 1;
+}
+
+void CDCLSolver::reduceLearnts() {
+  std::vector<uint32_t> learnts;
+  for (uint32_t cref = 0U; cref < clauses.size(); ++cref) {
+    const auto& c = clauses[cref];
+    if (c.learnt && !c.deleted && c.size > 2U && !isLocked(cref)) {
+      learnts.emplace_back(cref);
+    }
+  }
+  std::sort(learnts.begin(), learnts.end(), [this](uint32_t a, uint32_t b) {
+    return clauses[a].activity < clauses[b].activity;
+  });
+  learnts.resize(learnts.size() / 2);
+  if (learnts.empty()) {
+    return;
+  }
+  for (const auto cref : learnts) {
+    clauses[cref].deleted = true;
+    garbage += clauses[cref].size;
+    freeClauses.emplace_back(cref);
+  }
+  for (auto& ws : watches) {
+    ws.erase(std::remove_if(ws.begin(), ws.end(),
+                            [this](const Watcher& w) {
+                              return clauses[w.cref].deleted;
+                            }),
+             ws.end());
+  }
+  numLearnts -= learnts.size();
+
+  // compact the arena once most of it is garbage
+  if (2U * garbage > arena.size()) {
+    std::vector<ILit> compacted;
+    compacted.reserve(arena.size() - garbage);
+    for (auto& c : clauses) {
+      if (c.deleted) {
+        continue;
+      }
+      const auto* const lits = literals(c);
+      const auto offset = compacted.size();
+      compacted.insert(compacted.end(), lits, lits + c.size);
+      c.offset = offset;
+    }
+    arena = std::move(compacted);
+    garbage = 0U;
+  }
+}
+
+void CDCLSolver::bumpVar(const uint32_t v) {
+  activity[v] += varIncrement;
+  if (activity[v] > 1e100) {
+    for (auto& a : activity) {
+      a *= 1e-100;
+    }
+    varIncrement *= 1e-100;
+  }
+  if (heapIndex[v] >= 0) {
+    heapUp(static_cast<std::size_t>(heapIndex[v]));
+  }
+}
+
+void CDCLSolver::bumpClause(Clause& c) {
+  c.activity += clauseIncrement;
+  if (c.activity > 1e20) {
+    for (auto& other : clauses) {
+      if (other.learnt) {
+        other.activity *= 1e-20;
+      }
+    }
+    clauseIncrement *= 1e-20;
+  }
+}
+
+void CDCLSolver::heapUp(std::size_t pos) {
+  const auto v = heap[pos];
+  while (pos > 0U) {
+    const auto parent = (pos - 1U) / 2U;
+    if (activity[heap[parent]] >= activity[v]) {
+      break;
+    }
+    heap[pos] = heap[parent];
+    heapIndex[heap[pos]] = static_cast<int32_t>(pos);
+    pos = parent;
+  }
+  heap[pos] = v;
+  heapIndex[v] = static_cast<int32_t>(pos);
+}
+
+void CDCLSolver::heapDown(std::size_t pos) {
+  const auto v = heap[pos];
+  while (true) {
+    auto child = (2U * pos) + 1U;
+    if (child >= heap.size()) {
+      break;
+    }
+    if (child + 1U < heap.size() &&
+        activity[heap[child + 1U]] > activity[heap[child]]) {
+      ++child;
+    }
+    if (activity[heap[child]] <= activity[v]) {
+      break;
+    }
+    heap[pos] = heap[child];
+    heapIndex[heap[pos]] = static_cast<int32_t>(pos);
+    pos = child;
+  }
+  heap[pos] = v;
+  heapIndex[v] = static_cast<int32_t>(pos);
+}
+
+void CDCLSolver::heapInsert(const uint32_t v) {
+  heap.emplace_back(v);
+  heapUp(heap.size() - 1U);
+}
+
+uint32_t CDCLSolver::heapPop() {
+  const auto top = heap.front();
+  heapIndex[top] = -1;
+  heap.front() = heap.back();
+  heap.pop_back();
+  if (!heap.empty()) {
+    heapDown(0U);
+  }
+  return top;
+}
+
+double CDCLSolver::luby(const double y, std::size_t x) {
+  std::size_t size = 1U;
+  int seq = 0;
+  while (size < x + 1U) {
+    ++seq;
+    size = (2U * size) + 1U;
+  }
+  while (size - 1U != x) {
+    size = (size - 1U) >> 1U;
+    --seq;
+    x = x % size;
+  }
+  return std::pow(y, seq);
+}
+
+Result CDCLSolver::solve(const std::vector<Lit>& assumptions) {
+  model.clear();
+  interrupted = false;
+  const auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::milliseconds(timeout);
+  if (!ok) {
+    return Result::UNSAT;
+  }
+  std::vector<ILit> assumed;
+  assumed.reserve(assumptions.size());
+  for (const auto lit : assumptions) {
+    assumed.emplace_back(toInternal(lit));
+    ensureVars(var(assumed.back()) + 1U);
+  }
+  auto maxLearnts = std::max(clauses.size() / 3U, MIN_LEARNTS);
+  std::vector<ILit> learnt;
+  for (std::size_t restarts = 0U;; ++restarts) {
+    const auto budget = luby(RESTART_FACTOR, restarts) * RESTART_BASE;
+    std::size_t conflictsInRestart = 0U;
+    while (true) {
+      const auto conflict = propagate();
+      if (conflict != NO_REASON) {
+        ++conflicts;
+        ++conflictsInRestart;
+        if (decisionLevel() == 0U) {
+          ok = false;
+          return Result::UNSAT;
+        }
+        uint32_t backtrackLevel = 0U;
+        analyze(conflict, learnt, backtrackLevel);
+        cancelUntil(backtrackLevel);
+        if (learnt.size() == 1U) {
+          enqueue(learnt.front(), NO_REASON);
+        } else {
+          const auto cref = storeClause(learnt, true);
+          bumpClause(clauses[cref]);
+          enqueue(learnt.front(), cref);
+        }
+        varIncrement /= VAR_DECAY;
+        clauseIncrement /= CLAUSE_DECAY;
+        if (interrupted.load(std::memory_order_relaxed) ||
+            (timeout != 0U && std::chrono::steady_clock::now() >= deadline)) {
+          cancelUntil(0U);
+          return Result::NDEF;
+        }
+        continue;
+      }
+
+      if (static_cast<double>(conflictsInRestart) >= budget) {
+        cancelUntil(0U);
+        break;
+      }
+      if (numLearnts >= maxLearnts + trail.size()) {
+        reduceLearnts();
+      }
+
+      // assumptions are decided first, one per decision level
+      ILit next = NO_LIT;
+      while (decisionLevel() < assumed.size()) {
+        const auto p = assumed[decisionLevel()];
+        const auto val = value(p);
+        if (val == UNASSIGNED) {
+          next = p;
+          break;
+        }
+        if (val == 0) {
+          // the formula implies the negation of the assumptions
+          cancelUntil(0U);
+          return Result::UNSAT;
+        }
+        trailLimits.emplace_back(trail.size());
+      }
+      // otherwise pick the unassigned variable with the highest activity
+      while (next == NO_LIT && !heap.empty()) {
+        const auto v = heapPop();
+        if (assigns[v] == UNASSIGNED) {
+          next = (v << 1U) | (polarity[v] ? 1U : 0U);
+        }
+      }
+      if (next == NO_LIT) {
+        model.resize(assigns.size());
+        for (std::size_t v = 0U; v < assigns.size(); ++v) {
+          model[v] = assigns[v] == 1;
+        }
+        cancelUntil(0U);
+        return Result::SAT;
+      }
+      ++decisions;
+      trailLimits.emplace_back(trail.size());
+      enqueue(next, NO_REASON);
+    }
+    maxLearnts = static_cast<std::size_t>(static_cast<double>(maxLearnts) *
+                                          LEARNT_GROWTH);
+  }
+}
+
+bool CDCLSolver::getValue(const int32_t v) const {
+  if (v <= 0 || static_cast<std::size_t>(v) > model.size()) {
+    return false;
+  }
+  return model[static_cast<std::size_t>(v) - 1U];
+}
+
+std::map<std::string, double> CDCLSolver::getStatistics() const {
+  return {{"variables", static_cast<double>(assigns.size())},
+          {"clauses", static_cast<double>(clauses.size() - freeClauses.size() -
+                                          numLearnts)},
+          {"learnt_clauses", static_cast<double>(numLearnts)},
+          {"conflicts", static_cast<double>(conflicts)},
+          {"decisions", static_cast<double>(decisions)}};
+}
+
+void CDCLSolver::reset() {
+  arena.clear();
+  garbage = 0U;
+  clauses.clear();
+  freeClauses.clear();
+  watches.clear();
+  assigns.clear();
+  levels.clear();
+  reasons.clear();
+  polarity.clear();
+  model.clear();
+  trail.clear();
+  trailLimits.clear();
+  propagated = 0U;
+  ok = true;
+  activity.clear();
+  varIncrement = 1.;
+  clauseIncrement = 1.;
+  heap.clear();
+  heapIndex.clear();
+  seen.clear();
+  numLearnts = 0U;
+  conflicts = 0U;
+  decisions = 0U;
+  rng.seed(seed);
+  interrupted = false;
+}
+
+} // namespace cnflogic
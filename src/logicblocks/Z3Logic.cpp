@@ -4,9 +4,11 @@
 #include "LogicTerm.hpp"
 #include "Z3Model.hpp"
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <plog/Log.h>
 #include <sstream>
@@ -54,11 +56,12 @@ z3::expr Z3Base::convert(const LogicTerm& a, CType toType) {
   std::vector<std::pair<bool, z3::expr>> v;
 
   // First, try to find the expression in the cache
-  if (cache.find(a) != cache.end()) {
-    v = cache.at(a);
-    if (v[static_cast<size_t>(toType)].first) {
-      return v[static_cast<size_t>(toType)].second;
+  if (const auto it = cache.find(a); it != cache.end()) {
+    if (it->second[static_cast<size_t>(toType)].first) {
+      ++cacheHits;
+      return it->second[static_cast<size_t>(toType)].second;
     }
+    v = it->second;
   } else {
     for (int32_t i = 0; i < 4; i++) {
       v.emplace_back(false, ctx->bool_val(false));
@@ -74,7 +77,7 @@ z3::expr Z3Base::convert(const LogicTerm& a, CType toType) {
   case OpType::AND: {
     z3::expr s = this->ctx->bool_val(true);
     bool alternate = false;
-    for (const LogicTerm& lt : a.getNodes()) {
+    for (const LogicTerm& lt : LogicTerm::getFlatTerms(a, OpType::AND)) {
       if (alternate) {
         s = s && convert(lt, toType);
       } else {
@@ -87,7 +90,7 @@ z3::expr Z3Base::convert(const LogicTerm& a, CType toType) {
   case OpType::OR: {
     z3::expr s = this->ctx->bool_val(false);
     bool alternate = false;
-    for (const LogicTerm& lt : a.getNodes()) {
+    for (const LogicTerm& lt : LogicTerm::getFlatTerms(a, OpType::OR)) {
       if (alternate) {
         s = s || convert(lt, toType);
       } else {
@@ -119,16 +122,18 @@ z3::expr Z3Base::convert(const LogicTerm& a, CType toType) {
         a.getNodes()[0], a.getNodes()[1], z3::implies, CType::BOOL);
     break;
   case OpType::ADD: {
-    v[static_cast<size_t>(toType)].second = convertOperator(
-        a.getNodes(), z3::operator+, extractNumberType(a.getNodes()));
+    const auto terms = LogicTerm::getFlatTerms(a, OpType::ADD);
+    v[static_cast<size_t>(toType)].second =
+        convertOperator(terms, z3::operator+, extractNumberType(terms));
   } break;
   case OpType::SUB: {
     v[static_cast<size_t>(toType)].second = convertOperator(
         a.getNodes(), z3::operator-, extractNumberType(a.getNodes()));
   } break;
   case OpType::MUL: {
-    v[static_cast<size_t>(toType)].second = convertOperator(
-        a.getNodes(), z3::operator*, extractNumberType(a.getNodes()));
+    const auto terms = LogicTerm::getFlatTerms(a, OpType::MUL);
+    v[static_cast<size_t>(toType)].second =
+        convertOperator(terms, z3::operator*, extractNumberType(terms));
   } break;
   case OpType::DIV: {
     v[static_cast<size_t>(toType)].second =
@@ -179,47 +184,74 @@ z3::expr Z3Base::convert(const LogicTerm& a, CType toType) {
   }
 
   // Cache the result and return it
+  ++convertedNodes;
   v[static_cast<size_t>(toType)].first = true;
-  cache.insert_or_assign(a, v);
-  return cache.at(a)[static_cast<size_t>(toType)].second;
+  const auto it = cache.insert_or_assign(a, std::move(v)).first;
+  return it->second[static_cast<size_t>(toType)].second;
 }
 
-void Z3LogicBlock::assertFormula(const LogicTerm& a) {
-  if (a.getOpType() == OpType::AND) {
-    for (const auto& clause : a.getNodes()) {
-      clauses.insert(clause);
-      if (convertWhenAssert) {
-        this->solver->add(convert(clause, CType::BOOL).simplify());
-      }
-    }
-  } else {
-    clauses.insert(a);
-    if (convertWhenAssert) {
-      this->solver->add(convert(a, CType::BOOL).simplify());
-    }
+void Z3LogicBlock::emitClause(const LogicTerm& clause) {
+  solver->add(convert(clause, CType::BOOL).simplify());
+}
+
+std::map<std::string, double>
+Z3Base::collectStatistics(const z3::stats& statistics) {
+  std::map<std::string, double> values;
+  for (unsigned i = 0U; i < statistics.size(); ++i) {
+    values[statistics.key(i)] =
+        statistics.is_uint(i) ? static_cast<double>(statistics.uint_value(i))
+                              : statistics.double_value(i);
   }
+  return values;
 }
 
-void Z3LogicBlock::produceInstance() {
-  for (const auto& clause : clauses) {
-    solver->add(convert(clause, CType::BOOL).simplify());
+Statistics Z3Base::addConversionStatistics(Statistics stats) const {
+  stats.convertedNodes = convertedNodes;
+  stats.cacheHits = cacheHits;
+  return stats;
+}
+
+z3::expr_vector Z3Base::convertAll(const std::vector<LogicTerm>& terms) {
+  z3::expr_vector exprs(*ctx);
+  for (const auto& term : terms) {
+    exprs.push_back(convert(term, CType::BOOL));
   }
+  return exprs;
 }
 
-Result Z3LogicBlock::solve() {
+Result Z3LogicBlock::solve() { return solve(std::vector<LogicTerm>{}); }
+
+Result Z3LogicBlock::solve(const std::vector<LogicTerm>& assumptions) {
   produceInstance();
-  const auto res = solver->check();
+  const auto start = std::chrono::steady_clock::now();
+  const auto res = assumptions.empty()
+                       ? solver->check()
+                       : solver->check(convertAll(assumptions));
+  recordSolverCall(start);
+  stats.solver = collectStatistics(solver->statistics());
   if (res == z3::sat) {
+    delete model;
     // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
     model = new Z3Model(ctx, std::make_shared<z3::model>(solver->get_model()));
     return Result::SAT;
   }
-  return Result::UNSAT;
+  return res == z3::unsat ? Result::UNSAT : Result::NDEF;
+}
+
+void Z3LogicBlock::loadInstance(const std::string& filename) {
+  produceInstance();
+  try {
+    solver->from_file(filename.c_str());
+  } catch (const z3::exception& e) {
+    throw std::runtime_error("Z3 could not load " + filename + ": " + e.msg());
+  }
 }
 
 void Z3LogicBlock::internalReset() {
   variables.clear();
   cache.clear();
+  convertedNodes = 0U;
+  cacheHits = 0U;
   solver->reset();
   Z3Base::variables.clear();
 }
@@ -416,44 +448,45 @@ bool Z3LogicOptimizer::minimize(const LogicTerm& term) {
   return true;
 }
 
-void Z3LogicOptimizer::assertFormula(const LogicTerm& a) {
-  if (a.getOpType() == OpType::AND) {
-    for (const auto& clause : a.getNodes()) {
-      clauses.insert(clause);
-      if (convertWhenAssert) {
-        optimizer->add(convert(clause, CType::BOOL).simplify());
-      }
-    }
-  } else {
-    clauses.insert(a);
-    if (convertWhenAssert) {
-      optimizer->add(convert(a, CType::BOOL).simplify());
-    }
-  }
+void Z3LogicOptimizer::emitClause(const LogicTerm& clause) {
+  optimizer->add(convert(clause, CType::BOOL).simplify());
 }
 
-void Z3LogicOptimizer::produceInstance() {
-  for (const auto& clause : clauses) {
-    optimizer->add(convert(clause, CType::BOOL).simplify());
-  }
-}
+Result Z3LogicOptimizer::solve() { return solve(std::vector<LogicTerm>{}); }
 
-Result Z3LogicOptimizer::solve() {
+Result Z3LogicOptimizer::solve(const std::vector<LogicTerm>& assumptions) {
   produceInstance();
-  const auto res = optimizer->check();
+  const auto start = std::chrono::steady_clock::now();
+  const auto res = assumptions.empty()
+                       ? optimizer->check()
+                       : optimizer->check(convertAll(assumptions));
+  recordSolverCall(start);
+  stats.solver = collectStatistics(optimizer->statistics());
   if (res == z3::sat) {
+    delete model;
     // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
     model =
         new Z3Model(ctx, std::make_shared<z3::model>(optimizer->get_model()));
     return Result::SAT;
   }
-  return Result::UNSAT;
+  return res == z3::unsat ? Result::UNSAT : Result::NDEF;
+}
+
+void Z3LogicOptimizer::loadInstance(const std::string& filename) {
+  produceInstance();
+  try {
+    optimizer->from_file(filename.c_str());
+  } catch (const z3::exception& e) {
+    throw std::runtime_error("Z3 could not load " + filename + ": " + e.msg());
+  }
 }
 
 void Z3LogicOptimizer::internalReset() {
   weightedTerms.clear();
   variables.clear();
   cache.clear();
+  convertedNodes = 0U;
+  cacheHits = 0U;
   Z3Base::variables.clear();
   optimizer = std::make_shared<z3::optimize>(*ctx);
 }
@@ -47,9 +47,11 @@ from .compile import compile  # noqa: A004
 from .pyqmap import (
     Arch,
     Architecture,
+    CardinalityEncoding,
     CliffordSynthesizer,
     CommanderGrouping,
     Configuration,
+    DiskSynthesisCache,
     EarlyTermination,
     Encoding,
     Heuristic,
@@ -60,24 +62,30 @@ from .pyqmap import (
     InitialLayout,
     Layering,
     LookaheadHeuristic,
+    LRUSynthesisCache,
     MappingResults,
     Method,
     NeutralAtomHybridArchitecture,
     SwapReduction,
+    SynthesisCache,
     SynthesisConfiguration,
     SynthesisResults,
     Tableau,
     TargetMetric,
     Verbosity,
+    remove_redundant_gates,
+    synthesize_batch,
 )
 from .subarchitectures import SubarchitectureOrder
 
 __all__ = [
     "Arch",
     "Architecture",
+    "CardinalityEncoding",
     "CliffordSynthesizer",
     "CommanderGrouping",
     "Configuration",
+    "DiskSynthesisCache",
     "EarlyTermination",
     "Encoding",
     "Heuristic",
@@ -86,6 +94,7 @@ __all__ = [
     "InitialCircuitMapping",
     "InitialCoordinateMapping",
     "InitialLayout",
+    "LRUSynthesisCache",
     "Layering",
     "LookaheadHeuristic",
     "MappingResults",
@@ -93,6 +102,7 @@ __all__ = [
     "NeutralAtomHybridArchitecture",
     "SubarchitectureOrder",
     "SwapReduction",
+    "SynthesisCache",
     "SynthesisConfiguration",
     "SynthesisResults",
     "Tableau",
@@ -101,5 +111,7 @@ __all__ = [
     "__version__",
     "compile",
     "optimize_clifford",
+    "remove_redundant_gates",
+    "synthesize_batch",
     "synthesize_clifford",
 ]
@@ -89,6 +89,31 @@ class CircuitInfo:
 
     def __init__(self) -> None: ...
 
+class CardinalityEncoding:
+    __members__: ClassVar[dict[CardinalityEncoding, int]] = ...  # read-only
+    modulo_totalizer: ClassVar[CardinalityEncoding] = ...
+    pseudo_boolean: ClassVar[CardinalityEncoding] = ...
+    sequential_counter: ClassVar[CardinalityEncoding] = ...
+    totalizer: ClassVar[CardinalityEncoding] = ...
+
+    @overload
+    def __init__(self, value: int) -> None: ...
+    @overload
+    def __init__(self, arg0: str) -> None: ...
+    @overload
+    def __init__(self, arg0: CardinalityEncoding) -> None: ...
+    def __eq__(self, other: object) -> bool: ...
+    def __getstate__(self) -> int: ...
+    def __hash__(self) -> int: ...
+    def __index__(self) -> int: ...
+    def __int__(self) -> int: ...
+    def __ne__(self, other: object) -> bool: ...
+    def __setstate__(self, state: int) -> None: ...
+    @property
+    def name(self) -> str: ...
+    @property
+    def value(self) -> int: ...
+
 class CommanderGrouping:
     __members__: ClassVar[dict[CommanderGrouping, int]] = ...  # read-only
     fixed2: ClassVar[CommanderGrouping] = ...
@@ -124,6 +149,7 @@ class Configuration:
     first_lookahead_factor: float
     include_WCNF: bool  # noqa: N815
     initial_layout: InitialLayout
+    instance_dump_path: str
     iterative_bidirectional_routing: bool
     iterative_bidirectional_routing_passes: int
     layering: Layering
@@ -135,6 +161,7 @@ class Configuration:
     lookahead_factor: float
     lookaheads: int
     method: Method
+    portfolio_threads: int
     post_mapping_optimizations: bool
     pre_mapping_optimizations: bool
     subgraph: set[int]
@@ -184,7 +211,10 @@ class Encoding:
     __members__: ClassVar[dict[Encoding, int]] = ...  # read-only
     bimander: ClassVar[Encoding] = ...
     commander: ClassVar[Encoding] = ...
+    modulo_totalizer: ClassVar[Encoding] = ...
     naive: ClassVar[Encoding] = ...
+    sequential_counter: ClassVar[Encoding] = ...
+    totalizer: ClassVar[Encoding] = ...
 
     @overload
     def __init__(self, value: int) -> None: ...
@@ -285,6 +315,7 @@ class Layering:
     odd_gates: ClassVar[Layering] = ...
     qubit_triangle: ClassVar[Layering] = ...
     disjoint_2q_blocks: ClassVar[Layering] = ...
+    commutation_front: ClassVar[Layering] = ...
 
     @overload
     def __init__(self, value: int) -> None: ...
@@ -447,21 +478,48 @@ class Verbosity:
     @property
     def value(self) -> int: ...
 
+class SynthesisCache:
+    @property
+    def hits(self) -> int: ...
+    @property
+    def misses(self) -> int: ...
+
+class LRUSynthesisCache(SynthesisCache):
+    def __init__(self, capacity: int = ...) -> None: ...
+    def __len__(self) -> int: ...
+
+class DiskSynthesisCache(SynthesisCache):
+    def __init__(self, directory: str) -> None: ...
+
 class SynthesisConfiguration:
+    cache: SynthesisCache | None
+    coupling_map: set[tuple[int, int]]
+    database_path: str
+    dump_instances: bool
     dump_intermediate_results: bool
+    gate_limit_encoding: CardinalityEncoding
     gate_limit_factor: float
+    incremental_search: bool
     initial_timestep_limit: int
+    instances_path: str
     intermediate_results_path: str
     minimize_gates_after_depth_optimization: bool
     minimize_gates_after_two_qubit_gate_optimization: bool
+    prune_by_interaction: bool
     solver_parameters: dict[str, bool | int | float | str]
     target_metric: TargetMetric
     try_higher_gate_limit_for_two_qubit_gate_optimization: bool
+    two_qubit_gate_window: int
     use_maxsat: bool
+    use_database: bool
     use_symmetry_breaking: bool
     verbosity: Verbosity
     heuristic: bool
     split_size: int
+    n_threads_heuristic: int
+    heuristic_timeout: int
+    heuristic_passes: int
+    heuristic_time_budget: float
     linear_search: bool
 
     def __init__(self) -> None: ...
@@ -484,6 +542,8 @@ class SynthesisResults:
     @property
     def solver_calls(self) -> int: ...
     @property
+    def solver_statistics(self) -> dict[str, Any]: ...
+    @property
     def tableau(self) -> str: ...
     @property
     def two_qubit_gates(self) -> int: ...
@@ -509,6 +569,11 @@ class CliffordSynthesizer:
     @property
     def results(self) -> SynthesisResults: ...
 
+def remove_redundant_gates(qc: QuantumComputation, initial_tableau: Tableau | None = None) -> int: ...
+def synthesize_batch(
+    targets: list[Tableau], config: SynthesisConfiguration = ..., n_threads: int = ...
+) -> list[SynthesisResults]: ...
+
 class InitialCoordinateMapping:
     __members__: ClassVar[dict[str, int]] = ...  # read-only
     __entries: ClassVar[dict[str, int]] = ...
@@ -4,15 +4,20 @@
 //
 
 #include "Definitions.hpp"
+#include "cliffordsynthesis/BatchSynthesis.hpp"
 #include "cliffordsynthesis/CliffordSynthesizer.hpp"
 #include "cliffordsynthesis/Configuration.hpp"
+#include "cliffordsynthesis/Peephole.hpp"
 #include "cliffordsynthesis/Results.hpp"
+#include "cliffordsynthesis/SynthesisCache.hpp"
 #include "cliffordsynthesis/Tableau.hpp"
 #include "cliffordsynthesis/TargetMetric.hpp"
 #include "hybridmap/HybridNeutralAtomMapper.hpp"
 #include "hybridmap/NeutralAtomArchitecture.hpp"
 #include "hybridmap/NeutralAtomScheduler.hpp"
 #include "hybridmap/NeutralAtomUtils.hpp"
+#include "logicblocks/Encodings.hpp"
+#include "logicblocks/Statistics.hpp"
 #include "ir/QuantumComputation.hpp"
 #include "ir/operations/OpType.hpp"
 #include "na/NAComputation.hpp"
@@ -44,6 +49,7 @@
 #include <exception>
 #include <memory>
 #include <nlohmann/json.hpp>
+#include <optional>
 #include <plog/Severity.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
@@ -51,6 +57,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 
 namespace py = pybind11;
 using namespace pybind11::literals;
@@ -179,6 +186,7 @@ PYBIND11_MODULE(pyqmap, m, py::mod_gil_not_used()) {
       .value("odd_gates", Layering::OddGates)
       .value("qubit_triangle", Layering::QubitTriangle)
       .value("disjoint_2q_blocks", Layering::Disjoint2qBlocks)
+      .value("commutation_front", Layering::CommutationFront)
       .export_values()
       // allow construction from string
       .def(py::init([](const std::string& str) -> Layering {
@@ -207,6 +215,9 @@ PYBIND11_MODULE(pyqmap, m, py::mod_gil_not_used()) {
       .value("naive", Encoding::Naive)
       .value("commander", Encoding::Commander)
       .value("bimander", Encoding::Bimander)
+      .value("sequential_counter", Encoding::SequentialCounter)
+      .value("totalizer", Encoding::Totalizer)
+      .value("modulo_totalizer", Encoding::ModuloTotalizer)
       .export_values()
       // allow construction from string
       .def(py::init([](const std::string& str) -> Encoding {
@@ -275,7 +286,9 @@ PYBIND11_MODULE(pyqmap, m, py::mod_gil_not_used()) {
       .def_readwrite("encoding", &Configuration::encoding)
       .def_readwrite("commander_grouping", &Configuration::commanderGrouping)
       .def_readwrite("use_subsets", &Configuration::useSubsets)
+      .def_readwrite("portfolio_threads", &Configuration::portfolioThreads)
       .def_readwrite("include_WCNF", &Configuration::includeWCNF)
+      .def_readwrite("instance_dump_path", &Configuration::instanceDumpPath)
       .def_readwrite("enable_limits", &Configuration::enableSwapLimits)
       .def_readwrite("swap_reduction", &Configuration::swapReduction)
       .def_readwrite("swap_limit", &Configuration::swapLimit)
@@ -525,6 +538,23 @@ PYBIND11_MODULE(pyqmap, m, py::mod_gil_not_used()) {
       }));
   py::implicitly_convertible<py::str, cs::TargetMetric>();
 
+  py::enum_<encodings::CardinalityEncoding>(m, "CardinalityEncoding")
+      .value("pseudo_boolean", encodings::CardinalityEncoding::PseudoBoolean,
+             "Hand the gate count to the solver as integer sum.")
+      .value("sequential_counter",
+             encodings::CardinalityEncoding::SequentialCounter,
+             "Sequential counter encoding.")
+      .value("totalizer", encodings::CardinalityEncoding::Totalizer,
+             "Totalizer encoding.")
+      .value("modulo_totalizer",
+             encodings::CardinalityEncoding::ModuloTotalizer,
+             "Modulo totalizer encoding.")
+      .export_values()
+      .def(py::init([](const std::string& name) {
+        return encodings::cardinalityEncodingFromString(name);
+      }));
+  py::implicitly_convertible<py::str, encodings::CardinalityEncoding>();
+
   py::enum_<plog::Severity>(m, "Verbosity")
       .value("none", plog::Severity::none, "No output.")
       .value("fatal", plog::Severity::fatal, "Only show fatal errors.")
@@ -540,6 +570,25 @@ PYBIND11_MODULE(pyqmap, m, py::mod_gil_not_used()) {
       }));
   py::implicitly_convertible<py::str, plog::Severity>();
 
+  // Caches of synthesis results
+  py::class_<cs::SynthesisCache, std::shared_ptr<cs::SynthesisCache>>(
+      m, "SynthesisCache",
+      "Cache of optimal synthesis results keyed by the target tableau up to "
+      "a relabelling of the qubits.")
+      .def_property_readonly("hits", &cs::SynthesisCache::getHits)
+      .def_property_readonly("misses", &cs::SynthesisCache::getMisses);
+  py::class_<cs::LRUSynthesisCache, cs::SynthesisCache,
+             std::shared_ptr<cs::LRUSynthesisCache>>(
+      m, "LRUSynthesisCache",
+      "In-memory cache that evicts the least recently used results.")
+      .def(py::init<std::size_t>(), "capacity"_a = 1024U)
+      .def("__len__", &cs::LRUSynthesisCache::size);
+  py::class_<cs::DiskSynthesisCache, cs::SynthesisCache,
+             std::shared_ptr<cs::DiskSynthesisCache>>(
+      m, "DiskSynthesisCache",
+      "Persistent cache that stores one file per result in a directory.")
+      .def(py::init<std::string>(), "directory"_a);
+
   // Configuration for the synthesis
   py::class_<cs::Configuration>(
       m, "SynthesisConfiguration",
@@ -565,9 +614,45 @@ PYBIND11_MODULE(pyqmap, m, py::mod_gil_not_used()) {
       .def_readwrite("linear_search", &cs::Configuration::linearSearch,
                      "Use liner search instead of binary search "
                      "scheme for finding the optimum. Defaults to `false`.")
+      .def_readwrite(
+          "incremental_search", &cs::Configuration::incrementalSearch,
+          "Reuse a single incremental solver when searching for the optimal "
+          "number of (two-qubit) gates for a fixed timestep limit. Defaults "
+          "to `true`.")
+      .def_readwrite("coupling_map", &cs::Configuration::couplingMap,
+                     "Pairs of qubits that two-qubit gates may act on (in "
+                     "either direction). Empty by default, which allows all "
+                     "pairs.")
+      .def_readwrite(
+          "prune_by_interaction", &cs::Configuration::pruneByInteraction,
+          "Only allow two-qubit gates between qubits that are connected by "
+          "the rows of the initial and the target tableau. Qubits in "
+          "different components never need to interact, so the target stays "
+          "reachable. Defaults to `false`.")
+      .def_readwrite(
+          "two_qubit_gate_window", &cs::Configuration::twoQubitGateWindow,
+          "Only allow two-qubit gates within a window of this many "
+          "consecutive qubits that moves by one qubit per timestep. This may "
+          "increase the size of the optimal circuit. Defaults to `0`, which "
+          "disables the window.")
+      .def_readwrite("use_database", &cs::Configuration::useDatabase,
+                     "Look up optimal circuits for targets on up to two "
+                     "qubits (or three qubits with `database_path`) instead "
+                     "of calling the solver. Defaults to `true`.")
+      .def_readwrite("database_path", &cs::Configuration::databasePath,
+                     "Directory with the tables generated by the "
+                     "`mqt-qmap-clifford-db` tool. Empty by default.")
+      .def_readwrite("cache", &cs::Configuration::cache,
+                     "Cache of synthesis results that is consulted before "
+                     "calling the solver and shared between synthesizer runs. "
+                     "Defaults to `None`.")
       .def_readwrite(
           "target_metric", &cs::Configuration::target,
           "Target metric for the Clifford synthesis. Defaults to `gates`.")
+      .def_readwrite("gate_limit_encoding",
+                     &cs::Configuration::gateLimitEncoding,
+                     "Encoding of the limits on the number of (two-qubit) "
+                     "gates. Defaults to `pseudo_boolean`.")
       .def_readwrite("use_symmetry_breaking",
                      &cs::Configuration::useSymmetryBreaking,
                      "Use symmetry breaking clauses to speed up the synthesis "
@@ -581,12 +666,23 @@ PYBIND11_MODULE(pyqmap, m, py::mod_gil_not_used()) {
                      "Path to the directory where intermediate results should "
                      "be dumped. Defaults to `./`. The path needs to include a "
                      "path separator at the end.")
+      .def_readwrite("dump_instances", &cs::Configuration::dumpInstances,
+                     "Write each solver instance (together with a JSON file "
+                     "describing it) before it is solved, e.g., to replay it "
+                     "with `mqt-qmap-replay`. Defaults to `false`.")
+      .def_readwrite("instances_path", &cs::Configuration::instancesPath,
+                     "Directory where solver instances should be written to. "
+                     "Defaults to `./`.")
       .def_readwrite(
           "verbosity", &cs::Configuration::verbosity,
           "Verbosity level for the synthesis process. Defaults to 'warning'.")
-      .def_readwrite("solver_parameters", &cs::Configuration::solverParameters,
-                     "Parameters to be passed to Z3 as dict[str, bool | int | "
-                     "float | str]")
+      .def_readwrite(
+          "solver_parameters", &cs::Configuration::solverParameters,
+          "Parameters to be passed to the solver as dict[str, bool | int | "
+          "float | str]. The `backend` parameter selects the solver of the "
+          "non-MaxSAT calls: `z3` (default) or `cnf`, i.e., the embedded CDCL "
+          "solver with CNF preprocessing, which only supports the `timeout` "
+          "and `random_seed` parameters.")
       .def_readwrite(
           "minimize_gates_after_depth_optimization",
           &cs::Configuration::minimizeGatesAfterDepthOptimization,
@@ -623,6 +719,23 @@ PYBIND11_MODULE(pyqmap, m, py::mod_gil_not_used()) {
           "n_threads_heuristic", &cs::Configuration::nThreadsHeuristic,
           "Maximum number of threads used for the heuristic optimizer. "
           "Defaults to the number of available threads on the system.")
+      .def_readwrite(
+          "heuristic_timeout", &cs::Configuration::heuristicTimeout,
+          "Time limit in milliseconds for the synthesis of each subcircuit "
+          "in the heuristic. Solver calls on a subcircuit are limited to the "
+          "time left and no further call is started once it is used up. "
+          "Subcircuits that cannot be improved in time keep their original "
+          "gates. Defaults to `0` (no limit).")
+      .def_readwrite(
+          "heuristic_passes", &cs::Configuration::heuristicPasses,
+          "Maximum number of heuristic passes. Every other pass shifts the "
+          "subcircuits by half their size so that gates across previous "
+          "boundaries are optimized together. Passes stop once the depth "
+          "no longer improves. `0` means no limit. Defaults to `1`.")
+      .def_readwrite("heuristic_time_budget",
+                     &cs::Configuration::heuristicTimeBudget,
+                     "Time in seconds after which no further heuristic pass "
+                     "is started. Defaults to `0` (no limit).")
       .def("json", &cs::Configuration::json,
            "Returns a JSON-style dictionary of all the information present in "
            "the :class:`.Configuration`")
@@ -651,6 +764,14 @@ PYBIND11_MODULE(pyqmap, m, py::mod_gil_not_used()) {
                              "Returns the runtime of the synthesis in seconds.")
       .def_property_readonly("solver_calls", &cs::Results::getSolverCalls,
                              "Returns the number of calls to the SAT solver.")
+      .def_property_readonly(
+          "solver_statistics",
+          [](const cs::Results& results) {
+            nlohmann::basic_json<> stats = results.getSolverStatistics();
+            return stats;
+          },
+          "Returns the size of the formulations and the time spent encoding "
+          "and solving them, summed over all solver calls.")
       .def_property_readonly(
           "circuit", &cs::Results::getResultCircuit,
           "Returns the synthesized circuit as a qasm string.")
@@ -703,6 +824,26 @@ PYBIND11_MODULE(pyqmap, m, py::mod_gil_not_used()) {
                                     &cs::CliffordSynthesizer::getResults,
                                     "Returns the results of the synthesis.");
 
+  m.def(
+      "remove_redundant_gates",
+      [](qc::QuantumComputation& qc,
+         const std::optional<cs::Tableau>& initial) {
+        return initial ? cs::removeRedundantGates(qc, *initial)
+                       : cs::removeRedundantGates(qc);
+      },
+      "qc"_a, "initial_tableau"_a = std::nullopt,
+      "Removes the gates of a circuit that leave the tableau of the circuit "
+      "executed so far unchanged, starting from the initial tableau (or "
+      "|0...0> if none is given). Returns the number of removed gates.");
+
+  m.def("synthesize_batch", &cs::synthesizeBatch, "targets"_a,
+        "config"_a = cs::Configuration(),
+        "n_threads"_a = std::thread::hardware_concurrency(),
+        "Synthesizes a circuit for every target tableau (starting from the "
+        "identity) with a shared configuration on up to `n_threads` threads. "
+        "Targets that are equal up to a relabelling of the qubits are only "
+        "synthesized once. Returns the results in the order of the targets.");
+
   // Neutral Atom Hybrid Mapper
   py::enum_<na::InitialCoordinateMapping>(
       m, "InitialCoordinateMapping",
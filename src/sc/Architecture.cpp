@@ -223,6 +223,22 @@ void Architecture::createDistanceTable() {
                                        COST_DIRECTION_REVERSE,
                                        distanceTableReversals);
   }
+
+  const auto flatten = [](const Matrix& table, std::vector<double>& flat) {
+    flat.clear();
+    for (const auto& row : table) {
+      flat.insert(flat.end(), row.begin(), row.end());
+    }
+  };
+  flatten(distanceTable, flatDistanceTable);
+  flatten(distanceTableReversals, flatDistanceTableReversals);
+
+  edgeSources.clear();
+  edgeTargets.clear();
+  for (const auto& [first, second] : couplingMap) {
+    edgeSources.emplace_back(first);
+    edgeTargets.emplace_back(second);
+  }
 }
 
 void Architecture::createFidelityTable() {
@@ -287,6 +303,13 @@ void Architecture::createFidelityTable() {
   fidelityDistanceTables.clear();
   Dijkstra::buildEdgeSkipTable(couplingMap, fidelityDistanceTables,
                                swapFidelityCosts);
+
+  edgeFidelityCosts.clear();
+  edgeReverseFidelityCosts.clear();
+  for (const auto& [first, second] : couplingMap) {
+    edgeFidelityCosts.emplace_back(twoQubitFidelityCosts[first][second]);
+    edgeReverseFidelityCosts.emplace_back(twoQubitFidelityCosts[second][first]);
+  }
 }
 
 std::uint64_t
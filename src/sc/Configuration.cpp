@@ -66,7 +66,11 @@ nlohmann::basic_json<> Configuration::json() const {
       exact["commander_grouping"] = ::toString(commanderGrouping);
     }
     exact["include_WCNF"] = includeWCNF;
+    if (instanceDumpEnabled()) {
+      exact["instance_dump_path"] = instanceDumpPath;
+    }
     exact["use_subsets"] = useSubsets;
+    exact["portfolio_threads"] = portfolioThreads;
     if (enableSwapLimits) {
       auto& limits = exact["limits"];
       limits["swap_reduction"] = ::toString(swapReduction);
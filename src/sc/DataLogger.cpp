@@ -5,8 +5,8 @@
 
 #include "sc/DataLogger.hpp"
 
-#include "ir/operations/CompoundOperation.hpp"
 #include "ir/operations/OpType.hpp"
+#include "ir/operations/Operation.hpp"
 #include "sc/Architecture.hpp"
 #include "sc/MappingResults.hpp"
 #include "sc/utils.hpp"
@@ -94,11 +94,9 @@ void DataLogger::openNewLayer(std::size_t layerIndex) {
 };
 
 void DataLogger::logFinalizeLayer(
-    std::size_t layerIndex, const qc::CompoundOperation& ops,
+    std::size_t layerIndex, const std::vector<const qc::Operation*>& ops,
     const std::vector<std::uint16_t>& singleQubitMultiplicity,
-    const std::map<std::pair<std::uint16_t, std::uint16_t>,
-                   std::pair<std::uint16_t, std::uint16_t>>&
-        twoQubitMultiplicity,
+    const TwoQubitMultiplicity& twoQubitMultiplicity,
     const std::vector<std::int16_t>& initialLayout, std::size_t finalNodeId,
     double finalCostFixed, double finalCostHeur, double finalLookaheadPenalty,
     const std::vector<std::int16_t>& finalLayout,
@@ -124,18 +122,20 @@ void DataLogger::logFinalizeLayer(
   }
   nlohmann::basic_json json;
   std::stringstream qasmStream;
-  ops.dumpOpenQASM3(qasmStream, qregs, cregs);
+  for (const auto* op : ops) {
+    op->dumpOpenQASM(qasmStream, qregs, cregs, 0, true);
+  }
   json["qasm"] = qasmStream.str();
   if (twoQubitMultiplicity.empty()) {
     json["two_qubit_multiplicity"] = nlohmann::basic_json<>::array();
   } else {
     auto& twoMultJSON = json["two_qubit_multiplicity"];
     std::size_t j = 0;
-    for (const auto& [qubits, multiplicity] : twoQubitMultiplicity) {
-      twoMultJSON[j]["q1"] = qubits.first;
-      twoMultJSON[j]["q2"] = qubits.second;
-      twoMultJSON[j]["forward"] = multiplicity.first;
-      twoMultJSON[j]["backward"] = multiplicity.second;
+    for (const auto& [q1, q2, forward, backward] : twoQubitMultiplicity) {
+      twoMultJSON[j]["q1"] = q1;
+      twoMultJSON[j]["q2"] = q2;
+      twoMultJSON[j]["forward"] = forward;
+      twoMultJSON[j]["backward"] = backward;
       ++j;
     }
   }
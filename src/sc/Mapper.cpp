@@ -56,6 +56,7 @@ void Mapper::processDisjointQubitLayer(
     if (lastLayer.at(target).has_value()) {
       layer = *lastLayer.at(target) + 1;
     }
+    layer = std::max(layer, layerOffset);
     lastLayer.at(target) = layer;
   } else {
     if (!lastLayer.at(*control).has_value() &&
@@ -68,10 +69,13 @@ void Mapper::processDisjointQubitLayer(
     } else {
       layer = std::max(*lastLayer.at(*control), *lastLayer.at(target)) + 1;
     }
+    layer = std::max(layer, layerOffset);
     lastLayer.at(*control) = layer;
     lastLayer.at(target) = layer;
   }
 
+  // layers before `layerOffset` have already been routed
+  layer = std::max(layer, layerOffset) - layerOffset;
   if (layers.size() <= layer) {
     layers.emplace_back();
   }
@@ -104,8 +108,9 @@ void Mapper::processDisjoint2qBlockLayer(
     } else {
       layer = std::max(*lastLayer.at(*control), *lastLayer.at(target)) + 1;
 
-      if (*lastLayer.at(*control) == *lastLayer.at(target)) {
-        for (auto& g : layers.at(layer - 1)) {
+      if (*lastLayer.at(*control) == *lastLayer.at(target) &&
+          layer - 1 >= layerOffset) {
+        for (auto& g : layers.at(layer - 1 - layerOffset)) {
           if ((g.control == *control && g.target == target) ||
               (g.control == target && g.target == *control)) {
             // if last layer contained gate with equivalent qubit set, use that
@@ -116,10 +121,13 @@ void Mapper::processDisjoint2qBlockLayer(
         }
       }
     }
+    layer = std::max(layer, layerOffset);
     lastLayer.at(*control) = layer;
     lastLayer.at(target) = layer;
   }
 
+  // layers before `layerOffset` have already been routed
+  layer = std::max(layer, layerOffset) - layerOffset;
   if (layers.size() <= layer) {
     layers.emplace_back();
   }
@@ -130,146 +138,234 @@ void Mapper::processDisjoint2qBlockLayer(
   }
 }
 
-void Mapper::createLayers() {
-  const auto& config = results.config;
-  auto lastLayer = std::vector<std::optional<std::size_t>>(
-      architecture->getNqubits(), std::nullopt);
-
-  auto qubitsInLayer = std::set<std::uint16_t>{};
+Mapper::CommutationClass Mapper::commutationClass(const qc::OpType type,
+                                                  const bool control) {
+  if (control) {
+    return CommutationClass::ZDiagonal;
+  }
+  switch (type) {
+  case qc::I:
+  case qc::Z:
+  case qc::S:
+  case qc::Sdg:
+  case qc::T:
+  case qc::Tdg:
+  case qc::P:
+  case qc::RZ:
+    return CommutationClass::ZDiagonal;
+  case qc::X:
+  case qc::SX:
+  case qc::SXdg:
+  case qc::RX:
+    return CommutationClass::XDiagonal;
+  default:
+    return CommutationClass::None;
+  }
+}
 
-  bool even = true;
-  for (auto& gate : qc) {
-    // skip over barrier instructions
-    if (gate->getType() == qc::Barrier || gate->getType() == qc::Measure) {
-      continue;
+void Mapper::processCommutationLayer(
+    LayeringState& state, const std::optional<std::uint16_t>& control,
+    const std::uint16_t target, qc::Operation* gate) {
+  // first layer the gate may be placed in w.r.t. a single qubit
+  const auto earliestLayer = [&state](const std::uint16_t qubit,
+                                      const CommutationClass cls) {
+    if (cls == CommutationClass::None || state.runClass.at(qubit) != cls) {
+      // the gate does not commute with the previous gates on this qubit
+      state.runClass.at(qubit) = cls;
+      state.runStart.at(qubit) = state.lastLayer.at(qubit);
     }
+    const auto& before = state.runStart.at(qubit);
+    return before.has_value() ? *before + 1 : std::size_t{0};
+  };
+
+  std::size_t layer =
+      earliestLayer(target, commutationClass(gate->getType(), false));
+  if (control.has_value()) {
+    layer = std::max(layer,
+                     earliestLayer(*control, CommutationClass::ZDiagonal));
+  }
+  // layers before `layerOffset` have already been routed
+  layer = std::max(layer, layerOffset);
 
-    if (!gate->isUnitary()) {
-      throw QMAPException(
-          "Mapping not possible: circuit contains non-unitary operation: " +
-          std::string(gate->getName()));
+  if (control.has_value()) {
+    // 2Q-gates in one layer have to act on disjoint pairs of qubits
+    const auto sharesQubit = [&control, target](const Gate& g) {
+      if (g.singleQubit()) {
+        return false;
+      }
+      const auto c = static_cast<std::uint16_t>(g.control);
+      const bool samePair = (c == *control && g.target == target) ||
+                            (c == target && g.target == *control);
+      return !samePair && (c == *control || c == target ||
+                           g.target == *control || g.target == target);
+    };
+    while (layer - layerOffset < layers.size() &&
+           std::any_of(layers.at(layer - layerOffset).begin(),
+                       layers.at(layer - layerOffset).end(), sharesQubit)) {
+      ++layer;
     }
+  }
 
-    if (gate->getControls().size() > 1 || gate->getTargets().size() > 1) {
-      throw QMAPException("Circuit contains gates with more than one control. "
-                          "Please make sure that the input circuit's gates are "
-                          "decomposed to the appropriate gate set!");
+  for (const auto q : {std::optional<std::uint16_t>{target}, control}) {
+    if (q.has_value() && (!state.lastLayer.at(*q).has_value() ||
+                          *state.lastLayer.at(*q) < layer)) {
+      state.lastLayer.at(*q) = layer;
     }
+  }
+
+  if (layers.size() <= layer - layerOffset) {
+    layers.emplace_back();
+  }
+  if (control.has_value()) {
+    layers.at(layer - layerOffset).emplace_back(*control, target, gate);
+  } else {
+    layers.at(layer - layerOffset).emplace_back(-1, target, gate);
+  }
+}
+
+void Mapper::createLayers() {
+  LayeringState state(architecture->getNqubits());
+  for (auto& gate : qc) {
+    addToLayers(gate.get(), state);
+  }
+  results.input.layers = layers.size();
+
+  computeLayerMultiplicities();
+}
+
+void Mapper::addToLayers(qc::Operation* gate, LayeringState& state) {
+  const auto& config = results.config;
+
+  // skip over barrier instructions
+  if (gate->getType() == qc::Barrier || gate->getType() == qc::Measure) {
+    return;
+  }
+
+  if (!gate->isUnitary()) {
+    throw QMAPException(
+        "Mapping not possible: circuit contains non-unitary operation: " +
+        std::string(gate->getName()));
+  }
+
+  if (gate->getControls().size() > 1 || gate->getTargets().size() > 1) {
+    throw QMAPException("Circuit contains gates with more than one control. "
+                        "Please make sure that the input circuit's gates are "
+                        "decomposed to the appropriate gate set!");
+  }
 
-    const bool singleQubit = !gate->isControlled();
-    std::optional<std::uint16_t> control = std::nullopt;
-    if (!singleQubit) {
-      control = static_cast<std::uint16_t>(
-          qc.initialLayout.at((*gate->getControls().begin()).qubit));
+  const bool singleQubit = !gate->isControlled();
+  std::optional<std::uint16_t> control = std::nullopt;
+  if (!singleQubit) {
+    control = static_cast<std::uint16_t>(
+        qc.initialLayout.at((*gate->getControls().begin()).qubit));
+  }
+  const auto target =
+      static_cast<std::uint16_t>(qc.initialLayout.at(gate->getTargets().at(0)));
+
+  // methods of layering described in
+  // https://iic.jku.at/files/eda/2019_dac_mapping_quantum_circuits_ibm_architectures_using_minimal_number_swap_h_gates.pdf
+  switch (config.layering) {
+  case Layering::IndividualGates:
+    // each gate is put in a new layer
+    layers.emplace_back();
+    if (control.has_value()) {
+      layers.back().emplace_back(*control, target, gate);
+    } else {
+      layers.back().emplace_back(-1, target, gate);
     }
-    const auto target = static_cast<std::uint16_t>(
-        qc.initialLayout.at(gate->getTargets().at(0)));
-
-    // methods of layering described in
-    // https://iic.jku.at/files/eda/2019_dac_mapping_quantum_circuits_ibm_architectures_using_minimal_number_swap_h_gates.pdf
-    switch (config.layering) {
-    case Layering::IndividualGates:
-      // each gate is put in a new layer
+    break;
+  case Layering::DisjointQubits:
+    processDisjointQubitLayer(state.lastLayer, control, target, gate);
+    break;
+  case Layering::Disjoint2qBlocks:
+    processDisjoint2qBlockLayer(state.lastLayer, control, target, gate);
+    break;
+  case Layering::CommutationFront:
+    processCommutationLayer(state, control, target, gate);
+    break;
+  case Layering::OddGates:
+    // every other gate is put in a new layer
+    if (state.even) {
       layers.emplace_back();
-      if (control.has_value()) {
-        layers.back().emplace_back(*control, target, gate.get());
-      } else {
-        layers.back().emplace_back(-1, target, gate.get());
-      }
-      break;
-    case Layering::DisjointQubits:
-      processDisjointQubitLayer(lastLayer, control, target, gate.get());
-      break;
-    case Layering::Disjoint2qBlocks:
-      processDisjoint2qBlockLayer(lastLayer, control, target, gate.get());
-      break;
-    case Layering::OddGates:
-      // every other gate is put in a new layer
-      if (even) {
-        layers.emplace_back();
-        if (control.has_value()) {
-          layers.back().emplace_back(*control, target, gate.get());
-        } else {
-          layers.back().emplace_back(-1, target, gate.get());
-        }
-      } else {
-        if (control.has_value()) {
-          layers.back().emplace_back(*control, target, gate.get());
-        } else {
-          layers.back().emplace_back(-1, target, gate.get());
-        }
-      }
-      even = !even;
-      break;
-    case Layering::QubitTriangle:
-      if (layers.empty()) {
-        layers.emplace_back();
-      }
+    }
+    if (control.has_value()) {
+      layers.back().emplace_back(*control, target, gate);
+    } else {
+      layers.back().emplace_back(-1, target, gate);
+    }
+    state.even = !state.even;
+    break;
+  case Layering::QubitTriangle:
+    if (layers.empty()) {
+      layers.emplace_back();
+    }
 
-      if (singleQubit) {
-        // single qubit gates can be added in any layer
-        layers.back().emplace_back(-1, target, gate.get());
+    if (singleQubit) {
+      // single qubit gates can be added in any layer
+      layers.back().emplace_back(-1, target, gate);
+    } else {
+      auto& qubitsInLayer = state.qubitsInLayer;
+      qubitsInLayer.insert(*control);
+      qubitsInLayer.insert(target);
+
+      if (qubitsInLayer.size() <= 3) {
+        layers.back().emplace_back(*control, target, gate);
       } else {
+        layers.emplace_back();
+        layers.back().emplace_back(*control, target, gate);
+        qubitsInLayer.clear();
         qubitsInLayer.insert(*control);
         qubitsInLayer.insert(target);
-
-        if (qubitsInLayer.size() <= 3) {
-          layers.back().emplace_back(*control, target, gate.get());
-        } else {
-          layers.emplace_back();
-          layers.back().emplace_back(*control, target, gate.get());
-          qubitsInLayer.clear();
-          qubitsInLayer.insert(*control);
-          qubitsInLayer.insert(target);
-        }
       }
-      break;
     }
+    break;
   }
-  results.input.layers = layers.size();
+}
 
-  // compute qubit gate multiplicities
+void Mapper::computeLayerMultiplicities() {
   singleQubitMultiplicities = std::vector<SingleQubitMultiplicity>(
       layers.size(), SingleQubitMultiplicity(architecture->getNqubits(), 0));
   twoQubitMultiplicities =
       std::vector<TwoQubitMultiplicity>(layers.size(), TwoQubitMultiplicity{});
-  activeQubits = std::vector<std::set<std::uint16_t>>(
-      layers.size(), std::set<std::uint16_t>{});
-  activeQubits1QGates = std::vector<std::set<std::uint16_t>>(
-      layers.size(), std::set<std::uint16_t>{});
-  activeQubits2QGates = std::vector<std::set<std::uint16_t>>(
-      layers.size(), std::set<std::uint16_t>{});
+  activeQubits = std::vector<QubitSet>(layers.size(),
+                                       QubitSet(architecture->getNqubits()));
+  activeQubits1QGates = std::vector<QubitSet>(
+      layers.size(), QubitSet(architecture->getNqubits()));
+  activeQubits2QGates = std::vector<QubitSet>(
+      layers.size(), QubitSet(architecture->getNqubits()));
 
   for (std::size_t i = 0; i < layers.size(); ++i) {
-    for (const auto& gate : layers[i]) {
-      if (gate.singleQubit()) {
-        activeQubits[i].emplace(gate.target);
-        activeQubits1QGates[i].emplace(gate.target);
-        ++singleQubitMultiplicities[i][gate.target];
+    computeLayerMultiplicities(i);
+  }
+}
+
+void Mapper::computeLayerMultiplicities(const std::size_t layer) {
+  auto& singleQubitMultiplicity = singleQubitMultiplicities.at(layer);
+  auto& twoQubitMultiplicity = twoQubitMultiplicities.at(layer);
+  auto& active = activeQubits.at(layer);
+  auto& active1Q = activeQubits1QGates.at(layer);
+  auto& active2Q = activeQubits2QGates.at(layer);
+  std::fill(singleQubitMultiplicity.begin(), singleQubitMultiplicity.end(), 0);
+  twoQubitMultiplicity.clear();
+  active.clear();
+  active1Q.clear();
+  active2Q.clear();
+
+  for (const auto& gate : layers.at(layer)) {
+    if (gate.singleQubit()) {
+      active.insert(gate.target);
+      active1Q.insert(gate.target);
+      ++singleQubitMultiplicity[gate.target];
+    } else {
+      const auto control = static_cast<std::uint16_t>(gate.control);
+      active.insert(control);
+      active.insert(gate.target);
+      active2Q.insert(control);
+      active2Q.insert(gate.target);
+      if (control >= gate.target) {
+        addTwoQubitGateCount(twoQubitMultiplicity, gate.target, control, 0, 1);
       } else {
-        activeQubits[i].emplace(gate.control);
-        activeQubits[i].emplace(gate.target);
-        activeQubits2QGates[i].emplace(gate.control);
-        activeQubits2QGates[i].emplace(gate.target);
-        if (gate.control >= gate.target) {
-          const auto edge =
-              std::pair(gate.target, static_cast<std::uint16_t>(gate.control));
-          if (twoQubitMultiplicities[i].find(edge) ==
-              twoQubitMultiplicities[i].end()) {
-            twoQubitMultiplicities[i][edge] = {0, 1};
-          } else {
-            twoQubitMultiplicities[i][edge].second++;
-          }
-        } else {
-          const auto edge =
-              std::pair(static_cast<std::uint16_t>(gate.control), gate.target);
-          if (twoQubitMultiplicities[i].find(edge) ==
-              twoQubitMultiplicities[i].end()) {
-            twoQubitMultiplicities[i][edge] = {1, 0};
-          } else {
-            twoQubitMultiplicities[i][edge].first++;
-          }
-        }
+        addTwoQubitGateCount(twoQubitMultiplicity, control, gate.target, 1, 0);
       }
     }
   }
@@ -286,12 +382,11 @@ bool Mapper::isLayerSplittable(std::size_t index) {
     return false;
   }
   // check if there is a 1Q gate on a qubit that is not part of the 2Q gate
-  return std::any_of(activeQubits1QGates.at(index).begin(),
-                     activeQubits1QGates.at(index).end(),
-                     [this, index](auto q) {
-                       return activeQubits2QGates.at(index).find(q) ==
-                              activeQubits2QGates.at(index).end();
-                     });
+  const auto& activeQubits2Q = activeQubits2QGates.at(index);
+  return std::any_of(
+      activeQubits1QGates.at(index).begin(),
+      activeQubits1QGates.at(index).end(),
+      [&activeQubits2Q](auto q) { return !activeQubits2Q.contains(q); });
 }
 
 void Mapper::splitLayer(std::size_t index, Architecture& arch) {
@@ -305,63 +400,61 @@ void Mapper::splitLayer(std::size_t index, Architecture& arch) {
   SingleQubitMultiplicity singleQubitMultiplicity1(arch.getNqubits(), 0);
   TwoQubitMultiplicity twoQubitMultiplicity0{};
   TwoQubitMultiplicity twoQubitMultiplicity1{};
-  std::set<std::uint16_t> activeQubits0{};
-  std::set<std::uint16_t> activeQubits1QGates0{};
-  std::set<std::uint16_t> activeQubits2QGates0{};
-  std::set<std::uint16_t> activeQubits1{};
-  std::set<std::uint16_t> activeQubits1QGates1{};
-  std::set<std::uint16_t> activeQubits2QGates1{};
-
-  // 2Q-gates
+  QubitSet activeQubits0(arch.getNqubits());
+  QubitSet activeQubits1QGates0(arch.getNqubits());
+  QubitSet activeQubits2QGates0(arch.getNqubits());
+  QubitSet activeQubits1(arch.getNqubits());
+  QubitSet activeQubits1QGates1(arch.getNqubits());
+  QubitSet activeQubits2QGates1(arch.getNqubits());
+
+  // 2Q-gates (both halves stay sorted since the original multiplicity is)
   bool even = false;
-  for (const auto& edge : twoQubitMultiplicity) {
+  for (const auto& gateCount : twoQubitMultiplicity) {
     if (even) {
-      twoQubitMultiplicity0.insert(edge);
-      activeQubits0.emplace(edge.first.first);
-      activeQubits0.emplace(edge.first.second);
-      activeQubits2QGates0.emplace(edge.first.first);
-      activeQubits2QGates0.emplace(edge.first.second);
+      twoQubitMultiplicity0.emplace_back(gateCount);
+      activeQubits0.insert(gateCount.q1);
+      activeQubits0.insert(gateCount.q2);
+      activeQubits2QGates0.insert(gateCount.q1);
+      activeQubits2QGates0.insert(gateCount.q2);
     } else {
-      twoQubitMultiplicity1.insert(edge);
-      activeQubits1.emplace(edge.first.first);
-      activeQubits1.emplace(edge.first.second);
-      activeQubits2QGates1.emplace(edge.first.first);
-      activeQubits2QGates1.emplace(edge.first.second);
+      twoQubitMultiplicity1.emplace_back(gateCount);
+      activeQubits1.insert(gateCount.q1);
+      activeQubits1.insert(gateCount.q2);
+      activeQubits2QGates1.insert(gateCount.q1);
+      activeQubits2QGates1.insert(gateCount.q2);
     }
     even = !even;
   }
 
   // 1Q-gates
   even = true;
-  for (std::size_t q = 0; q < singleQubitMultiplicity.size(); ++q) {
+  for (std::uint16_t q = 0; q < singleQubitMultiplicity.size(); ++q) {
     if (singleQubitMultiplicity[q] == 0) {
       continue;
     }
     // if a qubit is also acted on by a 2Q-gate, put it on the same layer as
     // the 2Q-gate
-    if (activeQubits2QGates0.find(static_cast<std::uint16_t>(q)) !=
-        activeQubits2QGates0.end()) {
+    if (activeQubits2QGates0.contains(q)) {
       singleQubitMultiplicity0[q] = singleQubitMultiplicity[q];
-      activeQubits0.emplace(static_cast<std::uint16_t>(q));
-      activeQubits1QGates0.emplace(static_cast<std::uint16_t>(q));
+      activeQubits0.insert(q);
+      activeQubits1QGates0.insert(q);
       continue;
     }
-    if (activeQubits2QGates1.find(static_cast<std::uint16_t>(q)) !=
-        activeQubits2QGates1.end()) {
+    if (activeQubits2QGates1.contains(q)) {
       singleQubitMultiplicity1[q] = singleQubitMultiplicity[q];
-      activeQubits1.emplace(static_cast<std::uint16_t>(q));
-      activeQubits1QGates1.emplace(static_cast<std::uint16_t>(q));
+      activeQubits1.insert(q);
+      activeQubits1QGates1.insert(q);
       continue;
     }
 
     if (even) {
       singleQubitMultiplicity0[q] = singleQubitMultiplicity[q];
-      activeQubits0.emplace(q);
-      activeQubits1QGates0.emplace(q);
+      activeQubits0.insert(q);
+      activeQubits1QGates0.insert(q);
     } else {
       singleQubitMultiplicity1[q] = singleQubitMultiplicity[q];
-      activeQubits1.emplace(q);
-      activeQubits1QGates1.emplace(q);
+      activeQubits1.insert(q);
+      activeQubits1QGates1.insert(q);
     }
     even = !even;
   }
@@ -374,8 +467,7 @@ void Mapper::splitLayer(std::size_t index, Architecture& arch) {
         layer1.emplace_back(gate);
       }
     } else {
-      if (activeQubits2QGates0.find(gate.target) !=
-          activeQubits2QGates0.end()) {
+      if (activeQubits2QGates0.contains(gate.target)) {
         layer0.emplace_back(gate);
       } else {
         layer1.emplace_back(gate);
@@ -408,23 +500,17 @@ void Mapper::splitLayer(std::size_t index, Architecture& arch) {
   activeQubits[index] = activeQubits0;
   activeQubits.insert(
       activeQubits.begin() +
-          static_cast<std::vector<std::set<std::uint16_t>>::difference_type>(
-              index) +
-          1,
+          static_cast<std::vector<QubitSet>::difference_type>(index) + 1,
       activeQubits1);
   activeQubits1QGates[index] = activeQubits1QGates0;
   activeQubits1QGates.insert(
       activeQubits1QGates.begin() +
-          static_cast<std::vector<std::set<std::uint16_t>>::difference_type>(
-              index) +
-          1,
+          static_cast<std::vector<QubitSet>::difference_type>(index) + 1,
       activeQubits1QGates1);
   activeQubits2QGates[index] = activeQubits2QGates0;
   activeQubits2QGates.insert(
       activeQubits2QGates.begin() +
-          static_cast<std::vector<std::set<std::uint16_t>>::difference_type>(
-              index) +
-          1,
+          static_cast<std::vector<QubitSet>::difference_type>(index) + 1,
       activeQubits2QGates1);
   results.input.layers = layers.size();
 }
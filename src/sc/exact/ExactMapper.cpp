@@ -10,6 +10,7 @@
 #include "LogicTerm.hpp"
 #include "ir/operations/StandardOperation.hpp"
 #include "logicblocks/Encodings.hpp"
+#include "logicblocks/Instances.hpp"
 #include "logicblocks/LogicBlock.hpp"
 #include "logicblocks/Model.hpp"
 #include "logicblocks/util_logicblock.hpp"
@@ -26,9 +27,11 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <fstream>
 #include <iostream>
 #include <limits>
 #include <memory>
+#include <nlohmann/json.hpp>
 #include <set>
 #include <sstream>
 #include <string>
@@ -37,6 +40,30 @@
 #include <utility>
 #include <vector>
 
+namespace {
+encodings::CardinalityEncoding toCardinalityEncoding(const Encoding encoding) {
+  switch (encoding) {
+  case Encoding::SequentialCounter:
+    return encodings::CardinalityEncoding::SequentialCounter;
+  case Encoding::Totalizer:
+    return encodings::CardinalityEncoding::Totalizer;
+  case Encoding::ModuloTotalizer:
+    return encodings::CardinalityEncoding::ModuloTotalizer;
+  default:
+    throw QMAPException("Encoding " + toString(encoding) +
+                        " is not a cardinality encoding");
+  }
+}
+
+logicbase::LogicTerm
+exactlyOne(const std::vector<logicbase::LogicTerm>& vars,
+           const encodings::CardinalityEncoding encoding,
+           logicbase::LogicBlock* lb) {
+  return encodings::atMostK(vars, 1U, encoding, lb) &&
+         encodings::naiveAtLeastOne(vars);
+}
+} // namespace
+
 void ExactMapper::map(const Configuration& settings) {
   results.config = settings;
   const auto& config = results.config;
@@ -122,6 +149,7 @@ void ExactMapper::map(const Configuration& settings) {
   std::vector<Swaps> swaps(reducedLayerIndices.size(), Swaps{});
   mappingSwaps.reserve(reducedLayerIndices.size());
   std::size_t runs = 1;
+  logicbase::Statistics solverStatistics{};
   for (auto& choice : allPossibleQubitChoices) {
     std::size_t limit = 0U;
     std::size_t maxLimit = 0U;
@@ -198,6 +226,7 @@ void ExactMapper::map(const Configuration& settings) {
       // 6) call actual mapping routine
       coreMappingRoutine(choice, reducedCouplingMap, choiceResults, swaps,
                          limit, timeout);
+      solverStatistics += choiceResults.solverStatistics;
 
       if (config.verbose) {
         if (!choiceResults.timeout) {
@@ -234,6 +263,7 @@ void ExactMapper::map(const Configuration& settings) {
       break;
     }
   }
+  results.solverStatistics = solverStatistics;
 
   // return in case no result has been found
   if (results.timeout) {
@@ -405,14 +435,21 @@ void ExactMapper::coreMappingRoutine(
     const std::size_t limit, const std::size_t timeout) {
   const auto& config = results.config;
   using namespace logicbase;
+  const auto encodingStart = std::chrono::steady_clock::now();
   // LogicBlock
   bool success = false;
   logicutil::Params params;
   params.addParam("timeout", static_cast<std::uint32_t>(timeout));
   params.addParam("pb.compile_equality", true);
-  params.addParam("pp.wcnf", true);
+  // dumped instances are kept in SMT-LIB2 unless the WCNF is requested anyway
+  params.addParam("pp.wcnf",
+                  config.includeWCNF || !config.instanceDumpEnabled());
   params.addParam("maxres.hill_climb", true);
   params.addParam("maxres.pivot_on_correction_set", false);
+  if (config.portfolioThreads > 1) {
+    params.addParam(logicutil::PORTFOLIO_THREADS,
+                    static_cast<std::uint32_t>(config.portfolioThreads));
+  }
   std::unique_ptr<LogicBlockOptimizer> lb =
       logicutil::getZ3LogicOptimizer(success, true, params);
   if (!success) {
@@ -607,6 +644,25 @@ number of variables: (|L|-1) * m!
         }
       }
     }
+  } else {
+    const auto encoding = toCardinalityEncoding(config.encoding);
+    for (std::size_t k = 0; k < reducedLayerIndices.size(); ++k) {
+      for (std::size_t i = 0; i < qubitChoice.size(); ++i) {
+        std::vector<LogicTerm> varIDs;
+        for (std::size_t j = 0; j < qc.getNqubits(); ++j) {
+          varIDs.push_back(x[k][i][j]);
+        }
+        lb->assertFormula(encodings::atMostK(varIDs, 1U, encoding, lb.get()));
+      }
+
+      for (std::size_t j = 0; j < qc.getNqubits(); ++j) {
+        std::vector<LogicTerm> varIDs;
+        for (std::size_t i = 0; i < qubitChoice.size(); ++i) {
+          varIDs.push_back(x[k][i][j]);
+        }
+        lb->assertFormula(exactlyOne(varIDs, encoding, lb.get()));
+      }
+    }
   }
 
   //////////////////////////////////////////
@@ -698,7 +754,11 @@ number of variables: (|L|-1) * m!
         }
         ++piCount;
       } while (std::next_permutation(pi.begin(), pi.end()));
-      if (config.commanderGrouping == CommanderGrouping::Fixed2) {
+      if (config.encoding != Encoding::Commander &&
+          config.encoding != Encoding::Bimander) {
+        lb->assertFormula(exactlyOne(
+            varIDs, toCardinalityEncoding(config.encoding), lb.get()));
+      } else if (config.commanderGrouping == CommanderGrouping::Fixed2) {
         lb->assertFormula(encodings::exactlyOneCmdr(
             encodings::groupVars(varIDs, 2), LogicTerm::noneTerm(), lb.get()));
       } else if (config.commanderGrouping == CommanderGrouping::Fixed3) {
@@ -765,6 +825,28 @@ number of variables: (|L|-1) * m!
   if (config.includeWCNF) {
     choiceResults.wcnf = lb->dumpInternalSolver();
   }
+  lb->addEncodeTime(std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - encodingStart)
+                       .count());
+
+  if (config.instanceDumpEnabled()) {
+    const auto base =
+        logicutil::dumpInstance(*lb, config.instanceDumpPath, "exact");
+    if (!base.empty()) {
+      nlohmann::basic_json<> meta{};
+      meta["source"] = "exact_mapper";
+      meta["circuit"] = results.input.name;
+      meta["architecture"] = architecture->getName();
+      meta["qubit_choice"] = qubitChoice;
+      meta["swap_limit"] = limit;
+      meta["layers"] = reducedLayerIndices.size();
+      meta["encoding"] = ::toString(config.encoding);
+      meta["commander_grouping"] = ::toString(config.commanderGrouping);
+      meta["swap_reduction"] = ::toString(config.swapReduction);
+      meta["timeout"] = timeout;
+      std::ofstream(base + ".json") << meta.dump(2);
+    }
+  }
 
   //////////////////////////////////////////
   /// 	Solving							//
@@ -878,5 +960,6 @@ number of variables: (|L|-1) * m!
   } else {
     results.timeout = true;
   }
+  choiceResults.solverStatistics = lb->getStatistics();
   lb->reset();
 }
@@ -0,0 +1,197 @@
+//
+// This file is part of the MQT QMAP library released under the MIT license.
+// See README.md or go to https://github.com/cda-tum/qmap for more information.
+//
+
+#include "sc/heuristic/HeuristicKernels.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+// the AVX2 kernels are compiled via function attributes, so that the library
+// itself does not have to be built with `-mavx2` and still runs on older CPUs
+#if (defined(__x86_64__) || defined(_M_X64)) &&                               \
+    (defined(__GNUC__) || defined(__clang__))
+#define QMAP_HEURISTIC_KERNELS_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace kernels {
+
+namespace {
+
+template <class Combine>
+double combineLanes(const std::array<double, LANES>& acc, Combine combine) {
+  return combine(combine(acc[0], acc[1]), combine(acc[2], acc[3]));
+}
+
+double scalarPairMax(const double* table, const std::uint32_t* from,
+                     const std::uint32_t* to, const std::size_t count) {
+  std::array<double, LANES> acc{};
+  for (std::size_t i = 0; i < count; ++i) {
+    auto& lane = acc[i % LANES];
+    lane = std::max(lane, std::max(table[from[i]], table[to[i]]));
+  }
+  return combineLanes(acc, [](double a, double b) { return std::max(a, b); });
+}
+
+double scalarPairSum(const double* table, const std::uint32_t* from,
+                     const std::uint32_t* to, const std::size_t count) {
+  std::array<double, LANES> acc{};
+  for (std::size_t i = 0; i < count; ++i) {
+    acc[i % LANES] += std::max(table[from[i]], table[to[i]]);
+  }
+  return combineLanes(acc, [](double a, double b) { return a + b; });
+}
+
+double scalarEdgeCostMin(const double* costs, const double* row1,
+                         const std::uint32_t* col1, const double* row2,
+                         const std::uint32_t* col2, const std::size_t count) {
+  std::array<double, LANES> acc{};
+  acc.fill(std::numeric_limits<double>::max());
+  for (std::size_t i = 0; i < count; ++i) {
+    auto& lane = acc[i % LANES];
+    lane = std::min(lane, costs[i] + row1[col1[i]] + row2[col2[i]]);
+  }
+  return combineLanes(acc, [](double a, double b) { return std::min(a, b); });
+}
+
+#ifdef QMAP_HEURISTIC_KERNELS_AVX2
+// NOLINTBEGIN(portability-simd-intrinsics)
+// masked gather with an explicit source, since the unmasked variant leaves its
+// source register undefined, which triggers spurious warnings in GCC
+__attribute__((target("avx2"))) __m256d gather(const double* base,
+                                               const __m128i idx) {
+  const auto all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+  return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), base, idx, all,
+                                  sizeof(double));
+}
+
+__attribute__((target("avx2"))) __m256d gatherPair(const double* table,
+                                                   const std::uint32_t* from,
+                                                   const std::uint32_t* to) {
+  const auto f = _mm_loadu_si128(reinterpret_cast<const __m128i*>(from));
+  const auto t = _mm_loadu_si128(reinterpret_cast<const __m128i*>(to));
+  return _mm256_max_pd(gather(table, f), gather(table, t));
+}
+
+__attribute__((target("avx2"))) double
+avx2PairMax(const double* table, const std::uint32_t* from,
+            const std::uint32_t* to, const std::size_t count) {
+  auto vacc = _mm256_setzero_pd();
+  std::size_t i = 0;
+  for (; i + LANES <= count; i += LANES) {
+    vacc = _mm256_max_pd(vacc, gatherPair(table, from + i, to + i));
+  }
+  std::array<double, LANES> acc{};
+  _mm256_storeu_pd(acc.data(), vacc);
+  for (; i < count; ++i) {
+    auto& lane = acc[i % LANES];
+    lane = std::max(lane, std::max(table[from[i]], table[to[i]]));
+  }
+  return combineLanes(acc, [](double a, double b) { return std::max(a, b); });
+}
+
+__attribute__((target("avx2"))) double
+avx2PairSum(const double* table, const std::uint32_t* from,
+            const std::uint32_t* to, const std::size_t count) {
+  auto vacc = _mm256_setzero_pd();
+  std::size_t i = 0;
+  for (; i + LANES <= count; i += LANES) {
+    vacc = _mm256_add_pd(vacc, gatherPair(table, from + i, to + i));
+  }
+  std::array<double, LANES> acc{};
+  _mm256_storeu_pd(acc.data(), vacc);
+  for (; i < count; ++i) {
+    acc[i % LANES] += std::max(table[from[i]], table[to[i]]);
+  }
+  return combineLanes(acc, [](double a, double b) { return a + b; });
+}
+
+__attribute__((target("avx2"))) double
+avx2EdgeCostMin(const double* costs, const double* row1,
+                const std::uint32_t* col1, const double* row2,
+                const std::uint32_t* col2, const std::size_t count) {
+  auto vacc = _mm256_set1_pd(std::numeric_limits<double>::max());
+  std::size_t i = 0;
+  for (; i + LANES <= count; i += LANES) {
+    const auto c1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(col1 + i));
+    const auto c2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(col2 + i));
+    auto cost = _mm256_add_pd(_mm256_loadu_pd(costs + i), gather(row1, c1));
+    cost = _mm256_add_pd(cost, gather(row2, c2));
+    vacc = _mm256_min_pd(vacc, cost);
+  }
+  std::array<double, LANES> acc{};
+  _mm256_storeu_pd(acc.data(), vacc);
+  for (; i < count; ++i) {
+    auto& lane = acc[i % LANES];
+    lane = std::min(lane, costs[i] + row1[col1[i]] + row2[col2[i]]);
+  }
+  return combineLanes(acc, [](double a, double b) { return std::min(a, b); });
+}
+// NOLINTEND(portability-simd-intrinsics)
+#endif
+
+} // namespace
+
+bool isAvailable(const Backend backend) {
+  switch (backend) {
+  case Backend::Scalar:
+    return true;
+  case Backend::AVX2:
+#ifdef QMAP_HEURISTIC_KERNELS_AVX2
+    return __builtin_cpu_supports("avx2") != 0;
+#else
+    return false;
+#endif
+  }
+  return false;
+}
+
+Backend bestAvailable() {
+  static const Backend BEST =
+      isAvailable(Backend::AVX2) ? Backend::AVX2 : Backend::Scalar;
+  return BEST;
+}
+
+double gatherPairMax(const double* table, const std::uint32_t* from,
+                     const std::uint32_t* to, const std::size_t count,
+                     const Backend backend) {
+#ifdef QMAP_HEURISTIC_KERNELS_AVX2
+  if (backend == Backend::AVX2) {
+    return avx2PairMax(table, from, to, count);
+  }
+#endif
+  static_cast<void>(backend);
+  return scalarPairMax(table, from, to, count);
+}
+
+double gatherPairSum(const double* table, const std::uint32_t* from,
+                     const std::uint32_t* to, const std::size_t count,
+                     const Backend backend) {
+#ifdef QMAP_HEURISTIC_KERNELS_AVX2
+  if (backend == Backend::AVX2) {
+    return avx2PairSum(table, from, to, count);
+  }
+#endif
+  static_cast<void>(backend);
+  return scalarPairSum(table, from, to, count);
+}
+
+double gatherEdgeCostMin(const double* costs, const double* row1,
+                         const std::uint32_t* col1, const double* row2,
+                         const std::uint32_t* col2, const std::size_t count,
+                         const Backend backend) {
+#ifdef QMAP_HEURISTIC_KERNELS_AVX2
+  if (backend == Backend::AVX2) {
+    return avx2EdgeCostMin(costs, row1, col1, row2, col2, count);
+  }
+#endif
+  static_cast<void>(backend);
+  return scalarEdgeCostMin(costs, row1, col1, row2, col2, count);
+}
+
+} // namespace kernels
@@ -18,6 +18,7 @@
 #include "sc/configuration/InitialLayout.hpp"
 #include "sc/configuration/Layering.hpp"
 #include "sc/configuration/LookaheadHeuristic.hpp"
+#include "sc/heuristic/HeuristicKernels.hpp"
 #include "sc/utils.hpp"
 
 #include <algorithm>
@@ -45,6 +46,8 @@ void HeuristicMapper::map(const Configuration& configuration) {
 
   tightHeur = isTight(configuration.heuristic);
   fidelityAwareHeur = isFidelityAware(configuration.heuristic);
+  streaming = false;
+  layerOffset = 0;
 
   results = MappingResults{};
   results.config = configuration;
@@ -103,6 +106,131 @@ void HeuristicMapper::map(const Configuration& configuration) {
   }
 }
 
+void HeuristicMapper::mapStreaming(const Configuration& configuration,
+                                   std::ostream& os) {
+  if (configuration.dataLoggingEnabled()) {
+    throw QMAPException("Data logging is not supported when streaming the "
+                        "mapped circuit!");
+  }
+  if (configuration.iterativeBidirectionalRoutingPasses > 0) {
+    throw QMAPException("Iterative bidirectional routing is not supported "
+                        "when streaming the mapped circuit!");
+  }
+
+  tightHeur = isTight(configuration.heuristic);
+  fidelityAwareHeur = isFidelityAware(configuration.heuristic);
+
+  results = MappingResults{};
+  results.config = configuration;
+  const auto& config = results.config;
+  checkParameters();
+  const auto start = std::chrono::steady_clock::now();
+  initResults();
+
+  // perform pre-mapping optimizations
+  preMappingOptimizations(config);
+
+  streaming = true;
+  layers.clear();
+  layerOffset = 0;
+  LayeringState state(architecture->getNqubits());
+  auto gateIt = qc.begin();
+  std::size_t createdLayers = 0;
+  // the current layer, its lookahead layers, and one more layer that may
+  // still receive gates
+  const auto windowSize = config.nrLookaheads + 2;
+  const auto fillWindow = [&]() {
+    const auto before = layers.size();
+    while (gateIt != qc.end() && layers.size() < windowSize) {
+      addToLayers(gateIt->get(), state);
+      ++gateIt;
+    }
+    createdLayers += layers.size() - before;
+  };
+
+  fillWindow();
+  computeLayerMultiplicities();
+  createInitialMapping();
+
+  // build qubit index -> register map of the mapped circuit
+  qc::QubitIndexToRegisterMap qregs{};
+  const qc::BitIndexToRegisterMap cregs{};
+  os << "OPENQASM 3.0;\n"
+     << "include \"stdgates.inc\";\n";
+  for (const auto& [regName, reg] : qcMapped.getQuantumRegisters()) {
+    os << "qubit[" << reg.getSize() << "] " << regName << ";\n";
+    const auto bound = reg.getStartIndex() + reg.getSize();
+    for (qc::Qubit i = reg.getStartIndex(); i < bound; ++i) {
+      qregs.try_emplace(i, reg, reg.toString(i));
+    }
+  }
+
+  std::size_t gateidx = 0;
+  std::vector<std::size_t> gatesToAdjust{};
+  results.output.gates = 0U;
+  std::size_t routedLayers = 0;
+  while (!layers.empty()) {
+    computeLayerMultiplicities();
+    if (routeLayer(0, gateidx, gatesToAdjust)) {
+      ++routedLayers;
+    }
+
+    // write the mapped layer and discard it
+    postMappingOptimizations(config);
+    countGates(qcMapped, results.output);
+    qc::CompoundOperation mappedLayer{};
+    for (auto& op : qcMapped) {
+      mappedLayer.emplace_back(std::move(op));
+    }
+    qcMapped.clear();
+    mappedLayer.dumpOpenQASM3(os, qregs, cregs);
+
+    layers.erase(layers.begin());
+    ++layerOffset;
+    fillWindow();
+  }
+  streaming = false;
+  results.input.layers = createdLayers;
+
+  finalizeHeuristicBenchmark(routedLayers);
+
+  // infer output permutation from qubit locations
+  qcMapped.outputPermutation.clear();
+  for (std::size_t i = 0U; i < architecture->getNqubits(); ++i) {
+    const auto lq = qubits.at(i);
+    // only qubits from the original circuit are measured
+    if (lq != DEFAULT_POSITION &&
+        static_cast<qc::Qubit>(lq) < qc.getNqubits()) {
+      qcMapped.outputPermutation[static_cast<qc::Qubit>(i)] =
+          static_cast<qc::Qubit>(lq);
+    }
+  }
+
+  if (config.addMeasurementsToMappedCircuit &&
+      !qcMapped.outputPermutation.empty()) {
+    os << "bit[" << qc.getNqubits() << "] c;\n";
+    for (const auto& [physical, logical] : qcMapped.outputPermutation) {
+      os << "c[" << logical << "] = measure " << qregs.at(physical).second
+         << ";\n";
+    }
+  }
+  os << "// i";
+  for (const auto& [physical, logical] : qcMapped.initialLayout) {
+    os << " " << logical;
+  }
+  os << "\n// o";
+  for (const auto& [physical, logical] : qcMapped.outputPermutation) {
+    os << " " << logical;
+  }
+  os << "\n";
+  os.flush();
+
+  const auto end = std::chrono::steady_clock::now();
+  const std::chrono::duration<double> diff = end - start;
+  results.time = diff.count();
+  results.timeout = false;
+}
+
 void HeuristicMapper::staticInitialMapping() {
   for (const auto& gate : layers.at(0U)) {
     if (gate.singleQubit()) {
@@ -248,7 +376,9 @@ void findAndSWAP(const qc::Qubit targetValue, const qc::Qubit newPosition,
 } // namespace
 
 void HeuristicMapper::mapUnmappedGates(std::size_t layer) {
-  if (fidelityAwareHeur) {
+  // when streaming, gates on unmapped qubits cannot be adjusted after routing
+  // since they have already been written
+  if (fidelityAwareHeur || streaming) {
     for (std::size_t q = 0; q < singleQubitMultiplicities.at(layer).size();
          ++q) {
       if (singleQubitMultiplicities.at(layer).at(q) == 0) {
@@ -262,6 +392,10 @@ void HeuristicMapper::mapUnmappedGates(std::size_t layer) {
           if (qubits.at(physQbit) == -1) {
             locations.at(q) = static_cast<std::int16_t>(physQbit);
             qubits.at(physQbit) = static_cast<std::int16_t>(q);
+            if (streaming) {
+              findAndSWAP(static_cast<qc::Qubit>(q), physQbit,
+                          qcMapped.initialLayout);
+            }
             break;
           }
         }
@@ -269,8 +403,9 @@ void HeuristicMapper::mapUnmappedGates(std::size_t layer) {
     }
   }
 
-  for (const auto& [logEdge, _] : twoQubitMultiplicities.at(layer)) {
-    const auto& [q1, q2] = logEdge;
+  for (const auto& gateCount : twoQubitMultiplicities.at(layer)) {
+    const auto q1 = gateCount.q1;
+    const auto q2 = gateCount.q2;
 
     const auto q1Location = locations.at(q1);
     const auto q2Location = locations.at(q2);
@@ -382,108 +517,180 @@ void HeuristicMapper::pseudoRouteCircuit(bool reverse) {
   activeQubits2QGates = originalActiveQubits2QGates;
 }
 
-void HeuristicMapper::routeCircuit() {
+bool HeuristicMapper::routeLayer(const std::size_t layer, std::size_t& gateidx,
+                                 std::vector<std::size_t>& gatesToAdjust) {
   const auto& config = results.config;
+  // index of the layer in the whole circuit
+  const auto circuitLayer = layerOffset + layer;
 
-  std::size_t gateidx = 0;
-  std::vector<std::size_t> gatesToAdjust{};
-  results.output.gates = 0U;
-  for (std::size_t layerIndex = 0; layerIndex < layers.size(); ++layerIndex) {
-    const Node result = aStarMap(layerIndex, false);
+  // all gates of the layer may have been executed early already
+  if (layers.at(layer).empty()) {
+    return false;
+  }
 
-    qubits = result.qubits;
-    locations = result.locations;
+  const Node result = aStarMap(layer, false);
 
-    if (config.verbose) {
-      printLocations(std::clog);
-      printQubits(std::clog);
-    }
+  qubits = result.qubits;
+  locations = result.locations;
 
-    if (layerIndex != 0 && config.addBarriersBetweenLayers) {
-      qcMapped.barrier();
-      gateidx++;
-    }
+  if (config.verbose) {
+    printLocations(std::clog);
+    printQubits(std::clog);
+  }
 
-    // initial layer needs no swaps
-    if (layerIndex != 0 || config.swapOnFirstLayer) {
-      for (const auto& swap : result.swaps) {
-        if (swap.op == qc::SWAP) {
-          if (config.verbose) {
-            std::clog << "SWAP: " << swap.first << " <-> " << swap.second
-                      << "\n";
-          }
-          // check if SWAP is placed on a valid edge
-          assert(
-              architecture->isEdgeConnected({swap.first, swap.second}, false));
-          qcMapped.swap(swap.first, swap.second);
-          results.output.swaps++;
-        } else if (swap.op == qc::Teleportation) {
-          if (config.verbose) {
-            std::clog << "TELE: " << swap.first << " <-> " << swap.second
-                      << "\n";
-          }
-          qcMapped.emplace_back<qc::StandardOperation>(
-              qc::Targets{static_cast<qc::Qubit>(swap.first),
-                          static_cast<qc::Qubit>(swap.second),
-                          static_cast<qc::Qubit>(swap.middleAncilla)},
-              qc::Teleportation);
-          results.output.teleportations++;
+  if (circuitLayer != 0 && config.addBarriersBetweenLayers) {
+    qcMapped.barrier();
+    gateidx++;
+  }
+
+  // initial layer needs no swaps
+  if (circuitLayer != 0 || config.swapOnFirstLayer) {
+    for (const auto& swap : result.swaps) {
+      if (swap.op == qc::SWAP) {
+        if (config.verbose) {
+          std::clog << "SWAP: " << swap.first << " <-> " << swap.second << "\n";
+        }
+        // check if SWAP is placed on a valid edge
+        assert(architecture->isEdgeConnected({swap.first, swap.second}, false));
+        qcMapped.swap(swap.first, swap.second);
+        results.output.swaps++;
+      } else if (swap.op == qc::Teleportation) {
+        if (config.verbose) {
+          std::clog << "TELE: " << swap.first << " <-> " << swap.second << "\n";
         }
-        gateidx++;
+        qcMapped.emplace_back<qc::StandardOperation>(
+            qc::Targets{static_cast<qc::Qubit>(swap.first),
+                        static_cast<qc::Qubit>(swap.second),
+                        static_cast<qc::Qubit>(swap.middleAncilla)},
+            qc::Teleportation);
+        results.output.teleportations++;
       }
+      gateidx++;
     }
+  }
 
-    // add gates of the layer to circuit
-    for (const auto& gate : layers.at(layerIndex)) {
-      auto* op = dynamic_cast<qc::StandardOperation*>(gate.op);
-      if (op == nullptr) {
-        throw QMAPException(
-            "Cast to StandardOperation not possible during mapping. Check that "
-            "circuit contains only StandardOperations");
-      }
+  // add gates of the layer to circuit
+  for (const auto& gate : layers.at(layer)) {
+    appendMappedGate(gate, gateidx, gatesToAdjust);
+  }
 
-      if (gate.singleQubit()) {
-        if (locations.at(gate.target) == DEFAULT_POSITION) {
-          qcMapped.emplace_back<qc::StandardOperation>(
-              gate.target, op->getType(), op->getParameter());
-          gatesToAdjust.push_back(gateidx);
-          gateidx++;
-        } else {
-          qcMapped.emplace_back<qc::StandardOperation>(
-              locations.at(gate.target), op->getType(), op->getParameter());
-          gateidx++;
-        }
-      } else {
-        const Edge cnot = {
-            locations.at(static_cast<std::uint16_t>(gate.control)),
-            locations.at(gate.target)};
-        if (!architecture->isEdgeConnected(cnot)) {
-          const Edge reversed = {cnot.second, cnot.first};
-          // check if CNOT is placed on a valid edge
-          assert(architecture->isEdgeConnected(reversed));
-          qcMapped.h(reversed.first);
-          qcMapped.h(reversed.second);
-          qcMapped.cx(qc::Control{static_cast<qc::Qubit>(reversed.first)},
-                      reversed.second);
-          qcMapped.h(reversed.second);
-          qcMapped.h(reversed.first);
-
-          results.output.directionReverse++;
-          gateidx += 5;
-        } else {
-          qcMapped.cx(qc::Control{static_cast<qc::Qubit>(cnot.first)},
-                      cnot.second);
-          gateidx++;
-        }
+  if (config.layering == Layering::CommutationFront) {
+    absorbExecutableGates(layer, gateidx, gatesToAdjust);
+  }
+  return true;
+}
+
+void HeuristicMapper::appendMappedGate(
+    const Gate& gate, std::size_t& gateidx,
+    std::vector<std::size_t>& gatesToAdjust) {
+  auto* op = dynamic_cast<qc::StandardOperation*>(gate.op);
+  if (op == nullptr) {
+    throw QMAPException(
+        "Cast to StandardOperation not possible during mapping. Check that "
+        "circuit contains only StandardOperations");
+  }
+
+  if (gate.singleQubit()) {
+    if (locations.at(gate.target) == DEFAULT_POSITION) {
+      qcMapped.emplace_back<qc::StandardOperation>(
+          gate.target, op->getType(), op->getParameter());
+      gatesToAdjust.push_back(gateidx);
+      gateidx++;
+    } else {
+      qcMapped.emplace_back<qc::StandardOperation>(
+          locations.at(gate.target), op->getType(), op->getParameter());
+      gateidx++;
+    }
+  } else {
+    const Edge cnot = {locations.at(static_cast<std::uint16_t>(gate.control)),
+                       locations.at(gate.target)};
+    if (!architecture->isEdgeConnected(cnot)) {
+      const Edge reversed = {cnot.second, cnot.first};
+      // check if CNOT is placed on a valid edge
+      assert(architecture->isEdgeConnected(reversed));
+      qcMapped.h(reversed.first);
+      qcMapped.h(reversed.second);
+      qcMapped.cx(qc::Control{static_cast<qc::Qubit>(reversed.first)},
+                  reversed.second);
+      qcMapped.h(reversed.second);
+      qcMapped.h(reversed.first);
+
+      results.output.directionReverse++;
+      gateidx += 5;
+    } else {
+      qcMapped.cx(qc::Control{static_cast<qc::Qubit>(cnot.first)}, cnot.second);
+      gateidx++;
+    }
+  }
+}
+
+void HeuristicMapper::absorbExecutableGates(
+    const std::size_t layer, std::size_t& gateidx,
+    std::vector<std::size_t>& gatesToAdjust) {
+  const auto& config = results.config;
+  const auto end = std::min(layers.size(), layer + 1 + config.nrLookaheads);
+  // commutation class of the gates on each qubit which remain in the layers
+  // (std::nullopt if no gate on the qubit remains so far); later gates on
+  // the qubit may only be executed early if they commute with these
+  std::vector<std::optional<CommutationClass>> blocked(
+      architecture->getNqubits(), std::nullopt);
+  const auto passes = [&blocked](const std::uint16_t q,
+                                 const CommutationClass cls) {
+    return !blocked.at(q).has_value() ||
+           (*blocked.at(q) == cls && cls != CommutationClass::None);
+  };
+  const auto block = [&blocked](const std::uint16_t q,
+                                const CommutationClass cls) {
+    if (!blocked.at(q).has_value()) {
+      blocked.at(q) = cls;
+    } else if (*blocked.at(q) != cls) {
+      blocked.at(q) = CommutationClass::None;
+    }
+  };
+
+  for (std::size_t j = layer + 1; j < end; ++j) {
+    auto& gates = layers.at(j);
+    const auto sizeBefore = gates.size();
+    auto it = gates.begin();
+    while (it != gates.end()) {
+      const auto targetClass = commutationClass(it->op->getType(), false);
+      bool executable = locations.at(it->target) != DEFAULT_POSITION &&
+                        passes(it->target, targetClass);
+      std::uint16_t control = 0;
+      if (!it->singleQubit()) {
+        control = static_cast<std::uint16_t>(it->control);
+        executable = executable &&
+                     locations.at(control) != DEFAULT_POSITION &&
+                     passes(control, CommutationClass::ZDiagonal) &&
+                     architecture->isEdgeConnected(
+                         {static_cast<std::uint16_t>(locations.at(control)),
+                          static_cast<std::uint16_t>(locations.at(it->target))},
+                         false);
       }
+      if (executable) {
+        appendMappedGate(*it, gateidx, gatesToAdjust);
+        it = gates.erase(it);
+        continue;
+      }
+      block(it->target, targetClass);
+      if (!it->singleQubit()) {
+        block(control, CommutationClass::ZDiagonal);
+      }
+      ++it;
+    }
+    if (gates.size() != sizeBefore) {
+      computeLayerMultiplicities(j);
     }
   }
+}
 
+void HeuristicMapper::finalizeHeuristicBenchmark(const std::size_t nLayers) {
+  const auto& config = results.config;
   if (config.debug && results.heuristicBenchmark.expandedNodes > 0) {
     auto& benchmark = results.heuristicBenchmark;
     benchmark.secondsPerNode /= static_cast<double>(benchmark.expandedNodes);
     benchmark.averageBranchingFactor =
-        static_cast<double>(benchmark.generatedNodes - layers.size()) /
+        static_cast<double>(benchmark.generatedNodes - nLayers) /
         static_cast<double>(benchmark.expandedNodes);
     for (const auto& layer : results.layerHeuristicBenchmark) {
       benchmark.effectiveBranchingFactor +=
@@ -492,6 +699,20 @@ void HeuristicMapper::routeCircuit() {
            static_cast<double>(benchmark.expandedNodes));
     }
   }
+}
+
+void HeuristicMapper::routeCircuit() {
+  std::size_t gateidx = 0;
+  std::vector<std::size_t> gatesToAdjust{};
+  results.output.gates = 0U;
+  std::size_t routedLayers = 0;
+  for (std::size_t layerIndex = 0; layerIndex < layers.size(); ++layerIndex) {
+    if (routeLayer(layerIndex, gateidx, gatesToAdjust)) {
+      ++routedLayers;
+    }
+  }
+
+  finalizeHeuristicBenchmark(routedLayers);
 
   // infer output permutation from qubit locations
   qcMapped.outputPermutation.clear();
@@ -568,6 +789,16 @@ void HeuristicMapper::routeCircuit() {
   }
 }
 
+std::vector<const qc::Operation*>
+HeuristicMapper::getLayerOperations(const std::size_t layer) const {
+  std::vector<const qc::Operation*> ops{};
+  ops.reserve(layers.at(layer).size());
+  for (const auto& gate : layers.at(layer)) {
+    ops.emplace_back(gate.op);
+  }
+  return ops;
+}
+
 HeuristicMapper::Node HeuristicMapper::aStarMap(size_t layer, bool reverse) {
   const auto& config = results.config;
   nextNodeId = 0;
@@ -596,6 +827,33 @@ HeuristicMapper::Node HeuristicMapper::aStarMap(size_t layer, bool reverse) {
   }
   nodes.push(node);
 
+  // continue from the seeds carried over from a search aborted to split the
+  // layer; their swaps are replayed from the root, since all costs depending
+  // on the gates of the layer have to be re-evaluated for the split layer
+  // (seeds containing teleportations are dropped, since these depend on the
+  // teleportation qubits available while expanding each node)
+  for (const auto& seed : splitSeeds) {
+    if (std::any_of(seed.swaps.begin(), seed.swaps.end(),
+                    [](const Exchange& e) { return e.op != qc::SWAP; })) {
+      continue;
+    }
+    Node seedNode(nextNodeId++, node.id, node.qubits, node.locations,
+                  node.swaps, node.validMappedTwoQubitGates, node.costFixed,
+                  node.costFixedReversals, seed.depth, node.sharedSwaps);
+    for (const auto& swap : seed.swaps) {
+      applySWAP({swap.first, swap.second}, layer, seedNode);
+    }
+    if (config.dataLoggingEnabled()) {
+      dataLogger->logSearchNode(
+          layer, seedNode.id, seedNode.parent,
+          seedNode.costFixed + seedNode.costFixedReversals, seedNode.costHeur,
+          seedNode.lookaheadPenalty, seedNode.qubits, seedNode.validMapping,
+          seedNode.swaps, seedNode.depth);
+    }
+    nodes.push(seedNode);
+  }
+  splitSeeds.clear();
+
   const auto start = std::chrono::steady_clock::now();
   std::size_t expandedNodes = 0;
   std::size_t expandedNodesAfterFirstSolution = 0;
@@ -612,16 +870,22 @@ HeuristicMapper::Node HeuristicMapper::aStarMap(size_t layer, bool reverse) {
           nodes.top().getTotalCost() < bestDoneNode.getTotalFixedCost())) {
     if (splittable && expandedNodes >= config.automaticLayerSplitsNodeLimit) {
       if (config.dataLoggingEnabled()) {
-        qc::CompoundOperation compOp{};
-        for (const auto& gate : layers.at(layer)) {
-          compOp.emplace_back(gate.op->clone());
-        }
-
-        dataLogger->logFinalizeLayer(layer, compOp, singleQubitMultiplicity,
+        dataLogger->logFinalizeLayer(layer, getLayerOperations(layer),
+                                     singleQubitMultiplicity,
                                      twoQubitMultiplicity, qubits, 0, 0, 0, 0,
                                      {}, {}, 0);
         dataLogger->splitLayer();
       }
+      // keep the most promising nodes of the aborted search as seeds for the
+      // search on the split layer, so that the work done so far is not lost
+      splitSeeds.clear();
+      while (!nodes.empty() && splitSeeds.size() < MAX_SPLIT_SEEDS) {
+        splitSeeds.emplace_back(nodes.top());
+        nodes.pop();
+      }
+      while (!nodes.empty()) {
+        nodes.pop();
+      }
       splitLayer(layer, *architecture);
       if (config.verbose) {
         std::clog << "Split layer\n";
@@ -725,13 +989,8 @@ HeuristicMapper::Node HeuristicMapper::aStarMap(size_t layer, bool reverse) {
   }
 
   if (config.dataLoggingEnabled()) {
-    qc::CompoundOperation compOp{};
-    for (const auto& gate : layers.at(layer)) {
-      compOp.emplace_back(gate.op->clone());
-    }
-
     dataLogger->logFinalizeLayer(
-        layer, compOp, singleQubitMultiplicities.at(layer),
+        layer, getLayerOperations(layer), singleQubitMultiplicities.at(layer),
         twoQubitMultiplicities.at(layer), qubits, result.id, result.costFixed,
         result.costHeur, result.lookaheadPenalty, result.qubits, result.swaps,
         result.depth);
@@ -844,8 +1103,8 @@ void HeuristicMapper::expandNodeAddOneSwap(const Edge& swap, Node& node,
 
 void HeuristicMapper::recalculateFixedCost(std::size_t layer, Node& node) {
   node.validMappedTwoQubitGates.clear();
-  for (const auto& [edge, mult] : twoQubitMultiplicities.at(layer)) {
-    const auto [q1, q2] = edge;
+  for (const auto& [q1, q2, forwardMult, reverseMult] :
+       twoQubitMultiplicities.at(layer)) {
     const auto physQ1 = static_cast<std::uint16_t>(node.locations.at(q1));
     const auto physQ2 = static_cast<std::uint16_t>(node.locations.at(q2));
 
@@ -876,9 +1135,8 @@ void HeuristicMapper::recalculateFixedCostReversals(std::size_t layer,
   }
 
   // only consider reversal costs as fixed in goal nodes
-  for (const auto& [edge, mult] : twoQubitMultiplicities.at(layer)) {
-    const auto [q1, q2] = edge;
-    const auto [forwardMult, reverseMult] = mult;
+  for (const auto& [q1, q2, forwardMult, reverseMult] :
+       twoQubitMultiplicities.at(layer)) {
     const auto physQ1 = static_cast<std::uint16_t>(node.locations.at(q1));
     const auto physQ2 = static_cast<std::uint16_t>(node.locations.at(q2));
 
@@ -941,14 +1199,13 @@ void HeuristicMapper::recalculateFixedCostFidelity(std::size_t layer,
     }
   }
   // adding cost of two qubit gates that are already mapped next to each other
-  for (const auto& [edge, mult] : twoQubitGateMultiplicity) {
-    if (node.validMappedTwoQubitGates.find(edge) ==
+  for (const auto& [q1, q2, forwardMult, reverseMult] :
+       twoQubitGateMultiplicity) {
+    if (node.validMappedTwoQubitGates.find({q1, q2}) ==
         node.validMappedTwoQubitGates.end()) {
       // 2-qubit-gates not yet validly mapped are handled in the heuristic
       continue;
     }
-    const auto [q1, q2] = edge;
-    const auto [forwardMult, reverseMult] = mult;
     const auto physQ1 = static_cast<std::uint16_t>(node.locations.at(q1));
     const auto physQ2 = static_cast<std::uint16_t>(node.locations.at(q2));
 
@@ -983,9 +1240,10 @@ void HeuristicMapper::applySWAP(const Edge& swap, std::size_t layer,
   node.swaps.emplace_back(swap.first, swap.second, qc::SWAP);
 
   // check if swap created or destroyed any valid mappings of qubit pairs
-  for (const auto& [edge, mult] : twoQubitMultiplicities.at(layer)) {
-    const auto [q3, q4] = edge;
+  for (const auto& gateCount : twoQubitMultiplicities.at(layer)) {
+    const auto [q3, q4, forwardMult, reverseMult] = gateCount;
     if (q3 == q1 || q3 == q2 || q4 == q1 || q4 == q2) {
+      const auto edge = gateCount.edge();
       const auto physQ3 = static_cast<std::uint16_t>(node.locations.at(q3));
       const auto physQ4 = static_cast<std::uint16_t>(node.locations.at(q4));
       if (architecture->isEdgeConnected({physQ3, physQ4}, false)) {
@@ -995,9 +1253,9 @@ void HeuristicMapper::applySWAP(const Edge& swap, std::size_t layer,
           // not mapped validly before
           // add cost of newly validly mapped gates
           node.costFixed +=
-              mult.first *
+              forwardMult *
                   architecture->getTwoQubitFidelityCost(physQ3, physQ4) +
-              mult.second *
+              reverseMult *
                   architecture->getTwoQubitFidelityCost(physQ4, physQ3);
         }
         node.validMappedTwoQubitGates.emplace(edge);
@@ -1021,9 +1279,9 @@ void HeuristicMapper::applySWAP(const Edge& swap, std::size_t layer,
           }
 
           node.costFixed -=
-              mult.first * architecture->getTwoQubitFidelityCost(prevPhysQ3,
-                                                                 prevPhysQ4) +
-              mult.second *
+              forwardMult * architecture->getTwoQubitFidelityCost(prevPhysQ3,
+                                                                  prevPhysQ4) +
+              reverseMult *
                   architecture->getTwoQubitFidelityCost(prevPhysQ4, prevPhysQ3);
         }
         node.validMappedTwoQubitGates.erase(edge);
@@ -1125,17 +1383,17 @@ void HeuristicMapper::applyTeleportation(const Edge& swap, std::size_t layer,
   node.costFixed += COST_TELEPORTATION;
 
   // check if swap created or destroyed any valid mappings of qubit pairs
-  for (const auto& [edge, mult] : twoQubitMultiplicities.at(layer)) {
-    const auto [q3, q4] = edge;
+  for (const auto& [q3, q4, forwardMult, reverseMult] :
+       twoQubitMultiplicities.at(layer)) {
     if (q3 == q1 || q3 == q2 || q4 == q1 || q4 == q2) {
       const auto physQ3 = static_cast<std::uint16_t>(node.locations.at(q3));
       const auto physQ4 = static_cast<std::uint16_t>(node.locations.at(q4));
       if (architecture->isEdgeConnected({physQ3, physQ4}, false)) {
         // validly mapped now
-        node.validMappedTwoQubitGates.emplace(edge);
+        node.validMappedTwoQubitGates.emplace(q3, q4);
       } else {
         // not mapped validly now
-        node.validMappedTwoQubitGates.erase(edge);
+        node.validMappedTwoQubitGates.erase({q3, q4});
       }
     }
   }
@@ -1155,10 +1413,8 @@ void HeuristicMapper::updateSharedSwaps(const Edge& swap, std::size_t layer,
   const auto q1 = node.qubits.at(swap.first);
   const auto q2 = node.qubits.at(swap.second);
   if (q1 == -1 || q2 == -1 ||
-      consideredQubits.find(static_cast<std::uint16_t>(q1)) ==
-          consideredQubits.end() ||
-      consideredQubits.find(static_cast<std::uint16_t>(q2)) ==
-          consideredQubits.end()) {
+      !consideredQubits.contains(static_cast<std::uint16_t>(q1)) ||
+      !consideredQubits.contains(static_cast<std::uint16_t>(q2))) {
     // the given swap can only be a shared swap if both qubits are active in
     // the current layer
     return;
@@ -1168,16 +1424,16 @@ void HeuristicMapper::updateSharedSwaps(const Edge& swap, std::size_t layer,
   //        `Node::sharedSwaps` is ever used in a fidelity aware heuristic
   Edge logEdge1 = {q1, q1};
   Edge logEdge2 = {q2, q2};
-  for (const auto& [edge, multiplicity] : twoQubitGateMultiplicity) {
-    if (edge.first == q1) {
-      logEdge1.second = edge.second;
-    } else if (edge.second == q1) {
-      logEdge1.second = edge.first;
+  for (const auto& gateCount : twoQubitGateMultiplicity) {
+    if (gateCount.q1 == q1) {
+      logEdge1.second = gateCount.q2;
+    } else if (gateCount.q2 == q1) {
+      logEdge1.second = gateCount.q1;
     }
-    if (edge.first == q2) {
-      logEdge2.second = edge.second;
-    } else if (edge.second == q2) {
-      logEdge2.second = edge.first;
+    if (gateCount.q1 == q2) {
+      logEdge2.second = gateCount.q2;
+    } else if (gateCount.q2 == q2) {
+      logEdge2.second = gateCount.q1;
     }
   }
   if ( // if both swapped qubits are acted on by a 2q gate
@@ -1260,15 +1516,17 @@ double HeuristicMapper::heuristicGateCountMaxDistance(std::size_t layer,
     return 0.;
   }
   double costHeur = 0.;
+  const bool vectorized = distanceKernelsApplicable();
+  kernelFrom.clear();
+  kernelTo.clear();
 
-  for (const auto& [edge, multiplicity] : twoQubitMultiplicities.at(layer)) {
-    const auto& [q1, q2] = edge;
-    const auto [forwardMult, reverseMult] = multiplicity;
+  for (const auto& [q1, q2, forwardMult, reverseMult] :
+       twoQubitMultiplicities.at(layer)) {
     const auto physQ1 = static_cast<std::uint16_t>(node.locations.at(q1));
     const auto physQ2 = static_cast<std::uint16_t>(node.locations.at(q2));
 
     if (!architecture->bidirectional() &&
-        node.validMappedTwoQubitGates.find(edge) !=
+        node.validMappedTwoQubitGates.find({q1, q2}) !=
             node.validMappedTwoQubitGates.end()) {
       // validly mapped 2-qubit-gates
       if (!architecture->isEdgeConnected({physQ1, physQ2})) {
@@ -1282,6 +1540,10 @@ double HeuristicMapper::heuristicGateCountMaxDistance(std::size_t layer,
       }
     } else {
       // not validly mapped 2-qubit-gates
+      if (vectorized) {
+        addKernelPair(physQ1, physQ2, forwardMult, reverseMult);
+        continue;
+      }
       if (forwardMult > 0) {
         costHeur = std::max(costHeur, architecture->distance(physQ1, physQ2));
       }
@@ -1291,6 +1553,13 @@ double HeuristicMapper::heuristicGateCountMaxDistance(std::size_t layer,
     }
   }
 
+  if (vectorized) {
+    costHeur = std::max(
+        costHeur,
+        kernels::gatherPairMax(architecture->getFlatDistanceTable().data(),
+                               kernelFrom.data(), kernelTo.data(),
+                               kernelFrom.size()));
+  }
   return costHeur;
 }
 
@@ -1300,15 +1569,17 @@ double HeuristicMapper::heuristicGateCountSumDistance(std::size_t layer,
     return 0.;
   }
   double costHeur = 0.;
+  const bool vectorized = distanceKernelsApplicable();
+  kernelFrom.clear();
+  kernelTo.clear();
 
-  for (const auto& [edge, multiplicity] : twoQubitMultiplicities.at(layer)) {
-    const auto& [q1, q2] = edge;
-    const auto [forwardMult, reverseMult] = multiplicity;
+  for (const auto& [q1, q2, forwardMult, reverseMult] :
+       twoQubitMultiplicities.at(layer)) {
     const auto physQ1 = static_cast<std::uint16_t>(node.locations.at(q1));
     const auto physQ2 = static_cast<std::uint16_t>(node.locations.at(q2));
 
     if (!architecture->bidirectional() &&
-        node.validMappedTwoQubitGates.find(edge) !=
+        node.validMappedTwoQubitGates.find({q1, q2}) !=
             node.validMappedTwoQubitGates.end()) {
       // validly mapped 2-qubit-gates
       if (!architecture->isEdgeConnected({physQ1, physQ2})) {
@@ -1318,6 +1589,10 @@ double HeuristicMapper::heuristicGateCountSumDistance(std::size_t layer,
       }
     } else {
       // not validly mapped 2-qubit-gates
+      if (vectorized) {
+        addKernelPair(physQ1, physQ2, forwardMult, reverseMult);
+        continue;
+      }
       double swapCost = 0.;
 
       if (forwardMult == 0) {
@@ -1335,9 +1610,34 @@ double HeuristicMapper::heuristicGateCountSumDistance(std::size_t layer,
     }
   }
 
+  if (vectorized) {
+    costHeur +=
+        kernels::gatherPairSum(architecture->getFlatDistanceTable().data(),
+                               kernelFrom.data(), kernelTo.data(),
+                               kernelFrom.size());
+  }
   return costHeur;
 }
 
+bool HeuristicMapper::distanceKernelsApplicable() const {
+  const auto n = static_cast<std::size_t>(architecture->getNqubits());
+  return architecture->getCurrentTeleportations().empty() &&
+         n * n <= static_cast<std::size_t>(
+                      std::numeric_limits<std::int32_t>::max()) &&
+         architecture->getFlatDistanceTable().size() == n * n;
+}
+
+void HeuristicMapper::addKernelPair(const std::uint16_t physQ1,
+                                    const std::uint16_t physQ2,
+                                    const std::uint16_t forwardMult,
+                                    const std::uint16_t reverseMult) {
+  const auto n = static_cast<std::uint32_t>(architecture->getNqubits());
+  const auto forward = (physQ1 * n) + physQ2;
+  const auto reverse = (physQ2 * n) + physQ1;
+  kernelFrom.emplace_back(forwardMult > 0 ? forward : reverse);
+  kernelTo.emplace_back(reverseMult > 0 ? reverse : forward);
+}
+
 double HeuristicMapper::heuristicGateCountSumDistanceMinusSharedSwaps(
     std::size_t layer, Node& node) {
   if (node.validMapping) {
@@ -1349,9 +1649,8 @@ double HeuristicMapper::heuristicGateCountSumDistanceMinusSharedSwaps(
   std::vector<std::size_t> nSwaps{};
   nSwaps.reserve(twoQubitGateMultiplicity.size());
 
-  for (const auto& [edge, multiplicity] : twoQubitGateMultiplicity) {
-    const auto& [q1, q2] = edge;
-    const auto [forwardMult, reverseMult] = multiplicity;
+  for (const auto& [q1, q2, forwardMult, reverseMult] :
+       twoQubitGateMultiplicity) {
     const auto physQ1 = static_cast<std::uint16_t>(node.locations.at(q1));
     const auto physQ2 = static_cast<std::uint16_t>(node.locations.at(q2));
 
@@ -1362,7 +1661,7 @@ double HeuristicMapper::heuristicGateCountSumDistanceMinusSharedSwaps(
           std::min(forwardMult, reverseMult) * COST_DIRECTION_REVERSE;
     }
 
-    if (node.validMappedTwoQubitGates.find(edge) !=
+    if (node.validMappedTwoQubitGates.find({q1, q2}) !=
         node.validMappedTwoQubitGates.end()) {
       // validly mapped 2-qubit-gates
       continue;
@@ -1470,44 +1769,55 @@ double HeuristicMapper::heuristicFidelityBestLocation(std::size_t layer,
     savingsPotential += qbitSavings;
   }
 
+  // the edges of the architecture and the distance table rows are passed to
+  // the vectorized kernels as flat arrays
+  const auto& edgeSources = architecture->getEdgeSources();
+  const auto& edgeTargets = architecture->getEdgeTargets();
+  const auto& edgeCosts = architecture->getEdgeFidelityCosts();
+  const auto& edgeReverseCosts = architecture->getEdgeFidelityCosts(true);
+  const auto nEdges = edgeSources.size();
+  const auto& fidelityDistanceTables =
+      architecture->getFidelityDistanceTables();
+  const auto skipEdges = consideredQubits.size() - 1;
+  kernelZeroRow.assign(architecture->getNqubits(), 0.);
+  const auto fidelityRow = [&](const std::uint16_t physQbit) -> const double* {
+    if (skipEdges >= fidelityDistanceTables.size()) {
+      return kernelZeroRow.data();
+    }
+    return fidelityDistanceTables[skipEdges][physQbit].data();
+  };
+
   // iterating over all virtual qubit pairs, that share a gate on the
   // current layer
-  for (const auto& [edge, mult] : twoQubitGateMultiplicity) {
-    const auto [q1, q2] = edge;
-    const auto [forwardMult, reverseMult] = mult;
-
-    const bool edgeDone = (node.validMappedTwoQubitGates.find(edge) !=
-                               node.validMappedTwoQubitGates.end() ||
-                           node.validMappedTwoQubitGates.find({q1, q2}) !=
-                               node.validMappedTwoQubitGates.end());
+  for (const auto& [q1, q2, forwardMult, reverseMult] :
+       twoQubitGateMultiplicity) {
+    const bool edgeDone = node.validMappedTwoQubitGates.find({q1, q2}) !=
+                          node.validMappedTwoQubitGates.end();
 
     // find the optimal edge, to which to remap the given virtual qubit
     // pair and take the cost of moving it there via swaps plus the
     // fidelity cost  of executing all their shared gates on that edge
     // as the qubit pairs cost
-    double swapCost = std::numeric_limits<double>::max();
-    for (const auto& [q3, q4] : architecture->getCouplingMap()) {
-      swapCost = std::min(
-          swapCost,
-          forwardMult * architecture->getTwoQubitFidelityCost(q3, q4) +
-              reverseMult * architecture->getTwoQubitFidelityCost(q4, q3) +
-              architecture->fidelityDistance(
-                  static_cast<std::uint16_t>(node.locations.at(q1)), q3,
-                  consideredQubits.size() - 1) +
-              architecture->fidelityDistance(
-                  static_cast<std::uint16_t>(node.locations.at(q2)), q4,
-                  consideredQubits.size() - 1));
-      swapCost = std::min(
-          swapCost,
-          forwardMult * architecture->getTwoQubitFidelityCost(q4, q3) +
-              reverseMult * architecture->getTwoQubitFidelityCost(q3, q4) +
-              architecture->fidelityDistance(
-                  static_cast<std::uint16_t>(node.locations.at(q2)), q3,
-                  consideredQubits.size() - 1) +
-              architecture->fidelityDistance(
-                  static_cast<std::uint16_t>(node.locations.at(q1)), q4,
-                  consideredQubits.size() - 1));
+    const auto loc1 = static_cast<std::uint16_t>(node.locations.at(q1));
+    const auto loc2 = static_cast<std::uint16_t>(node.locations.at(q2));
+    const auto* row1 = fidelityRow(loc1);
+    const auto* row2 = fidelityRow(loc2);
+    kernelEdgeCosts.resize(nEdges);
+    for (std::size_t i = 0; i < nEdges; ++i) {
+      kernelEdgeCosts[i] = (forwardMult * edgeCosts[i]) +
+                           (reverseMult * edgeReverseCosts[i]);
+    }
+    double swapCost = kernels::gatherEdgeCostMin(
+        kernelEdgeCosts.data(), row1, edgeSources.data(), row2,
+        edgeTargets.data(), nEdges);
+    for (std::size_t i = 0; i < nEdges; ++i) {
+      kernelEdgeCosts[i] = (forwardMult * edgeReverseCosts[i]) +
+                           (reverseMult * edgeCosts[i]);
     }
+    swapCost = std::min(swapCost, kernels::gatherEdgeCostMin(
+                                      kernelEdgeCosts.data(), row2,
+                                      edgeSources.data(), row1,
+                                      edgeTargets.data(), nEdges));
 
     if (edgeDone) {
       const double currEdgeCost =
@@ -1564,9 +1874,8 @@ HeuristicMapper::lookaheadGateCountMaxDistance(const std::size_t layer,
                                                HeuristicMapper::Node& node) {
   double penalty = 0.;
 
-  for (const auto& [edge, multiplicity] : twoQubitMultiplicities.at(layer)) {
-    const auto& [q1, q2] = edge;
-    const auto [forwardMult, reverseMult] = multiplicity;
+  for (const auto& [q1, q2, forwardMult, reverseMult] :
+       twoQubitMultiplicities.at(layer)) {
 
     const auto loc1 = node.locations.at(q1);
     const auto loc2 = node.locations.at(q2);
@@ -1628,9 +1937,8 @@ HeuristicMapper::lookaheadGateCountSumDistance(const std::size_t layer,
                                                HeuristicMapper::Node& node) {
   double penalty = 0.;
 
-  for (const auto& [edge, multiplicity] : twoQubitMultiplicities.at(layer)) {
-    const auto& [q1, q2] = edge;
-    const auto [forwardMult, reverseMult] = multiplicity;
+  for (const auto& [q1, q2, forwardMult, reverseMult] :
+       twoQubitMultiplicities.at(layer)) {
 
     const auto loc1 = node.locations.at(q1);
     const auto loc2 = node.locations.at(q2);
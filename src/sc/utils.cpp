@@ -177,6 +177,25 @@ void Dijkstra::buildSingleEdgeSkipTable(const Matrix& distanceTable,
   }
 }
 
+/// add the given gate counts to the (sorted) entry of the edge (q1, q2)
+void addTwoQubitGateCount(TwoQubitMultiplicity& multiplicity,
+                          const std::uint16_t q1, const std::uint16_t q2,
+                          const std::uint16_t forward,
+                          const std::uint16_t backward) {
+  assert(q1 <= q2);
+  const auto it = std::lower_bound(
+      multiplicity.begin(), multiplicity.end(), Edge{q1, q2},
+      [](const TwoQubitGateCount& count, const Edge& edge) {
+        return count.edge() < edge;
+      });
+  if (it != multiplicity.end() && it->q1 == q1 && it->q2 == q2) {
+    it->forward += forward;
+    it->backward += backward;
+    return;
+  }
+  multiplicity.insert(it, {q1, q2, forward, backward});
+}
+
 /// Create a string representation of a given permutation
 /// \param pi permutation
 /// \return string representation of pi
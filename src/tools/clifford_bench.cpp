@@ -0,0 +1,168 @@
+//
+// This file is part of the MQT QMAP library released under the MIT license.
+// See README.md or go to https://github.com/cda-tum/qmap for more information.
+//
+
+// Runs the Clifford synthesizer on the tests of a JSON file in the format of
+// test/cliffordsynthesis/{circuits,tableaus}.json and prints one JSON line of
+// results per test. This is used to compare the encoding-size reductions of
+// cs::Configuration (coupling map, interaction and window pruning) and the
+// solve times of the gate limit encodings.
+
+#include "Logic.hpp"
+#include "cliffordsynthesis/CliffordSynthesizer.hpp"
+#include "cliffordsynthesis/Configuration.hpp"
+#include "cliffordsynthesis/Tableau.hpp"
+#include "cliffordsynthesis/TargetMetric.hpp"
+#include "logicblocks/Encodings.hpp"
+#include "logicblocks/Statistics.hpp"
+#include "qasm3/Importer.hpp"
+
+#include <cstddef>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr auto USAGE =
+    "Usage: mqt-qmap-clifford-bench [options] tests.json\n"
+    "  --metric m      gates|depth|two_qubit_gates (default: gates)\n"
+    "  --line          only allow two-qubit gates between neighbouring\n"
+    "                  qubits of a line\n"
+    "  --interaction   prune pairs of qubits that never interact\n"
+    "  --window n      restrict two-qubit gates to a window of n qubits\n"
+    "  --database      look up small targets in the database of optimal\n"
+    "                  circuits instead of solving them\n"
+    "  --gate-limit-encoding e\n"
+    "                  pseudo_boolean|sequential_counter|totalizer|\n"
+    "                  modulo_totalizer (default: pseudo_boolean)\n";
+
+struct Options {
+  std::string tests;
+  cs::TargetMetric metric = cs::TargetMetric::Gates;
+  bool line = false;
+  bool interaction = false;
+  std::size_t window = 0U;
+  bool database = false;
+  encodings::CardinalityEncoding gateLimitEncoding =
+      encodings::CardinalityEncoding::PseudoBoolean;
+};
+
+Options parseOptions(const std::vector<std::string>& args) {
+  Options opts;
+  for (std::size_t i = 0U; i < args.size(); ++i) {
+    const auto& arg = args[i];
+    const auto value = [&]() -> const std::string& {
+      if (i + 1U >= args.size()) {
+        throw std::invalid_argument("Missing value for " + arg);
+      }
+      return args[++i];
+    };
+    if (arg == "--metric") {
+      const auto& metric = value();
+      if (metric != "gates" && metric != "depth" &&
+          metric != "two_qubit_gates") {
+        throw std::invalid_argument("Unknown metric " + metric);
+      }
+      opts.metric = cs::targetMetricFromString(metric);
+    } else if (arg == "--line") {
+      opts.line = true;
+    } else if (arg == "--interaction") {
+      opts.interaction = true;
+    } else if (arg == "--window") {
+      opts.window = std::stoul(value());
+    } else if (arg == "--database") {
+      opts.database = true;
+    } else if (arg == "--gate-limit-encoding") {
+      opts.gateLimitEncoding =
+          encodings::cardinalityEncodingFromString(value());
+    } else if (!arg.empty() && arg[0] == '-') {
+      throw std::invalid_argument("Unknown option " + arg);
+    } else {
+      opts.tests = arg;
+    }
+  }
+  if (opts.tests.empty()) {
+    throw std::invalid_argument("Missing test file");
+  }
+  return opts;
+}
+
+cs::CliffordSynthesizer createSynthesizer(const nlohmann::json& test) {
+  if (test.contains("initial_circuit")) {
+    auto qc =
+        qasm3::Importer::imports(test["initial_circuit"].get<std::string>());
+    if (test.contains("initial_tableau")) {
+      return {cs::Tableau(test["initial_tableau"].get<std::string>()), qc};
+    }
+    return cs::CliffordSynthesizer(qc);
+  }
+  const auto target = cs::Tableau(test["target_tableau"].get<std::string>());
+  if (test.contains("initial_tableau")) {
+    return {cs::Tableau(test["initial_tableau"].get<std::string>()), target};
+  }
+  return cs::CliffordSynthesizer(target);
+}
+
+std::size_t qubitCount(const nlohmann::json& test) {
+  if (test.contains("initial_circuit")) {
+    return qasm3::Importer::imports(
+               test["initial_circuit"].get<std::string>())
+        .getNqubits();
+  }
+  return cs::Tableau(test["target_tableau"].get<std::string>())
+      .getQubitCount();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  try {
+    const auto opts =
+        parseOptions(std::vector<std::string>(argv + 1, argv + argc));
+    std::ifstream ifs(opts.tests);
+    if (!ifs.good()) {
+      throw std::invalid_argument("Could not open " + opts.tests);
+    }
+    const auto tests = nlohmann::json::parse(ifs);
+    for (const auto& test : tests) {
+      auto config = cs::Configuration();
+      config.target = opts.metric;
+      config.useDatabase = opts.database;
+      config.pruneByInteraction = opts.interaction;
+      config.twoQubitGateWindow = opts.window;
+      config.gateLimitEncoding = opts.gateLimitEncoding;
+      if (opts.line) {
+        const auto n = qubitCount(test);
+        for (std::size_t q = 1U; q < n; ++q) {
+          config.couplingMap.emplace(q - 1U, q);
+        }
+      }
+
+      auto synthesizer = createSynthesizer(test);
+      synthesizer.synthesize(config);
+      const auto& results = synthesizer.getResults();
+      nlohmann::json j;
+      j["description"] = test["description"];
+      j["gate_limit_encoding"] =
+          encodings::toString(opts.gateLimitEncoding);
+      j["result"] = logicbase::toString(results.getSolverResult());
+      j["gates"] = results.getGates();
+      j["two_qubit_gates"] = results.getTwoQubitGates();
+      j["depth"] = results.getDepth();
+      j["solver_calls"] = results.getSolverCalls();
+      j["runtime"] = results.getRuntime();
+      j["solver_statistics"] = results.getSolverStatistics();
+      std::cout << j.dump() << '\n';
+    }
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << '\n' << USAGE;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,122 @@
+//
+// This file is part of the MQT QMAP library released under the MIT license.
+// See README.md or go to https://github.com/cda-tum/qmap for more information.
+//
+
+// Runs the exact mapper on OpenQASM circuits and prints one JSON line of
+// results per circuit. This is used to compare the solve times of the
+// encodings of the exact mapper's at-most-one and exactly-one constraints.
+
+#include "qasm3/Importer.hpp"
+#include "sc/Architecture.hpp"
+#include "sc/configuration/AvailableArchitecture.hpp"
+#include "sc/configuration/Configuration.hpp"
+#include "sc/configuration/Encoding.hpp"
+#include "sc/configuration/Method.hpp"
+#include "sc/exact/ExactMapper.hpp"
+
+#include <cstddef>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr auto USAGE =
+    "Usage: mqt-qmap-exact-bench [options] --arch a circuit.qasm...\n"
+    "  --arch a        architecture file or name, e.g., IBM_QX4\n"
+    "  --encoding e    naive|commander|bimander|sequential_counter|\n"
+    "                  totalizer|modulo_totalizer (default: commander)\n"
+    "  --timeout ms    time limit per circuit (default: 3600000)\n"
+    "  --no-subsets    map to all physical qubits instead of trying each\n"
+    "                  subset of the required size\n";
+
+struct Options {
+  std::vector<std::string> circuits;
+  std::string architecture;
+  Encoding encoding = Encoding::Commander;
+  std::size_t timeout = 3600000U;
+  bool subsets = true;
+};
+
+Options parseOptions(const std::vector<std::string>& args) {
+  Options opts;
+  for (std::size_t i = 0U; i < args.size(); ++i) {
+    const auto& arg = args[i];
+    const auto value = [&]() -> const std::string& {
+      if (i + 1U >= args.size()) {
+        throw std::invalid_argument("Missing value for " + arg);
+      }
+      return args[++i];
+    };
+    if (arg == "--arch") {
+      opts.architecture = value();
+    } else if (arg == "--encoding") {
+      opts.encoding = encodingFromString(value());
+    } else if (arg == "--timeout") {
+      opts.timeout = std::stoul(value());
+    } else if (arg == "--no-subsets") {
+      opts.subsets = false;
+    } else if (!arg.empty() && arg[0] == '-') {
+      throw std::invalid_argument("Unknown option " + arg);
+    } else {
+      opts.circuits.emplace_back(arg);
+    }
+  }
+  if (opts.architecture.empty()) {
+    throw std::invalid_argument("Missing architecture");
+  }
+  if (opts.circuits.empty()) {
+    throw std::invalid_argument("Missing circuit file");
+  }
+  return opts;
+}
+
+Architecture loadArchitecture(const std::string& architecture) {
+  Architecture arch{};
+  if (std::ifstream(architecture).good()) {
+    arch.loadCouplingMap(architecture);
+  } else {
+    arch.loadCouplingMap(architectureFromString(architecture));
+  }
+  return arch;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  try {
+    const auto opts =
+        parseOptions(std::vector<std::string>(argv + 1, argv + argc));
+    auto arch = loadArchitecture(opts.architecture);
+    for (const auto& circuit : opts.circuits) {
+      auto config = Configuration();
+      config.method = Method::Exact;
+      config.encoding = opts.encoding;
+      config.timeout = opts.timeout;
+      config.useSubsets = opts.subsets;
+
+      auto qc = qasm3::Importer::importf(circuit);
+      auto mapper = ExactMapper(qc, arch);
+      mapper.map(config);
+      const auto& results = mapper.getResults();
+      nlohmann::json j;
+      j["circuit"] = circuit;
+      j["encoding"] = toString(opts.encoding);
+      j["timeout"] = results.timeout;
+      j["swaps"] = results.output.swaps;
+      j["direction_reverse"] = results.output.directionReverse;
+      j["mapping_time"] = results.time;
+      j["solver_statistics"] = results.solverStatistics;
+      std::cout << j.dump() << '\n';
+    }
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << '\n' << USAGE;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,225 @@
+//
+// This file is part of the MQT QMAP library released under the MIT license.
+// See README.md or go to https://github.com/cda-tum/qmap for more information.
+//
+
+// Replays solver instances written by the exact mapper
+// (Configuration::instanceDumpPath) or the Clifford synthesizer
+// (cs::Configuration::dumpInstances) with a chosen backend and parameter set
+// and prints one JSON object per line and run.
+
+#include "Instances.hpp"
+#include "Logic.hpp"
+#include "LogicBlock.hpp"
+#include "PortfolioLogic.hpp"
+#include "SATSolver.hpp"
+#include "util_logicblock.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr auto USAGE =
+    "Usage: mqt-qmap-replay [options] <instance or directory>...\n"
+    "  --backend z3|cnf    backend to replay the instances with (default: z3)\n"
+    "  --param name=value  solver parameter (only random_seed for cnf)\n"
+    "  --threads n         number of solvers to run as a portfolio\n"
+    "  --preprocess        simplify the instances before solving (cnf)\n"
+    "  --repeat n          number of runs per instance (default: 1)\n";
+
+struct Options {
+  std::string backend = "z3";
+  logicutil::Params params;
+  nlohmann::basic_json<> paramsJson = nlohmann::basic_json<>::object();
+  std::uint32_t seed = 0U;
+  std::size_t threads = 1U;
+  bool preprocess = false;
+  std::size_t repeat = 1U;
+  std::vector<std::filesystem::path> instances;
+};
+
+// values are typed like on Z3's command line
+logicutil::Param parseParam(const std::string& arg) {
+  const auto pos = arg.find('=');
+  if (pos == std::string::npos || pos == 0U || pos + 1U == arg.size()) {
+    throw std::invalid_argument("Expected name=value but got " + arg);
+  }
+  const auto name = arg.substr(0U, pos);
+  const auto value = arg.substr(pos + 1U);
+  if (value == "true" || value == "false") {
+    return {name, value == "true"};
+  }
+  if (value.find_first_not_of("0123456789") == std::string::npos) {
+    return {name, static_cast<std::uint32_t>(std::stoul(value))};
+  }
+  if (value.find_first_not_of("0123456789.eE+-") == std::string::npos) {
+    return {name, std::stod(value)};
+  }
+  return {name, value};
+}
+
+void addInstances(const std::filesystem::path& path,
+                  std::vector<std::filesystem::path>& instances) {
+  if (!std::filesystem::is_directory(path)) {
+    instances.emplace_back(path);
+    return;
+  }
+  std::vector<std::filesystem::path> entries;
+  for (const auto& entry : std::filesystem::directory_iterator(path)) {
+    const auto ext = entry.path().extension().string();
+    if (entry.is_regular_file() &&
+        (ext == ".smt2" || ext == ".cnf" || ext == ".wcnf")) {
+      entries.emplace_back(entry.path());
+    }
+  }
+  std::sort(entries.begin(), entries.end());
+  instances.insert(instances.end(), entries.begin(), entries.end());
+}
+
+Options parseOptions(const std::vector<std::string>& args) {
+  Options opts;
+  for (std::size_t i = 0U; i < args.size(); ++i) {
+    const auto& arg = args[i];
+    const auto value = [&]() -> const std::string& {
+      if (i + 1U >= args.size()) {
+        throw std::invalid_argument("Missing value for " + arg);
+      }
+      return args[++i];
+    };
+    if (arg == "--backend") {
+      opts.backend = value();
+      if (opts.backend != "z3" && opts.backend != "cnf") {
+        throw std::invalid_argument("Unknown backend " + opts.backend);
+      }
+    } else if (arg == "--param") {
+      const auto& raw = value();
+      const auto param = parseParam(raw);
+      if (param.name == "random_seed" &&
+          param.type == logicutil::ParamType::UINT) {
+        opts.seed = param.uivalue;
+      }
+      opts.params.addParam(param);
+      opts.paramsJson[param.name] = raw.substr(param.name.size() + 1U);
+    } else if (arg == "--threads") {
+      opts.threads = std::max<std::size_t>(std::stoul(value()), 1U);
+    } else if (arg == "--preprocess") {
+      opts.preprocess = true;
+    } else if (arg == "--repeat") {
+      opts.repeat = std::max<std::size_t>(std::stoul(value()), 1U);
+    } else if (arg.rfind("--", 0U) == 0U) {
+      throw std::invalid_argument("Unknown option " + arg);
+    } else {
+      addInstances(arg, opts.instances);
+    }
+  }
+  return opts;
+}
+
+// the exact mapper (and MaxSAT-based synthesis) dump optimization instances
+bool isOptimization(const std::filesystem::path& instance) {
+  if (instance.extension() == ".wcnf") {
+    return true;
+  }
+  std::ifstream is(instance);
+  const std::string content((std::istreambuf_iterator<char>(is)),
+                            std::istreambuf_iterator<char>());
+  return content.find("(assert-soft") != std::string::npos ||
+         content.find("(minimize") != std::string::npos ||
+         content.find("(maximize") != std::string::npos;
+}
+
+std::unique_ptr<logicbase::LogicBlock>
+createLogicBlock(const Options& opts, const std::filesystem::path& instance) {
+  bool success = false;
+  if (opts.backend == "z3") {
+    auto params = opts.params;
+    if (opts.threads > 1U) {
+      params.addParam(logicutil::PORTFOLIO_THREADS,
+                      static_cast<std::uint32_t>(opts.threads));
+    }
+    if (isOptimization(instance)) {
+      return logicutil::getZ3LogicOptimizer(success, true, params);
+    }
+    return logicutil::getZ3LogicBlock(success, true, params);
+  }
+  if (opts.threads == 1U) {
+    return logicutil::getCNFLogicBlock(
+        success, true, std::make_unique<cnflogic::CDCLSolver>(opts.seed),
+        opts.preprocess);
+  }
+  std::vector<std::unique_ptr<logicbase::LogicBlock>> instances;
+  for (std::size_t i = 0U; i < opts.threads; ++i) {
+    instances.emplace_back(logicutil::getCNFLogicBlock(
+        success, true,
+        std::make_unique<cnflogic::CDCLSolver>(
+            opts.seed + static_cast<std::uint32_t>(i)),
+        opts.preprocess));
+  }
+  return std::make_unique<portfoliologic::PortfolioLogicBlock>(
+      std::move(instances));
+}
+
+nlohmann::basic_json<> readMetadata(std::filesystem::path instance) {
+  std::ifstream is(instance.replace_extension(".json"));
+  if (!is.good()) {
+    return nlohmann::basic_json<>::object();
+  }
+  auto meta = nlohmann::basic_json<>::parse(is, nullptr, false);
+  return meta.is_discarded() ? nlohmann::basic_json<>::object() : meta;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  Options opts;
+  try {
+    opts = parseOptions(std::vector<std::string>(argv + 1, argv + argc));
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << '\n' << USAGE;
+    return 1;
+  }
+  if (opts.instances.empty()) {
+    std::cerr << USAGE;
+    return 1;
+  }
+
+  int status = 0;
+  for (const auto& instance : opts.instances) {
+    nlohmann::basic_json<> j{};
+    j["instance"] = instance.string();
+    j["metadata"] = readMetadata(instance);
+    j["backend"] = opts.backend;
+    j["params"] = opts.paramsJson;
+    j["threads"] = opts.threads;
+    j["preprocess"] = opts.preprocess;
+    for (std::size_t run = 0U; run < opts.repeat; ++run) {
+      auto out = j;
+      out["run"] = run;
+      try {
+        const auto lb = createLogicBlock(opts, instance);
+        const auto res = logicutil::replayInstance(*lb, instance.string());
+        out["result"] = logicbase::toString(res.result);
+        out["time"] = res.time;
+        out["statistics"] = res.statistics;
+      } catch (const std::exception& e) {
+        out["error"] = e.what();
+        status = 1;
+      }
+      std::cout << out.dump() << '\n';
+    }
+  }
+  return status;
+}
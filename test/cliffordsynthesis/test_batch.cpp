@@ -0,0 +1,82 @@
+//
+// This file is part of the MQT QMAP library released under the MIT license.
+// See README.md or go to https://github.com/cda-tum/qmap for more information.
+//
+
+#include "cliffordsynthesis/BatchSynthesis.hpp"
+#include "cliffordsynthesis/CliffordSynthesizer.hpp"
+#include "cliffordsynthesis/Configuration.hpp"
+#include "cliffordsynthesis/Tableau.hpp"
+#include "cliffordsynthesis/TargetMetric.hpp"
+#include "ir/QuantumComputation.hpp"
+#include "ir/operations/Control.hpp"
+#include "qasm3/Importer.hpp"
+
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+namespace cs {
+
+namespace {
+// h(a); cx(a, b); s(c)
+Tableau entangle(const qc::Qubit a, const qc::Qubit b, const qc::Qubit c) {
+  auto qc = qc::QuantumComputation(3);
+  qc.h(a);
+  qc.cx(qc::Control{a}, b);
+  qc.s(c);
+  return Tableau(qc);
+}
+} // namespace
+
+TEST(BatchSynthesisTest, MatchesIndividualSyntheses) {
+  const std::vector<Tableau> targets = {entangle(0, 1, 2), entangle(2, 0, 1),
+                                        entangle(0, 1, 2), entangle(1, 2, 2),
+                                        Tableau("[+ZZ, +XX]")};
+  auto config = Configuration();
+  config.target = TargetMetric::Gates;
+  config.useDatabase = false;
+  const auto results = synthesizeBatch(targets, config, 2U);
+  ASSERT_EQ(results.size(), targets.size());
+
+  for (std::size_t i = 0U; i < targets.size(); ++i) {
+    auto single = CliffordSynthesizer(targets[i]);
+    single.synthesize(config);
+    EXPECT_EQ(results[i].getGates(), single.getResults().getGates());
+    const auto circuit =
+        qasm3::Importer::imports(results[i].getResultCircuit());
+    EXPECT_EQ(Tableau(circuit), targets[i]);
+  }
+  // the relabelled and the repeated target reuse the first result
+  EXPECT_GT(results[0].getSolverCalls(), 0U);
+  EXPECT_EQ(results[1].getSolverCalls(), 0U);
+  EXPECT_EQ(results[2].getSolverCalls(), 0U);
+  EXPECT_GT(results[3].getSolverCalls(), 0U);
+}
+
+TEST(BatchSynthesisTest, RestrictedPairsOnlyShareIdenticalTargets) {
+  const std::vector<Tableau> targets = {entangle(0, 1, 2), entangle(2, 0, 1),
+                                        entangle(0, 1, 2)};
+  auto config = Configuration();
+  config.target = TargetMetric::Gates;
+  config.couplingMap = {{0, 1}, {1, 2}};
+  const auto results = synthesizeBatch(targets, config);
+  EXPECT_GT(results[1].getSolverCalls(), 0U);
+  EXPECT_EQ(results[2].getSolverCalls(), 0U);
+  for (std::size_t i = 0U; i < targets.size(); ++i) {
+    const auto circuit =
+        qasm3::Importer::imports(results[i].getResultCircuit());
+    EXPECT_EQ(Tableau(circuit), targets[i]);
+  }
+}
+
+TEST(BatchSynthesisTest, EmptyAndHeuristic) {
+  EXPECT_TRUE(synthesizeBatch({}).empty());
+  auto config = Configuration();
+  config.heuristic = true;
+  EXPECT_THROW(static_cast<void>(synthesizeBatch({Tableau(2)}, config)),
+               std::invalid_argument);
+}
+
+} // namespace cs
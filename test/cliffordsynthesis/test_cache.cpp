@@ -0,0 +1,136 @@
+//
+// This file is part of the MQT QMAP library released under the MIT license.
+// See README.md or go to https://github.com/cda-tum/qmap for more information.
+//
+
+#include "cliffordsynthesis/CliffordSynthesizer.hpp"
+#include "cliffordsynthesis/Configuration.hpp"
+#include "cliffordsynthesis/SynthesisCache.hpp"
+#include "cliffordsynthesis/Tableau.hpp"
+#include "cliffordsynthesis/TargetMetric.hpp"
+#include "ir/QuantumComputation.hpp"
+#include "ir/operations/Control.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <limits>
+#include <memory>
+#include <string>
+
+using namespace qc::literals;
+
+namespace cs {
+
+namespace {
+// h(a); cx(a, b); s(c)
+qc::QuantumComputation
+entangle(const qc::Qubit a, const qc::Qubit b, const qc::Qubit c) {
+  auto qc = qc::QuantumComputation(3);
+  qc.h(a);
+  qc.cx(qc::Control{a}, b);
+  qc.s(c);
+  return qc;
+}
+
+CacheEntry entry(const std::size_t depth) {
+  CacheEntry e;
+  e.circuit = "OPENQASM 3.0;";
+  e.depth = depth;
+  return e;
+}
+} // namespace
+
+TEST(SynthesisCacheTest, CanonicalUpToRelabelling) {
+  const auto qc = entangle(0, 1, 2);
+  const auto relabelled = entangle(2, 0, 1);
+  const auto other = entangle(0, 2, 2);
+  for (const bool destabilizers : {false, true}) {
+    const CanonicalTableau canonical(
+        Tableau(qc, 0, std::numeric_limits<std::size_t>::max(), destabilizers));
+    const CanonicalTableau canonicalRelabelled(
+        Tableau(relabelled, 0, std::numeric_limits<std::size_t>::max(),
+                destabilizers));
+    const CanonicalTableau canonicalOther(Tableau(
+        other, 0, std::numeric_limits<std::size_t>::max(), destabilizers));
+    EXPECT_EQ(canonical.tableau, canonicalRelabelled.tableau);
+    EXPECT_NE(canonical.tableau, canonicalOther.tableau);
+  }
+}
+
+TEST(SynthesisCacheTest, KeyIncludesTimestepLimitForTwoQubitGates) {
+  const CanonicalTableau canonical(Tableau(entangle(0, 1, 2)));
+  auto config = Configuration();
+  auto limited = Configuration();
+  limited.initialTimestepLimit = 5U;
+  for (const auto target : {TargetMetric::Gates, TargetMetric::Depth}) {
+    config.target = target;
+    limited.target = target;
+    EXPECT_EQ(SynthesisCache::key(canonical, config, false),
+              SynthesisCache::key(canonical, limited, false));
+  }
+  config.target = TargetMetric::TwoQubitGates;
+  limited.target = TargetMetric::TwoQubitGates;
+  EXPECT_NE(SynthesisCache::key(canonical, config, false),
+            SynthesisCache::key(canonical, limited, false));
+}
+
+TEST(SynthesisCacheTest, LRUEviction) {
+  LRUSynthesisCache cache(2U);
+  cache.store("a", entry(1U));
+  cache.store("b", entry(2U));
+  // "a" becomes the most recently used entry, so "b" is evicted
+  ASSERT_TRUE(cache.lookup("a").has_value());
+  cache.store("c", entry(3U));
+  EXPECT_EQ(cache.size(), 2U);
+  EXPECT_FALSE(cache.lookup("b").has_value());
+  EXPECT_EQ(cache.lookup("c")->depth, 3U);
+  EXPECT_EQ(cache.getHits(), 2U);
+  EXPECT_EQ(cache.getMisses(), 1U);
+}
+
+TEST(SynthesisCacheTest, DiskPersistence) {
+  const auto directory =
+      (std::filesystem::temp_directory_path() / "qmap_test_cache").string();
+  std::filesystem::remove_all(directory);
+  {
+    DiskSynthesisCache cache(directory);
+    cache.store("key", entry(4U));
+  }
+  DiskSynthesisCache cache(directory);
+  const auto hit = cache.lookup("key");
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_EQ(hit->depth, 4U);
+  EXPECT_EQ(hit->circuit, "OPENQASM 3.0;");
+  EXPECT_FALSE(cache.lookup("other key").has_value());
+  std::filesystem::remove_all(directory);
+}
+
+TEST(SynthesisCacheTest, SynthesisReusesRelabelledResult) {
+  auto cache = std::make_shared<LRUSynthesisCache>();
+  auto config = Configuration();
+  config.target = TargetMetric::Gates;
+  config.cache = cache;
+
+  auto qc = entangle(0, 1, 2);
+  auto first = CliffordSynthesizer(qc);
+  first.synthesize(config);
+  EXPECT_EQ(cache->getMisses(), 1U);
+  EXPECT_EQ(cache->size(), 1U);
+
+  auto relabelled = entangle(2, 0, 1);
+  auto second = CliffordSynthesizer(relabelled);
+  second.synthesize(config);
+  EXPECT_EQ(cache->getHits(), 1U);
+  EXPECT_EQ(second.getResults().getSolverCalls(), 0U);
+  EXPECT_EQ(second.getResults().getGates(), first.getResults().getGates());
+  EXPECT_EQ(Tableau(second.getResultCircuit()), Tableau(relabelled));
+
+  // the cached result is specific to the target metric
+  config.target = TargetMetric::Depth;
+  auto third = CliffordSynthesizer(relabelled);
+  third.synthesize(config);
+  EXPECT_EQ(cache->getMisses(), 2U);
+}
+
+} // namespace cs
@@ -0,0 +1,105 @@
+//
+// This file is part of the MQT QMAP library released under the MIT license.
+// See README.md or go to https://github.com/cda-tum/qmap for more information.
+//
+
+#include "cliffordsynthesis/CliffordDatabase.hpp"
+#include "cliffordsynthesis/CliffordSynthesizer.hpp"
+#include "cliffordsynthesis/Configuration.hpp"
+#include "cliffordsynthesis/Tableau.hpp"
+#include "cliffordsynthesis/TargetMetric.hpp"
+#include "ir/QuantumComputation.hpp"
+#include "ir/operations/Control.hpp"
+
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <limits>
+#include <string>
+
+using namespace qc::literals;
+
+namespace cs {
+
+TEST(CliffordDatabaseTest, CoversGroup) {
+  // every tableau that is reachable from the identity (including signs)
+  EXPECT_EQ(CliffordDatabase::get(1U, false, TargetMetric::Gates)->size(), 6U);
+  EXPECT_EQ(CliffordDatabase::get(1U, true, TargetMetric::Gates)->size(), 24U);
+  EXPECT_EQ(CliffordDatabase::get(2U, false, TargetMetric::Gates)->size(),
+            360U);
+  EXPECT_EQ(CliffordDatabase::get(2U, true, TargetMetric::Gates)->size(),
+            11520U);
+  // larger tables are only loaded from a directory
+  EXPECT_EQ(CliffordDatabase::get(3U, false, TargetMetric::Gates), nullptr);
+}
+
+TEST(CliffordDatabaseTest, LookupReproducesTarget) {
+  auto qc = qc::QuantumComputation(2U);
+  qc.h(0);
+  qc.cx(0_pc, 1);
+  qc.s(1);
+  qc.cx(1_pc, 0);
+  for (const auto metric : {TargetMetric::Gates, TargetMetric::Depth,
+                            TargetMetric::TwoQubitGates}) {
+    const auto* const db = CliffordDatabase::get(2U, true, metric);
+    ASSERT_NE(db, nullptr);
+    const Tableau target(qc, 0, std::numeric_limits<std::size_t>::max(), true);
+    const auto circuit = db->lookup(target);
+    ASSERT_TRUE(circuit.has_value());
+    EXPECT_EQ(Tableau(*circuit, 0, std::numeric_limits<std::size_t>::max(),
+                      true),
+              target);
+    EXPECT_LE(circuit->size(), qc.size());
+  }
+}
+
+TEST(CliffordDatabaseTest, SaveAndLoad) {
+  const auto db = CliffordDatabase::generate(2U, false, TargetMetric::Depth);
+  const auto file =
+      (std::filesystem::temp_directory_path() /
+       CliffordDatabase::filename(2U, false, TargetMetric::Depth))
+          .string();
+  db.save(file);
+  // the entry count follows the magic and the header in little-endian order
+  std::ifstream is(file, std::ios::binary);
+  std::array<unsigned char, 20> bytes{};
+  is.read(reinterpret_cast<char*>(bytes.data()), bytes.size());
+  std::size_t count = 0U;
+  for (std::size_t i = 0U; i < 8U; ++i) {
+    count |= static_cast<std::size_t>(bytes[12U + i]) << (8U * i);
+  }
+  EXPECT_EQ(count, db.size());
+  is.close();
+  const auto loaded = CliffordDatabase::load(file);
+  std::filesystem::remove(file);
+  EXPECT_EQ(loaded.size(), db.size());
+  EXPECT_EQ(loaded.getQubitCount(), 2U);
+  EXPECT_FALSE(loaded.hasDestabilizers());
+  EXPECT_EQ(loaded.getMetric(), TargetMetric::Depth);
+
+  auto qc = qc::QuantumComputation(2U);
+  qc.h(1);
+  qc.cx(1_pc, 0);
+  const Tableau target(qc);
+  EXPECT_EQ(Tableau(*loaded.lookup(target)), target);
+}
+
+TEST(CliffordDatabaseTest, SynthesisUsesDatabase) {
+  auto qc = qc::QuantumComputation(2U);
+  qc.h(0);
+  qc.h(0);
+  qc.x(1);
+  qc.cx(0_pc, 1);
+  auto synthesizer = CliffordSynthesizer(qc);
+  auto config = Configuration();
+  config.target = TargetMetric::Gates;
+  synthesizer.synthesize(config);
+  const auto& results = synthesizer.getResults();
+  EXPECT_EQ(results.getSolverCalls(), 0U);
+  EXPECT_EQ(results.getGates(), 2U);
+  EXPECT_EQ(Tableau(synthesizer.getResultCircuit()), Tableau(qc));
+}
+
+} // namespace cs
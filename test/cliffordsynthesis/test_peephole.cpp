@@ -0,0 +1,78 @@
+//
+// This file is part of the MQT QMAP library released under the MIT license.
+// See README.md or go to https://github.com/cda-tum/qmap for more information.
+//
+
+#include "cliffordsynthesis/Peephole.hpp"
+#include "cliffordsynthesis/Tableau.hpp"
+#include "ir/QuantumComputation.hpp"
+#include "ir/operations/Control.hpp"
+#include "ir/operations/OpType.hpp"
+
+#include <cstddef>
+#include <gtest/gtest.h>
+
+using namespace qc::literals;
+
+namespace cs {
+
+TEST(PeepholeTest, RemovesGatesStabilizingTheState) {
+  auto qc = qc::QuantumComputation(2U);
+  qc.z(0);
+  qc.cz(0_pc, 1);
+  qc.h(0);
+  qc.x(0);
+  qc.cx(0_pc, 1);
+  const auto expected = Tableau(qc);
+  qc.i(1);
+
+  // z and cz act trivially on |00> and x on |+>
+  EXPECT_EQ(removeRedundantGates(qc), 4U);
+  ASSERT_EQ(qc.size(), 2U);
+  EXPECT_EQ(qc.at(0)->getType(), qc::OpType::H);
+  EXPECT_EQ(Tableau(qc), expected);
+}
+
+TEST(PeepholeTest, KeepsGatesChangingTheOperation) {
+  auto qc = qc::QuantumComputation(2U);
+  qc.z(0);
+  qc.cz(0_pc, 1);
+  // with destabilizers, only identities can leave the tableau unchanged
+  EXPECT_EQ(removeRedundantGates(qc, Tableau(2U, true)), 0U);
+  EXPECT_EQ(qc.size(), 2U);
+}
+
+TEST(PeepholeTest, StopsAtUnsupportedOperations) {
+  auto qc = qc::QuantumComputation(2U);
+  qc.z(0);
+  qc.barrier();
+  qc.t(1);
+  qc.z(1);
+  EXPECT_EQ(removeRedundantGates(qc), 1U);
+  ASSERT_EQ(qc.size(), 3U);
+  EXPECT_EQ(qc.at(0)->getType(), qc::OpType::Barrier);
+  EXPECT_EQ(qc.at(2)->getType(), qc::OpType::Z);
+}
+
+TEST(PeepholeTest, DetectsChangesBeyondTheFirstWord) {
+  constexpr std::size_t nQubits = 100U;
+  auto tableau = Tableau(nQubits, true);
+  auto entangle = qc::QuantumComputation(nQubits);
+  entangle.h(nQubits - 1U);
+  entangle.cx(qc::Control{nQubits - 1U}, 0);
+  for (const auto& op : entangle) {
+    EXPECT_TRUE(tableau.applyGateAndDetectChange(op.get()));
+  }
+
+  auto qc = qc::QuantumComputation(nQubits);
+  qc.h(nQubits - 1U);
+  qc.x(nQubits - 1U);
+  qc.z(0);
+  qc.z(nQubits - 1U);
+  // x stabilizes |+> and z stabilizes |0>, but z flips the sign of |+>
+  EXPECT_EQ(removeRedundantGates(qc), 2U);
+  ASSERT_EQ(qc.size(), 2U);
+  EXPECT_EQ(qc.at(1)->getType(), qc::OpType::Z);
+}
+
+} // namespace cs
@@ -4,8 +4,11 @@
 //
 
 #include "cliffordsynthesis/CliffordSynthesizer.hpp"
+#include "cliffordsynthesis/Configuration.hpp"
 #include "cliffordsynthesis/Results.hpp"
+#include "cliffordsynthesis/Tableau.hpp"
 #include "cliffordsynthesis/TargetMetric.hpp"
+#include "cliffordsynthesis/encoding/QubitPairPruning.hpp"
 #include "ir/QuantumComputation.hpp"
 #include "ir/operations/Control.hpp"
 #include "qasm3/Importer.hpp"
@@ -16,6 +19,7 @@
 #include <iostream>
 #include <limits>
 #include <plog/Severity.h>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -109,6 +113,8 @@ protected:
     config.verbosity = plog::Severity::verbose;
     config.dumpIntermediateResults = true;
     config.useSymmetryBreaking = true;
+    // the small targets would otherwise never reach the SAT encoding
+    config.useDatabase = false;
   }
 
   void TearDown() override {
@@ -162,6 +168,17 @@ TEST_P(SynthesisTest, Gates) {
   synthesizer.synthesize(config);
   results = synthesizer.getResults();
 
+  EXPECT_EQ(results.getGates(), test.expectedMinimalGates);
+  EXPECT_GE(results.getSolverStatistics().solverCalls,
+            results.getSolverCalls());
+}
+
+TEST_P(SynthesisTest, GatesInteractionPruning) {
+  config.target = TargetMetric::Gates;
+  config.pruneByInteraction = true;
+  synthesizer.synthesize(config);
+  results = synthesizer.getResults();
+
   EXPECT_EQ(results.getGates(), test.expectedMinimalGates);
 }
 
@@ -250,6 +267,48 @@ TEST_P(SynthesisTest, DepthMinimalGatesLinearSearch) {
   EXPECT_EQ(results.getGates(), test.expectedMinimalGatesAtMinimalDepth);
 }
 
+TEST_P(SynthesisTest, DepthMinimalGatesNonIncremental) {
+  config.target = TargetMetric::Depth;
+  config.incrementalSearch = false;
+  config.minimizeGatesAfterDepthOptimization = true;
+  synthesizer.synthesize(config);
+  results = synthesizer.getResults();
+
+  EXPECT_EQ(results.getDepth(), test.expectedMinimalDepth);
+  EXPECT_EQ(results.getGates(), test.expectedMinimalGatesAtMinimalDepth);
+}
+
+TEST_P(SynthesisTest, DepthMinimalGatesTotalizer) {
+  config.target = TargetMetric::Depth;
+  config.gateLimitEncoding = encodings::CardinalityEncoding::Totalizer;
+  config.minimizeGatesAfterDepthOptimization = true;
+  synthesizer.synthesize(config);
+  results = synthesizer.getResults();
+
+  EXPECT_EQ(results.getDepth(), test.expectedMinimalDepth);
+  EXPECT_EQ(results.getGates(), test.expectedMinimalGatesAtMinimalDepth);
+}
+
+TEST_P(SynthesisTest, GatesCNF) {
+  config.target = TargetMetric::Gates;
+  config.solverParameters["backend"] = std::string("cnf");
+  synthesizer.synthesize(config);
+  results = synthesizer.getResults();
+
+  EXPECT_EQ(results.getGates(), test.expectedMinimalGates);
+}
+
+TEST_P(SynthesisTest, DepthMinimalGatesCNF) {
+  config.target = TargetMetric::Depth;
+  config.solverParameters["backend"] = std::string("cnf");
+  config.minimizeGatesAfterDepthOptimization = true;
+  synthesizer.synthesize(config);
+  results = synthesizer.getResults();
+
+  EXPECT_EQ(results.getDepth(), test.expectedMinimalDepth);
+  EXPECT_EQ(results.getGates(), test.expectedMinimalGatesAtMinimalDepth);
+}
+
 TEST_P(SynthesisTest, TwoQubitGates) {
   config.target = TargetMetric::TwoQubitGates;
   config.tryHigherGateLimitForTwoQubitGateOptimization = true;
@@ -259,6 +318,27 @@ TEST_P(SynthesisTest, TwoQubitGates) {
   EXPECT_EQ(results.getTwoQubitGates(), test.expectedMinimalTwoQubitGates);
 }
 
+TEST_P(SynthesisTest, TwoQubitGatesNonIncremental) {
+  config.target = TargetMetric::TwoQubitGates;
+  config.incrementalSearch = false;
+  config.tryHigherGateLimitForTwoQubitGateOptimization = true;
+  synthesizer.synthesize(config);
+  results = synthesizer.getResults();
+
+  EXPECT_EQ(results.getTwoQubitGates(), test.expectedMinimalTwoQubitGates);
+}
+
+TEST_P(SynthesisTest, TwoQubitGatesSequentialCounter) {
+  config.target = TargetMetric::TwoQubitGates;
+  config.incrementalSearch = false;
+  config.gateLimitEncoding = encodings::CardinalityEncoding::SequentialCounter;
+  config.tryHigherGateLimitForTwoQubitGateOptimization = true;
+  synthesizer.synthesize(config);
+  results = synthesizer.getResults();
+
+  EXPECT_EQ(results.getTwoQubitGates(), test.expectedMinimalTwoQubitGates);
+}
+
 TEST_P(SynthesisTest, TwoQubitGatesMaxSAT) {
   config.target = TargetMetric::TwoQubitGates;
   config.tryHigherGateLimitForTwoQubitGateOptimization = true;
@@ -361,6 +441,27 @@ TEST_P(SynthesisTest, TestDestabilizerTwoQubitGates) {
   }
 }
 
+TEST(BinarySearchTest, SkipsProbesAboveKnownSolution) {
+  // The initial circuit has a single gate, so the configured limit of 64
+  // timesteps only leaves the limit 0 to be probed. Without skipping the
+  // limits implied by known solutions, the search would probe 32, 16, 8, 4,
+  // 2, 1 and 0, i.e., call the solver seven times.
+  auto qc = qc::QuantumComputation(1);
+  qc.h(0);
+  for (const auto target : {TargetMetric::Gates, TargetMetric::Depth}) {
+    auto config = Configuration();
+    config.target = target;
+    config.initialTimestepLimit = 64U;
+    config.useDatabase = false;
+    auto synth = CliffordSynthesizer(qc);
+    synth.synthesize(config);
+    const auto& results = synth.getResults();
+    EXPECT_TRUE(results.sat());
+    EXPECT_EQ(results.getGates(), 1U);
+    EXPECT_EQ(results.getSolverCalls(), 1U);
+  }
+}
+
 TEST(HeuristicTest, basic) {
   auto config = Configuration();
   auto qc = qc::QuantumComputation(2);
@@ -421,4 +522,217 @@ TEST(HeuristicTest, fourLayers) {
   synth.synthesize(config);
   EXPECT_EQ(synth.getResults().getDepth(), 2);
 }
+
+TEST(HeuristicTest, deterministicAcrossThreads) {
+  auto qc = qc::QuantumComputation(3);
+  for (std::size_t i = 0U; i < 4U; ++i) {
+    qc.h(0);
+    qc.cx(0_pc, 1);
+    qc.s(2);
+    qc.cx(1_pc, 2);
+    qc.h(1);
+  }
+  auto config = Configuration();
+  config.heuristic = true;
+  config.splitSize = 2;
+  config.target = TargetMetric::Depth;
+  // the blocks would otherwise be answered by the database
+  config.useDatabase = false;
+
+  config.nThreadsHeuristic = 1U;
+  auto sequential = CliffordSynthesizer(qc);
+  sequential.synthesize(config);
+
+  config.nThreadsHeuristic = 4U;
+  auto parallel = CliffordSynthesizer(qc);
+  parallel.synthesize(config);
+
+  EXPECT_EQ(sequential.getResults().getResultCircuit(),
+            parallel.getResults().getResultCircuit());
+  EXPECT_EQ(sequential.getResults().getDepth(),
+            parallel.getResults().getDepth());
+}
+
+TEST(HeuristicTest, timeoutKeepsOriginalBlocks) {
+  auto qc = qc::QuantumComputation(2);
+  qc.h(0);
+  qc.cx(0_pc, 1);
+  qc.h(1);
+  qc.cx(1_pc, 0);
+  const auto originalDepth = qc.getDepth();
+  auto config = Configuration();
+  config.heuristic = true;
+  config.splitSize = 2;
+  config.target = TargetMetric::Depth;
+  config.heuristicTimeout = 1U;
+  config.useDatabase = false;
+  auto synth = CliffordSynthesizer(qc);
+  synth.synthesize(config);
+  EXPECT_LE(synth.getResults().getDepth(), originalDepth);
+  EXPECT_EQ(Tableau(synth.getResultCircuit()), Tableau(qc));
+}
+
+TEST(HeuristicTest, blocksOnFewQubitsUseDatabase) {
+  // the block only acts on qubits 1 and 3, so it is looked up in the
+  // two-qubit table even though the solver times out
+  auto qc = qc::QuantumComputation(4);
+  qc.h(1);
+  qc.s(3);
+  qc.cx(1_pc, 3);
+  qc.cx(1_pc, 3);
+  qc.s(3);
+  qc.h(1);
+  auto config = Configuration();
+  config.heuristic = true;
+  config.splitSize = 4;
+  config.target = TargetMetric::Depth;
+  config.heuristicTimeout = 1U;
+  auto synth = CliffordSynthesizer(qc);
+  synth.synthesize(config);
+  EXPECT_EQ(synth.getResults().getDepth(), 1U);
+  EXPECT_EQ(Tableau(synth.getResultCircuit()), Tableau(qc));
+}
+
+TEST(HeuristicTest, refinementAcrossWindows) {
+  // each aligned window of two layers is optimal on its own, but the shifted
+  // windows cancel the Hadamards and then the phase gates
+  auto qc = qc::QuantumComputation(1);
+  qc.s(0);
+  qc.h(0);
+  qc.h(0);
+  qc.sdg(0);
+  auto config = Configuration();
+  config.heuristic = true;
+  config.splitSize = 2;
+  config.target = TargetMetric::Depth;
+
+  auto singlePass = CliffordSynthesizer(qc);
+  singlePass.synthesize(config);
+  EXPECT_EQ(singlePass.getResults().getDepth(), 4);
+
+  config.heuristicPasses = 0U;
+  auto refined = CliffordSynthesizer(qc);
+  refined.synthesize(config);
+  EXPECT_EQ(refined.getResults().getDepth(), 0);
+}
+
+TEST(QubitPairPruningTest, InteractionComponents) {
+  // qubits 0 and 2 are entangled, qubit 1 and 3 are only acted on locally
+  auto qc = qc::QuantumComputation(4);
+  qc.h(0);
+  qc.cx(0_pc, 2);
+  qc.h(1);
+  qc.s(3);
+  const auto components =
+      encoding::interactionComponents(Tableau(4), Tableau(qc));
+  EXPECT_EQ(components[0], components[2]);
+  EXPECT_NE(components[0], components[1]);
+  EXPECT_NE(components[1], components[3]);
+}
+
+TEST(QubitPairPruningTest, Masks) {
+  const CouplingMap line = {{0, 1}, {1, 2}, {2, 3}};
+  const auto coupled = encoding::createQubitPairMasks(4, 1, line, {}, 0);
+  ASSERT_EQ(coupled.size(), 1U);
+  EXPECT_TRUE(coupled[0][1][0]);
+  EXPECT_TRUE(coupled[0][2][3]);
+  EXPECT_FALSE(coupled[0][0][2]);
+  EXPECT_FALSE(coupled[0][1][1]);
+
+  const auto components = std::vector<std::size_t>{0, 0, 2, 2};
+  const auto split = encoding::createQubitPairMasks(4, 1, line, components, 0);
+  EXPECT_TRUE(split[0][0][1]);
+  EXPECT_FALSE(split[0][1][2]);
+
+  // the window of two qubits moves over [0, 1], [1, 2], [2, 3], [0, 1], ...
+  const auto window = encoding::createQubitPairMasks(4, 4, {}, {}, 2);
+  EXPECT_TRUE(window[0][0][1]);
+  EXPECT_FALSE(window[0][1][2]);
+  EXPECT_TRUE(window[1][2][1]);
+  EXPECT_TRUE(window[2][2][3]);
+  EXPECT_FALSE(window[2][0][3]);
+  EXPECT_TRUE(window[3][1][0]);
+}
+
+TEST(QubitPairPruningTest, CouplingMap) {
+  auto qc = qc::QuantumComputation(3);
+  qc.h(0);
+  qc.cx(0_pc, 1);
+  qc.cx(0_pc, 2);
+  const CouplingMap line = {{0, 1}, {1, 2}};
+  auto config = Configuration();
+  config.target = TargetMetric::Gates;
+  config.couplingMap = line;
+  auto synth = CliffordSynthesizer(qc);
+  synth.synthesize(config);
+
+  const auto result = synth.getResultCircuit();
+  EXPECT_EQ(Tableau(result), Tableau(qc));
+  for (const auto& op : result) {
+    if (op->getNcontrols() == 0U) {
+      continue;
+    }
+    const std::size_t ctrl = op->getControls().begin()->qubit;
+    const std::size_t trgt = op->getTargets().front();
+    EXPECT_TRUE(line.count({ctrl, trgt}) + line.count({trgt, ctrl}) > 0U);
+  }
+}
+
+TEST(QubitPairPruningTest, Window) {
+  auto qc = qc::QuantumComputation(3);
+  qc.h(0);
+  qc.cx(0_pc, 2);
+  auto config = Configuration();
+  config.target = TargetMetric::Depth;
+  config.twoQubitGateWindow = 2U;
+  auto synth = CliffordSynthesizer(qc);
+  synth.synthesize(config);
+  EXPECT_TRUE(synth.getResults().sat());
+  EXPECT_EQ(Tableau(synth.getResultCircuit()), Tableau(qc));
+}
+
+TEST(QubitPairPruningTest, InvalidConfiguration) {
+  auto qc = qc::QuantumComputation(3);
+  qc.h(0);
+  qc.cx(0_pc, 2);
+  auto config = Configuration();
+
+  config.twoQubitGateWindow = 1U;
+  auto window = CliffordSynthesizer(qc);
+  EXPECT_THROW(window.synthesize(config), std::invalid_argument);
+
+  config.twoQubitGateWindow = 0U;
+  config.couplingMap = {{0, 3}};
+  auto outOfRange = CliffordSynthesizer(qc);
+  EXPECT_THROW(outOfRange.synthesize(config), std::invalid_argument);
+
+  config.couplingMap = {{0, 1}};
+  auto disconnected = CliffordSynthesizer(qc);
+  EXPECT_THROW(disconnected.synthesize(config), std::invalid_argument);
+}
+
+TEST(QubitPairPruningTest, WindowSeparatesInteractingQubits) {
+  // only qubits 0 and 3 interact, but a window of two never contains both
+  auto qc = qc::QuantumComputation(4);
+  qc.h(0);
+  qc.cx(0_pc, 3);
+  auto config = Configuration();
+  config.twoQubitGateWindow = 2U;
+
+  config.pruneByInteraction = true;
+  auto interaction = CliffordSynthesizer(qc);
+  EXPECT_THROW(interaction.synthesize(config), std::invalid_argument);
+
+  config.pruneByInteraction = false;
+  config.couplingMap = {{0, 3}};
+  auto coupled = CliffordSynthesizer(qc);
+  EXPECT_THROW(coupled.synthesize(config), std::invalid_argument);
+
+  const auto components =
+      encoding::interactionComponents(Tableau(4), Tableau(qc));
+  EXPECT_FALSE(encoding::connectsComponents(
+      encoding::createQubitPairMasks(4, 3, {}, components, 2), components));
+  EXPECT_TRUE(encoding::connectsComponents(
+      encoding::createQubitPairMasks(4, 3, {}, {}, 2), components));
+}
 } // namespace cs
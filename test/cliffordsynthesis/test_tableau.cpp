@@ -13,6 +13,7 @@
 #include <bitset>
 #include <cstddef>
 #include <gtest/gtest.h>
+#include <limits>
 #include <memory>
 #include <sstream>
 #include <stdexcept>
@@ -631,6 +632,96 @@ TEST_F(TestTableau, LargeBV) {
   }
 }
 
+TEST_F(TestTableau, MultiWordTableau) {
+  // 2 * 70 rows span several words per column
+  constexpr std::size_t N = 70U;
+  auto large = Tableau(N, true);
+  for (std::size_t i = 0U; i < N; ++i) {
+    large.applyH(i);
+    large.applyS(i);
+  }
+  for (std::size_t i = 0U; i + 1U < N; ++i) {
+    large.applyCX(i, i + 1U);
+    large.applyCZ(i + 1U, i);
+    large.applySwap(i, (i + 7U) % N);
+  }
+  EXPECT_FALSE(large.isIdentityTableau());
+  EXPECT_EQ(large, Tableau(large.toString()));
+
+  // undo all gates (Sdag * H inverts H * S)
+  for (std::size_t i = N - 1U; i-- > 0U;) {
+    large.applySwap(i, (i + 7U) % N);
+    large.applyCZ(i + 1U, i);
+    large.applyCX(i, i + 1U);
+  }
+  for (std::size_t i = 0U; i < N; ++i) {
+    large.applySdag(i);
+    large.applyH(i);
+  }
+  EXPECT_TRUE(large.isIdentityTableau());
+  EXPECT_EQ(large, Tableau(N, true));
+  EXPECT_EQ(large[N + 3U][N + 3U], 1U);
+  EXPECT_EQ(large.at(N + 3U).size(), (2U * N) + 1U);
+  EXPECT_THROW(static_cast<void>(large.at(2U * N)), std::out_of_range);
+}
+
+TEST_F(TestTableau, WideTableauMatchesEntrywiseUpdates) {
+  // 2 * 150 rows span five words per column, so the vectorized updates (if
+  // available) and the remaining words are both exercised
+  constexpr std::size_t N = 150U;
+  auto wide = Tableau(N, true);
+  for (std::size_t i = 0U; i < N; ++i) {
+    wide.applyH(i);
+    wide.applyCX(i, (i + 1U) % N);
+  }
+  auto expected = wide;
+  const auto r = 2U * N;
+  for (std::size_t i = 0U; i < N; ++i) {
+    const auto a = i;
+    const auto b = (i * 7U + 3U) % N == a ? (a + 1U) % N : (i * 7U + 3U) % N;
+    wide.applyS(a);
+    wide.applyY(b);
+    wide.applyCX(a, b);
+    wide.applySdag(b);
+    wide.applyCZ(b, a);
+    wide.applyH(b);
+    wide.applyX(a);
+    wide.applyZ(b);
+    for (std::size_t row = 0U; row < 2U * N; ++row) {
+      auto xa = expected.get(row, a);
+      auto za = expected.get(row, a + N);
+      auto xb = expected.get(row, b);
+      auto zb = expected.get(row, b + N);
+      auto phase = expected.get(row, r);
+      // S(a), Y(b)
+      phase ^= xa && za;
+      za ^= xa;
+      phase ^= xb ^ zb;
+      // CX(a, b)
+      phase ^= xa && zb && !(xb ^ za);
+      za ^= zb;
+      xb ^= xa;
+      // Sdag(b), CZ(b, a)
+      phase ^= xb && !zb;
+      zb ^= xb;
+      phase ^= xb && xa && (zb ^ za);
+      zb ^= xa;
+      za ^= xb;
+      // H(b), X(a), Z(b)
+      phase ^= xb && zb;
+      std::swap(xb, zb);
+      phase ^= za;
+      phase ^= xb;
+      expected.set(row, a, xa);
+      expected.set(row, a + N, za);
+      expected.set(row, b, xb);
+      expected.set(row, b + N, zb);
+      expected.set(row, r, phase);
+    }
+  }
+  EXPECT_EQ(wide, expected);
+}
+
 TEST_F(TestTableau, TableauIO) {
   const std::string filename = "tableau.txt";
   tableau.dump(filename);
@@ -645,6 +736,101 @@ TEST_F(TestTableau, TableauIO) {
   EXPECT_EQ(fullTableau, tableau2);
 }
 
+TEST_F(TestTableau, BinaryIO) {
+  auto large = Tableau(70U, true);
+  for (std::size_t i = 0U; i + 1U < 70U; ++i) {
+    large.applyH(i);
+    large.applyCX(i, i + 1U);
+  }
+  for (const auto& t : {tableau, fullTableau, large}) {
+    std::stringstream ss;
+    t.dumpBinary(ss);
+    auto t2 = Tableau{};
+    t2.importBinary(ss);
+    EXPECT_EQ(t, t2);
+  }
+
+  const std::string filename = "tableau.bin";
+  large.dumpBinary(filename);
+  auto tableau2 = Tableau{};
+  tableau2.importBinary(filename);
+  EXPECT_EQ(large, tableau2);
+
+  std::stringstream truncated;
+  large.dumpBinary(truncated);
+  std::stringstream ss(truncated.str().substr(0U, 40U));
+  EXPECT_THROW(tableau2.importBinary(ss), std::runtime_error);
+  std::stringstream text(large.toString());
+  EXPECT_THROW(tableau2.importBinary(text), std::runtime_error);
+}
+
+TEST_F(TestTableau, StreamOperations) {
+  using namespace qc::literals;
+
+  qc::QuantumComputation qc(3U);
+  qc.h(0);
+  qc.cx(0_pc, 2);
+  auto compOP = std::make_unique<qc::CompoundOperation>();
+  compOP->emplace_back<qc::StandardOperation>(1, qc::S);
+  compOP->emplace_back<qc::StandardOperation>(2_pc, 1, qc::Z);
+  qc.emplace_back(compOP);
+  qc.swap(0, 1);
+
+  auto streamed = Tableau(3U, true);
+  streamed.applyOperations(qc.begin(), qc.end());
+  EXPECT_EQ(streamed, Tableau(qc, 0, std::numeric_limits<std::size_t>::max(),
+                              true));
+}
+
+TEST_F(TestTableau, QASMImport) {
+  using namespace qc::literals;
+
+  qc::QuantumComputation qc(3U);
+  qc.h(0);
+  qc.h(1);
+  qc.cx(0_pc, 2);
+  qc.sdg(1);
+  qc.cz(2_pc, 1);
+  qc.iswap(0, 2);
+
+  std::istringstream qasm2("OPENQASM 2.0;\n"
+                           "include \"qelib1.inc\";\n"
+                           "qreg q[2];\n"
+                           "qreg r[1];\n"
+                           "creg c[3];\n"
+                           "h q; // broadcast over the register\n"
+                           "cx q[0], r[0];\n"
+                           "sdg q[1]; /* inline; comment */ cz r[0], q[1];\n"
+                           "barrier q, r;\n"
+                           "iswap q[0], r[0];\n");
+  auto imported = Tableau{};
+  imported.importQASM(qasm2);
+  EXPECT_EQ(imported, Tableau(qc));
+
+  std::istringstream qasm3("OPENQASM 3.0;\n"
+                           "include \"stdgates.inc\";\n"
+                           "qubit[3] q;\n"
+                           "h q[0];\n"
+                           "h q[1];\n"
+                           "cx q[0], q[2];\n"
+                           "sdg q[1];\n"
+                           "cz q[2], q[1];\n"
+                           "iswap q[0], q[2];\n");
+  imported.importQASM(qasm3, true);
+  EXPECT_EQ(imported, Tableau(qc, 0, std::numeric_limits<std::size_t>::max(),
+                              true));
+
+  for (const auto* const invalid :
+       {"qreg q[1]; t q[0];", "qreg q[1]; h q[1];", "qreg q[1]; h q[0]",
+        "qreg q[1]; h q[0]; qreg r[1];", "qreg q[2]; cx q[0], q[0];",
+        "qreg q[2]; qreg r[1]; cx q, r;", "qreg q[1]; measure q[0];",
+        "qreg q[x];", "qubit[99999999999999999999999] q;",
+        "qreg q[2]; h q[0x1];"}) {
+    std::istringstream is(invalid);
+    EXPECT_THROW(imported.importQASM(is), std::runtime_error);
+  }
+}
+
 TEST_F(TestTableau, InvalidInput) {
   EXPECT_THROW(tableau = Tableau("[ZZX, aXy]"), std::invalid_argument);
   EXPECT_THROW(tableau = Tableau("[ZZ__I, XXY]"), std::invalid_argument);
@@ -0,0 +1,388 @@
+#include "CNFLogic.hpp"
+#include "Encodings.hpp"
+#include "Logic.hpp"
+#include "LogicTerm.hpp"
+#include "Model.hpp"
+#include "SATSolver.hpp"
+#include "util_logicblock.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace logicbase;
+
+TEST(TestCNF, BooleanFormulas) {
+  cnflogic::CNFLogicBlock lb;
+
+  const auto a = lb.makeVariable("a");
+  const auto b = lb.makeVariable("b");
+  const auto c = lb.makeVariable("c");
+  lb.assertFormula(LogicTerm::implies(a, b));
+  lb.assertFormula(a || c);
+  lb.assertFormula(!c);
+  lb.assertFormula(LogicTerm::ite(b, c, !a) == LogicTerm(false));
+  EXPECT_EQ(lb.solve(), Result::SAT);
+
+  auto* model = lb.getModel();
+  EXPECT_TRUE(model->getBoolValue(a, &lb));
+  EXPECT_TRUE(model->getBoolValue(b, &lb));
+  EXPECT_FALSE(model->getBoolValue(c, &lb));
+
+  lb.assertFormula(a != b);
+  EXPECT_EQ(lb.solve(), Result::UNSAT);
+  lb.reset();
+
+  const auto x = lb.makeVariable("x");
+  lb.assertFormula(x);
+  EXPECT_EQ(lb.solve(), Result::SAT);
+  EXPECT_TRUE(lb.getModel()->getBoolValue(x, &lb));
+}
+
+TEST(TestCNF, Statistics) {
+  cnflogic::CNFLogicBlock lb;
+
+  const auto a = lb.makeVariable("a");
+  const auto b = lb.makeVariable("b");
+  const auto c = lb.makeVariable("c");
+  lb.assertFormula(a || b);
+  lb.assertFormula((a || b) != c);
+  lb.assertFormula(!a);
+  EXPECT_EQ(lb.solve(), Result::SAT);
+
+  const auto stats = lb.getStatistics();
+  EXPECT_EQ(stats.boolVariables, 3U);
+  EXPECT_EQ(stats.assertedFormulas, 3U);
+  EXPECT_EQ(stats.assertedClauses, 3U);
+  EXPECT_GT(stats.convertedNodes, 0U);
+  EXPECT_GT(stats.cacheHits, 0U);
+  EXPECT_EQ(stats.solverCalls, 1U);
+  EXPECT_EQ(stats.solver.count("conflicts"), 1U);
+  EXPECT_EQ(stats.solver.at("variables"),
+            static_cast<double>(lb.getNumVars()));
+}
+
+TEST(TestCNF, Bitvectors) {
+  cnflogic::CNFLogicBlock lb(std::make_unique<cnflogic::CDCLSolver>(), false);
+
+  const auto x = lb.makeVariable("x", CType::BITVECTOR, 8);
+  const auto y = lb.makeVariable("y", CType::BITVECTOR, 8);
+  const auto z = lb.makeVariable("z", CType::BITVECTOR, 8);
+  lb.assertFormula(x == LogicTerm(0b10110101ULL, 8));
+  lb.assertFormula(y == (x ^ LogicTerm(0b00001111ULL, 8)));
+  lb.assertFormula(z == ((x & y) | LogicTerm(0b1ULL, 8)));
+  lb.produceInstance();
+  EXPECT_EQ(lb.solve(), Result::SAT);
+
+  auto* model = lb.getModel();
+  EXPECT_EQ(model->getBitvectorValue(x, &lb), 0b10110101U);
+  EXPECT_EQ(model->getBitvectorValue(y, &lb), 0b10111010U);
+  EXPECT_EQ(model->getBitvectorValue(z, &lb), 0b10110001U);
+  EXPECT_TRUE(model->getBoolValue(x, &lb));
+
+  // pending clauses are only encoded once
+  const auto numClauses = lb.getNumClauses();
+  EXPECT_EQ(lb.solve(), Result::SAT);
+  EXPECT_EQ(lb.getNumClauses(), numClauses);
+
+  lb.assertFormula(y != LogicTerm(0b10111010ULL, 8));
+  EXPECT_EQ(lb.solve(), Result::UNSAT);
+}
+
+TEST(TestCNF, PushPopAndAssumptions) {
+  cnflogic::CNFLogicBlock lb(std::make_unique<cnflogic::CDCLSolver>(), false);
+
+  const auto x = lb.makeVariable("x", CType::BITVECTOR, 4);
+  const auto y = lb.makeVariable("y", CType::BITVECTOR, 4);
+  const auto p = lb.makeVariable("p");
+  lb.assertFormula(LogicTerm::implies(p, x == y));
+
+  lb.push();
+  lb.assertFormula(x == LogicTerm(0b0101ULL, 4));
+  lb.push();
+  lb.assertFormula(y == LogicTerm(0b1010ULL, 4));
+  EXPECT_EQ(lb.solve({p}), Result::UNSAT);
+  EXPECT_EQ(lb.solve(), Result::SAT);
+  EXPECT_FALSE(lb.getModel()->getBoolValue(p, &lb));
+
+  // the inner scope is gone, the outer one is still active
+  lb.pop();
+  EXPECT_EQ(lb.solve({p}), Result::SAT);
+  EXPECT_EQ(lb.getModel()->getBitvectorValue(y, &lb), 0b0101U);
+
+  lb.pop();
+  EXPECT_EQ(lb.solve({p, y == LogicTerm(0b1111ULL, 4)}), Result::SAT);
+  EXPECT_EQ(lb.getModel()->getBitvectorValue(x, &lb), 0b1111U);
+  EXPECT_THROW(lb.pop(), std::runtime_error);
+}
+
+TEST(TestCNF, RandomAssumptions) {
+  constexpr int32_t N_VARS = 40;
+  std::mt19937 gen(7U);
+  std::uniform_int_distribution<int32_t> varDist(1, N_VARS);
+  std::bernoulli_distribution signDist(0.5);
+
+  // one incremental solver is compared to a fresh solver for every query
+  cnflogic::CDCLSolver incremental;
+  std::vector<std::vector<cnflogic::Lit>> clauses;
+  for (std::size_t c = 0U; c < 120U; ++c) {
+    std::vector<cnflogic::Lit> clause;
+    for (std::size_t k = 0U; k < 3U; ++k) {
+      const auto v = varDist(gen);
+      clause.emplace_back(signDist(gen) ? v : -v);
+    }
+    incremental.addClause(clause);
+    clauses.emplace_back(clause);
+  }
+  for (std::size_t run = 0U; run < 50U; ++run) {
+    std::vector<cnflogic::Lit> assumptions;
+    for (std::size_t k = 0U; k < 6U; ++k) {
+      const auto v = varDist(gen);
+      assumptions.emplace_back(signDist(gen) ? v : -v);
+    }
+    cnflogic::CDCLSolver fresh;
+    for (const auto& clause : clauses) {
+      fresh.addClause(clause);
+    }
+    for (const auto l : assumptions) {
+      fresh.addClause({l});
+    }
+    const auto expected = fresh.solve();
+    ASSERT_EQ(incremental.solve(assumptions), expected);
+    if (expected == Result::SAT) {
+      for (const auto l : assumptions) {
+        EXPECT_EQ(incremental.getValue(l > 0 ? l : -l), l > 0);
+      }
+    }
+  }
+  // assumptions never make the solver itself unsatisfiable
+  EXPECT_EQ(incremental.solve(), Result::SAT);
+}
+
+TEST(TestCNF, UnsupportedTerms) {
+  cnflogic::CNFLogicBlock lb;
+  const auto i = lb.makeVariable("i", CType::INT);
+  EXPECT_THROW(lb.assertFormula(i == LogicTerm(1)), std::runtime_error);
+}
+
+TEST(TestCNF, ExactlyOneEncodings) {
+  bool success = false;
+  auto lb = logicutil::getCNFLogicBlock(success, true);
+  ASSERT_TRUE(success);
+
+  std::vector<LogicTerm> vars;
+  for (std::size_t i = 0U; i < 12U; ++i) {
+    vars.emplace_back(lb->makeVariable("v_" + std::to_string(i)));
+  }
+  lb->assertFormula(encodings::exactlyOneCmdr(
+      encodings::groupVars(vars, 3), LogicTerm::noneTerm(), lb.get()));
+  lb->assertFormula(vars[0] || vars[5]);
+  lb->assertFormula(!vars[0]);
+  ASSERT_EQ(lb->solve(), Result::SAT);
+
+  std::size_t count = 0U;
+  for (std::size_t i = 0U; i < vars.size(); ++i) {
+    if (lb->getModel()->getBoolValue(vars[i], lb.get())) {
+      ++count;
+      EXPECT_EQ(i, 5U);
+    }
+  }
+  EXPECT_EQ(count, 1U);
+}
+
+class TestCardinality
+    : public testing::TestWithParam<encodings::CardinalityEncoding> {};
+
+INSTANTIATE_TEST_SUITE_P(
+    CNF, TestCardinality,
+    testing::Values(encodings::CardinalityEncoding::SequentialCounter,
+                    encodings::CardinalityEncoding::Totalizer,
+                    encodings::CardinalityEncoding::ModuloTotalizer),
+    [](const testing::TestParamInfo<encodings::CardinalityEncoding>& inf) {
+      return encodings::toString(inf.param);
+    });
+
+TEST_P(TestCardinality, AllAssignments) {
+  constexpr std::size_t N = 7U;
+  cnflogic::CNFLogicBlock lb;
+  std::vector<LogicTerm> vars;
+  for (std::size_t i = 0U; i < N; ++i) {
+    vars.emplace_back(lb.makeVariable("x_" + std::to_string(i)));
+  }
+  const encodings::Cardinality card(vars, GetParam(), &lb,
+                                    encodings::Cardinality::Bounds::Both);
+  lb.assertFormula(card.getDefinitions());
+
+  // the counter is only encoded once, bounds are passed as assumptions
+  for (std::size_t k = 0U; k <= N; ++k) {
+    for (uint32_t assignment = 0U; assignment < (1U << N); ++assignment) {
+      std::vector<LogicTerm> assumptions;
+      std::size_t count = 0U;
+      for (std::size_t i = 0U; i < N; ++i) {
+        const bool value = ((assignment >> i) & 1U) != 0U;
+        assumptions.emplace_back(value ? vars[i] : !vars[i]);
+        count += value ? 1U : 0U;
+      }
+      assumptions.emplace_back(card.atMost(k));
+      EXPECT_EQ(lb.solve(assumptions), count <= k ? Result::SAT : Result::UNSAT)
+          << "at most " << k << " of " << assignment;
+      assumptions.back() = card.atLeast(k);
+      EXPECT_EQ(lb.solve(assumptions), count >= k ? Result::SAT : Result::UNSAT)
+          << "at least " << k << " of " << assignment;
+    }
+  }
+}
+
+TEST_P(TestCardinality, TightenBound) {
+  constexpr std::size_t N = 20U;
+  cnflogic::CNFLogicBlock lb;
+  std::vector<LogicTerm> vars;
+  for (std::size_t i = 0U; i < N; ++i) {
+    vars.emplace_back(lb.makeVariable("x_" + std::to_string(i)));
+  }
+  lb.assertFormula(encodings::atLeastK(vars, 5U, GetParam(), &lb));
+
+  const encodings::Cardinality card(vars, GetParam(), &lb,
+                                    encodings::Cardinality::Bounds::AtMost, 8U);
+  lb.assertFormula(card.getDefinitions());
+  const auto numClauses = lb.getNumClauses();
+  for (std::size_t k = 8U; k >= 5U; --k) {
+    lb.assertFormula(card.atMost(k));
+    ASSERT_EQ(lb.solve(), Result::SAT);
+    std::size_t count = 0U;
+    for (const auto& v : vars) {
+      count += lb.getModel()->getBoolValue(v, &lb) ? 1U : 0U;
+    }
+    EXPECT_GE(count, 5U);
+    EXPECT_LE(count, k);
+  }
+  // tightening only added the bounds
+  EXPECT_LE(lb.getNumClauses(), numClauses + 8U);
+  lb.assertFormula(card.atMost(4U));
+  EXPECT_EQ(lb.solve(), Result::UNSAT);
+  EXPECT_THROW(static_cast<void>(card.atLeast(1U)), std::invalid_argument);
+  if (GetParam() != encodings::CardinalityEncoding::ModuloTotalizer) {
+    // unary counters are truncated at the maximal bound
+    EXPECT_THROW(static_cast<void>(card.atMost(9U)), std::invalid_argument);
+  }
+}
+
+TEST(TestCNF, PigeonHole) {
+  constexpr std::size_t HOLES = 6U;
+  cnflogic::CNFLogicBlock lb;
+
+  std::vector<std::vector<LogicTerm>> p(HOLES + 1U);
+  for (std::size_t i = 0U; i <= HOLES; ++i) {
+    for (std::size_t h = 0U; h < HOLES; ++h) {
+      p[i].emplace_back(lb.makeVariable("p_" + std::to_string(i) + "_" +
+                                        std::to_string(h)));
+    }
+    lb.assertFormula(encodings::naiveAtLeastOne(p[i]));
+  }
+  for (std::size_t h = 0U; h < HOLES; ++h) {
+    std::vector<LogicTerm> hole;
+    for (std::size_t i = 0U; i <= HOLES; ++i) {
+      hole.emplace_back(p[i][h]);
+    }
+    lb.assertFormula(encodings::naiveAtMostOne(hole));
+  }
+  EXPECT_EQ(lb.solve(), Result::UNSAT);
+}
+
+TEST(TestCNF, BackendParameter) {
+  // the pigeonhole formula with twelve holes is far too hard for a timeout
+  // of one millisecond
+  constexpr std::size_t HOLES = 12U;
+  logicutil::Params params;
+  params.addParam(logicutil::BACKEND, std::string("cnf"));
+  params.addParam("timeout", static_cast<uint32_t>(1U));
+  bool success = false;
+  auto lb = logicutil::getLogicBlock(success, true, params);
+  ASSERT_TRUE(success);
+  EXPECT_NE(dynamic_cast<cnflogic::CNFLogicBlock*>(lb.get()), nullptr);
+
+  std::vector<std::vector<LogicTerm>> p(HOLES + 1U);
+  for (std::size_t i = 0U; i <= HOLES; ++i) {
+    for (std::size_t h = 0U; h < HOLES; ++h) {
+      p[i].emplace_back(lb->makeVariable("p_" + std::to_string(i) + "_" +
+                                         std::to_string(h)));
+    }
+    lb->assertFormula(encodings::naiveAtLeastOne(p[i]));
+  }
+  for (std::size_t h = 0U; h < HOLES; ++h) {
+    std::vector<LogicTerm> hole;
+    for (std::size_t i = 0U; i <= HOLES; ++i) {
+      hole.emplace_back(p[i][h]);
+    }
+    lb->assertFormula(encodings::naiveAtMostOne(hole));
+  }
+  EXPECT_EQ(lb->solve(), Result::NDEF);
+
+  auto unsupported = params;
+  unsupported.addParam("sat.restart", std::string("luby"));
+  EXPECT_THROW(std::ignore = logicutil::getLogicBlock(success, true,
+                                                      unsupported),
+               std::invalid_argument);
+  logicutil::Params unknown;
+  unknown.addParam(logicutil::BACKEND, std::string("minisat"));
+  EXPECT_THROW(std::ignore = logicutil::getLogicBlock(success, true, unknown),
+               std::invalid_argument);
+}
+
+TEST(TestCNF, RandomInstances) {
+  constexpr int32_t N_VARS = 60;
+  constexpr std::size_t N_CLAUSES = 250U;
+  std::mt19937 gen(42U);
+  std::uniform_int_distribution<int32_t> varDist(1, N_VARS);
+  std::bernoulli_distribution signDist(0.5);
+
+  std::size_t satisfiable = 0U;
+  for (std::size_t run = 0U; run < 20U; ++run) {
+    std::vector<std::vector<cnflogic::Lit>> clauses;
+    cnflogic::CDCLSolver solver;
+    for (std::size_t c = 0U; c < N_CLAUSES; ++c) {
+      std::vector<cnflogic::Lit> clause;
+      for (std::size_t k = 0U; k < 3U; ++k) {
+        const auto v = varDist(gen);
+        clause.emplace_back(signDist(gen) ? v : -v);
+      }
+      solver.addClause(clause);
+      clauses.emplace_back(clause);
+    }
+    if (solver.solve() != Result::SAT) {
+      continue;
+    }
+    ++satisfiable;
+    for (const auto& clause : clauses) {
+      bool sat = false;
+      for (const auto l : clause) {
+        sat = sat || (solver.getValue(l > 0 ? l : -l) == (l > 0));
+      }
+      EXPECT_TRUE(sat);
+    }
+  }
+  // the clause/variable ratio is close to the phase transition
+  EXPECT_GT(satisfiable, 0U);
+  EXPECT_LT(satisfiable, 20U);
+}
+
+TEST(TestCNF, DumpDIMACS) {
+  cnflogic::CNFLogicBlock lb;
+  const auto a = lb.makeVariable("a");
+  const auto b = lb.makeVariable("b");
+  lb.assertFormula(a || !b);
+  lb.assertFormula(b);
+
+  const auto dimacs = lb.dumpInternalSolver();
+  EXPECT_EQ(dimacs, "p cnf 2 2\n1 -2 0\n2 0\n");
+
+  std::stringstream ss;
+  lb.dumpWCNF(ss, {{!a, 2.0}});
+  EXPECT_EQ(ss.str(), "p wcnf 2 3 3\n3 1 -2 0\n3 2 0\n2 -1 0\n");
+}
@@ -0,0 +1,124 @@
+#include "Instances.hpp"
+#include "Logic.hpp"
+#include "LogicBlock.hpp"
+#include "LogicTerm.hpp"
+#include "SATSolver.hpp"
+#include "util_logicblock.hpp"
+
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+using namespace logicbase;
+
+class TestInstances : public testing::Test {
+protected:
+  std::string directory;
+
+  void SetUp() override {
+    directory =
+        (std::filesystem::temp_directory_path() / "qmap_test_instances")
+            .string();
+  }
+  void TearDown() override { std::filesystem::remove_all(directory); }
+};
+
+namespace {
+// satisfiable with a unique model, unsatisfiable if `conflict` is set
+void assertFormulation(LogicBlock& lb, const bool conflict) {
+  const auto x = lb.makeVariable("x", CType::BITVECTOR, 4);
+  const auto p = lb.makeVariable("p");
+  const auto q = lb.makeVariable("q");
+  lb.assertFormula(LogicTerm::implies(p, x == LogicTerm(0b1001ULL, 4)));
+  lb.assertFormula(p || q);
+  lb.assertFormula(!q);
+  if (conflict) {
+    lb.assertFormula(x == LogicTerm(0b0110ULL, 4));
+  }
+}
+} // namespace
+
+TEST_F(TestInstances, Format) {
+  EXPECT_EQ(logicutil::getInstanceFormat("c comment\np cnf 2 1\n1 2 0\n"),
+            logicutil::InstanceFormat::DIMACS);
+  EXPECT_EQ(logicutil::getInstanceFormat("p wcnf 2 1 2\n2 1 2 0\n"),
+            logicutil::InstanceFormat::WCNF);
+  EXPECT_EQ(logicutil::getInstanceFormat("(declare-fun p () Bool)\n"),
+            logicutil::InstanceFormat::SMTLIB2);
+  EXPECT_EQ(logicutil::getExtension(logicutil::InstanceFormat::DIMACS),
+            ".cnf");
+}
+
+TEST_F(TestInstances, Z3Solver) {
+  for (const bool conflict : {false, true}) {
+    bool success = false;
+    auto lb = logicutil::getZ3LogicBlock(success, true);
+    assertFormulation(*lb, conflict);
+    const auto base = logicutil::dumpInstance(*lb, directory, "z3");
+    ASSERT_FALSE(base.empty());
+    const auto filename = base + ".smt2";
+    ASSERT_TRUE(std::filesystem::exists(filename));
+
+    auto replay = logicutil::getZ3LogicBlock(success, true);
+    const auto res = logicutil::replayInstance(*replay, filename);
+    EXPECT_EQ(res.result, conflict ? Result::UNSAT : Result::SAT);
+    EXPECT_EQ(res.result, lb->solve());
+    EXPECT_EQ(res.statistics.solverCalls, 1U);
+    EXPECT_GE(res.time, 0.);
+  }
+}
+
+TEST_F(TestInstances, Z3Optimizer) {
+  bool success = false;
+  auto lb = logicutil::getZ3LogicOptimizer(success, true);
+  const auto a = lb->makeVariable("a");
+  const auto b = lb->makeVariable("b");
+  lb->assertFormula(a || b);
+  lb->weightedTerm(!a, 2);
+  lb->weightedTerm(!b, 1);
+  lb->makeMinimize();
+  const auto base = logicutil::dumpInstance(*lb, directory, "opt");
+  ASSERT_FALSE(base.empty());
+
+  auto replay = logicutil::getZ3LogicOptimizer(success, true);
+  const auto res = logicutil::replayInstance(*replay, base + ".smt2");
+  EXPECT_EQ(res.result, Result::SAT);
+}
+
+TEST_F(TestInstances, CNF) {
+  for (const bool conflict : {false, true}) {
+    bool success = false;
+    auto lb = logicutil::getCNFLogicBlock(success, true);
+    assertFormulation(*lb, conflict);
+    const auto base = logicutil::dumpInstance(*lb, directory, "cnf");
+    ASSERT_FALSE(base.empty());
+    const auto filename = base + ".cnf";
+    ASSERT_TRUE(std::filesystem::exists(filename));
+    const auto expected = conflict ? Result::UNSAT : Result::SAT;
+
+    // DIMACS instances can be replayed by both backends
+    auto cnf = logicutil::getCNFLogicBlock(success, true);
+    EXPECT_EQ(logicutil::replayInstance(*cnf, filename).result, expected);
+    auto z3 = logicutil::getZ3LogicBlock(success, true);
+    EXPECT_EQ(logicutil::replayInstance(*z3, filename).result, expected);
+    auto preprocessed = logicutil::getCNFLogicBlock(
+        success, true, std::make_unique<cnflogic::CDCLSolver>(), true);
+    EXPECT_EQ(logicutil::replayInstance(*preprocessed, filename).result,
+              expected);
+  }
+}
+
+TEST_F(TestInstances, UnsupportedFormat) {
+  bool success = false;
+  auto lb = logicutil::getZ3LogicBlock(success, true);
+  assertFormulation(*lb, false);
+  const auto base = logicutil::dumpInstance(*lb, directory, "z3");
+
+  auto cnf = logicutil::getCNFLogicBlock(success, true);
+  EXPECT_THROW(cnf->loadInstance(base + ".cnf"), std::runtime_error);
+  EXPECT_THROW(cnf->loadInstance(base + ".smt2"), std::invalid_argument);
+  auto z3 = logicutil::getZ3LogicBlock(success, true);
+  EXPECT_THROW(z3->loadInstance(base + ".cnf"), std::runtime_error);
+}
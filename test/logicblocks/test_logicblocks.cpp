@@ -6,10 +6,14 @@
 #include "Z3Logic.hpp"
 
 #include <cstddef>
+#include <cstdint>
 #include <gtest/gtest.h>
 #include <memory>
+#include <set>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 #include <z3++.h>
 
@@ -553,6 +557,251 @@ TEST_F(TestZ3, TestVariableConversionsToReal) {
   z3logic.reset();
 }
 
+TEST_F(TestZ3, HashConsing) {
+  z3logic::Z3LogicBlock z3logic(ctx, solver, false);
+
+  const auto a = z3logic.makeVariable("a", CType::BOOL);
+  const auto b = z3logic.makeVariable("b", CType::BOOL);
+  const auto c = z3logic.makeVariable("c", CType::BOOL);
+
+  // structurally equal terms share a single node
+  const auto ab1 = a && b;
+  const auto ab2 = a && b;
+  EXPECT_EQ(ab1.getID(), ab2.getID());
+  EXPECT_TRUE(ab1.deepEquals(ab2));
+  EXPECT_NE((a || b).getID(), ab1.getID());
+  EXPECT_NE((b && a).getID(), ab1.getID());
+  EXPECT_EQ(LogicTerm(3).getID(), LogicTerm(3).getID());
+
+  // variables with the same name are distinct
+  const auto a2 = z3logic.makeVariable("a", CType::BOOL);
+  EXPECT_NE(a.getID(), a2.getID());
+  EXPECT_NE((a2 && b).getID(), ab1.getID());
+
+  // the shared subterm is only stored once
+  const auto size = z3logic.getTermStore().size();
+  const auto f = (ab1 || c) && (ab2 || !c);
+  EXPECT_EQ(f.getNodes()[0].getNodes()[0].getID(),
+            f.getNodes()[1].getNodes()[0].getID());
+  EXPECT_EQ(z3logic.getTermStore().size(), size + 4U);
+  EXPECT_EQ(f.getDepth(), 3U);
+
+  z3logic.assertFormula(f);
+  z3logic.assertFormula(!c);
+  z3logic.produceInstance();
+  EXPECT_EQ(z3logic.solve(), Result::SAT);
+
+  // constants are kept in their handles and never retained by a store
+  const auto x = z3logic.makeVariable("x", CType::INT);
+  const auto globalSize = TermStore::global().size();
+  const auto blockSize = z3logic.getTermStore().size();
+  EXPECT_EQ((x + LogicTerm(3)).getID(), (x + LogicTerm(3)).getID());
+  EXPECT_NE((x + LogicTerm(3)).getID(), (x + LogicTerm(4)).getID());
+  EXPECT_EQ(LogicTerm(2.5).getFloatValue(), 2.5);
+  EXPECT_EQ(LogicTerm(-7).getIntValue(), -7);
+  EXPECT_EQ(TermStore::global().size(), globalSize);
+  EXPECT_EQ(z3logic.getTermStore().size(), blockSize + 2U);
+
+  z3logic.reset();
+  EXPECT_EQ(z3logic.getTermStore().size(), 0U);
+}
+
+TEST_F(TestZ3, AccumulatedChainsGrowLinearly) {
+  z3logic::Z3LogicBlock z3logic(ctx, solver, false);
+
+  constexpr std::size_t N = 200U;
+  std::vector<LogicTerm> vars;
+  for (std::size_t i = 0U; i < N; ++i) {
+    vars.emplace_back(
+        z3logic.makeVariable("x" + std::to_string(i), CType::BOOL));
+  }
+  // every step of the accumulation adds a single binary node
+  const auto size = z3logic.getTermStore().size();
+  auto all = vars.front();
+  for (std::size_t i = 1U; i < N; ++i) {
+    all = all && vars[i];
+  }
+  EXPECT_EQ(z3logic.getTermStore().size(), size + N - 1U);
+  EXPECT_EQ(LogicTerm::getFlatTerms(all, OpType::AND).size(), N);
+
+  z3logic.assertFormula(all);
+  z3logic.produceInstance();
+  EXPECT_EQ(z3logic.solve(), Result::SAT);
+  z3logic.assertFormula(!vars.back());
+  z3logic.produceInstance();
+  EXPECT_EQ(z3logic.solve(), Result::UNSAT);
+}
+
+TEST_F(TestZ3, StreamingClauses) {
+  z3logic::Z3LogicBlock z3logic(ctx, solver, true);
+
+  const auto a = z3logic.makeVariable("a", CType::BOOL);
+  const auto b = z3logic.makeVariable("b", CType::BOOL);
+  const auto c = z3logic.makeVariable("c", CType::BOOL);
+  z3logic.assertFormula(a && (b || c));
+  EXPECT_TRUE(z3logic.getRetainedClauses().empty());
+
+  z3logic.setRetainClauses(true);
+  z3logic.assertFormula(!c);
+  ASSERT_EQ(z3logic.getRetainedClauses().size(), 1U);
+  EXPECT_EQ(z3logic.getRetainedClauses().front().getID(), (!c).getID());
+
+  // clauses are handed to the solver exactly once, even on repeated solves
+  EXPECT_EQ(z3logic.solve(), Result::SAT);
+  EXPECT_EQ(z3logic.solve(), Result::SAT);
+  const auto dump = z3logic.dumpInternalSolver();
+  std::size_t asserts = 0U;
+  for (auto pos = dump.find("(assert"); pos != std::string::npos;
+       pos = dump.find("(assert", pos + 1)) {
+    ++asserts;
+  }
+  EXPECT_EQ(asserts, 3U);
+
+  z3logic.reset();
+  EXPECT_TRUE(z3logic.getRetainedClauses().empty());
+}
+
+TEST_F(TestZ3, Statistics) {
+  z3logic::Z3LogicBlock z3logic(ctx, solver, true);
+
+  const auto a = z3logic.makeVariable("a", CType::BOOL);
+  const auto b = z3logic.makeVariable("b", CType::BOOL);
+  const auto x = z3logic.makeVariable("x", CType::INT);
+  const auto y = z3logic.makeVariable("y", CType::BITVECTOR, 8);
+  z3logic.assertFormula(a && (a || b) && (x > LogicTerm(2)));
+  z3logic.assertFormula(y == LogicTerm(3ULL, 8));
+  z3logic.addEncodeTime(1.);
+  EXPECT_EQ(z3logic.solve(), Result::SAT);
+  EXPECT_EQ(z3logic.solve({b}), Result::SAT);
+
+  auto stats = z3logic.getStatistics();
+  EXPECT_EQ(stats.boolVariables, 2U);
+  EXPECT_EQ(stats.intVariables, 1U);
+  EXPECT_EQ(stats.bitvectorVariables, 1U);
+  EXPECT_EQ(stats.getVariables(), 4U);
+  EXPECT_EQ(stats.assertedFormulas, 2U);
+  EXPECT_EQ(stats.assertedClauses, 4U);
+  EXPECT_GT(stats.convertedNodes, 0U);
+  // `a` is converted as clause and again inside `a || b`
+  EXPECT_GT(stats.cacheHits, 0U);
+  EXPECT_EQ(stats.solverCalls, 2U);
+  EXPECT_DOUBLE_EQ(stats.encodeTime, 1.);
+  EXPECT_GT(stats.convertTime, 0.);
+  EXPECT_GT(stats.solveTime, 0.);
+  EXPECT_FALSE(stats.solver.empty());
+
+  auto sum = stats;
+  sum += stats;
+  EXPECT_EQ(sum.solverCalls, 4U);
+  EXPECT_EQ(sum.getVariables(), 8U);
+
+  z3logic.reset();
+  stats = z3logic.getStatistics();
+  EXPECT_EQ(stats.getVariables(), 0U);
+  EXPECT_EQ(stats.convertedNodes, 0U);
+  EXPECT_EQ(stats.solverCalls, 0U);
+}
+
+TEST_F(TestZ3, PushPopAndAssumptions) {
+  z3logic::Z3LogicBlock z3logic(ctx, solver, true);
+
+  const auto a = z3logic.makeVariable("a", CType::BOOL);
+  const auto b = z3logic.makeVariable("b", CType::BOOL);
+  z3logic.assertFormula(a || b);
+  z3logic.setRetainClauses(true);
+
+  z3logic.push();
+  z3logic.assertFormula(!a);
+  z3logic.assertFormula(!b);
+  EXPECT_EQ(z3logic.getNumScopes(), 1U);
+  EXPECT_EQ(z3logic.getRetainedClauses().size(), 2U);
+  EXPECT_EQ(z3logic.solve(), Result::UNSAT);
+
+  z3logic.pop();
+  EXPECT_EQ(z3logic.getNumScopes(), 0U);
+  EXPECT_TRUE(z3logic.getRetainedClauses().empty());
+  EXPECT_EQ(z3logic.solve(), Result::SAT);
+
+  // assumptions only hold for a single call
+  EXPECT_EQ(z3logic.solve({!a, !b}), Result::UNSAT);
+  EXPECT_EQ(z3logic.solve({!a}), Result::SAT);
+  EXPECT_TRUE(z3logic.getModel()->getBoolValue(b, &z3logic));
+  EXPECT_EQ(z3logic.solve({!b}), Result::SAT);
+  EXPECT_TRUE(z3logic.getModel()->getBoolValue(a, &z3logic));
+
+  EXPECT_THROW(z3logic.pop(), std::runtime_error);
+}
+
+TEST_F(TestZ3, CardinalityEncodings) {
+  using encodings::CardinalityEncoding;
+  for (const auto encoding :
+       {CardinalityEncoding::PseudoBoolean,
+        CardinalityEncoding::SequentialCounter, CardinalityEncoding::Totalizer,
+        CardinalityEncoding::ModuloTotalizer}) {
+    z3logic::Z3LogicBlock z3logic(ctx, std::make_shared<z3::solver>(*ctx));
+    std::vector<LogicTerm> vars;
+    for (std::size_t i = 0U; i < 10U; ++i) {
+      vars.emplace_back(
+          z3logic.makeVariable("x_" + std::to_string(i), CType::BOOL));
+    }
+    z3logic.assertFormula(encodings::atMostK(vars, 3U, encoding, &z3logic));
+    z3logic.assertFormula(encodings::atLeastK(vars, 3U, encoding, &z3logic));
+    ASSERT_EQ(z3logic.solve(), Result::SAT) << encodings::toString(encoding);
+    std::size_t count = 0U;
+    for (const auto& v : vars) {
+      count += z3logic.getModel()->getBoolValue(v, &z3logic) ? 1U : 0U;
+    }
+    EXPECT_EQ(count, 3U) << encodings::toString(encoding);
+
+    z3logic.assertFormula(encodings::atMostK(vars, 2U, encoding, &z3logic));
+    EXPECT_EQ(z3logic.solve(), Result::UNSAT) << encodings::toString(encoding);
+  }
+}
+
+TEST(TestLogicTerm, ConcurrentFormulations) {
+  constexpr std::size_t N_THREADS = 8U;
+  constexpr std::size_t N_VARS = 64U;
+
+  std::vector<std::vector<uint64_t>> globalIds(N_THREADS);
+  std::vector<Result> results(N_THREADS, Result::NDEF);
+  std::vector<std::thread> threads;
+  threads.reserve(N_THREADS);
+  for (std::size_t t = 0U; t < N_THREADS; ++t) {
+    threads.emplace_back([t, &globalIds, &results]() {
+      auto ctx = std::make_shared<z3::context>();
+      auto solver = std::make_shared<z3::solver>(*ctx);
+      z3logic::Z3LogicBlock lb(ctx, solver, false);
+
+      std::vector<LogicTerm> vars;
+      for (std::size_t i = 0U; i < N_VARS; ++i) {
+        vars.emplace_back(lb.makeVariable("x_" + std::to_string(i),
+                                          CType::INT));
+        // terms without a block share the process-wide id counter
+        globalIds[t].emplace_back(LogicTerm("g", CType::BOOL).getID());
+      }
+      LogicTerm sum = LogicTerm(0);
+      for (std::size_t i = 0U; i < N_VARS; ++i) {
+        lb.assertFormula(vars[i] >= LogicTerm(0));
+        lb.assertFormula(vars[i] <= LogicTerm(static_cast<int>(t)));
+        sum = sum + vars[i];
+      }
+      lb.assertFormula(sum == LogicTerm(static_cast<int>(t * N_VARS)));
+      lb.produceInstance();
+      results[t] = lb.solve();
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  std::set<uint64_t> ids;
+  for (std::size_t t = 0U; t < N_THREADS; ++t) {
+    EXPECT_EQ(results[t], Result::SAT);
+    ids.insert(globalIds[t].begin(), globalIds[t].end());
+  }
+  EXPECT_EQ(ids.size(), N_THREADS * N_VARS);
+}
+
 class TestZ3Opt : public testing::TestWithParam<logicbase::OpType> {
 protected:
   void SetUp() override {}
@@ -0,0 +1,149 @@
+#include "CNFLogic.hpp"
+#include "Logic.hpp"
+#include "LogicBlock.hpp"
+#include "LogicTerm.hpp"
+#include "PortfolioLogic.hpp"
+#include "SATSolver.hpp"
+#include "util_logicblock.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace logicbase;
+
+namespace {
+std::unique_ptr<portfoliologic::PortfolioLogicBlock> makeMixedPortfolio() {
+  bool success = false;
+  std::vector<std::unique_ptr<LogicBlock>> instances;
+  instances.emplace_back(logicutil::getZ3LogicBlock(success, true));
+  instances.emplace_back(logicutil::getCNFLogicBlock(success, true));
+  instances.emplace_back(logicutil::getCNFLogicBlock(
+      success, true, std::make_unique<cnflogic::CDCLSolver>(42U)));
+  return std::make_unique<portfoliologic::PortfolioLogicBlock>(
+      std::move(instances));
+}
+
+// n + 1 pigeons in n holes, which is hard for CDCL solvers
+void assertPigeonhole(LogicBlock& lb, const std::size_t n) {
+  std::vector<std::vector<LogicTerm>> x(n + 1U);
+  for (std::size_t p = 0U; p <= n; ++p) {
+    auto somewhere = LogicTerm(false);
+    for (std::size_t h = 0U; h < n; ++h) {
+      x[p].emplace_back(lb.makeVariable("x_" + std::to_string(p) + "_" +
+                                        std::to_string(h)));
+      somewhere = somewhere || x[p][h];
+    }
+    lb.assertFormula(somewhere);
+  }
+  for (std::size_t h = 0U; h < n; ++h) {
+    for (std::size_t p = 0U; p <= n; ++p) {
+      for (std::size_t q = p + 1U; q <= n; ++q) {
+        lb.assertFormula(!x[p][h] || !x[q][h]);
+      }
+    }
+  }
+}
+} // namespace
+
+TEST(TestPortfolio, MixedBackends) {
+  auto lb = makeMixedPortfolio();
+  EXPECT_EQ(lb->getNumInstances(), 3U);
+
+  const auto a = lb->makeVariable("a");
+  const auto b = lb->makeVariable("b");
+  const auto c = lb->makeVariable("c");
+  lb->assertFormula(LogicTerm::implies(a, b));
+  lb->assertFormula(a || c);
+  lb->assertFormula(!c);
+  EXPECT_EQ(lb->solve(), Result::SAT);
+  EXPECT_LT(lb->getWinner(), lb->getNumInstances());
+  auto* model = lb->getModel();
+  EXPECT_TRUE(model->getBoolValue(a, lb.get()));
+  EXPECT_TRUE(model->getBoolValue(b, lb.get()));
+  EXPECT_FALSE(model->getBoolValue(c, lb.get()));
+
+  lb->push();
+  lb->assertFormula(!b);
+  EXPECT_EQ(lb->solve(), Result::UNSAT);
+  lb->pop();
+  EXPECT_EQ(lb->solve({a}), Result::SAT);
+  EXPECT_EQ(lb->solve({!a}), Result::UNSAT);
+
+  lb->reset();
+  const auto x = lb->makeVariable("x");
+  lb->assertFormula(!x);
+  EXPECT_EQ(lb->solve(), Result::SAT);
+  EXPECT_FALSE(lb->getModel()->getBoolValue(x, lb.get()));
+}
+
+TEST(TestPortfolio, Interrupt) {
+  std::vector<std::unique_ptr<LogicBlock>> instances;
+  for (uint32_t seed = 0U; seed < 2U; ++seed) {
+    instances.emplace_back(std::make_unique<cnflogic::CNFLogicBlock>(
+        std::make_unique<cnflogic::CDCLSolver>(seed)));
+  }
+  portfoliologic::PortfolioLogicBlock lb(std::move(instances));
+  assertPigeonhole(lb, 12U);
+
+  auto result = std::async(std::launch::async, [&lb]() { return lb.solve(); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  lb.interrupt();
+  EXPECT_EQ(result.get(), Result::NDEF);
+
+  // the instances remain usable
+  lb.push();
+  const auto y = lb.makeVariable("y");
+  lb.assertFormula(y && !y);
+  EXPECT_EQ(lb.solve(), Result::UNSAT);
+  lb.pop();
+}
+
+TEST(TestPortfolio, Factories) {
+  bool success = false;
+  logicutil::Params params;
+  params.addParam(logicutil::PORTFOLIO_THREADS, 4U);
+  auto lb = logicutil::getZ3LogicBlock(success, true, params);
+  EXPECT_TRUE(success);
+  auto* portfolio =
+      dynamic_cast<portfoliologic::PortfolioLogicBlock*>(lb.get());
+  ASSERT_NE(portfolio, nullptr);
+  EXPECT_EQ(portfolio->getNumInstances(), 4U);
+
+  auto optimizer = logicutil::getZ3LogicOptimizer(success, true, params);
+  EXPECT_NE(
+      dynamic_cast<portfoliologic::PortfolioLogicOptimizer*>(optimizer.get()),
+      nullptr);
+  std::vector<LogicTerm> vars;
+  for (std::size_t i = 0U; i < 6U; ++i) {
+    vars.emplace_back(optimizer->makeVariable("v" + std::to_string(i)));
+    optimizer->weightedTerm(vars.back(), 1.);
+  }
+  optimizer->assertFormula(vars[0] || vars[1]);
+  optimizer->assertFormula(vars[2] || vars[3]);
+  optimizer->assertFormula(!vars[0] || vars[4]);
+  optimizer->makeMinimize();
+  EXPECT_EQ(optimizer->solve(), Result::SAT);
+  std::size_t count = 0U;
+  for (const auto& v : vars) {
+    count += optimizer->getModel()->getBoolValue(v, optimizer.get()) ? 1U : 0U;
+  }
+  EXPECT_EQ(count, 2U);
+
+  logicutil::Params invalid;
+  invalid.addParam(logicutil::PORTFOLIO_THREADS, true);
+  EXPECT_THROW(static_cast<void>(
+                   logicutil::getZ3LogicBlock(success, true, invalid)),
+               std::invalid_argument);
+  EXPECT_THROW(portfoliologic::PortfolioLogicBlock(
+                   std::vector<std::unique_ptr<LogicBlock>>{}),
+               std::invalid_argument);
+}
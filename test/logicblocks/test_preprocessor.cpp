@@ -0,0 +1,295 @@
+#include "CNFLogic.hpp"
+#include "Logic.hpp"
+#include "LogicTerm.hpp"
+#include "Preprocessor.hpp"
+#include "SATSolver.hpp"
+#include "util_logicblock.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace logicbase;
+using cnflogic::Lit;
+
+namespace {
+using Clauses = std::vector<std::vector<Lit>>;
+
+// mixes binary and ternary clauses, so that all techniques find some work
+Clauses randomClauses(std::mt19937& gen, const int32_t nVars,
+                      const std::size_t nClauses) {
+  std::uniform_int_distribution<int32_t> varDist(1, nVars);
+  std::bernoulli_distribution signDist(0.5);
+  std::bernoulli_distribution binaryDist(0.4);
+  Clauses clauses;
+  for (std::size_t c = 0U; c < nClauses; ++c) {
+    std::vector<Lit> clause;
+    const std::size_t size = binaryDist(gen) ? 2U : 3U;
+    for (std::size_t k = 0U; k < size; ++k) {
+      const auto v = varDist(gen);
+      clause.emplace_back(signDist(gen) ? v : -v);
+    }
+    clauses.emplace_back(clause);
+  }
+  return clauses;
+}
+
+bool satisfies(const Clauses& clauses, const std::vector<bool>& values) {
+  for (const auto& clause : clauses) {
+    bool sat = false;
+    for (const auto l : clause) {
+      sat = sat || values[static_cast<std::size_t>(l > 0 ? l : -l)] == (l > 0);
+    }
+    if (!sat) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Result solveFresh(const Clauses& clauses) {
+  cnflogic::CDCLSolver solver;
+  for (const auto& clause : clauses) {
+    solver.addClause(clause);
+  }
+  return solver.solve();
+}
+
+std::vector<bool> getModel(const cnflogic::CDCLSolver& solver,
+                           const int32_t nVars) {
+  std::vector<bool> values(static_cast<std::size_t>(nVars) + 1U);
+  for (int32_t v = 1; v <= nVars; ++v) {
+    values[static_cast<std::size_t>(v)] = solver.getValue(v);
+  }
+  return values;
+}
+} // namespace
+
+TEST(TestPreprocessor, UnitPropagation) {
+  cnflogic::Preprocessor pre;
+  for (int32_t v = 1; v <= 4; ++v) {
+    pre.freeze(v);
+  }
+  pre.addClause({1});
+  pre.addClause({-1, 2});
+  pre.addClause({-2, 3, 4});
+  pre.addClause({-2, -3, 1});
+  EXPECT_TRUE(pre.simplify());
+  EXPECT_EQ(pre.getStatistics().at("fixed"), 2.);
+
+  const auto clauses = pre.extractClauses();
+  ASSERT_EQ(clauses.size(), 3U);
+  EXPECT_EQ(clauses[0], std::vector<Lit>{1});
+  EXPECT_EQ(clauses[1], std::vector<Lit>{2});
+  EXPECT_EQ(clauses[2], (std::vector<Lit>{3, 4}));
+}
+
+TEST(TestPreprocessor, EquivalentLiterals) {
+  cnflogic::Preprocessor pre;
+  pre.freeze(4);
+  pre.freeze(5);
+  // 1 == -2 == 3
+  pre.addClause({1, 2});
+  pre.addClause({-1, -2});
+  pre.addClause({2, 3});
+  pre.addClause({-2, -3});
+  pre.addClause({1, 4, 5});
+  pre.addClause({-3, -4, 5});
+  EXPECT_TRUE(pre.simplify());
+  EXPECT_EQ(pre.getRepresentative(2), -pre.getRepresentative(1));
+  EXPECT_EQ(pre.getRepresentative(3), pre.getRepresentative(1));
+
+  cnflogic::CDCLSolver solver;
+  for (const auto& clause : pre.extractClauses()) {
+    solver.addClause(clause);
+  }
+  ASSERT_EQ(solver.solve(), Result::SAT);
+  auto values = getModel(solver, 5);
+  pre.extendModel(values);
+  EXPECT_NE(values[1], values[2]);
+  EXPECT_EQ(values[1], values[3]);
+  EXPECT_TRUE(values[4] || values[5] || values[1]);
+}
+
+TEST(TestPreprocessor, Subsumption) {
+  cnflogic::Preprocessor pre;
+  for (int32_t v = 1; v <= 4; ++v) {
+    pre.freeze(v);
+  }
+  pre.addClause({1, 2, 3});
+  pre.addClause({2, 1});
+  pre.addClause({1, 2, 4});
+  pre.addClause({-1, 3, 4});
+  EXPECT_TRUE(pre.simplify());
+  EXPECT_EQ(pre.getStatistics().at("subsumed"), 2.);
+  EXPECT_EQ(pre.getNumClauses(), 2U);
+}
+
+TEST(TestPreprocessor, VariableElimination) {
+  cnflogic::Preprocessor pre;
+  pre.freeze(2);
+  pre.freeze(3);
+  pre.freeze(4);
+  pre.addClause({1, 2});
+  pre.addClause({-1, 3});
+  pre.addClause({-1, 4});
+  EXPECT_TRUE(pre.simplify());
+  EXPECT_TRUE(pre.isEliminated(1));
+  const auto clauses = pre.extractClauses();
+  ASSERT_EQ(clauses.size(), 2U);
+  EXPECT_EQ(clauses[0], (std::vector<Lit>{2, 3}));
+  EXPECT_EQ(clauses[1], (std::vector<Lit>{2, 4}));
+
+  // a model of the resolvents is extended to the eliminated variable
+  std::vector<bool> values{false, false, false, true, true};
+  pre.extendModel(values);
+  EXPECT_TRUE(values[1]);
+  values = {false, false, true, false, true};
+  pre.extendModel(values);
+  EXPECT_FALSE(values[1]);
+
+  // using the variable again restores its clauses
+  Clauses restored;
+  const auto rewritten = pre.rewrite({-1, -2}, restored);
+  EXPECT_EQ(rewritten, (std::vector<Lit>{-1, -2}));
+  EXPECT_EQ(restored.size(), 3U);
+  EXPECT_FALSE(pre.isEliminated(1));
+}
+
+TEST(TestPreprocessor, Unsatisfiable) {
+  cnflogic::Preprocessor pre;
+  pre.addClause({1, 2});
+  pre.addClause({1, -2});
+  pre.addClause({-1, 2});
+  pre.addClause({-1, -2});
+  EXPECT_FALSE(pre.simplify());
+  const auto clauses = pre.extractClauses();
+  ASSERT_EQ(clauses.size(), 1U);
+  EXPECT_TRUE(clauses.front().empty());
+}
+
+TEST(TestPreprocessor, RandomInstances) {
+  constexpr int32_t N_VARS = 50;
+  std::mt19937 gen(11U);
+  std::size_t satisfiable = 0U;
+  std::size_t eliminated = 0U;
+  for (std::size_t run = 0U; run < 30U; ++run) {
+    const auto clauses = randomClauses(gen, N_VARS, 80U + 3U * run);
+    cnflogic::Preprocessor pre;
+    for (const auto& clause : clauses) {
+      pre.addClause(clause);
+    }
+    pre.simplify();
+    eliminated +=
+        static_cast<std::size_t>(pre.getStatistics().at("eliminated"));
+
+    cnflogic::CDCLSolver solver;
+    for (const auto& clause : pre.extractClauses()) {
+      solver.addClause(clause);
+    }
+    const auto res = solver.solve();
+    ASSERT_EQ(res, solveFresh(clauses));
+    if (res == Result::SAT) {
+      ++satisfiable;
+      auto values = getModel(solver, N_VARS);
+      pre.extendModel(values);
+      EXPECT_TRUE(satisfies(clauses, values));
+    }
+  }
+  EXPECT_GT(satisfiable, 0U);
+  EXPECT_LT(satisfiable, 30U);
+  EXPECT_GT(eliminated, 0U);
+}
+
+TEST(TestPreprocessor, RandomIncremental) {
+  constexpr int32_t N_VARS = 40;
+  std::mt19937 gen(3U);
+  std::uniform_int_distribution<int32_t> varDist(1, N_VARS);
+  std::bernoulli_distribution signDist(0.5);
+
+  auto clauses = randomClauses(gen, N_VARS, 100U);
+  cnflogic::Preprocessor pre;
+  for (const auto& clause : clauses) {
+    pre.addClause(clause);
+  }
+  pre.simplify();
+  cnflogic::CDCLSolver solver;
+  for (const auto& clause : pre.extractClauses()) {
+    solver.addClause(clause);
+  }
+
+  // later clauses and assumptions use eliminated and substituted variables
+  for (std::size_t run = 0U; run < 40U; ++run) {
+    Clauses restored;
+    const auto clause = randomClauses(gen, N_VARS, 1U).front();
+    const auto rewritten = pre.rewrite(clause, restored);
+    for (const auto& c : restored) {
+      solver.addClause(c);
+    }
+    solver.addClause(rewritten);
+    clauses.emplace_back(clause);
+
+    std::vector<Lit> assumptions;
+    for (std::size_t k = 0U; k < 3U; ++k) {
+      const auto v = varDist(gen);
+      assumptions.emplace_back(signDist(gen) ? v : -v);
+    }
+    auto expectedClauses = clauses;
+    for (const auto l : assumptions) {
+      expectedClauses.push_back({l});
+    }
+    restored.clear();
+    const auto assumed = pre.rewrite(assumptions, restored);
+    for (const auto& c : restored) {
+      solver.addClause(c);
+    }
+    const auto res = solver.solve(assumed);
+    ASSERT_EQ(res, solveFresh(expectedClauses));
+    if (res == Result::SAT) {
+      auto values = getModel(solver, N_VARS);
+      pre.extendModel(values);
+      EXPECT_TRUE(satisfies(expectedClauses, values));
+    }
+  }
+}
+
+TEST(TestPreprocessor, LogicBlock) {
+  bool success = false;
+  auto lb = logicutil::getCNFLogicBlock(
+      success, false, std::make_unique<cnflogic::CDCLSolver>(), true);
+  EXPECT_TRUE(success);
+
+  const auto x = lb->makeVariable("x", CType::BITVECTOR, 4);
+  const auto y = lb->makeVariable("y", CType::BITVECTOR, 4);
+  const auto p = lb->makeVariable("p");
+  const auto q = lb->makeVariable("q");
+  lb->assertFormula(LogicTerm::implies(p, x == y));
+  lb->assertFormula(p == !q);
+
+  lb->push();
+  lb->assertFormula(x == LogicTerm(0b0101ULL, 4));
+  EXPECT_EQ(lb->solve({!q}), Result::SAT);
+  EXPECT_TRUE(lb->getModel()->getBoolValue(p, lb.get()));
+  EXPECT_EQ(lb->getModel()->getBitvectorValue(y, lb.get()), 0b0101U);
+  lb->push();
+  lb->assertFormula(y == LogicTerm(0b1010ULL, 4));
+  EXPECT_EQ(lb->solve({p}), Result::UNSAT);
+  EXPECT_EQ(lb->solve(), Result::SAT);
+  EXPECT_TRUE(lb->getModel()->getBoolValue(q, lb.get()));
+  lb->pop();
+  lb->pop();
+
+  lb->assertFormula(q);
+  EXPECT_EQ(lb->solve({y == LogicTerm(0b1111ULL, 4)}), Result::SAT);
+  EXPECT_FALSE(lb->getModel()->getBoolValue(p, lb.get()));
+  EXPECT_EQ(lb->getModel()->getBitvectorValue(y, lb.get()), 0b1111U);
+
+  const auto* block = dynamic_cast<cnflogic::CNFLogicBlock*>(lb.get());
+  ASSERT_NE(block, nullptr);
+  ASSERT_NE(block->getPreprocessor(), nullptr);
+  const auto stats = lb->getStatistics();
+  EXPECT_EQ(stats.solver.count("preprocess_eliminated"), 1U);
+}
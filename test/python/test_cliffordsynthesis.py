@@ -7,6 +7,7 @@ from dataclasses import dataclass
 from pathlib import Path
 
 import pytest
+from mqt.core.ir import QuantumComputation
 from qiskit import QuantumCircuit, qasm2
 from qiskit.quantum_info import Clifford, PauliList
 
@@ -278,3 +279,26 @@ def test_invalid_kwarg_to_synthesis() -> None:
     """Test that we raise an error if we pass an invalid kwarg to synthesis."""
     with pytest.raises(ValueError, match="Invalid keyword argument"):
         qmap.synthesize_clifford(target_tableau=qmap.Tableau("Z"), invalid_kwarg=True)
+
+
+def test_remove_redundant_gates() -> None:
+    """Test that gates acting trivially on the prepared state are removed."""
+    qc = QuantumComputation(2)
+    qc.z(0)
+    qc.h(0)
+    qc.x(0)
+    qc.cx(0, 1)
+    assert qmap.remove_redundant_gates(qc) == 2
+    assert len(qc) == 2
+    assert qmap.remove_redundant_gates(qc, qmap.Tableau(2, True)) == 0
+
+
+def test_synthesize_batch() -> None:
+    """Test that a batch of targets is synthesized and repeated targets are reused."""
+    targets = [qmap.Tableau("[+ZZ, +XX]"), qmap.Tableau("Z"), qmap.Tableau("[+ZZ, +XX]")]
+    results = qmap.synthesize_batch(targets, n_threads=2)
+    assert len(results) == 3
+    assert results[0].sat()
+    assert results[1].gates == 0
+    assert results[2].gates == results[0].gates
+    assert results[2].solver_calls == 0
@@ -19,10 +19,14 @@
 #include "sc/utils.hpp"
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <filesystem>
+#include <fstream>
 #include <gtest/gtest.h>
 #include <iostream>
 #include <memory>
+#include <nlohmann/json.hpp>
 #include <qasm3/Importer.hpp>
 #include <set>
 #include <sstream>
@@ -269,6 +273,21 @@ TEST_P(ExactTest, BimanderEncodingUnidirectionallogarithm) {
   SUCCEED() << "Mapping successful";
 }
 
+TEST_P(ExactTest, CardinalityEncodings) {
+  settings.encoding = Encoding::Commander;
+  settings.commanderGrouping = CommanderGrouping::Fixed3;
+  ibmqYorktownMapper->map(settings);
+  const auto expected = ibmqYorktownMapper->getResults().output.gates;
+
+  for (const auto encoding : {Encoding::SequentialCounter, Encoding::Totalizer,
+                              Encoding::ModuloTotalizer}) {
+    settings.encoding = encoding;
+    auto mapper = ExactMapper(qc, ibmqYorktown);
+    mapper.map(settings);
+    EXPECT_EQ(mapper.getResults().output.gates, expected) << encoding;
+  }
+}
+
 TEST_P(ExactTest, LimitsBidirectional) {
   settings.enableSwapLimits = true;
   settings.useSubsets = false;
@@ -365,6 +384,7 @@ TEST_P(ExactTest, toStringMethods) {
   EXPECT_EQ(toString(Layering::Disjoint2qBlocks), "disjoint_2q_blocks");
   EXPECT_EQ(toString(Layering::OddGates), "odd_gates");
   EXPECT_EQ(toString(Layering::QubitTriangle), "qubit_triangle");
+  EXPECT_EQ(toString(Layering::CommutationFront), "commutation_front");
 
   EXPECT_EQ(toString(Encoding::Naive), "naive");
   EXPECT_EQ(toString(Encoding::Commander), "commander");
@@ -421,6 +441,45 @@ TEST_F(ExactTest, WCNF) {
   EXPECT_TRUE(!wcnf.empty());
 }
 
+TEST_F(ExactTest, SolverStatistics) {
+  settings.verbose = false;
+  ibmqLondonMapper->map(settings);
+  const auto& results = ibmqLondonMapper->getResults();
+  const auto& stats = results.solverStatistics;
+  EXPECT_GT(stats.solverCalls, 0U);
+  EXPECT_GT(stats.boolVariables, 0U);
+  EXPECT_GT(stats.assertedFormulas, 0U);
+  EXPECT_GT(stats.encodeTime, 0.);
+  EXPECT_TRUE(results.json()["statistics"].contains("solver_statistics"));
+}
+
+TEST_F(ExactTest, InstanceDump) {
+  const auto directory =
+      std::filesystem::temp_directory_path() / "qmap_exact_instances";
+  std::filesystem::remove_all(directory);
+  settings.verbose = false;
+  settings.instanceDumpPath = directory.string();
+  ibmqLondonMapper->map(settings);
+
+  std::size_t instances = 0U;
+  for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+    if (entry.path().extension() != ".smt2") {
+      continue;
+    }
+    ++instances;
+    auto metadata = entry.path();
+    std::ifstream is(metadata.replace_extension(".json"));
+    ASSERT_TRUE(is.good());
+    const auto meta = nlohmann::basic_json<>::parse(is);
+    EXPECT_EQ(meta["source"], "exact_mapper");
+    EXPECT_EQ(meta["qubit_choice"].size(), qc.getNqubits());
+    EXPECT_TRUE(meta.contains("swap_limit"));
+    EXPECT_TRUE(meta.contains("layers"));
+  }
+  EXPECT_GT(instances, 0U);
+  std::filesystem::remove_all(directory);
+}
+
 TEST_F(ExactTest, WCNFNotAvailable) {
   using namespace qc::literals;
 
@@ -4,9 +4,9 @@
 //
 
 #include "Definitions.hpp"
-#include "ir/operations/CompoundOperation.hpp"
 #include "ir/operations/Control.hpp"
 #include "ir/operations/OpType.hpp"
+#include "ir/operations/Operation.hpp"
 #include "qasm3/Importer.hpp"
 #include "sc/Architecture.hpp"
 #include "sc/DataLogger.hpp"
@@ -17,6 +17,7 @@
 #include "sc/configuration/Layering.hpp"
 #include "sc/configuration/LookaheadHeuristic.hpp"
 #include "sc/configuration/Method.hpp"
+#include "sc/heuristic/HeuristicKernels.hpp"
 #include "sc/heuristic/HeuristicMapper.hpp"
 #include "sc/utils.hpp"
 
@@ -30,6 +31,7 @@
 #include <gtest/gtest.h>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <memory>
 #include <nlohmann/json.hpp>
 #include <random>
@@ -986,6 +988,90 @@ TEST_P(TestHeuristics, HeuristicProperties) {
   }
 }
 
+TEST(Kernels, MatchReferenceAndBackendsAgree) {
+  std::mt19937 mt(42);
+  std::uniform_real_distribution<double> value(0., 100.);
+  constexpr std::uint32_t N = 13;
+  std::vector<double> table(N * N);
+  std::vector<double> row1(N);
+  std::vector<double> row2(N);
+  for (auto& v : table) {
+    v = value(mt);
+  }
+  for (std::uint32_t i = 0; i < N; ++i) {
+    row1[i] = value(mt);
+    row2[i] = value(mt);
+  }
+  std::uniform_int_distribution<std::uint32_t> tableIndex(0, (N * N) - 1);
+  std::uniform_int_distribution<std::uint32_t> rowIndex(0, N - 1);
+
+  // lengths not divisible by the number of lanes exercise the scalar tails
+  for (std::size_t count = 0; count <= 19; ++count) {
+    std::vector<std::uint32_t> from(count);
+    std::vector<std::uint32_t> to(count);
+    std::vector<std::uint32_t> col1(count);
+    std::vector<std::uint32_t> col2(count);
+    std::vector<double> costs(count);
+    double refMax = 0.;
+    double refMin = std::numeric_limits<double>::max();
+    for (std::size_t i = 0; i < count; ++i) {
+      from[i] = tableIndex(mt);
+      to[i] = tableIndex(mt);
+      col1[i] = rowIndex(mt);
+      col2[i] = rowIndex(mt);
+      costs[i] = value(mt);
+      refMax = std::max({refMax, table[from[i]], table[to[i]]});
+      refMin = std::min(refMin, costs[i] + row1[col1[i]] + row2[col2[i]]);
+    }
+
+    const auto scalarMax =
+        kernels::gatherPairMax(table.data(), from.data(), to.data(), count,
+                               kernels::Backend::Scalar);
+    const auto scalarSum =
+        kernels::gatherPairSum(table.data(), from.data(), to.data(), count,
+                               kernels::Backend::Scalar);
+    const auto scalarMin = kernels::gatherEdgeCostMin(
+        costs.data(), row1.data(), col1.data(), row2.data(), col2.data(),
+        count, kernels::Backend::Scalar);
+    EXPECT_EQ(scalarMax, refMax);
+    EXPECT_EQ(scalarMin, refMin);
+
+    if (!kernels::isAvailable(kernels::Backend::AVX2)) {
+      continue;
+    }
+    // the vectorized results have to be bitwise identical
+    EXPECT_EQ(kernels::gatherPairMax(table.data(), from.data(), to.data(),
+                                     count, kernels::Backend::AVX2),
+              scalarMax);
+    EXPECT_EQ(kernels::gatherPairSum(table.data(), from.data(), to.data(),
+                                     count, kernels::Backend::AVX2),
+              scalarSum);
+    EXPECT_EQ(kernels::gatherEdgeCostMin(costs.data(), row1.data(),
+                                         col1.data(), row2.data(),
+                                         col2.data(), count,
+                                         kernels::Backend::AVX2),
+              scalarMin);
+  }
+}
+
+TEST(Kernels, ExactForIntegerDistances) {
+  const std::vector<double> table{0., 30., 34., 64.};
+  const std::vector<std::uint32_t> from{1, 2, 3, 0, 1};
+  const std::vector<std::uint32_t> to{2, 2, 0, 0, 3};
+  for (const auto backend :
+       {kernels::Backend::Scalar, kernels::Backend::AVX2}) {
+    if (!kernels::isAvailable(backend)) {
+      continue;
+    }
+    EXPECT_EQ(kernels::gatherPairMax(table.data(), from.data(), to.data(),
+                                     from.size(), backend),
+              64.);
+    EXPECT_EQ(kernels::gatherPairSum(table.data(), from.data(), to.data(),
+                                     from.size(), backend),
+              34. + 34. + 64. + 0. + 64.);
+  }
+}
+
 TEST(Functionality, HeuristicBenchmark) {
   /*
       3
@@ -1168,6 +1254,67 @@ TEST(Functionality, NoMeasurementsAdded) {
   EXPECT_NE(qcMapped.back()->getType(), qc::Measure);
 }
 
+TEST(Functionality, StreamingMatchesInMemoryMapping) {
+  using namespace qc::literals;
+  // construct circuit, where each gate forms its own layer
+  qc::QuantumComputation qc{5U};
+  for (std::size_t i = 0; i < 10; ++i) {
+    qc.cx(0_pc, 2);
+    qc.cx(1_pc, 4);
+    qc.cx(3_pc, 0);
+    qc.cx(4_pc, 2);
+  }
+
+  Architecture arch{};
+  arch.loadCouplingMap(AvailableArchitecture::IbmqLondon);
+
+  auto config = Configuration{};
+  config.layering = Layering::IndividualGates;
+  config.initialLayout = InitialLayout::Identity;
+  config.lookaheadHeuristic = LookaheadHeuristic::GateCountMaxDistance;
+  config.nrLookaheads = 3;
+  config.addMeasurementsToMappedCircuit = false;
+  // CNOT cancellation would otherwise also act across layers in `map`
+  config.postMappingOptimizations = false;
+
+  HeuristicMapper mapper(qc, arch);
+  mapper.map(config);
+  const auto results = mapper.getResults();
+  std::stringstream qasm{};
+  mapper.dumpResult(qasm);
+  const auto qcMapped = qasm3::Importer::import(qasm);
+
+  // with only 2Q-gates the sliding window contains exactly the lookahead
+  // layers, so streaming has to find the same swaps
+  HeuristicMapper streamingMapper(qc, arch);
+  std::stringstream streamed{};
+  streamingMapper.mapStreaming(config, streamed);
+  const auto& streamingResults = streamingMapper.getResults();
+  EXPECT_EQ(streamingResults.input.layers, results.input.layers);
+  EXPECT_EQ(streamingResults.output.swaps, results.output.swaps);
+  EXPECT_EQ(streamingResults.output.directionReverse,
+            results.output.directionReverse);
+  EXPECT_EQ(streamingResults.output.gates, results.output.gates);
+
+  const auto qcStreamed = qasm3::Importer::import(streamed);
+  EXPECT_EQ(qcStreamed.getNops(), qcMapped.getNops());
+}
+
+TEST(Functionality, StreamingInvalidSettings) {
+  using namespace qc::literals;
+  qc::QuantumComputation qc{2U};
+  qc.cx(0_pc, 1);
+  Architecture arch{};
+  arch.loadCouplingMap(AvailableArchitecture::IbmqLondon);
+  HeuristicMapper mapper(qc, arch);
+  std::stringstream os{};
+
+  auto config = Configuration{};
+  config.iterativeBidirectionalRouting = true;
+  config.iterativeBidirectionalRoutingPasses = 1;
+  EXPECT_THROW(mapper.mapStreaming(config, os), QMAPException);
+}
+
 TEST(Functionality, InvalidCircuits) {
   Configuration config{};
   config.method = Method::Heuristic;
@@ -1193,14 +1340,14 @@ TEST(Functionality, DataLoggerAfterClose) {
   qc.x(0);
   Architecture arch{3, {}};
   auto dataLogger = std::make_unique<DataLogger>(dataLoggingPath, arch, qc);
-  const qc::CompoundOperation compOp{};
+  const std::vector<const qc::Operation*> ops{};
   Exchange teleport(0, 2, 1, qc::OpType::Teleportation);
 
   dataLogger->logSearchNode(0, 0, 0, 0., 0., 0., {}, false, {{teleport}}, 0);
   dataLogger->logSearchNode(1, 0, 0, 0., 0., 0., {}, false, {}, 0);
   dataLogger->splitLayer();
-  dataLogger->logFinalizeLayer(0, compOp, {}, {}, {}, 0, 0., 0., 0., {}, {}, 0);
-  dataLogger->logFinalizeLayer(0, compOp, {}, {}, {}, 0, 0., 0., 0., {}, {}, 0);
+  dataLogger->logFinalizeLayer(0, ops, {}, {}, {}, 0, 0., 0., 0., {}, {}, 0);
+  dataLogger->logFinalizeLayer(0, ops, {}, {}, {}, 0, 0., 0., 0., {}, {}, 0);
   dataLogger->logSearchNode(0, 0, 0, 0., 0., 0., {}, false, {}, 0);
   dataLogger->close();
   dataLogger->clearLog();
@@ -1209,7 +1356,7 @@ TEST(Functionality, DataLoggerAfterClose) {
   dataLogger->logInputCircuit(qc);
   dataLogger->logOutputCircuit(qc);
   dataLogger->logSearchNode(0, 0, 0, 0., 0., 0., {}, false, {}, 0);
-  dataLogger->logFinalizeLayer(0, compOp, {}, {}, {}, 0, 0., 0., 0., {}, {}, 0);
+  dataLogger->logFinalizeLayer(0, ops, {}, {}, {}, 0, 0., 0., 0., {}, {}, 0);
   dataLogger->splitLayer();
   MappingResults result;
   dataLogger->logMappingResult(result);
@@ -1804,6 +1951,53 @@ TEST_F(LayeringTest, IndividualGates) {
   EXPECT_EQ(barriers, result.input.layers);
 }
 
+TEST(Layering, CommutationFrontMergesCommutingGates) {
+  // the rz commutes with both CNOTs on their control qubit
+  qc::QuantumComputation qc{3};
+  qc.cx(0, 1);
+  qc.rz(0.5, 0);
+  qc.cx(0, 2);
+  Architecture arch{3, {{0, 1}, {1, 2}}};
+  Configuration settings{};
+  settings.initialLayout = InitialLayout::Identity;
+  settings.preMappingOptimizations = false;
+  settings.postMappingOptimizations = false;
+
+  settings.layering = Layering::DisjointQubits;
+  auto mapper = std::make_unique<HeuristicMapper>(qc, arch);
+  mapper->map(settings);
+  EXPECT_EQ(mapper->getResults().input.layers, 3);
+
+  settings.layering = Layering::CommutationFront;
+  mapper = std::make_unique<HeuristicMapper>(qc, arch);
+  mapper->map(settings);
+  EXPECT_EQ(mapper->getResults().input.layers, 2);
+}
+
+TEST(Layering, CommutationFrontExecutesGatesEarly) {
+  qc::QuantumComputation qc{4};
+  qc.cx(0, 1);
+  qc.cx(1, 2);
+  qc.cx(2, 3);
+  Architecture arch{4, {{0, 1}, {1, 2}, {2, 3}}};
+  Configuration settings{};
+  settings.initialLayout = InitialLayout::Identity;
+  settings.layering = Layering::CommutationFront;
+  settings.preMappingOptimizations = false;
+  settings.postMappingOptimizations = false;
+  settings.debug = true;
+
+  auto mapper = std::make_unique<HeuristicMapper>(qc, arch);
+  mapper->map(settings);
+  const auto& results = mapper->getResults();
+  EXPECT_EQ(results.input.layers, 3);
+  // the later layers are executable after routing the first one, so only a
+  // single search is necessary
+  EXPECT_EQ(results.layerHeuristicBenchmark.size(), 1);
+  EXPECT_EQ(results.output.swaps, 0);
+  EXPECT_EQ(results.output.cnots, 3);
+}
+
 class HeuristicTest5Q : public testing::TestWithParam<std::string> {
 protected:
   std::string testExampleDir = "../../../examples/";
@@ -2467,6 +2661,9 @@ TEST(HeuristicTestFidelity, LayerSplitting) {
       FAIL() << "Could not open file " << settings.dataLoggingPath << path;
     }
     std::string line;
+    std::set<std::size_t> nodeIds{};
+    std::size_t expandedNodes = 0;
+    std::size_t lastParent = 0;
     while (std::getline(layerNodeFile, line)) {
       if (line.empty()) {
         continue;
@@ -2477,17 +2674,27 @@ TEST(HeuristicTestFidelity, LayerSplitting) {
         FAIL() << "Missing value for node id in " << settings.dataLoggingPath
                << path;
       }
+      nodeIds.emplace(std::stoull(col));
       if (std::getline(lineStream, col, ';')) {
-        if (std::stoull(col) != 0) {
-          // should only contain root node and its direct children
-          FAIL() << "Unexpected value for parent node id in "
-                 << settings.dataLoggingPath << path;
+        const auto parent = std::stoull(col);
+        // should only contain the root node, the seeds carried over from the
+        // previously aborted search (as children of the root), and the
+        // children of the single expanded node
+        if (nodeIds.count(parent) == 0) {
+          FAIL() << "Unknown parent node id in " << settings.dataLoggingPath
+                 << path;
+        }
+        if (parent != 0 && parent != lastParent) {
+          ++expandedNodes;
+          lastParent = parent;
         }
       } else {
         FAIL() << "Missing value for parent node id in "
                << settings.dataLoggingPath << path;
       }
     }
+    EXPECT_LE(expandedNodes, 1) << "More than one node expanded in "
+                                << settings.dataLoggingPath << path;
   }
   if (!std::filesystem::exists(settings.dataLoggingPath +
                                "layer_0.presplit-0.json")) {
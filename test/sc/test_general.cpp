@@ -6,6 +6,7 @@
 #include "sc/Architecture.hpp"
 #include "sc/utils.hpp"
 
+#include <cstdint>
 #include <fstream>
 #include <gtest/gtest.h>
 #include <vector>
@@ -185,3 +186,43 @@ TEST(General, DijkstraSkipEdges) {
   Dijkstra::buildEdgeSkipTable(cm, edgeSkipDistanceTable, edgeWeights);
   EXPECT_EQ(edgeSkipDistanceTable, edgeSkipTargetTable);
 }
+
+TEST(General, QubitSet) {
+  QubitSet set(70);
+  EXPECT_TRUE(set.empty());
+  set.insert(65);
+  set.insert(3);
+  set.insert(64);
+  set.insert(3);
+  EXPECT_EQ(set.size(), 3);
+  EXPECT_TRUE(set.contains(3));
+  EXPECT_TRUE(set.contains(64));
+  EXPECT_FALSE(set.contains(4));
+  EXPECT_FALSE(set.contains(200));
+  EXPECT_EQ(std::vector<std::uint16_t>(set.begin(), set.end()),
+            (std::vector<std::uint16_t>{3, 64, 65}));
+
+  set.insert(130);
+  EXPECT_TRUE(set.contains(130));
+  EXPECT_EQ(set.size(), 4);
+
+  set.clear();
+  EXPECT_TRUE(set.empty());
+  EXPECT_EQ(set.begin(), set.end());
+}
+
+TEST(General, TwoQubitMultiplicityStaysSorted) {
+  TwoQubitMultiplicity multiplicity{};
+  addTwoQubitGateCount(multiplicity, 2, 3, 1, 0);
+  addTwoQubitGateCount(multiplicity, 0, 4, 0, 1);
+  addTwoQubitGateCount(multiplicity, 2, 3, 0, 1);
+  addTwoQubitGateCount(multiplicity, 0, 1, 1, 0);
+
+  ASSERT_EQ(multiplicity.size(), 3);
+  EXPECT_EQ(multiplicity[0].edge(), Edge(0, 1));
+  EXPECT_EQ(multiplicity[1].edge(), Edge(0, 4));
+  EXPECT_EQ(multiplicity[1].backward, 1);
+  EXPECT_EQ(multiplicity[2].edge(), Edge(2, 3));
+  EXPECT_EQ(multiplicity[2].forward, 1);
+  EXPECT_EQ(multiplicity[2].backward, 1);
+}